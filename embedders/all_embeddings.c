@@ -13,7 +13,8 @@
  * Compile with:
  *     
  *     cc -o all_embeddings -O4 all_embeddings.c ../multicode/shared/multicode_base.c\
- *       ../multicode/shared/multicode_input.c
+ *       ../multicode/shared/multicode_input.c \
+ *       ../multicode/shared/multicode_scanner.c
  * 
  */
 
@@ -13,7 +13,8 @@
  * Compile with:
  *     
  *     cc -o circular -O4  circular.c ../multicode/shared/multicode_base.c \
- *     ../multicode/shared/multicode_input.c
+ *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c
  * 
  */
 
@@ -14,7 +14,8 @@
  *     
  *     cc -o hamiltonian_embed -O4  hamiltonian_embed.c \
  *     ../multicode/shared/multicode_base.c \
- *     ../multicode/shared/multicode_input.c
+ *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c
  * 
  */
 
@@ -0,0 +1,382 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* Vertex colourings are constructed with the DSATUR rule: the next vertex
+ * that gets a colour is the vertex with the most different colours among its
+ * neighbours (its saturation), and ties are broken by the number of
+ * neighbours that are not yet coloured.
+ *
+ * A greedy clique gives a lower bound on the chromatic number. The vertices
+ * of this clique get the first colours before the search starts, which also
+ * removes the symmetry between the colours. A greedy colouring with the
+ * DSATUR rule gives an upper bound. The branch-and-bound search then only
+ * looks for colourings with fewer colours than the best colouring found so
+ * far, and stops as soon as it reaches the lower bound.
+ *
+ * For each vertex the number of neighbours with each colour is stored,
+ * together with a bitset of the colours that appear among its neighbours.
+ * Both are updated when a vertex gets or loses a colour. Loops are ignored,
+ * and parallel edges are treated as a single edge.
+ */
+
+#include "multi_colouring.h"
+#include "../../multicode/shared/multicode_bitset.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    int order;
+
+    //the neighbours of v are neighbours[offsets[v]] up to neighbours[offsets[v+1]-1]
+    int *offsets;
+    int *neighbours;
+
+    //colours are numbered from 1 up to colourLimit, 0 means no colour
+    int colourLimit;
+    int colourWords;
+    int *colour;
+    //the number of neighbours of v with colour c is neighbourColours[v*(colourLimit+1) + c]
+    unsigned short *neighbourColours;
+    //colour 0 is always in these sets
+    BITSET_WORD *saturationSets;
+    int *saturation;
+    int *uncolouredDegree;
+
+    int *clique;
+    int cliqueSize;
+
+    //the number of colours in the best colouring so far
+    int best;
+    //the search stops when a colouring with at most this many colours is found
+    int goal;
+} COLOURING;
+
+#define NEIGHBOUR_COLOURS(colouring, v, c) \
+    (colouring)->neighbourColours[(size_t)(v) * ((colouring)->colourLimit + 1) + (c)]
+#define SATURATION_SET(colouring, v) \
+    ((colouring)->saturationSets + (size_t)(v) * (colouring)->colourWords)
+
+static void *allocateArray(size_t size){
+    void *array = malloc(size == 0 ? 1 : size);
+    if(array == NULL){
+        fprintf(stderr, "Insufficient memory for colouring -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+/* Stores the simple graph underlying graph and returns its maximum degree.
+ */
+static int setNeighbours(COLOURING *colouring, GRAPH graph, ADJACENCY adj){
+    int v, i;
+    int order = graph[0][0];
+    int edgeCount = 0;
+    int maximumDegree = 0;
+    int *lastSeen;
+
+    for(v = 1; v <= order; v++){
+        edgeCount += adj[v];
+    }
+    colouring->offsets = (int *)allocateArray(sizeof(int)*(order + 2));
+    colouring->neighbours = (int *)allocateArray(sizeof(int)*edgeCount);
+    lastSeen = (int *)allocateArray(sizeof(int)*(order + 1));
+    for(v = 0; v <= order; v++){
+        lastSeen[v] = 0;
+    }
+
+    edgeCount = 0;
+    for(v = 1; v <= order; v++){
+        colouring->offsets[v] = edgeCount;
+        for(i = 0; i < adj[v]; i++){
+            int neighbour = graph[v][i];
+            if(neighbour != v && lastSeen[neighbour] != v){
+                lastSeen[neighbour] = v;
+                colouring->neighbours[edgeCount++] = neighbour;
+            }
+        }
+        if(edgeCount - colouring->offsets[v] > maximumDegree){
+            maximumDegree = edgeCount - colouring->offsets[v];
+        }
+    }
+    colouring->offsets[order + 1] = edgeCount;
+    free(lastSeen);
+
+    return maximumDegree;
+}
+
+/* Stores a clique in colouring. The clique is grown from each vertex in turn
+ * by adding the candidate with the most neighbours among the other
+ * candidates, and the largest clique is kept.
+ */
+static void findGreedyClique(COLOURING *colouring, GRAPH graph, ADJACENCY adj){
+    int v, u, i;
+    int order = colouring->order;
+    BITSET_ADJACENCY *matrix = newBitsetAdjacency();
+    int wordCount;
+    BITSET_WORD *candidates, *intersection;
+    int *clique = (int *)allocateArray(sizeof(int)*(order + 1));
+
+    buildBitsetAdjacency(graph, adj, matrix);
+    wordCount = matrix->wordCount;
+    candidates = newBitsets(2, wordCount);
+    intersection = candidates + wordCount;
+
+    colouring->cliqueSize = 0;
+    for(v = 1; v <= order; v++){
+        int size = 1;
+        int candidateCount;
+
+        if(colouring->offsets[v + 1] - colouring->offsets[v] < colouring->cliqueSize){
+            //v cannot be in a larger clique
+            continue;
+        }
+
+        clique[0] = v;
+        for(i = 0; i < wordCount; i++){
+            candidates[i] = BITSET_ROW(matrix, v)[i];
+        }
+        BITSET_REMOVE(candidates, v);
+        candidateCount = bitsetSize(candidates, wordCount);
+
+        while(candidateCount > 0){
+            int next = 0;
+            int nextCount = -1;
+            for(u = 1; u <= order; u++){
+                if(BITSET_CONTAINS(candidates, u)){
+                    int count = intersectBitsets(intersection, candidates,
+                            BITSET_ROW(matrix, u), wordCount);
+                    if(count > nextCount){
+                        next = u;
+                        nextCount = count;
+                    }
+                }
+            }
+            clique[size++] = next;
+            intersectBitsets(candidates, candidates, BITSET_ROW(matrix, next), wordCount);
+            BITSET_REMOVE(candidates, next);
+            candidateCount = bitsetSize(candidates, wordCount);
+        }
+
+        if(size > colouring->cliqueSize){
+            colouring->cliqueSize = size;
+            for(i = 0; i < size; i++){
+                colouring->clique[i] = clique[i];
+            }
+        }
+    }
+
+    free(clique);
+    free(candidates);
+    freeBitsetAdjacency(matrix);
+}
+
+static void assignColour(COLOURING *colouring, int v, int c){
+    int i;
+
+    colouring->colour[v] = c;
+    for(i = colouring->offsets[v]; i < colouring->offsets[v + 1]; i++){
+        int neighbour = colouring->neighbours[i];
+        if(NEIGHBOUR_COLOURS(colouring, neighbour, c)++ == 0){
+            BITSET_ADD(SATURATION_SET(colouring, neighbour), c);
+            colouring->saturation[neighbour]++;
+        }
+        colouring->uncolouredDegree[neighbour]--;
+    }
+}
+
+static void removeColour(COLOURING *colouring, int v){
+    int i;
+    int c = colouring->colour[v];
+
+    colouring->colour[v] = 0;
+    for(i = colouring->offsets[v]; i < colouring->offsets[v + 1]; i++){
+        int neighbour = colouring->neighbours[i];
+        if(--NEIGHBOUR_COLOURS(colouring, neighbour, c) == 0){
+            BITSET_REMOVE(SATURATION_SET(colouring, neighbour), c);
+            colouring->saturation[neighbour]--;
+        }
+        colouring->uncolouredDegree[neighbour]++;
+    }
+}
+
+/* Removes all colours and then gives the vertices of the clique the first
+ * colours.
+ */
+static void resetColouring(COLOURING *colouring){
+    int v, i;
+    int order = colouring->order;
+
+    for(i = 0; i < (order + 1) * (colouring->colourLimit + 1); i++){
+        colouring->neighbourColours[i] = 0;
+    }
+    clearBitset(colouring->saturationSets, (order + 1) * colouring->colourWords);
+    for(v = 1; v <= order; v++){
+        colouring->colour[v] = 0;
+        BITSET_ADD(SATURATION_SET(colouring, v), 0);
+        colouring->saturation[v] = 0;
+        colouring->uncolouredDegree[v] = colouring->offsets[v + 1] - colouring->offsets[v];
+    }
+
+    for(i = 0; i < colouring->cliqueSize; i++){
+        assignColour(colouring, colouring->clique[i], i + 1);
+    }
+}
+
+/* Returns the vertex without a colour that has the largest saturation, and
+ * among those the one with the most neighbours without a colour.
+ */
+static int selectVertex(COLOURING *colouring){
+    int v;
+    int selected = 0;
+
+    for(v = 1; v <= colouring->order; v++){
+        if(colouring->colour[v]){
+            continue;
+        }
+        if(selected == 0 ||
+                colouring->saturation[v] > colouring->saturation[selected] ||
+                (colouring->saturation[v] == colouring->saturation[selected] &&
+                 colouring->uncolouredDegree[v] > colouring->uncolouredDegree[selected])){
+            selected = v;
+        }
+    }
+
+    return selected;
+}
+
+/* Returns the smallest colour that is at least first and that is not used
+ * by a neighbour of v, or a colour larger than colourLimit if there is none.
+ */
+static int nextFreeColour(COLOURING *colouring, int v, int first){
+    BITSET_WORD *saturationSet = SATURATION_SET(colouring, v);
+    int word = first / BITSET_WORD_SIZE;
+    BITSET_WORD freeColours;
+
+    if(first > colouring->colourLimit){
+        return first;
+    }
+    freeColours = ~saturationSet[word] & (~0ULL << (first % BITSET_WORD_SIZE));
+    while(freeColours == 0){
+        word++;
+        if(word == colouring->colourWords){
+            return colouring->colourLimit + 1;
+        }
+        freeColours = ~saturationSet[word];
+    }
+    return word * BITSET_WORD_SIZE + __builtin_ctzll(freeColours);
+}
+
+/* Colours the remaining vertices with the DSATUR rule and the smallest free
+ * colour, and returns the number of colours that were used.
+ */
+static int colourGreedily(COLOURING *colouring){
+    int i;
+    int usedColours = colouring->cliqueSize;
+
+    for(i = colouring->cliqueSize; i < colouring->order; i++){
+        int v = selectVertex(colouring);
+        int c = nextFreeColour(colouring, v, 1);
+        assignColour(colouring, v, c);
+        if(c > usedColours){
+            usedColours = c;
+        }
+    }
+
+    return usedColours;
+}
+
+/* Tries all colourings of the remaining vertices that use fewer colours than
+ * the best colouring so far. The colours that are used by the coloured
+ * vertices are 1 up to usedColours.
+ */
+static void extendColouring(COLOURING *colouring, int colouredCount, int usedColours){
+    int v, c;
+
+    if(colouredCount == colouring->order){
+        colouring->best = usedColours;
+        return;
+    }
+
+    v = selectVertex(colouring);
+    c = nextFreeColour(colouring, v, 1);
+    //a new colour is only tried once: all unused colours are equivalent
+    while(c <= usedColours + 1 && c < colouring->best){
+        assignColour(colouring, v, c);
+        extendColouring(colouring, colouredCount + 1, c > usedColours ? c : usedColours);
+        removeColour(colouring, v);
+        if(colouring->best <= colouring->goal){
+            return;
+        }
+        c = nextFreeColour(colouring, v, c + 1);
+    }
+}
+
+/* Returns the chromatic number of the graph. If bound is not NO_COLOUR_BOUND,
+ * the search stops as soon as it is known whether the graph can be coloured
+ * with bound colours: in that case the value is at most bound if it can,
+ * but it need not be the chromatic number, and it is bound + 1 otherwise.
+ */
+int findChromaticNumber(GRAPH graph, ADJACENCY adj, int bound){
+    int order = graph[0][0];
+    int upperBound;
+    COLOURING colouring;
+
+    if(order == 0){
+        return 0;
+    }
+
+    colouring.order = order;
+    colouring.colourLimit = setNeighbours(&colouring, graph, adj) + 1;
+    colouring.colourWords = BITSET_WORD_COUNT(colouring.colourLimit);
+    colouring.colour = (int *)allocateArray(sizeof(int)*(order + 1));
+    colouring.neighbourColours = (unsigned short *)allocateArray(
+            sizeof(unsigned short)*(order + 1)*(colouring.colourLimit + 1));
+    colouring.saturationSets = newBitsets(order + 1, colouring.colourWords);
+    colouring.saturation = (int *)allocateArray(sizeof(int)*(order + 1));
+    colouring.uncolouredDegree = (int *)allocateArray(sizeof(int)*(order + 1));
+    colouring.clique = (int *)allocateArray(sizeof(int)*(order + 1));
+
+    findGreedyClique(&colouring, graph, adj);
+    resetColouring(&colouring);
+    upperBound = colourGreedily(&colouring);
+
+    if(bound != NO_COLOUR_BOUND && colouring.cliqueSize > bound){
+        colouring.best = bound + 1;
+    } else if(bound != NO_COLOUR_BOUND && upperBound <= bound){
+        colouring.best = upperBound;
+    } else {
+        colouring.best = upperBound;
+        colouring.goal = colouring.cliqueSize;
+        if(bound != NO_COLOUR_BOUND){
+            //only colourings with at most bound colours are of interest
+            colouring.best = bound + 1;
+            colouring.goal = bound;
+        }
+        if(colouring.best > colouring.goal){
+            resetColouring(&colouring);
+            extendColouring(&colouring, colouring.cliqueSize, colouring.cliqueSize);
+        }
+    }
+
+    free(colouring.offsets);
+    free(colouring.neighbours);
+    free(colouring.colour);
+    free(colouring.neighbourColours);
+    free(colouring.saturationSets);
+    free(colouring.saturation);
+    free(colouring.uncolouredDegree);
+    free(colouring.clique);
+
+    return colouring.best;
+}
+
+/* Returns TRUE if the graph can be coloured with the given number of
+ * colours.
+ */
+boolean isColourable(GRAPH graph, ADJACENCY adj, int colours){
+    return findChromaticNumber(graph, adj, colours) <= colours;
+}
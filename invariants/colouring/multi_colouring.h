@@ -0,0 +1,19 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTI_COLOURING_H
+#define	MULTI_COLOURING_H
+
+#include "../../multicode/shared/multicode_base.h"
+
+#define NO_COLOUR_BOUND 0
+
+int findChromaticNumber(GRAPH graph, ADJACENCY adj, int bound);
+
+boolean isColourable(GRAPH graph, ADJACENCY adj, int colours);
+
+#endif	/* MULTI_COLOURING_H */
@@ -9,82 +9,263 @@
  * 
  */
 
-#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "../../multicode/shared/multicode_base.h"
-    
-//try to find a path from the current vertex to the target
-boolean findPath(GRAPH graph, ADJACENCY adj, int currentVertex, int target, int *paths, int order, boolean* currentPath, int *capacity) {
-    int i;
-    if(currentVertex==target)
-        return TRUE;
-    currentPath[currentVertex]=TRUE;
-    for(i=0; i < adj[currentVertex]; i++){
-        int nextVertex = graph[currentVertex][i];
-        if(paths[currentVertex*(order+1) + nextVertex]-paths[nextVertex*(order+1) + currentVertex]<=capacity[currentVertex*(order+1) + nextVertex]-1 && !currentPath[nextVertex]){
-            paths[currentVertex*(order+1) + nextVertex]++;
-            if(findPath(graph, adj, nextVertex, target, paths, order, currentPath, capacity))
-                return TRUE;
-            else
-                paths[currentVertex*(order+1) + nextVertex]--;
-        }
-    }
-    currentPath[currentVertex]=FALSE;
-    return FALSE;
-}
+#include "multi_connectivity.h"
+#include "multi_flow.h"
+
+//the network is reused for all calls in the same thread
+_Thread_local FLOW_NETWORK *edgeNetwork = NULL;
 
 //returns the minimum of the maxflow of the st-network and maxValue
 int findMaxFlowInSTNetwork(GRAPH graph, ADJACENCY adj, int source, int target, int maxValue){
     int i, j;
-
     int order = graph[0][0];
-    int paths[(order+1)*(order+1)];
-    int capacity[(order+1)*(order+1)];
-    for(i=0; i<(order+1)*(order+1); i++){
-        paths[i] = 0;
-        capacity[i] = 0;
+
+    if(edgeNetwork == NULL){
+        edgeNetwork = newFlowNetwork();
     }
+    clearFlowNetwork(edgeNetwork, order + 1);
     for(i = 1; i <= order; i++){
         for(j = 0; j < adj[i]; j++){
-            capacity[i*(order+1) + graph[i][j]]++;
+            //each edge can be used once, in either direction
+            if(i < graph[i][j]){
+                addArcPair(edgeNetwork, i, graph[i][j], 1, 1);
+            }
         }
     }
-    
-    int pathCount = 0;
-    boolean currentPath[order+1];
-    for(i=0; i<(order+1); i++){
-        currentPath[i] = FALSE;
-    }
-    while(findPath(graph, adj, source, target, paths, order, currentPath, capacity) && pathCount < maxValue){
-        pathCount++;
-        for(i=0; i<(order+1); i++){
-            currentPath[i] = FALSE;
+
+    return findMaxFlow(edgeNetwork, source, target, maxValue);
+}
+
+static void *allocateWorkSpace(void *array, size_t size){
+    array = realloc(array, size);
+    if(array == NULL){
+        fprintf(stderr, "Insufficient memory for minimum cut -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+/* Work space for the minimum cut computation. The vertices that have been
+ * merged into one vertex share a list of edge ends: edgeEnd[e] is the other
+ * end of the edge end e, and nextEdgeEnd[e] is the next edge end in the list.
+ * The list of each vertex runs from firstEdgeEnd to lastEdgeEnd.
+ */
+_Thread_local int *mergedInto = NULL;
+_Thread_local int *firstEdgeEnd = NULL;
+_Thread_local int *lastEdgeEnd = NULL;
+_Thread_local int *edgeEnd = NULL;
+_Thread_local int *nextEdgeEnd = NULL;
+_Thread_local int *connection = NULL;
+_Thread_local boolean *added = NULL;
+_Thread_local int *heapKeys = NULL;
+_Thread_local int *heapVertices = NULL;
+_Thread_local int cutVertexCapacity = 0;
+_Thread_local int cutEdgeEndCapacity = 0;
+
+static void prepareCutWorkSpace(int order, int edgeEnds){
+    if(order + 1 > cutVertexCapacity){
+        cutVertexCapacity = order + 1;
+        mergedInto = (int *)allocateWorkSpace(mergedInto, sizeof(int)*cutVertexCapacity);
+        firstEdgeEnd = (int *)allocateWorkSpace(firstEdgeEnd, sizeof(int)*cutVertexCapacity);
+        lastEdgeEnd = (int *)allocateWorkSpace(lastEdgeEnd, sizeof(int)*cutVertexCapacity);
+        connection = (int *)allocateWorkSpace(connection, sizeof(int)*cutVertexCapacity);
+        added = (boolean *)allocateWorkSpace(added, sizeof(boolean)*cutVertexCapacity);
+    }
+    if(edgeEnds + order + 1 > cutEdgeEndCapacity){
+        cutEdgeEndCapacity = edgeEnds + order + 1;
+        edgeEnd = (int *)allocateWorkSpace(edgeEnd, sizeof(int)*cutEdgeEndCapacity);
+        nextEdgeEnd = (int *)allocateWorkSpace(nextEdgeEnd, sizeof(int)*cutEdgeEndCapacity);
+        heapKeys = (int *)allocateWorkSpace(heapKeys, sizeof(int)*cutEdgeEndCapacity);
+        heapVertices = (int *)allocateWorkSpace(heapVertices, sizeof(int)*cutEdgeEndCapacity);
+    }
+}
+
+//returns the vertex into which v has been merged
+static int findMergedVertex(int v){
+    while(mergedInto[v] != v){
+        mergedInto[v] = mergedInto[mergedInto[v]];
+        v = mergedInto[v];
+    }
+    return v;
+}
+
+static void pushHeap(int *heapSize, int key, int v){
+    int i = (*heapSize)++;
+    while(i > 0 && heapKeys[(i - 1)/2] < key){
+        heapKeys[i] = heapKeys[(i - 1)/2];
+        heapVertices[i] = heapVertices[(i - 1)/2];
+        i = (i - 1)/2;
+    }
+    heapKeys[i] = key;
+    heapVertices[i] = v;
+}
+
+static int popHeap(int *heapSize){
+    int top = heapVertices[0];
+    int key = heapKeys[--(*heapSize)];
+    int v = heapVertices[*heapSize];
+    int i = 0, child;
+    while((child = 2*i + 1) < *heapSize){
+        if(child + 1 < *heapSize && heapKeys[child + 1] > heapKeys[child]){
+            child++;
+        }
+        if(heapKeys[child] <= key){
+            break;
         }
+        heapKeys[i] = heapKeys[child];
+        heapVertices[i] = heapVertices[child];
+        i = child;
     }
-    return pathCount;
+    heapKeys[i] = key;
+    heapVertices[i] = v;
+    return top;
 }
 
+static boolean isConnected(GRAPH graph, ADJACENCY adj){
+    int i, order = graph[0][0];
+    int head = 0, tail = 0;
+
+    //connection is used as the queue and added marks the visited vertices
+    for(i = 1; i <= order; i++){
+        added[i] = FALSE;
+    }
+    added[1] = TRUE;
+    connection[tail++] = 1;
+    while(head < tail){
+        int v = connection[head++];
+        for(i = 0; i < adj[v]; i++){
+            if(!added[graph[v][i]]){
+                added[graph[v][i]] = TRUE;
+                connection[tail++] = graph[v][i];
+            }
+        }
+    }
+    return tail == order;
+}
+
+/* Returns the weight of the cut that separates the last vertex that is added
+ * in a maximum adjacency ordering of the remaining vertices from the others,
+ * and merges that vertex into the one that was added before it. The graph
+ * should be connected.
+ */
+static int minimumCutPhase(int order, int start){
+    int i, v, previous = start, last = start, heapSize = 0;
+    int remaining = 0;
+
+    for(v = 1; v <= order; v++){
+        if(mergedInto[v] == v){
+            connection[v] = 0;
+            added[v] = FALSE;
+            remaining++;
+        }
+    }
+
+    v = start;
+    while(TRUE){
+        int edge, previousEdge = -1;
+        added[v] = TRUE;
+        remaining--;
+        previous = last;
+        last = v;
+        if(remaining == 0){
+            break;
+        }
+        //update the connections and drop edges that became loops
+        for(edge = firstEdgeEnd[v]; edge != -1; edge = nextEdgeEnd[edge]){
+            int w = findMergedVertex(edgeEnd[edge]);
+            if(w == v){
+                if(previousEdge == -1){
+                    firstEdgeEnd[v] = nextEdgeEnd[edge];
+                } else {
+                    nextEdgeEnd[previousEdge] = nextEdgeEnd[edge];
+                }
+                continue;
+            }
+            previousEdge = edge;
+            if(!added[w]){
+                connection[w]++;
+                pushHeap(&heapSize, connection[w], w);
+            }
+        }
+        lastEdgeEnd[v] = previousEdge;
+        //the entries in the heap are not updated, so skip outdated entries
+        do {
+            i = heapKeys[0];
+            v = popHeap(&heapSize);
+        } while(added[v] || i != connection[v]);
+    }
+
+    //merge the last vertex into the previous one
+    mergedInto[last] = previous;
+    if(firstEdgeEnd[previous] == -1){
+        firstEdgeEnd[previous] = firstEdgeEnd[last];
+        lastEdgeEnd[previous] = lastEdgeEnd[last];
+    } else if(firstEdgeEnd[last] != -1){
+        nextEdgeEnd[lastEdgeEnd[previous]] = firstEdgeEnd[last];
+        lastEdgeEnd[previous] = lastEdgeEnd[last];
+    }
+    
+    return connection[last];
+}
+
+/* Computes the edge connectivity with the algorithm of Stoer and Wagner: in
+ * each phase a cut is found, and two vertices on the same side of a minimum
+ * cut are merged, until only one vertex is left.
+ */
 int findEdgeConnectivity(GRAPH graph, ADJACENCY adj){
-    int i;
-    int minDegree, vertexMinDegree, minimumCutSize;
+    int i, j, edgeEnds = 0;
+    int minDegree, minimumCutSize;
+    int order = graph[0][0];
     
     minDegree = adj[1];
-    vertexMinDegree = 1;
     
-    for (i = 2; i <= graph[0][0]; i++){
+    for (i = 2; i <= order; i++){
         if(adj[i]<minDegree){
             minDegree = adj[i];
-            vertexMinDegree = i;
+        }
+    }
+    if(order < 2){
+        return minDegree;
+    }
+    
+    for (i = 1; i <= order; i++){
+        edgeEnds += adj[i];
+    }
+    prepareCutWorkSpace(order, edgeEnds);
+    
+    if(!isConnected(graph, adj)){
+        return 0;
+    }
+    
+    edgeEnds = 0;
+    for (i = 1; i <= order; i++){
+        mergedInto[i] = i;
+        firstEdgeEnd[i] = lastEdgeEnd[i] = -1;
+        for(j = 0; j < adj[i]; j++){
+            if(graph[i][j] != i){
+                edgeEnd[edgeEnds] = graph[i][j];
+                nextEdgeEnd[edgeEnds] = firstEdgeEnd[i];
+                if(firstEdgeEnd[i] == -1){
+                    lastEdgeEnd[i] = edgeEnds;
+                }
+                firstEdgeEnd[i] = edgeEnds;
+                edgeEnds++;
+            }
         }
     }
     
     minimumCutSize = minDegree;
-    for (i = 1; i <= graph[0][0]; i++){
-        if(i!=vertexMinDegree){
-            minimumCutSize = findMaxFlowInSTNetwork(graph, adj, vertexMinDegree, i, minimumCutSize);
+    //a connected graph has no cut that is smaller than 1
+    for (i = 1; i < order && minimumCutSize > 1; i++){
+        int cut = minimumCutPhase(order, findMergedVertex(1));
+        if(cut < minimumCutSize){
+            minimumCutSize = cut;
         }
-        //TODO: add optimalisations
     }
     
     return minimumCutSize;
-}
\ No newline at end of file
+}
@@ -8,8 +8,6 @@
 #ifndef MULTI_CONNECTIVITY_H
 #define	MULTI_CONNECTIVITY_H
 
-boolean findPath(GRAPH graph, ADJACENCY adj, int currentVertex, int target, int *paths, int order, boolean* currentPath);
-
 int findMaxFlowInSTNetwork(GRAPH graph, ADJACENCY adj, int source, int target, int maxValue);
 
 int findEdgeConnectivity(GRAPH graph, ADJACENCY adj);
@@ -0,0 +1,231 @@
+/*
+ * Main developer: Nico Van Cleemput
+ * 
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* Maximum flows are computed with Dinic's algorithm: a breadth-first search
+ * from the source assigns a level to each vertex, and then paths that only
+ * use arcs from one level to the next are augmented until none are left. The
+ * search for augmenting paths uses an explicit stack, so the depth of the
+ * network is not limited by the size of the call stack.
+ */
+
+#include "multi_flow.h"
+#include<stdio.h>
+#include<stdlib.h>
+
+static void *resize(void *array, size_t size){
+    array = realloc(array, size);
+    if(array == NULL){
+        fprintf(stderr, "Insufficient memory for flow network -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+FLOW_NETWORK *newFlowNetwork(){
+    FLOW_NETWORK *network = (FLOW_NETWORK *)resize(NULL, sizeof(FLOW_NETWORK));
+
+    network->vertexCount = 0;
+    network->arcCount = 0;
+    network->head = NULL;
+    network->capacity = NULL;
+    network->residual = NULL;
+    network->firstArc = NULL;
+    network->arcs = NULL;
+    network->arcsSorted = TRUE;
+    network->level = NULL;
+    network->currentArc = NULL;
+    network->queue = NULL;
+    network->path = NULL;
+    network->vertexCapacity = 0;
+    network->arcCapacity = 0;
+
+    return network;
+}
+
+void freeFlowNetwork(FLOW_NETWORK *network){
+    free(network->head);
+    free(network->capacity);
+    free(network->residual);
+    free(network->firstArc);
+    free(network->arcs);
+    free(network->level);
+    free(network->currentArc);
+    free(network->queue);
+    free(network->path);
+    free(network);
+}
+
+/* Removes all arcs and sets the number of vertices of the network.
+ */
+void clearFlowNetwork(FLOW_NETWORK *network, int vertexCount){
+    if(vertexCount > network->vertexCapacity){
+        network->vertexCapacity = vertexCount;
+        network->firstArc = (int *)resize(network->firstArc, sizeof(int)*(vertexCount + 1));
+        network->level = (int *)resize(network->level, sizeof(int)*vertexCount);
+        network->currentArc = (int *)resize(network->currentArc, sizeof(int)*vertexCount);
+        network->queue = (int *)resize(network->queue, sizeof(int)*vertexCount);
+        network->path = (int *)resize(network->path, sizeof(int)*vertexCount);
+    }
+    network->vertexCount = vertexCount;
+    network->arcCount = 0;
+    network->arcsSorted = FALSE;
+}
+
+/* Adds an arc from from to to with the given capacity, and the reverse arc
+ * with capacity reverseCapacity. An undirected edge corresponds to a pair of
+ * arcs with the same capacity.
+ */
+void addArcPair(FLOW_NETWORK *network, int from, int to, int capacity, int reverseCapacity){
+    int arc = network->arcCount;
+
+    if(arc + 2 > network->arcCapacity){
+        network->arcCapacity = 2*network->arcCapacity + 64;
+        network->head = (int *)resize(network->head, sizeof(int)*network->arcCapacity);
+        network->capacity = (int *)resize(network->capacity, sizeof(int)*network->arcCapacity);
+        network->residual = (int *)resize(network->residual, sizeof(int)*network->arcCapacity);
+        network->arcs = (int *)resize(network->arcs, sizeof(int)*network->arcCapacity);
+    }
+
+    network->head[arc] = to;
+    network->capacity[arc] = capacity;
+    network->head[arc + 1] = from;
+    network->capacity[arc + 1] = reverseCapacity;
+    network->arcCount += 2;
+    network->arcsSorted = FALSE;
+}
+
+//groups the arcs by the vertex they leave
+static void sortArcs(FLOW_NETWORK *network){
+    int v, arc;
+    int *firstArc = network->firstArc;
+
+    for(v = 0; v <= network->vertexCount; v++){
+        firstArc[v] = 0;
+    }
+    for(arc = 0; arc < network->arcCount; arc++){
+        //the tail of an arc is the head of its reverse
+        firstArc[network->head[arc ^ 1] + 1]++;
+    }
+    for(v = 0; v < network->vertexCount; v++){
+        firstArc[v + 1] += firstArc[v];
+    }
+    for(arc = 0; arc < network->arcCount; arc++){
+        network->arcs[firstArc[network->head[arc ^ 1]]++] = arc;
+    }
+    //restore the start positions that were shifted while placing the arcs
+    for(v = network->vertexCount; v > 0; v--){
+        firstArc[v] = firstArc[v - 1];
+    }
+    firstArc[0] = 0;
+
+    network->arcsSorted = TRUE;
+}
+
+//returns TRUE if the target can still be reached from the source
+static boolean assignLevels(FLOW_NETWORK *network, int source, int target){
+    int v, i, head = 0, tail = 0;
+    int *level = network->level;
+
+    for(v = 0; v < network->vertexCount; v++){
+        level[v] = -1;
+    }
+    level[source] = 0;
+    network->queue[tail++] = source;
+    while(head < tail){
+        v = network->queue[head++];
+        for(i = network->firstArc[v]; i < network->firstArc[v + 1]; i++){
+            int arc = network->arcs[i];
+            int w = network->head[arc];
+            if(level[w] < 0 && network->residual[arc] > 0){
+                level[w] = level[v] + 1;
+                if(w == target){
+                    return TRUE;
+                }
+                network->queue[tail++] = w;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/* Returns the minimum of the maximum flow from source to target and limit.
+ * The capacities of the arcs are not changed, so the same network can be
+ * used for several pairs of vertices.
+ */
+int findMaxFlow(FLOW_NETWORK *network, int source, int target, int limit){
+    int arc, i, depth, v, flow = 0;
+    int *residual = network->residual;
+    int *path = network->path;
+
+    if(source == target || limit <= 0){
+        return 0;
+    }
+
+    if(!network->arcsSorted){
+        sortArcs(network);
+    }
+    for(arc = 0; arc < network->arcCount; arc++){
+        residual[arc] = network->capacity[arc];
+    }
+
+    while(flow < limit && assignLevels(network, source, target)){
+        for(v = 0; v < network->vertexCount; v++){
+            network->currentArc[v] = network->firstArc[v];
+        }
+
+        depth = 0;
+        v = source;
+        while(flow < limit){
+            if(v == target){
+                //augment along the path and retreat to its first saturated arc
+                int bottleneck = limit - flow;
+                for(i = 0; i < depth; i++){
+                    if(residual[path[i]] < bottleneck){
+                        bottleneck = residual[path[i]];
+                    }
+                }
+                for(i = 0; i < depth; i++){
+                    residual[path[i]] -= bottleneck;
+                    residual[path[i] ^ 1] += bottleneck;
+                }
+                flow += bottleneck;
+                if(flow == limit){
+                    break;
+                }
+                for(i = 0; residual[path[i]] > 0; i++);
+                depth = i;
+                v = network->head[path[i] ^ 1];
+                continue;
+            }
+
+            //advance along the current arc of v if it leads to the next level
+            while(network->currentArc[v] < network->firstArc[v + 1]){
+                arc = network->arcs[network->currentArc[v]];
+                if(residual[arc] > 0 &&
+                        network->level[network->head[arc]] == network->level[v] + 1){
+                    break;
+                }
+                network->currentArc[v]++;
+            }
+            if(network->currentArc[v] < network->firstArc[v + 1]){
+                path[depth++] = arc;
+                v = network->head[arc];
+            } else {
+                //the target cannot be reached from v in this phase
+                network->level[v] = -1;
+                if(depth == 0){
+                    break;
+                }
+                depth--;
+                v = network->head[path[depth] ^ 1];
+                network->currentArc[v]++;
+            }
+        }
+    }
+
+    return flow;
+}
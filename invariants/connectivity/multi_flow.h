@@ -0,0 +1,52 @@
+/*
+ * Main developer: Nico Van Cleemput
+ * 
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTI_FLOW_H
+#define	MULTI_FLOW_H
+
+#include "../../multicode/shared/multicode_base.h"
+
+/* A flow network with vertices 0 up to vertexCount-1. The arcs are stored in
+ * pairs: arc a and arc a^1 are each other's reverse. The memory that is used
+ * grows with the number of vertices and arcs, and is reused when the network
+ * is cleared.
+ */
+typedef struct {
+    int vertexCount;
+    int arcCount;
+
+    int *head;
+    int *capacity;
+    int *residual;
+
+    //the arcs leaving v are arcs[firstArc[v]] up to arcs[firstArc[v+1]-1]
+    int *firstArc;
+    int *arcs;
+    boolean arcsSorted;
+
+    //work space for the max flow computation
+    int *level;
+    int *currentArc;
+    int *queue;
+    int *path;
+
+    int vertexCapacity;
+    int arcCapacity;
+} FLOW_NETWORK;
+
+FLOW_NETWORK *newFlowNetwork();
+
+void freeFlowNetwork(FLOW_NETWORK *network);
+
+void clearFlowNetwork(FLOW_NETWORK *network, int vertexCount);
+
+void addArcPair(FLOW_NETWORK *network, int from, int to, int capacity, int reverseCapacity);
+
+int findMaxFlow(FLOW_NETWORK *network, int source, int target, int limit);
+
+#endif	/* MULTI_FLOW_H */
+
@@ -0,0 +1,433 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* Before the search, a problem is rejected if the work graph is not
+ * 2-connected or if it is bipartite with unbalanced sides. The rules that
+ * are applied during the search are implemented in the search itself.
+ */
+
+#include "multi_hamiltonian_pruning.h"
+#include "multi_hamiltonian_search.h"
+#include <stdlib.h>
+#include <pthread.h>
+
+static PRUNING_STATISTICS pruningStatistics;
+static pthread_mutex_t statisticsLock = PTHREAD_MUTEX_INITIALIZER;
+
+HAMILTONIAN_PROBLEM *newHamiltonianProblem(){
+    HAMILTONIAN_PROBLEM *problem = (HAMILTONIAN_PROBLEM *)malloc(sizeof(HAMILTONIAN_PROBLEM));
+    if(problem == NULL){
+        fprintf(stderr, "Insufficient memory for hamiltonian problem -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    problem->type = CYCLE_PROBLEM;
+    problem->order = 0;
+    problem->virtualVertex = 0;
+    problem->originalVertex = NULL;
+    problem->offsets = NULL;
+    problem->degrees = NULL;
+    problem->neighbours = NULL;
+    problem->cycle = NULL;
+    problem->discovery = NULL;
+    problem->low = NULL;
+    problem->stack = NULL;
+    problem->nextNeighbour = NULL;
+    problem->vertexCapacity = 0;
+    problem->neighbourCapacity = 0;
+
+    return problem;
+}
+
+void freeHamiltonianProblem(HAMILTONIAN_PROBLEM *problem){
+    free(problem->originalVertex);
+    free(problem->offsets);
+    free(problem->degrees);
+    free(problem->neighbours);
+    free(problem->cycle);
+    free(problem->discovery);
+    free(problem->low);
+    free(problem->stack);
+    free(problem->nextNeighbour);
+    free(problem);
+}
+
+static void ensureProblemCapacity(HAMILTONIAN_PROBLEM *problem, int order, int neighbourCount){
+    if(order + 2 > problem->vertexCapacity){
+        problem->vertexCapacity = order + 2;
+        free(problem->originalVertex);
+        free(problem->offsets);
+        free(problem->degrees);
+        free(problem->cycle);
+        free(problem->discovery);
+        free(problem->low);
+        free(problem->stack);
+        free(problem->nextNeighbour);
+        problem->originalVertex = (int *)malloc(sizeof(int)*problem->vertexCapacity);
+        problem->offsets = (int *)malloc(sizeof(int)*problem->vertexCapacity);
+        problem->degrees = (unsigned short *)malloc(sizeof(unsigned short)*problem->vertexCapacity);
+        problem->cycle = (int *)malloc(sizeof(int)*problem->vertexCapacity);
+        problem->discovery = (int *)malloc(sizeof(int)*problem->vertexCapacity);
+        problem->low = (int *)malloc(sizeof(int)*problem->vertexCapacity);
+        problem->stack = (int *)malloc(sizeof(int)*problem->vertexCapacity);
+        problem->nextNeighbour = (int *)malloc(sizeof(int)*problem->vertexCapacity);
+    }
+    if(neighbourCount > problem->neighbourCapacity){
+        problem->neighbourCapacity = neighbourCount;
+        free(problem->neighbours);
+        problem->neighbours = (unsigned short *)malloc(sizeof(unsigned short)*problem->neighbourCapacity);
+    }
+    if(problem->originalVertex == NULL || problem->offsets == NULL || problem->degrees == NULL ||
+            problem->cycle == NULL || problem->discovery == NULL || problem->low == NULL ||
+            problem->stack == NULL || problem->nextNeighbour == NULL ||
+            (problem->neighbourCapacity > 0 && problem->neighbours == NULL)){
+        fprintf(stderr, "Insufficient memory for hamiltonian problem -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Stores the simple graph underlying graph without removedVertex (0 if no
+ * vertex is removed) as the work graph. For path problems the virtual vertex
+ * is the last vertex of the work graph.
+ */
+static void setWorkGraph(HAMILTONIAN_PROBLEM *problem, GRAPH graph, ADJACENCY adj,
+        int type, int removedVertex, int from, int to){
+    int v, w, i;
+    int order = graph[0][0];
+    int workOrder = order - (removedVertex ? 1 : 0) + (type == CYCLE_PROBLEM ? 0 : 1);
+    int neighbourCount = 2*order;
+    int workVertex[MAXN + 1];
+    int lastSeen[MAXN + 1];
+
+    for(v = 1; v <= order; v++){
+        neighbourCount += adj[v];
+    }
+    ensureProblemCapacity(problem, workOrder, neighbourCount);
+
+    problem->type = type;
+    problem->order = workOrder;
+    problem->virtualVertex = type == CYCLE_PROBLEM ? 0 : workOrder;
+
+    w = 0;
+    for(v = 1; v <= order; v++){
+        if(v == removedVertex){
+            workVertex[v] = 0;
+        } else {
+            workVertex[v] = ++w;
+            problem->originalVertex[w] = v;
+        }
+        lastSeen[v] = 0;
+    }
+
+    neighbourCount = 0;
+    for(v = 1; v <= order; v++){
+        if(v == removedVertex){
+            continue;
+        }
+        w = workVertex[v];
+        problem->offsets[w] = neighbourCount;
+        //parallel edges and loops are of no use for a hamiltonian cycle
+        lastSeen[v] = v;
+        for(i = 0; i < adj[v]; i++){
+            int neighbour = graph[v][i];
+            if(neighbour != removedVertex && lastSeen[neighbour] != v){
+                lastSeen[neighbour] = v;
+                problem->neighbours[neighbourCount++] = workVertex[neighbour];
+            }
+        }
+        if(type == PATH_PROBLEM || (type == PATH_BETWEEN_PROBLEM && (v == from || v == to))){
+            problem->neighbours[neighbourCount++] = problem->virtualVertex;
+        }
+        problem->degrees[w] = neighbourCount - problem->offsets[w];
+    }
+
+    if(problem->virtualVertex){
+        problem->originalVertex[problem->virtualVertex] = 0;
+        problem->offsets[problem->virtualVertex] = neighbourCount;
+        if(type == PATH_PROBLEM){
+            for(w = 1; w < problem->virtualVertex; w++){
+                problem->neighbours[neighbourCount++] = w;
+            }
+        } else {
+            //the first neighbour is the start of the path
+            problem->neighbours[neighbourCount++] = workVertex[from];
+            problem->neighbours[neighbourCount++] = workVertex[to];
+        }
+        problem->degrees[problem->virtualVertex] =
+                neighbourCount - problem->offsets[problem->virtualVertex];
+    }
+}
+
+/* Does graph minus removedVertex have a hamiltonian cycle?
+ */
+void setCycleProblem(HAMILTONIAN_PROBLEM *problem, GRAPH graph, ADJACENCY adj,
+        int removedVertex){
+    setWorkGraph(problem, graph, adj, CYCLE_PROBLEM, removedVertex, 0, 0);
+}
+
+/* Does graph minus removedVertex have a hamiltonian path?
+ */
+void setPathProblem(HAMILTONIAN_PROBLEM *problem, GRAPH graph, ADJACENCY adj,
+        int removedVertex){
+    setWorkGraph(problem, graph, adj, PATH_PROBLEM, removedVertex, 0, 0);
+}
+
+/* Does graph have a hamiltonian path from one vertex to another vertex?
+ */
+void setPathBetweenProblem(HAMILTONIAN_PROBLEM *problem, GRAPH graph, ADJACENCY adj,
+        int from, int to){
+    setWorkGraph(problem, graph, adj, PATH_BETWEEN_PROBLEM, 0, from, to);
+}
+
+/* Returns FALSE if the work graph cannot have a hamiltonian cycle because it
+ * is not 2-connected. For a path problem with free ends, the virtual vertex
+ * is ignored: the graph should be connected and removing a vertex should not
+ * leave more than two components.
+ */
+boolean passesConnectivityCheck(HAMILTONIAN_PROBLEM *problem){
+    int v, w;
+    int order = problem->order;
+    int ignoredVertex = problem->type == PATH_PROBLEM ? problem->virtualVertex : 0;
+    int allowedComponents = problem->type == PATH_PROBLEM ? 2 : 1;
+    int *discovery = problem->discovery;
+    int *low = problem->low;
+    int *stack = problem->stack;
+    int *nextNeighbour = problem->nextNeighbour;
+    //the number of components that are separated from the rest by removing v
+    int *separated = problem->cycle;
+    int counter = 0;
+    int top = 0;
+    boolean passes = TRUE;
+
+    if(order - (ignoredVertex ? 1 : 0) < 2){
+        return TRUE;
+    }
+
+    for(v = 1; v <= order; v++){
+        discovery[v] = 0;
+    }
+
+    //Tarjan's algorithm without recursion
+    discovery[1] = low[1] = ++counter;
+    nextNeighbour[1] = separated[1] = 0;
+    stack[top++] = 1;
+    while(top > 0){
+        v = stack[top - 1];
+        if(nextNeighbour[v] < problem->degrees[v]){
+            w = problem->neighbours[problem->offsets[v] + nextNeighbour[v]++];
+            if(w == ignoredVertex){
+                continue;
+            }
+            if(discovery[w] == 0){
+                discovery[w] = low[w] = ++counter;
+                nextNeighbour[w] = separated[w] = 0;
+                stack[top++] = w;
+            } else if(discovery[w] < low[v]){
+                low[v] = discovery[w];
+            }
+        } else {
+            top--;
+            if(top > 0){
+                w = stack[top - 1];
+                if(low[v] < low[w]){
+                    low[w] = low[v];
+                }
+                if(low[v] >= discovery[w]){
+                    separated[w]++;
+                }
+            }
+        }
+    }
+
+    if(counter < order - (ignoredVertex ? 1 : 0)){
+        passes = FALSE;
+    } else if(separated[1] > allowedComponents){
+        //the first vertex is the root of the tree
+        passes = FALSE;
+    } else {
+        for(v = 2; v <= order && passes; v++){
+            if(v != ignoredVertex && separated[v] + 1 > allowedComponents){
+                passes = FALSE;
+            }
+        }
+    }
+
+    if(!passes){
+        PRUNING_STATISTICS statistics = {0};
+        statistics.connectivityRejections = 1;
+        addPruningStatistics(&statistics);
+    }
+
+    return passes;
+}
+
+/* Returns FALSE if the work graph without the virtual vertex is bipartite and
+ * the sides do not allow a hamiltonian cycle or path. The work graph should
+ * pass the connectivity check.
+ */
+static boolean passesBipartitionCheck(HAMILTONIAN_PROBLEM *problem){
+    int i, v;
+    int order = problem->order;
+    int virtualVertex = problem->virtualVertex;
+    int *colour = problem->discovery;
+    int *queue = problem->stack;
+    int sideSizes[3] = {0, 0, 0};
+    int head = 0, tail = 0;
+    boolean passes;
+
+    for(v = 1; v <= order; v++){
+        colour[v] = 0;
+    }
+    for(v = 1; v <= order; v++){
+        if(colour[v] || v == virtualVertex){
+            continue;
+        }
+        colour[v] = 1;
+        sideSizes[1]++;
+        queue[tail++] = v;
+        while(head < tail){
+            int w = queue[head++];
+            unsigned short *neighbours = problem->neighbours + problem->offsets[w];
+            for(i = 0; i < problem->degrees[w]; i++){
+                int neighbour = neighbours[i];
+                if(neighbour == virtualVertex){
+                    continue;
+                }
+                if(!colour[neighbour]){
+                    colour[neighbour] = 3 - colour[w];
+                    sideSizes[colour[neighbour]]++;
+                    queue[tail++] = neighbour;
+                } else if(colour[neighbour] == colour[w]){
+                    //odd cycle
+                    return TRUE;
+                }
+            }
+        }
+    }
+
+    if(problem->type == CYCLE_PROBLEM){
+        passes = sideSizes[1] == sideSizes[2];
+    } else if(problem->type == PATH_PROBLEM){
+        passes = abs(sideSizes[1] - sideSizes[2]) <= 1;
+    } else {
+        unsigned short *ends = problem->neighbours + problem->offsets[virtualVertex];
+        if(colour[ends[0]] == colour[ends[1]]){
+            passes = sideSizes[colour[ends[0]]] == sideSizes[3 - colour[ends[0]]] + 1;
+        } else {
+            passes = sideSizes[1] == sideSizes[2];
+        }
+    }
+
+    if(!passes){
+        PRUNING_STATISTICS statistics = {0};
+        statistics.bipartitionRejections = 1;
+        addPruningStatistics(&statistics);
+    }
+
+    return passes;
+}
+
+/* Stores the hamiltonian cycle or path that was found in path, using the
+ * vertices of the input graph.
+ */
+static void storePath(HAMILTONIAN_PROBLEM *problem, int *path){
+    int i;
+    int order = problem->order;
+    int length = order;
+    int first = 0;
+
+    if(problem->virtualVertex){
+        while(problem->cycle[first] != problem->virtualVertex){
+            first++;
+        }
+        first++;
+        length--;
+    }
+    for(i = 0; i < length; i++){
+        path[i] = problem->originalVertex[problem->cycle[(first + i) % order]];
+    }
+
+    if(problem->type == PATH_BETWEEN_PROBLEM &&
+            path[0] != problem->originalVertex[
+                    problem->neighbours[problem->offsets[problem->virtualVertex]]]){
+        for(i = 0; i < length/2; i++){
+            int temp = path[i];
+            path[i] = path[length - 1 - i];
+            path[length - 1 - i] = temp;
+        }
+    }
+}
+
+/* Returns TRUE if the work graph has a hamiltonian cycle. The search uses
+ * threadCount threads. If path is not NULL, the cycle or path that was found
+ * is stored in it.
+ */
+boolean solveHamiltonianProblem(HAMILTONIAN_PROBLEM *problem, int threadCount, int *path){
+    int v, start;
+    PRUNING_STATISTICS statistics = {0};
+
+    statistics.searches = 1;
+    addPruningStatistics(&statistics);
+
+    if(problem->order < 3){
+        if(problem->type == PATH_PROBLEM && problem->order == 2){
+            //a single vertex
+            if(path != NULL){
+                path[0] = problem->originalVertex[1];
+            }
+            return TRUE;
+        }
+        return FALSE;
+    }
+
+    if(!passesConnectivityCheck(problem) || !passesBipartitionCheck(problem)){
+        return FALSE;
+    }
+
+    if(problem->type == PATH_BETWEEN_PROBLEM){
+        start = problem->virtualVertex;
+    } else {
+        //the virtual vertex is adjacent to all other vertices, so it is never chosen
+        start = 1;
+        for(v = 2; v <= problem->order; v++){
+            if(v != problem->virtualVertex && problem->degrees[v] < problem->degrees[start]){
+                start = v;
+            }
+        }
+    }
+
+    if(!searchPrunedHamiltonianCycle(problem, start, threadCount, problem->cycle)){
+        return FALSE;
+    }
+    if(path != NULL){
+        storePath(problem, path);
+    }
+    return TRUE;
+}
+
+void addPruningStatistics(PRUNING_STATISTICS *statistics){
+    pthread_mutex_lock(&statisticsLock);
+    pruningStatistics.searches += statistics->searches;
+    pruningStatistics.connectivityRejections += statistics->connectivityRejections;
+    pruningStatistics.bipartitionRejections += statistics->bipartitionRejections;
+    pruningStatistics.nodes += statistics->nodes;
+    pruningStatistics.degreeCuts += statistics->degreeCuts;
+    pruningStatistics.forcedEdgeCuts += statistics->forcedEdgeCuts;
+    pruningStatistics.connectivityCuts += statistics->connectivityCuts;
+    pthread_mutex_unlock(&statisticsLock);
+}
+
+void printPruningStatistics(FILE *f){
+    pthread_mutex_lock(&statisticsLock);
+    fprintf(f, "Searches:                         %llu\n", pruningStatistics.searches);
+    fprintf(f, "  rejected by connectivity:       %llu\n", pruningStatistics.connectivityRejections);
+    fprintf(f, "  rejected by bipartition:        %llu\n", pruningStatistics.bipartitionRejections);
+    fprintf(f, "Search nodes:                     %llu\n", pruningStatistics.nodes);
+    fprintf(f, "  branches cut by degrees:        %llu\n", pruningStatistics.degreeCuts);
+    fprintf(f, "  branches cut by forced edges:   %llu\n", pruningStatistics.forcedEdgeCuts);
+    fprintf(f, "  branches cut by connectivity:   %llu\n", pruningStatistics.connectivityCuts);
+    pthread_mutex_unlock(&statisticsLock);
+}
@@ -0,0 +1,87 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTI_HAMILTONIAN_PRUNING_H
+#define	MULTI_HAMILTONIAN_PRUNING_H
+
+#include "../../multicode/shared/multicode_base.h"
+#include <stdio.h>
+
+#define CYCLE_PROBLEM 0
+#define PATH_PROBLEM 1
+#define PATH_BETWEEN_PROBLEM 2
+
+/* A question about hamiltonian cycles or paths, stated as the question
+ * whether a work graph has a hamiltonian cycle. The work graph is the simple
+ * graph underlying the input graph, possibly with one vertex removed. For
+ * path problems a virtual vertex is added: it is adjacent to all vertices
+ * when the ends of the path are free, and to the two ends otherwise.
+ *
+ * The neighbours of v in the work graph are neighbours[offsets[v]] up to
+ * neighbours[offsets[v] + degrees[v] - 1].
+ */
+typedef struct {
+    int type;
+    int order;
+
+    //the virtual vertex, or 0 for a cycle problem
+    int virtualVertex;
+
+    //the vertex of the input graph that corresponds to each vertex
+    int *originalVertex;
+
+    int *offsets;
+    unsigned short *degrees;
+    unsigned short *neighbours;
+
+    //work space for the checks and the search
+    int *cycle;
+    int *discovery;
+    int *low;
+    int *stack;
+    int *nextNeighbour;
+
+    int vertexCapacity;
+    int neighbourCapacity;
+} HAMILTONIAN_PROBLEM;
+
+/* The number of times each rule was applied. For the rules that are applied
+ * during the search, this is the number of branches that were cut.
+ */
+typedef struct {
+    unsigned long long int searches;
+    unsigned long long int connectivityRejections;
+    unsigned long long int bipartitionRejections;
+
+    unsigned long long int nodes;
+    unsigned long long int degreeCuts;
+    unsigned long long int forcedEdgeCuts;
+    unsigned long long int connectivityCuts;
+} PRUNING_STATISTICS;
+
+HAMILTONIAN_PROBLEM *newHamiltonianProblem();
+
+void freeHamiltonianProblem(HAMILTONIAN_PROBLEM *problem);
+
+void setCycleProblem(HAMILTONIAN_PROBLEM *problem, GRAPH graph, ADJACENCY adj,
+        int removedVertex);
+
+void setPathProblem(HAMILTONIAN_PROBLEM *problem, GRAPH graph, ADJACENCY adj,
+        int removedVertex);
+
+void setPathBetweenProblem(HAMILTONIAN_PROBLEM *problem, GRAPH graph, ADJACENCY adj,
+        int from, int to);
+
+boolean passesConnectivityCheck(HAMILTONIAN_PROBLEM *problem);
+
+boolean solveHamiltonianProblem(HAMILTONIAN_PROBLEM *problem, int threadCount, int *path);
+
+void addPruningStatistics(PRUNING_STATISTICS *statistics);
+
+void printPruningStatistics(FILE *f);
+
+#endif	/* MULTI_HAMILTONIAN_PRUNING_H */
@@ -0,0 +1,808 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The hamiltonian cycles through a start vertex are constructed by extending
+ * a path that starts with one neighbour of the start vertex (the target),
+ * the start vertex and another neighbour, until the path can be closed at
+ * the target.
+ *
+ * Each path is a task. When the search uses several threads, each worker
+ * has its own list of tasks. A worker that has no tasks left steals the
+ * oldest task of another worker. While there are idle workers, the branches
+ * that a busy worker has not yet explored are handed out as new tasks.
+ *
+ * A pruned search keeps track of the number of open neighbours of each
+ * vertex: the neighbours that are not in the path, the end of the path and
+ * the target. A vertex that is not yet in the path needs two open neighbours
+ * and the target needs one. A vertex with exactly two open neighbours forces
+ * both edges, so if it is adjacent to the end of the path, the path has to
+ * continue there. For the same reason, at most one such vertex can be
+ * adjacent to the target, and at most two to a virtual vertex that is
+ * adjacent to all other vertices. Finally, the vertices that are not in the
+ * path should induce a connected graph. This is only checked when the last
+ * vertex that was added to the path could have disconnected them.
+ */
+
+#include "multi_hamiltonian_search.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+//branches are only handed out if at least this many vertices are not yet in the path
+#define MINIMUM_SPLIT_SIZE 8
+
+#define EDGE_INCIDENCE(matrix, order, v, w) (matrix)[(v)*((order) + 1) + (w)]
+
+#define NO_CUT 0
+#define DEGREE_CUT 1
+#define FORCED_EDGE_CUT 2
+
+int searchThreadCount = 1;
+
+typedef struct _hamiltonianSearch HAMILTONIAN_SEARCH;
+
+typedef struct {
+    HAMILTONIAN_SEARCH *search;
+    int index;
+
+    /* Each task is an array: the first element is the length of the path
+     * and the remaining elements are the path. The owner takes tasks from
+     * the back, and other workers steal tasks from the front.
+     */
+    pthread_mutex_t lock;
+    int **tasks;
+    int firstTask;
+    int lastTask;
+    int taskCapacity;
+
+    //the current path, starting with the target and the start vertex
+    int *path;
+    boolean *visited;
+
+    unsigned long long int cycleCount;
+    //(order+1)x(order+1) matrix or NULL if not needed
+    unsigned long long int *edgeIncidence;
+
+    //only used in a pruned search
+    int *openNeighbours;
+    boolean *targetNeighbour;
+    //the number of vertices outside the path that are forced to be adjacent to the target
+    int forcedAtTarget;
+    //the number of vertices outside the path that are forced to be adjacent to the virtual vertex
+    int forcedAtVirtual;
+    int *queue;
+    unsigned int *mark;
+    unsigned int currentMark;
+    PRUNING_STATISTICS statistics;
+} SEARCH_WORKER;
+
+struct _hamiltonianSearch {
+    //the neighbours of v are neighbours[offsets[v]] up to neighbours[offsets[v] + degrees[v] - 1]
+    unsigned short *neighbours;
+    int *offsets;
+    unsigned short *degrees;
+    int order;
+
+    boolean pruned;
+    //the virtual vertex of a path problem, which is adjacent to all other vertices, or 0
+    int virtualVertex;
+
+    boolean stopAtFirstCycle;
+    //stores the first cycle that was found if not NULL
+    int *firstCycle;
+
+    int workerCount;
+    SEARCH_WORKER *workers;
+
+    atomic_int stopped;
+    atomic_int idleWorkers;
+    //the number of tasks that have been created, but not yet finished
+    atomic_long pendingTasks;
+
+    pthread_mutex_t idleLock;
+    pthread_cond_t workAvailable;
+    //changes each time a task is added
+    long taskVersion;
+};
+
+/* Returns TRUE if this call stopped the search.
+ */
+static boolean stopSearch(HAMILTONIAN_SEARCH *search){
+    boolean first = !atomic_exchange(&(search->stopped), TRUE);
+    if(search->workerCount > 1){
+        pthread_mutex_lock(&(search->idleLock));
+        pthread_cond_broadcast(&(search->workAvailable));
+        pthread_mutex_unlock(&(search->idleLock));
+    }
+    return first;
+}
+
+static void handleCycle(SEARCH_WORKER *worker){
+    int i;
+    int order = worker->search->order;
+    int *path = worker->path;
+    unsigned long long int *matrix = worker->edgeIncidence;
+
+    worker->cycleCount++;
+
+    if(worker->search->stopAtFirstCycle){
+        if(stopSearch(worker->search) && worker->search->firstCycle != NULL){
+            for(i = 0; i < order; i++){
+                worker->search->firstCycle[i] = path[i];
+            }
+        }
+        return;
+    }
+
+    if(matrix != NULL){
+        for(i = 1; i < order; i++){
+            EDGE_INCIDENCE(matrix, order, path[i-1], path[i])++;
+            EDGE_INCIDENCE(matrix, order, path[i], path[i-1])++;
+        }
+        EDGE_INCIDENCE(matrix, order, path[0], path[order-1])++;
+        EDGE_INCIDENCE(matrix, order, path[order-1], path[0])++;
+    }
+}
+
+static void addTask(SEARCH_WORKER *worker, int *task){
+    HAMILTONIAN_SEARCH *search = worker->search;
+
+    atomic_fetch_add(&(search->pendingTasks), 1);
+
+    pthread_mutex_lock(&(worker->lock));
+    if(worker->lastTask == worker->taskCapacity){
+        worker->taskCapacity = 2*worker->taskCapacity + 16;
+        worker->tasks = (int **)realloc(worker->tasks, sizeof(int *)*worker->taskCapacity);
+        if(worker->tasks == NULL){
+            fprintf(stderr, "Insufficient memory for search tasks -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    worker->tasks[worker->lastTask++] = task;
+    pthread_mutex_unlock(&(worker->lock));
+
+    pthread_mutex_lock(&(search->idleLock));
+    search->taskVersion++;
+    pthread_cond_signal(&(search->workAvailable));
+    pthread_mutex_unlock(&(search->idleLock));
+}
+
+static int *newTask(int *path, int length){
+    int i;
+    int *task = (int *)malloc(sizeof(int)*(length + 1));
+    if(task == NULL){
+        fprintf(stderr, "Insufficient memory for search tasks -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    task[0] = length;
+    for(i = 0; i < length; i++){
+        task[i + 1] = path[i];
+    }
+    return task;
+}
+
+static int *takeTask(SEARCH_WORKER *worker, boolean steal){
+    int *task = NULL;
+
+    pthread_mutex_lock(&(worker->lock));
+    if(worker->firstTask < worker->lastTask){
+        if(steal){
+            task = worker->tasks[worker->firstTask++];
+        } else {
+            task = worker->tasks[--(worker->lastTask)];
+        }
+        if(worker->firstTask == worker->lastTask){
+            worker->firstTask = worker->lastTask = 0;
+        }
+    }
+    pthread_mutex_unlock(&(worker->lock));
+
+    return task;
+}
+
+static inline boolean shouldSplit(HAMILTONIAN_SEARCH *search, int depth){
+    return search->workerCount > 1 && search->order - depth > MINIMUM_SPLIT_SIZE &&
+            atomic_load_explicit(&(search->idleWorkers), memory_order_relaxed) > 0;
+}
+
+/* Extends the path, which ends in next at position depth, in all possible
+ * ways. While other workers are idle, the branches are handed out as tasks
+ * instead of being explored.
+ */
+static void extendPath(SEARCH_WORKER *worker, int target, int next, int depth){
+    int i;
+    HAMILTONIAN_SEARCH *search = worker->search;
+    unsigned short *neighbours = search->neighbours + search->offsets[next];
+    int degree = search->degrees[next];
+
+    for(i = 0; i < degree; i++){
+        int neighbour = neighbours[i];
+        if(worker->visited[neighbour]){
+            continue;
+        }
+        if(neighbour == target){
+            if(depth + 1 == search->order){
+                worker->path[depth + 1] = neighbour;
+                handleCycle(worker);
+            }
+        } else if(shouldSplit(search, depth)){
+            //leave this branch to an idle worker
+            worker->path[depth + 1] = neighbour;
+            addTask(worker, newTask(worker->path, depth + 2));
+        } else {
+            if(atomic_load_explicit(&(search->stopped), memory_order_relaxed)){
+                return;
+            }
+            worker->visited[neighbour] = TRUE;
+            worker->path[depth + 1] = neighbour;
+            extendPath(worker, target, neighbour, depth + 1);
+            worker->visited[neighbour] = FALSE;
+        }
+    }
+}
+
+/* Returns TRUE if the vertices that are not in the path, which ends at
+ * position depth, induce a connected graph. As long as the virtual vertex is
+ * not in the path, it may split the other vertices in two parts. The search
+ * starts from seed, or from the first vertex that is not in the path if seed
+ * is 0.
+ */
+static boolean remainingVerticesConnected(SEARCH_WORKER *worker, int seed, int depth){
+    int i;
+    HAMILTONIAN_SEARCH *search = worker->search;
+    int virtualVertex = search->virtualVertex;
+    boolean *visited = worker->visited;
+    unsigned int *mark = worker->mark;
+    int *queue = worker->queue;
+    int remaining = search->order - depth - 1;
+    int allowedComponents = 1;
+    int components = 0;
+    int reached = 0;
+
+    if(virtualVertex && !visited[virtualVertex]){
+        remaining--;
+        allowedComponents = 2;
+    }
+    if(remaining == 0){
+        return TRUE;
+    }
+
+    worker->currentMark++;
+    if(worker->currentMark == 0){
+        for(i = 0; i <= search->order; i++){
+            mark[i] = 0;
+        }
+        worker->currentMark = 1;
+    }
+
+    while(TRUE){
+        int head = 0, tail = 0;
+
+        if(seed == 0){
+            seed = 1;
+            while(visited[seed] || seed == virtualVertex || mark[seed] == worker->currentMark){
+                seed++;
+            }
+        }
+        mark[seed] = worker->currentMark;
+        queue[tail++] = seed;
+        while(head < tail){
+            int v = queue[head++];
+            unsigned short *neighbours = search->neighbours + search->offsets[v];
+            for(i = 0; i < search->degrees[v]; i++){
+                int neighbour = neighbours[i];
+                if(!visited[neighbour] && neighbour != virtualVertex &&
+                        mark[neighbour] != worker->currentMark){
+                    mark[neighbour] = worker->currentMark;
+                    queue[tail++] = neighbour;
+                }
+            }
+        }
+
+        reached += tail;
+        components++;
+        if(reached == remaining){
+            return TRUE;
+        } else if(components == allowedComponents){
+            return FALSE;
+        }
+        seed = 0;
+    }
+}
+
+/* Moves the end of the path from end to next and updates the open
+ * neighbours. Returns the rule that shows that the new path cannot be
+ * extended to a hamiltonian cycle, or NO_CUT.
+ */
+static int advanceEnd(SEARCH_WORKER *worker, int target, int end, int next){
+    int i;
+    HAMILTONIAN_SEARCH *search = worker->search;
+    unsigned short *neighbours = search->neighbours + search->offsets[end];
+    int degree = search->degrees[end];
+    int *open = worker->openNeighbours;
+    boolean *visited = worker->visited;
+    boolean *targetNeighbour = worker->targetNeighbour;
+    int virtualVertex = search->virtualVertex;
+    int cut = NO_CUT;
+
+    if(targetNeighbour[next] && open[next] == 2){
+        worker->forcedAtTarget--;
+    }
+    if(virtualVertex && next != virtualVertex && open[next] == 2){
+        worker->forcedAtVirtual--;
+    }
+    visited[next] = TRUE;
+
+    //end is no longer open
+    for(i = 0; i < degree; i++){
+        int neighbour = neighbours[i];
+        open[neighbour]--;
+        if(!visited[neighbour]){
+            if(open[neighbour] < 2){
+                cut = DEGREE_CUT;
+            } else if(open[neighbour] == 2){
+                if(targetNeighbour[neighbour]){
+                    worker->forcedAtTarget++;
+                }
+                if(virtualVertex && neighbour != virtualVertex){
+                    worker->forcedAtVirtual++;
+                }
+            }
+        } else if(neighbour == target && open[neighbour] == 0){
+            cut = DEGREE_CUT;
+        }
+    }
+
+    if(cut == NO_CUT && (worker->forcedAtTarget > 1 ||
+            (virtualVertex && !visited[virtualVertex] && worker->forcedAtVirtual > 2))){
+        cut = FORCED_EDGE_CUT;
+    }
+
+    return cut;
+}
+
+static void retreatEnd(SEARCH_WORKER *worker, int end, int next){
+    int i;
+    HAMILTONIAN_SEARCH *search = worker->search;
+    unsigned short *neighbours = search->neighbours + search->offsets[end];
+    int degree = search->degrees[end];
+    int *open = worker->openNeighbours;
+    boolean *visited = worker->visited;
+    boolean *targetNeighbour = worker->targetNeighbour;
+    int virtualVertex = search->virtualVertex;
+
+    for(i = 0; i < degree; i++){
+        int neighbour = neighbours[i];
+        if(!visited[neighbour] && open[neighbour] == 2){
+            if(targetNeighbour[neighbour]){
+                worker->forcedAtTarget--;
+            }
+            if(virtualVertex && neighbour != virtualVertex){
+                worker->forcedAtVirtual--;
+            }
+        }
+        open[neighbour]++;
+    }
+
+    visited[next] = FALSE;
+    if(targetNeighbour[next] && open[next] == 2){
+        worker->forcedAtTarget++;
+    }
+    if(virtualVertex && next != virtualVertex && open[next] == 2){
+        worker->forcedAtVirtual++;
+    }
+}
+
+/* Extends the path, which ends in end at position depth, in all ways that
+ * are not excluded by the pruning rules. In a pruned search the target is
+ * marked as visited.
+ */
+static void extendPrunedPath(SEARCH_WORKER *worker, int target, int end, int depth){
+    int i;
+    HAMILTONIAN_SEARCH *search = worker->search;
+    unsigned short *neighbours = search->neighbours + search->offsets[end];
+    int degree = search->degrees[end];
+    boolean *visited = worker->visited;
+    int *open = worker->openNeighbours;
+    int forced = 0;
+    int remainingNeighbours = 0;
+    int seed = 0;
+
+    worker->statistics.nodes++;
+
+    if(depth + 1 == search->order){
+        for(i = 0; i < degree; i++){
+            if(neighbours[i] == target){
+                worker->path[depth + 1] = target;
+                handleCycle(worker);
+                return;
+            }
+        }
+        return;
+    }
+
+    for(i = 0; i < degree; i++){
+        int neighbour = neighbours[i];
+        if(visited[neighbour]){
+            continue;
+        }
+        if(neighbour != search->virtualVertex){
+            remainingNeighbours++;
+            seed = neighbour;
+        }
+        if(open[neighbour] == 2){
+            if(forced){
+                //two vertices both need an edge to the end of the path
+                worker->statistics.forcedEdgeCuts++;
+                return;
+            }
+            forced = neighbour;
+        }
+    }
+
+    /* removing end could only disconnect the remaining vertices if it had
+     * two neighbours among them
+     */
+    if((remainingNeighbours > 1 || end == search->virtualVertex) &&
+            !remainingVerticesConnected(worker, seed, depth)){
+        worker->statistics.connectivityCuts++;
+        return;
+    }
+
+    for(i = 0; i < degree; i++){
+        int neighbour = neighbours[i];
+        if(visited[neighbour]){
+            continue;
+        }
+        if(forced && neighbour != forced){
+            worker->statistics.forcedEdgeCuts++;
+            continue;
+        }
+        worker->path[depth + 1] = neighbour;
+        if(shouldSplit(search, depth)){
+            //leave this branch to an idle worker
+            addTask(worker, newTask(worker->path, depth + 2));
+            continue;
+        }
+        if(atomic_load_explicit(&(search->stopped), memory_order_relaxed)){
+            return;
+        }
+        switch(advanceEnd(worker, target, end, neighbour)){
+            case NO_CUT:
+                extendPrunedPath(worker, target, neighbour, depth + 1);
+                break;
+            case DEGREE_CUT:
+                worker->statistics.degreeCuts++;
+                break;
+            case FORCED_EDGE_CUT:
+                worker->statistics.forcedEdgeCuts++;
+                break;
+        }
+        retreatEnd(worker, end, neighbour);
+    }
+}
+
+/* Sets up the open neighbours for the given path and checks all rules
+ * before the path is extended.
+ */
+static void runPrunedTask(SEARCH_WORKER *worker, int *path, int length){
+    int i, v;
+    HAMILTONIAN_SEARCH *search = worker->search;
+    int order = search->order;
+    int target = path[0];
+    int end = path[length - 1];
+    boolean *visited = worker->visited;
+    int *open = worker->openNeighbours;
+    int cut = NO_CUT;
+
+    for(v = 0; v <= order; v++){
+        visited[v] = FALSE;
+        worker->targetNeighbour[v] = FALSE;
+    }
+    for(i = 0; i < length; i++){
+        worker->path[i] = path[i];
+        visited[path[i]] = TRUE;
+    }
+    for(i = 0; i < search->degrees[target]; i++){
+        worker->targetNeighbour[search->neighbours[search->offsets[target] + i]] = TRUE;
+    }
+
+    worker->forcedAtTarget = 0;
+    worker->forcedAtVirtual = 0;
+    for(v = 1; v <= order; v++){
+        unsigned short *neighbours = search->neighbours + search->offsets[v];
+        open[v] = 0;
+        for(i = 0; i < search->degrees[v]; i++){
+            int neighbour = neighbours[i];
+            if(!visited[neighbour] || neighbour == end || neighbour == target){
+                open[v]++;
+            }
+        }
+        if(!visited[v]){
+            if(open[v] < 2){
+                cut = DEGREE_CUT;
+            } else if(open[v] == 2){
+                if(worker->targetNeighbour[v]){
+                    worker->forcedAtTarget++;
+                }
+                if(search->virtualVertex && v != search->virtualVertex){
+                    worker->forcedAtVirtual++;
+                }
+            }
+        }
+    }
+    if(length < order && open[target] == 0){
+        cut = DEGREE_CUT;
+    }
+    if(cut == NO_CUT && (worker->forcedAtTarget > 1 || (search->virtualVertex &&
+            !visited[search->virtualVertex] && worker->forcedAtVirtual > 2))){
+        cut = FORCED_EDGE_CUT;
+    }
+
+    if(cut == DEGREE_CUT){
+        worker->statistics.degreeCuts++;
+    } else if(cut == FORCED_EDGE_CUT){
+        worker->statistics.forcedEdgeCuts++;
+    } else if(!remainingVerticesConnected(worker, 0, length - 1)){
+        worker->statistics.connectivityCuts++;
+    } else {
+        extendPrunedPath(worker, target, end, length - 1);
+    }
+}
+
+static void runTask(SEARCH_WORKER *worker, int *path, int length){
+    int i;
+
+    if(worker->search->pruned){
+        runPrunedTask(worker, path, length);
+        return;
+    }
+
+    for(i = 0; i <= worker->search->order; i++){
+        worker->visited[i] = FALSE;
+    }
+    worker->path[0] = path[0];
+    for(i = 1; i < length; i++){
+        worker->path[i] = path[i];
+        worker->visited[path[i]] = TRUE;
+    }
+
+    if(path[length - 1] == path[0]){
+        //the target is a neighbour of the start vertex through two edges
+        if(length - 1 == worker->search->order){
+            handleCycle(worker);
+        }
+    } else {
+        extendPath(worker, path[0], path[length - 1], length - 1);
+    }
+}
+
+static void *runWorker(void *arg){
+    int i;
+    SEARCH_WORKER *worker = (SEARCH_WORKER *)arg;
+    HAMILTONIAN_SEARCH *search = worker->search;
+
+    while(!atomic_load(&(search->stopped))){
+        long taskVersion;
+        int *task;
+
+        pthread_mutex_lock(&(search->idleLock));
+        taskVersion = search->taskVersion;
+        pthread_mutex_unlock(&(search->idleLock));
+
+        task = takeTask(worker, FALSE);
+        for(i = 1; task == NULL && i < search->workerCount; i++){
+            task = takeTask(search->workers + (worker->index + i) % search->workerCount, TRUE);
+        }
+
+        if(task != NULL){
+            runTask(worker, task + 1, task[0]);
+            free(task);
+            if(atomic_fetch_sub(&(search->pendingTasks), 1) == 1){
+                //this was the last task: wake up the idle workers so they can stop
+                pthread_mutex_lock(&(search->idleLock));
+                pthread_cond_broadcast(&(search->workAvailable));
+                pthread_mutex_unlock(&(search->idleLock));
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(&(search->idleLock));
+        if(atomic_load(&(search->pendingTasks)) == 0){
+            pthread_mutex_unlock(&(search->idleLock));
+            break;
+        }
+        //only wait if no tasks were added while we were looking for one
+        if(taskVersion == search->taskVersion && !atomic_load(&(search->stopped))){
+            atomic_fetch_add(&(search->idleWorkers), 1);
+            pthread_cond_wait(&(search->workAvailable), &(search->idleLock));
+            atomic_fetch_sub(&(search->idleWorkers), 1);
+        }
+        pthread_mutex_unlock(&(search->idleLock));
+    }
+
+    return NULL;
+}
+
+static void *allocateWorkerArray(size_t size){
+    void *array = malloc(size);
+    if(array == NULL){
+        fprintf(stderr, "Insufficient memory for search workers -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+/* Searches the hamiltonian cycles through start with threadCount threads and
+ * returns the number of cycles that were found. The graph of the search
+ * should already be set. If edgeIncidence is not NULL, the number of cycles
+ * through each edge is added to it.
+ */
+static unsigned long long int searchCycles(HAMILTONIAN_SEARCH *search, int start,
+        int threadCount, unsigned long long int *edgeIncidence){
+    int i, j, k;
+    int order = search->order;
+    unsigned short *startNeighbours = search->neighbours + search->offsets[start];
+    unsigned long long int cycleCount = 0;
+
+    search->workerCount = threadCount;
+    atomic_init(&(search->stopped), FALSE);
+    atomic_init(&(search->idleWorkers), 0);
+    atomic_init(&(search->pendingTasks), 0);
+    search->taskVersion = 0;
+
+    search->workers = (SEARCH_WORKER *)allocateWorkerArray(sizeof(SEARCH_WORKER)*threadCount);
+    for(i = 0; i < threadCount; i++){
+        SEARCH_WORKER *worker = search->workers + i;
+        worker->search = search;
+        worker->index = i;
+        pthread_mutex_init(&(worker->lock), NULL);
+        worker->tasks = NULL;
+        worker->firstTask = worker->lastTask = worker->taskCapacity = 0;
+        worker->path = (int *)allocateWorkerArray(sizeof(int)*(order + 1));
+        worker->visited = (boolean *)allocateWorkerArray(sizeof(boolean)*(order + 1));
+        worker->cycleCount = 0;
+        if(edgeIncidence == NULL){
+            worker->edgeIncidence = NULL;
+        } else if(i == 0){
+            worker->edgeIncidence = edgeIncidence;
+        } else {
+            worker->edgeIncidence = (unsigned long long int *)calloc(
+                    (order + 1)*(order + 1), sizeof(unsigned long long int));
+            if(worker->edgeIncidence == NULL){
+                fprintf(stderr, "Insufficient memory for edge incidences -- exiting!\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        if(search->pruned){
+            worker->openNeighbours = (int *)allocateWorkerArray(sizeof(int)*(order + 1));
+            worker->targetNeighbour = (boolean *)allocateWorkerArray(sizeof(boolean)*(order + 1));
+            worker->queue = (int *)allocateWorkerArray(sizeof(int)*(order + 1));
+            worker->mark = (unsigned int *)calloc(order + 1, sizeof(unsigned int));
+            if(worker->mark == NULL){
+                fprintf(stderr, "Insufficient memory for search workers -- exiting!\n");
+                exit(EXIT_FAILURE);
+            }
+            worker->currentMark = 0;
+            worker->statistics = (PRUNING_STATISTICS){0};
+        }
+    }
+
+    if(threadCount > 1){
+        pthread_mutex_init(&(search->idleLock), NULL);
+        pthread_cond_init(&(search->workAvailable), NULL);
+    }
+
+    //the initial paths: one for each pair of edges at the start vertex
+    k = 0;
+    for(i = 1; i < search->degrees[start] && !atomic_load(&(search->stopped)); i++){
+        for(j = 0; j < i && !atomic_load(&(search->stopped)); j++){
+            int path[3] = {startNeighbours[j], start, startNeighbours[i]};
+            if(threadCount == 1){
+                runTask(search->workers, path, 3);
+            } else {
+                addTask(search->workers + (k++ % threadCount), newTask(path, 3));
+            }
+        }
+    }
+
+    if(threadCount > 1){
+        pthread_t threads[threadCount];
+
+        for(i = 0; i < threadCount; i++){
+            if(pthread_create(threads + i, NULL, runWorker, search->workers + i)){
+                fprintf(stderr, "Could not start search thread -- exiting!\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        for(i = 0; i < threadCount; i++){
+            pthread_join(threads[i], NULL);
+        }
+
+        pthread_mutex_destroy(&(search->idleLock));
+        pthread_cond_destroy(&(search->workAvailable));
+    }
+
+    for(i = 0; i < threadCount; i++){
+        SEARCH_WORKER *worker = search->workers + i;
+        cycleCount += worker->cycleCount;
+        if(i > 0 && worker->edgeIncidence != NULL){
+            for(j = 0; j < (order + 1)*(order + 1); j++){
+                edgeIncidence[j] += worker->edgeIncidence[j];
+            }
+            free(worker->edgeIncidence);
+        }
+        if(search->pruned){
+            addPruningStatistics(&(worker->statistics));
+            free(worker->openNeighbours);
+            free(worker->targetNeighbour);
+            free(worker->queue);
+            free(worker->mark);
+        }
+        //tasks are left behind if the search was stopped
+        for(j = worker->firstTask; j < worker->lastTask; j++){
+            free(worker->tasks[j]);
+        }
+        free(worker->tasks);
+        free(worker->path);
+        free(worker->visited);
+        pthread_mutex_destroy(&(worker->lock));
+    }
+    free(search->workers);
+
+    return cycleCount;
+}
+
+/* Returns TRUE if the work graph of the problem has a hamiltonian cycle
+ * through start. The search uses the pruning rules. If cycle is not NULL, the
+ * first cycle that is found is stored in it.
+ */
+boolean searchPrunedHamiltonianCycle(HAMILTONIAN_PROBLEM *problem, int start,
+        int threadCount, int *cycle){
+    HAMILTONIAN_SEARCH search;
+
+    search.neighbours = problem->neighbours;
+    search.offsets = problem->offsets;
+    search.degrees = problem->degrees;
+    search.order = problem->order;
+    search.pruned = TRUE;
+    //the virtual vertex of a path problem between two given vertices is the start
+    search.virtualVertex = problem->type == PATH_PROBLEM ? problem->virtualVertex : 0;
+    search.stopAtFirstCycle = TRUE;
+    search.firstCycle = cycle;
+
+    return searchCycles(&search, start, threadCount, NULL) > 0;
+}
+
+/* Returns the number of hamiltonian cycles. Cycles that use different edges
+ * between the same vertices are counted separately. If edgeIncidence is not
+ * NULL, it should be an (order+1)x(order+1) matrix, and for each edge vw the
+ * number of cycles through that edge is added to the entries vw and wv.
+ */
+unsigned long long int countHamiltonianCycles(GRAPH graph, ADJACENCY adj, int start,
+        int threadCount, unsigned long long int *edgeIncidence){
+    int v;
+    int order = graph[0][0];
+    int offsets[order + 1];
+    HAMILTONIAN_SEARCH search;
+
+    //the rows of the graph are used as the lists of neighbours
+    for(v = 0; v <= order; v++){
+        offsets[v] = v*(MAXVAL + 1);
+    }
+    search.neighbours = graph[0];
+    search.offsets = offsets;
+    search.degrees = adj;
+    search.order = order;
+    search.pruned = FALSE;
+    search.virtualVertex = 0;
+    search.stopAtFirstCycle = FALSE;
+    search.firstCycle = NULL;
+
+    return searchCycles(&search, start, threadCount, edgeIncidence);
+}
@@ -0,0 +1,24 @@
+/*
+ * Main developer: Nico Van Cleemput
+ * 
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTI_HAMILTONIAN_SEARCH_H
+#define	MULTI_HAMILTONIAN_SEARCH_H
+
+#include "../../multicode/shared/multicode_base.h"
+#include "multi_hamiltonian_pruning.h"
+
+//the number of threads that is used for the search in a single graph
+extern int searchThreadCount;
+
+boolean searchPrunedHamiltonianCycle(HAMILTONIAN_PROBLEM *problem, int start,
+        int threadCount, int *cycle);
+
+unsigned long long int countHamiltonianCycles(GRAPH graph, ADJACENCY adj, int start,
+        int threadCount, unsigned long long int *edgeIncidence);
+
+#endif	/* MULTI_HAMILTONIAN_SEARCH_H */
+
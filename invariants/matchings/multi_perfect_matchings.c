@@ -0,0 +1,510 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* Perfect matchings are counted by dynamic programming over the vertices in
+ * an order that keeps the frontier small. The frontier consists of the
+ * vertices that have already been handled and that still have neighbours
+ * that have not. A state is the set of frontier vertices that are not yet
+ * matched, and for each state the number of ways to match the other handled
+ * vertices is stored. When a vertex is handled, it is either matched to an
+ * unmatched frontier vertex or it is left unmatched, and a vertex that is
+ * still unmatched when its last neighbour is handled can no longer be
+ * matched. The number of states is at most exponential in the largest
+ * frontier, which is small for graphs with a small pathwidth, e.g., planar
+ * graphs or cubic graphs up to about a hundred vertices.
+ *
+ * Each frontier vertex has a fixed slot in the bitmask that represents a
+ * state, so there can be at most MAXIMUM_SLOTS frontier vertices. When there
+ * are more, or when there are more than MAXIMUM_STATES states, the perfect
+ * matchings are enumerated instead.
+ *
+ * Parallel edges give different perfect matchings, and loops are ignored.
+ * The counts are exact, and the program exits if a count does not fit in an
+ * unsigned 128-bit integer.
+ */
+
+#include "multi_perfect_matchings.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define MAXIMUM_SLOTS 63
+#define MAXIMUM_STATES (1 << 24)
+
+//the number of steps that is spent on trying vertex orders with different start vertices
+#define ORDER_TRIAL_WORK (1 << 26)
+
+//marks a used entry in a state table, so that the empty state can be stored
+#define OCCUPIED (1ULL << 63)
+
+typedef struct {
+    int order;
+
+    //the distinct neighbours of v are neighbours[offsets[v]] up to neighbours[offsets[v+1]-1]
+    int *offsets;
+    int *neighbours;
+    //the number of edges between v and the corresponding neighbour
+    int *multiplicities;
+} MATCHING_GRAPH;
+
+typedef struct {
+    unsigned long long int *keys;
+    MATCHING_COUNT *counts;
+    size_t capacity;
+    size_t size;
+} STATE_TABLE;
+
+static void *allocateArray(size_t size){
+    void *array = malloc(size == 0 ? 1 : size);
+    if(array == NULL){
+        fprintf(stderr, "Insufficient memory for perfect matchings -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+static MATCHING_COUNT addCounts(MATCHING_COUNT a, MATCHING_COUNT b){
+    MATCHING_COUNT sum;
+    if(__builtin_add_overflow(a, b, &sum)){
+        fprintf(stderr, "Number of perfect matchings does not fit in 128 bits -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return sum;
+}
+
+static MATCHING_COUNT multiplyCount(MATCHING_COUNT a, int multiplicity){
+    MATCHING_COUNT product;
+    if(__builtin_mul_overflow(a, (MATCHING_COUNT)multiplicity, &product)){
+        fprintf(stderr, "Number of perfect matchings does not fit in 128 bits -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return product;
+}
+
+static void buildMatchingGraph(GRAPH graph, ADJACENCY adj, MATCHING_GRAPH *matchingGraph){
+    int v, i;
+    int order = graph[0][0];
+    int edgeCount = 0;
+    int *position;
+
+    for(v = 1; v <= order; v++){
+        edgeCount += adj[v];
+    }
+    matchingGraph->order = order;
+    matchingGraph->offsets = (int *)allocateArray(sizeof(int)*(order + 2));
+    matchingGraph->neighbours = (int *)allocateArray(sizeof(int)*edgeCount);
+    matchingGraph->multiplicities = (int *)allocateArray(sizeof(int)*edgeCount);
+    //the position of each neighbour of the current vertex, or -1
+    position = (int *)allocateArray(sizeof(int)*(order + 1));
+    for(v = 0; v <= order; v++){
+        position[v] = -1;
+    }
+
+    edgeCount = 0;
+    for(v = 1; v <= order; v++){
+        matchingGraph->offsets[v] = edgeCount;
+        for(i = 0; i < adj[v]; i++){
+            int neighbour = graph[v][i];
+            if(neighbour == v){
+                continue;
+            }
+            if(position[neighbour] < matchingGraph->offsets[v]){
+                position[neighbour] = edgeCount;
+                matchingGraph->neighbours[edgeCount] = neighbour;
+                matchingGraph->multiplicities[edgeCount] = 1;
+                edgeCount++;
+            } else {
+                matchingGraph->multiplicities[position[neighbour]]++;
+            }
+        }
+    }
+    matchingGraph->offsets[order + 1] = edgeCount;
+    free(position);
+}
+
+static void freeMatchingGraph(MATCHING_GRAPH *matchingGraph){
+    free(matchingGraph->offsets);
+    free(matchingGraph->neighbours);
+    free(matchingGraph->multiplicities);
+}
+
+//=========================== VERTEX ORDER ============================
+
+/* Stores an order of the vertices that starts with start in vertexOrder.
+ * Each time the vertex is chosen that increases the size of the frontier the
+ * least. Ties are broken in favour of vertices that are adjacent to a handled
+ * vertex, and then in favour of vertices with fewer neighbours that are not
+ * yet handled. Returns the sum of 2^f over all frontier sizes f, which
+ * estimates the number of states in the dynamic programming.
+ */
+static double findVertexOrder(MATCHING_GRAPH *matchingGraph, int start, int *vertexOrder,
+        int *unhandledNeighbours, boolean *handled){
+    int v, i, position;
+    int order = matchingGraph->order;
+    int frontierSize = 0;
+    double cost = 0;
+
+    for(v = 1; v <= order; v++){
+        unhandledNeighbours[v] = matchingGraph->offsets[v + 1] - matchingGraph->offsets[v];
+        handled[v] = FALSE;
+    }
+
+    for(position = 0; position < order; position++){
+        int best = 0, bestGrowth = 0, bestTouches = FALSE;
+
+        if(position == 0){
+            best = start;
+            bestGrowth = unhandledNeighbours[start] > 0 ? 1 : 0;
+        }
+        for(v = 1; v <= order && position > 0; v++){
+            int growth;
+            boolean touches = FALSE;
+
+            if(handled[v]){
+                continue;
+            }
+            growth = unhandledNeighbours[v] > 0 ? 1 : 0;
+            for(i = matchingGraph->offsets[v]; i < matchingGraph->offsets[v + 1]; i++){
+                int neighbour = matchingGraph->neighbours[i];
+                if(handled[neighbour]){
+                    touches = TRUE;
+                    if(unhandledNeighbours[neighbour] == 1){
+                        growth--;
+                    }
+                }
+            }
+            if(best == 0 || growth < bestGrowth ||
+                    (growth == bestGrowth && touches && !bestTouches) ||
+                    (growth == bestGrowth && touches == bestTouches &&
+                     unhandledNeighbours[v] < unhandledNeighbours[best])){
+                best = v;
+                bestGrowth = growth;
+                bestTouches = touches;
+            }
+        }
+
+        vertexOrder[position] = best;
+        handled[best] = TRUE;
+        for(i = matchingGraph->offsets[best]; i < matchingGraph->offsets[best + 1]; i++){
+            unhandledNeighbours[matchingGraph->neighbours[i]]--;
+        }
+        frontierSize += bestGrowth;
+        cost += ldexp(1, frontierSize);
+    }
+
+    return cost;
+}
+
+/* Stores the cheapest order that is found by starting from several vertices
+ * in vertexOrder. No more orders are tried once the time that was spent on
+ * them exceeds the estimated time for the dynamic programming, or once the
+ * total work exceeds ORDER_TRIAL_WORK.
+ */
+static void findBestVertexOrder(MATCHING_GRAPH *matchingGraph, int *vertexOrder){
+    int i, trial;
+    int order = matchingGraph->order;
+    int trials = ORDER_TRIAL_WORK / ((double)order * order + 1);
+    int *unhandledNeighbours = (int *)allocateArray(sizeof(int)*(order + 1));
+    boolean *handled = (boolean *)allocateArray(sizeof(boolean)*(order + 1));
+    int *candidateOrder = (int *)allocateArray(sizeof(int)*order);
+    double bestCost = -1;
+
+    if(trials < 1){
+        trials = 1;
+    } else if(trials > order){
+        trials = order;
+    }
+
+    for(trial = 0; trial < trials && (bestCost < 0 || (double)trial * order * order < bestCost); trial++){
+        int start = 1 + (int)((long long int)trial * order / trials);
+        double cost = findVertexOrder(matchingGraph, start, candidateOrder,
+                unhandledNeighbours, handled);
+        if(bestCost < 0 || cost < bestCost){
+            bestCost = cost;
+            for(i = 0; i < order; i++){
+                vertexOrder[i] = candidateOrder[i];
+            }
+        }
+    }
+
+    free(unhandledNeighbours);
+    free(handled);
+    free(candidateOrder);
+}
+
+//=========================== STATE TABLES ============================
+
+static void initStateTable(STATE_TABLE *table, size_t capacity){
+    size_t i;
+
+    table->keys = (unsigned long long int *)allocateArray(sizeof(unsigned long long int)*capacity);
+    table->counts = (MATCHING_COUNT *)allocateArray(sizeof(MATCHING_COUNT)*capacity);
+    table->capacity = capacity;
+    table->size = 0;
+    for(i = 0; i < capacity; i++){
+        table->keys[i] = 0;
+    }
+}
+
+static void freeStateTable(STATE_TABLE *table){
+    free(table->keys);
+    free(table->counts);
+}
+
+static inline size_t hashState(unsigned long long int key, size_t capacity){
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 20) & (capacity - 1);
+}
+
+static void insertState(STATE_TABLE *table, unsigned long long int key, MATCHING_COUNT count);
+
+static void growStateTable(STATE_TABLE *table){
+    size_t i;
+    STATE_TABLE old = *table;
+
+    initStateTable(table, old.capacity * 2);
+    for(i = 0; i < old.capacity; i++){
+        if(old.keys[i]){
+            insertState(table, old.keys[i], old.counts[i]);
+        }
+    }
+    freeStateTable(&old);
+}
+
+/* Adds count to the count of the state with the given key.
+ */
+static void insertState(STATE_TABLE *table, unsigned long long int key, MATCHING_COUNT count){
+    size_t index = hashState(key, table->capacity);
+
+    while(table->keys[index]){
+        if(table->keys[index] == key){
+            table->counts[index] = addCounts(table->counts[index], count);
+            return;
+        }
+        index = (index + 1) & (table->capacity - 1);
+    }
+    table->keys[index] = key;
+    table->counts[index] = count;
+    table->size++;
+    if(2 * table->size > table->capacity){
+        growStateTable(table);
+    }
+}
+
+static void clearStateTable(STATE_TABLE *table){
+    size_t i;
+
+    for(i = 0; i < table->capacity; i++){
+        table->keys[i] = 0;
+    }
+    table->size = 0;
+}
+
+//=========================== DYNAMIC PROGRAMMING ============================
+
+/* Counts the perfect matchings with dynamic programming. Returns FALSE if
+ * the frontier or the number of states is too large.
+ */
+static boolean countByDynamicProgramming(MATCHING_GRAPH *matchingGraph, MATCHING_COUNT *count){
+    int v, i, position;
+    int order = matchingGraph->order;
+    int *vertexOrder = (int *)allocateArray(sizeof(int)*order);
+    int *unhandledNeighbours = (int *)allocateArray(sizeof(int)*(order + 1));
+    int *slot = (int *)allocateArray(sizeof(int)*(order + 1));
+    int freeSlots[MAXIMUM_SLOTS];
+    int freeSlotCount = MAXIMUM_SLOTS;
+    STATE_TABLE current, next;
+    boolean success = TRUE;
+
+    findBestVertexOrder(matchingGraph, vertexOrder);
+    for(v = 1; v <= order; v++){
+        unhandledNeighbours[v] = matchingGraph->offsets[v + 1] - matchingGraph->offsets[v];
+        slot[v] = -1;
+    }
+    for(i = 0; i < MAXIMUM_SLOTS; i++){
+        freeSlots[i] = MAXIMUM_SLOTS - 1 - i;
+    }
+
+    initStateTable(&current, 16);
+    initStateTable(&next, 16);
+    insertState(&current, OCCUPIED, 1);
+
+    for(position = 0; position < order && current.size > 0; position++){
+        unsigned long long int dyingSlots = 0;
+        int vertexSlot = -1;
+        size_t j;
+
+        v = vertexOrder[position];
+        for(i = matchingGraph->offsets[v]; i < matchingGraph->offsets[v + 1]; i++){
+            int neighbour = matchingGraph->neighbours[i];
+            unhandledNeighbours[neighbour]--;
+            if(slot[neighbour] >= 0 && unhandledNeighbours[neighbour] == 0){
+                //v is the last neighbour that can still be matched to this neighbour
+                dyingSlots |= 1ULL << slot[neighbour];
+            }
+        }
+        if(unhandledNeighbours[v] > 0){
+            if(freeSlotCount == 0){
+                success = FALSE;
+                break;
+            }
+            vertexSlot = freeSlots[--freeSlotCount];
+        }
+
+        clearStateTable(&next);
+        for(j = 0; j < current.capacity; j++){
+            unsigned long long int state = current.keys[j];
+            MATCHING_COUNT stateCount = current.counts[j];
+            if(!state){
+                continue;
+            }
+            //match v to an unmatched neighbour on the frontier
+            for(i = matchingGraph->offsets[v]; i < matchingGraph->offsets[v + 1]; i++){
+                int neighbour = matchingGraph->neighbours[i];
+                if(slot[neighbour] >= 0 && (state & (1ULL << slot[neighbour]))){
+                    unsigned long long int nextState = state & ~(1ULL << slot[neighbour]);
+                    if(!(nextState & dyingSlots)){
+                        insertState(&next, nextState,
+                                multiplyCount(stateCount, matchingGraph->multiplicities[i]));
+                    }
+                }
+            }
+            //leave v unmatched for now
+            if(vertexSlot >= 0 && !(state & dyingSlots)){
+                insertState(&next, state | (1ULL << vertexSlot), stateCount);
+            }
+        }
+        if(next.size > MAXIMUM_STATES){
+            success = FALSE;
+            break;
+        }
+
+        for(i = matchingGraph->offsets[v]; i < matchingGraph->offsets[v + 1]; i++){
+            int neighbour = matchingGraph->neighbours[i];
+            if(slot[neighbour] >= 0 && unhandledNeighbours[neighbour] == 0){
+                freeSlots[freeSlotCount++] = slot[neighbour];
+                slot[neighbour] = -1;
+            }
+        }
+        slot[v] = vertexSlot;
+
+        STATE_TABLE swap = current;
+        current = next;
+        next = swap;
+    }
+
+    if(success){
+        size_t index = hashState(OCCUPIED, current.capacity);
+        *count = 0;
+        while(current.keys[index]){
+            if(current.keys[index] == OCCUPIED){
+                *count = current.counts[index];
+                break;
+            }
+            index = (index + 1) & (current.capacity - 1);
+        }
+    }
+
+    freeStateTable(&current);
+    freeStateTable(&next);
+    free(vertexOrder);
+    free(unhandledNeighbours);
+    free(slot);
+
+    return success;
+}
+
+//=========================== ENUMERATION ============================
+
+/* Enumerates the perfect matchings of the available vertices. The vertex
+ * that is matched next is the available vertex with the fewest available
+ * neighbours.
+ */
+static MATCHING_COUNT extendPerfectMatching(MATCHING_GRAPH *matchingGraph, boolean *available,
+        int *availableNeighbours, int remaining){
+    int v, i, j;
+    int selected = 0;
+    MATCHING_COUNT count = 0;
+
+    if(remaining == 0){
+        return 1;
+    }
+
+    for(v = 1; v <= matchingGraph->order; v++){
+        if(available[v] && (selected == 0 || availableNeighbours[v] < availableNeighbours[selected])){
+            selected = v;
+            if(availableNeighbours[v] == 0){
+                return 0;
+            }
+        }
+    }
+
+    available[selected] = FALSE;
+    for(j = matchingGraph->offsets[selected]; j < matchingGraph->offsets[selected + 1]; j++){
+        availableNeighbours[matchingGraph->neighbours[j]]--;
+    }
+    for(i = matchingGraph->offsets[selected]; i < matchingGraph->offsets[selected + 1]; i++){
+        int neighbour = matchingGraph->neighbours[i];
+        if(!available[neighbour]){
+            continue;
+        }
+        available[neighbour] = FALSE;
+        for(j = matchingGraph->offsets[neighbour]; j < matchingGraph->offsets[neighbour + 1]; j++){
+            availableNeighbours[matchingGraph->neighbours[j]]--;
+        }
+        count = addCounts(count, multiplyCount(
+                extendPerfectMatching(matchingGraph, available, availableNeighbours, remaining - 2),
+                matchingGraph->multiplicities[i]));
+        for(j = matchingGraph->offsets[neighbour]; j < matchingGraph->offsets[neighbour + 1]; j++){
+            availableNeighbours[matchingGraph->neighbours[j]]++;
+        }
+        available[neighbour] = TRUE;
+    }
+    for(j = matchingGraph->offsets[selected]; j < matchingGraph->offsets[selected + 1]; j++){
+        availableNeighbours[matchingGraph->neighbours[j]]++;
+    }
+    available[selected] = TRUE;
+
+    return count;
+}
+
+static MATCHING_COUNT countByEnumeration(MATCHING_GRAPH *matchingGraph){
+    int v;
+    int order = matchingGraph->order;
+    boolean *available = (boolean *)allocateArray(sizeof(boolean)*(order + 1));
+    int *availableNeighbours = (int *)allocateArray(sizeof(int)*(order + 1));
+    MATCHING_COUNT count;
+
+    for(v = 1; v <= order; v++){
+        available[v] = TRUE;
+        availableNeighbours[v] = matchingGraph->offsets[v + 1] - matchingGraph->offsets[v];
+    }
+    count = extendPerfectMatching(matchingGraph, available, availableNeighbours, order);
+
+    free(available);
+    free(availableNeighbours);
+
+    return count;
+}
+
+/* Returns the number of perfect matchings of the graph.
+ */
+MATCHING_COUNT countPerfectMatchings(GRAPH graph, ADJACENCY adj){
+    MATCHING_GRAPH matchingGraph;
+    MATCHING_COUNT count;
+
+    if(graph[0][0] % 2){
+        return 0;
+    }
+
+    buildMatchingGraph(graph, adj, &matchingGraph);
+    if(!countByDynamicProgramming(&matchingGraph, &count)){
+        count = countByEnumeration(&matchingGraph);
+    }
+    freeMatchingGraph(&matchingGraph);
+
+    return count;
+}
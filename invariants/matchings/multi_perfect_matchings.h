@@ -0,0 +1,18 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTI_PERFECT_MATCHINGS_H
+#define	MULTI_PERFECT_MATCHINGS_H
+
+#include "../../multicode/shared/multicode_base.h"
+
+//an exact count of perfect matchings
+typedef unsigned __int128 MATCHING_COUNT;
+
+MATCHING_COUNT countPerfectMatchings(GRAPH graph, ADJACENCY adj);
+
+#endif	/* MULTI_PERFECT_MATCHINGS_H */
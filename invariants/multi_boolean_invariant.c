@@ -12,23 +12,29 @@
  * 
  * Compile with:
  *     
- *     cc -o multi_invariant_invariantname -O4 \
+ *     cc -o multi_invariant_invariantname -O4 -pthread \
  *     -DINVARIANT=invariantmethod \
  *     multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c \
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
  *     multi_invariant_invariantname.c
  * 
  * or:
  *     
- *     cc -o multi_invariant_invariantname -O4 \
+ *     cc -o multi_invariant_invariantname -O4 -pthread \
  *     -DINVARIANT=invariantmethod \
  *     -DINVARIANTNAME=invariantname \
  *     multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c \
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
  *     multi_invariant_invariantname.c
  * 
  */
@@ -48,15 +54,77 @@
 #include "../multicode/shared/multicode_base.h"
 #include "../multicode/shared/multicode_input.h"
 #include "../multicode/shared/multicode_output.h"
+#include "../multicode/shared/multicode_parallel.h"
 
 #define XSTR(s) STR(s)
 #define STR(s) #s
 
 boolean INVARIANT(GRAPH graph, ADJACENCY adj);
 
+#ifdef PARALLEL_SEARCH
+//the invariant splits the search in a single graph over this number of threads
+extern int searchThreadCount;
+#define SEARCH_OPTIONS "s:"
+#else
+#define SEARCH_OPTIONS ""
+#endif
+
+#ifdef SEARCH_STATISTICS
+//prints how often each pruning rule of the search was applied
+extern void printPruningStatistics(FILE *f);
+#define STATISTICS_OPTIONS "p"
+#else
+#define STATISTICS_OPTIONS ""
+#endif
+
 int graphCount = 0;
 int graphsFiltered = 0;
 
+boolean doFiltering = FALSE;
+boolean invert = FALSE;
+boolean printStatistics = FALSE;
+
+//only used when the invariant is computed by several threads
+GRAPH *outputGraph;
+ADJACENCY *outputAdj;
+
+boolean passesFilter(boolean value){
+    return (invert && !value) || (!invert && value);
+}
+
+/* Handles the value of the invariant for the next graph in the input. The
+ * graph is only used when it is written to the output.
+ */
+void handleValue(GRAPH graph, ADJACENCY adj, boolean value){
+    graphCount++;
+    
+    if(doFiltering){
+        if(passesFilter(value)){
+            graphsFiltered++;
+            writeMultiCode(graph, adj, stdout);
+        }
+    } else {
+        if(value){
+            fprintf(stdout, "Graph %d has the property " XSTR(INVARIANTNAME) ".\n", graphCount);
+        } else {
+            fprintf(stdout, "Graph %d does not have the property " XSTR(INVARIANTNAME) ".\n", graphCount);
+        }
+    }
+}
+
+void evaluateGraph(GRAPH graph, ADJACENCY adj, void *result){
+    *((boolean *)result) = INVARIANT(graph, adj);
+}
+
+void handleResult(unsigned short *code, int length, void *result){
+    boolean value = *((boolean *)result);
+    
+    if(doFiltering && passesFilter(value)){
+        decodeMultiCode(code, length, *outputGraph, *outputAdj);
+    }
+    handleValue(*outputGraph, *outputAdj, value);
+}
+
 //====================== USAGE =======================
 
 void help(char *name) {
@@ -70,6 +138,19 @@ void help(char *name) {
     fprintf(stderr, "       Filter graphs that have the property.\n");
     fprintf(stderr, "    -i, --invert\n");
     fprintf(stderr, "       Invert the filter.\n");
+    fprintf(stderr, "    -t #, --threads #\n");
+    fprintf(stderr, "       Compute the invariant with the specified number of threads. The\n");
+    fprintf(stderr, "       output is the same as when using a single thread.\n");
+#ifdef PARALLEL_SEARCH
+    fprintf(stderr, "    -s #, --search-threads #\n");
+    fprintf(stderr, "       Split the search in each graph over the specified number of threads.\n");
+    fprintf(stderr, "       This is useful for a few hard graphs, while -t is better suited for\n");
+    fprintf(stderr, "       many easy graphs.\n");
+#endif
+#ifdef SEARCH_STATISTICS
+    fprintf(stderr, "    -p, --pruning-statistics\n");
+    fprintf(stderr, "       Print how often each pruning rule of the search was applied.\n");
+#endif
     fprintf(stderr, "    -h, --help\n");
     fprintf(stderr, "       Print this help and return.\n");
 }
@@ -87,8 +168,7 @@ int main(int argc, char** argv) {
     GRAPH graph;
     ADJACENCY adj;
     
-    boolean doFiltering = FALSE;
-    boolean invert = FALSE;
+    int threadCount = 1;
 
     /*=========== commandline parsing ===========*/
 
@@ -97,11 +177,18 @@ int main(int argc, char** argv) {
     static struct option long_options[] = {
         {"invert", no_argument, NULL, 'i'},
         {"filter", no_argument, NULL, 'f'},
+        {"threads", required_argument, NULL, 't'},
+#ifdef PARALLEL_SEARCH
+        {"search-threads", required_argument, NULL, 's'},
+#endif
+#ifdef SEARCH_STATISTICS
+        {"pruning-statistics", no_argument, NULL, 'p'},
+#endif
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "hfi", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "hfit:" SEARCH_OPTIONS STATISTICS_OPTIONS, long_options, &option_index)) != -1) {
         switch (c) {
             case 'i':
                 invert = TRUE;
@@ -109,6 +196,29 @@ int main(int argc, char** argv) {
             case 'f':
                 doFiltering = TRUE;
                 break;
+            case 't':
+                threadCount = atoi(optarg);
+                if(threadCount < 1){
+                    fprintf(stderr, "The number of threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+#ifdef PARALLEL_SEARCH
+            case 's':
+                searchThreadCount = atoi(optarg);
+                if(searchThreadCount < 1){
+                    fprintf(stderr, "The number of search threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+#endif
+#ifdef SEARCH_STATISTICS
+            case 'p':
+                printStatistics = TRUE;
+                break;
+#endif
             case 'h':
                 help(name);
                 return EXIT_SUCCESS;
@@ -122,27 +232,23 @@ int main(int argc, char** argv) {
         }
     }
     
-    unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readMultiCode(code, &length, stdin)) {
-        decodeMultiCode(code, length, graph, adj);
-        graphCount++;
-        
-        boolean value = INVARIANT(graph, adj);
-        if(doFiltering){
-            if(invert && !value){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            } else if(!invert && value){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            }
-        } else {
-            if(value){
-                fprintf(stdout, "Graph %d has the property " XSTR(INVARIANTNAME) ".\n", graphCount);
-            } else {
-                fprintf(stdout, "Graph %d does not have the property " XSTR(INVARIANTNAME) ".\n", graphCount);
-            }
+    if(threadCount > 1){
+        outputGraph = (GRAPH *)malloc(sizeof(GRAPH));
+        outputAdj = (ADJACENCY *)malloc(sizeof(ADJACENCY));
+        if(outputGraph == NULL || outputAdj == NULL){
+            fprintf(stderr, "Insufficient memory -- exiting!\n");
+            return EXIT_FAILURE;
+        }
+        processMultiCodeInParallel(stdin, threadCount, sizeof(boolean),
+                evaluateGraph, handleResult);
+        free(outputGraph);
+        free(outputAdj);
+    } else {
+        unsigned short code[MAXCODELENGTH];
+        int length;
+        while (readMultiCode(code, &length, stdin)) {
+            decodeMultiCode(code, length, graph, adj);
+            handleValue(graph, adj, INVARIANT(graph, adj));
         }
     }
     
@@ -150,6 +256,11 @@ int main(int argc, char** argv) {
     if(doFiltering){
         fprintf(stderr, "Filtered %d graph%s.\n", graphsFiltered, graphsFiltered==1 ? "" : "s");
     }
+#ifdef SEARCH_STATISTICS
+    if(printStatistics){
+        printPruningStatistics(stderr);
+    }
+#endif
 
     return (EXIT_SUCCESS);
 }
@@ -0,0 +1,307 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* This program reads a graph in multicode format from standard in,
+ * computes the specified invariant and writes the result to standard
+ * out. The invariant is a count that may be too large for an int: it is
+ * stored as an unsigned 128-bit integer.
+ *
+ *
+ * Compile with:
+ *
+ *     cc -o multi_invariant_invariantname -O4 -pthread \
+ *     -DINVARIANT=invariantmethod \
+ *     -DINVARIANTNAME=invariantname \
+ *     multi_count_invariant.c \
+ *     ../multicode/shared/multicode_base.c \
+ *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
+ *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     multi_invariant_invariantname.c
+ *
+ */
+
+#ifndef INVARIANT
+    #error "INVARIANT must be defined"
+#endif
+
+#ifndef INVARIANTNAME
+#define INVARIANTNAME INVARIANT
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include "../multicode/shared/multicode_base.h"
+#include "../multicode/shared/multicode_input.h"
+#include "../multicode/shared/multicode_output.h"
+#include "../multicode/shared/multicode_parallel.h"
+
+#define XSTR(s) STR(s)
+#define STR(s) #s
+
+typedef unsigned __int128 COUNT;
+
+//enough for the 39 digits of the largest count
+#define COUNT_DIGITS 40
+
+COUNT INVARIANT(GRAPH graph, ADJACENCY adj);
+
+int graphCount = 0;
+int graphsFiltered = 0;
+
+COUNT filterValue;
+boolean doFiltering = FALSE;
+boolean findMinimum = FALSE;
+boolean findMaximum = FALSE;
+
+boolean allowEqual = TRUE;
+boolean allowLess = FALSE;
+boolean allowGreater = FALSE;
+
+COUNT maximum = 0;
+boolean maximumFound = FALSE;
+COUNT minimum = 0;
+boolean minimumFound = FALSE;
+int extremumGraph = -1;
+
+//only used when the invariant is computed by several threads
+GRAPH *outputGraph;
+ADJACENCY *outputAdj;
+
+/* Writes the decimal digits of value to buffer, which should have room for
+ * COUNT_DIGITS characters, and returns buffer.
+ */
+char *countToString(COUNT value, char *buffer){
+    char digits[COUNT_DIGITS];
+    int length = 0, i;
+
+    do {
+        digits[length++] = '0' + (int)(value % 10);
+        value /= 10;
+    } while(value > 0);
+    for(i = 0; i < length; i++){
+        buffer[i] = digits[length - 1 - i];
+    }
+    buffer[length] = '\0';
+
+    return buffer;
+}
+
+/* Returns FALSE if string is not a non-negative integer that fits in a COUNT.
+ */
+boolean parseCount(char *string, COUNT *value){
+    COUNT result = 0;
+
+    if(*string == '\0'){
+        return FALSE;
+    }
+    while(*string){
+        int digit = *string - '0';
+        if(digit < 0 || digit > 9 || result > (~(COUNT)0 - digit) / 10){
+            return FALSE;
+        }
+        result = 10 * result + digit;
+        string++;
+    }
+    *value = result;
+
+    return TRUE;
+}
+
+boolean passesFilter(COUNT value){
+    return (allowEqual && filterValue == value) ||
+           (allowLess && filterValue > value) ||
+           (allowGreater && filterValue < value);
+}
+
+/* Handles the value of the invariant for the next graph in the input. The
+ * graph is only used when it is written to the output.
+ */
+void handleValue(GRAPH graph, ADJACENCY adj, COUNT value){
+    char buffer[COUNT_DIGITS];
+
+    graphCount++;
+
+    if(doFiltering){
+        if(passesFilter(value)){
+            graphsFiltered++;
+            writeMultiCode(graph, adj, stdout);
+        }
+    } else if(findMaximum) {
+        if(!maximumFound || value>maximum){
+            maximum = value;
+            maximumFound = TRUE;
+            extremumGraph = graphCount;
+        }
+    } else if(findMinimum) {
+        if(!minimumFound || value<minimum){
+            minimum = value;
+            minimumFound = TRUE;
+            extremumGraph = graphCount;
+        }
+    } else {
+        fprintf(stdout, "Graph %d has " XSTR(INVARIANTNAME) " equal to %s.\n",
+                graphCount, countToString(value, buffer));
+    }
+}
+
+void evaluateGraph(GRAPH graph, ADJACENCY adj, void *result){
+    *((COUNT *)result) = INVARIANT(graph, adj);
+}
+
+void handleResult(unsigned short *code, int length, void *result){
+    COUNT value = *((COUNT *)result);
+
+    if(doFiltering && passesFilter(value)){
+        decodeMultiCode(code, length, *outputGraph, *outputAdj);
+    }
+    handleValue(*outputGraph, *outputAdj, value);
+}
+
+//====================== USAGE =======================
+
+void help(char *name) {
+    fprintf(stderr, "The program %s calculates the %s \nfor graphs in multicode format.\n\n", name, XSTR(INVARIANTNAME));
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options]\n\n", name);
+    fprintf(stderr, "\nThis program can handle graphs up to %d vertices. Recompile if you need larger\n", MAXN);
+    fprintf(stderr, "graphs. Values up to 2^128-1 are computed exactly.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -f #, --filter #\n");
+    fprintf(stderr, "       Filter graphs that have the specified value for the invariant.\n");
+    fprintf(stderr, "    -l, --less\n");
+    fprintf(stderr, "       Filter allows graphs with value less than the specified value.\n");
+    fprintf(stderr, "    -g, --greater\n");
+    fprintf(stderr, "       Filter allows graphs with value greater than the specified value.\n");
+    fprintf(stderr, "    -n, --not-equal\n");
+    fprintf(stderr, "       Filter does not allow graphs with value equal to specified value.\n");
+    fprintf(stderr, "    -m, --minimum\n");
+    fprintf(stderr, "       Find the graph with the smallest value.\n");
+    fprintf(stderr, "    -M, --maximum\n");
+    fprintf(stderr, "       Find the graph with the largest value.\n");
+    fprintf(stderr, "    -t #, --threads #\n");
+    fprintf(stderr, "       Compute the invariant with the specified number of threads. The\n");
+    fprintf(stderr, "       output is the same as when using a single thread.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+
+    GRAPH graph;
+    ADJACENCY adj;
+
+    int threadCount = 1;
+    char buffer[COUNT_DIGITS];
+
+    /*=========== commandline parsing ===========*/
+
+    int c;
+    char *name = argv[0];
+    static struct option long_options[] = {
+        {"not-equal", no_argument, NULL, 'n'},
+        {"less", no_argument, NULL, 'l'},
+        {"greater", no_argument, NULL, 'g'},
+        {"minimum", no_argument, NULL, 'm'},
+        {"maximum", no_argument, NULL, 'M'},
+        {"filter", required_argument, NULL, 'f'},
+        {"threads", required_argument, NULL, 't'},
+        {"help", no_argument, NULL, 'h'}
+    };
+    int option_index = 0;
+
+    while ((c = getopt_long(argc, argv, "hf:lgnmMt:", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'n':
+                allowEqual = FALSE;
+                break;
+            case 'l':
+                allowLess = TRUE;
+                break;
+            case 'g':
+                allowGreater = TRUE;
+                break;
+            case 'f':
+                doFiltering = TRUE;
+                if(!parseCount(optarg, &filterValue)){
+                    fprintf(stderr, "The filter value should be a non-negative integer.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'm':
+                findMinimum = TRUE;
+                break;
+            case 'M':
+                findMaximum = TRUE;
+                break;
+            case 't':
+                threadCount = atoi(optarg);
+                if(threadCount < 1){
+                    fprintf(stderr, "The number of threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'h':
+                help(name);
+                return EXIT_SUCCESS;
+            case '?':
+                usage(name);
+                return EXIT_FAILURE;
+            default:
+                fprintf(stderr, "Illegal option %c.\n", c);
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(threadCount > 1){
+        outputGraph = (GRAPH *)malloc(sizeof(GRAPH));
+        outputAdj = (ADJACENCY *)malloc(sizeof(ADJACENCY));
+        if(outputGraph == NULL || outputAdj == NULL){
+            fprintf(stderr, "Insufficient memory -- exiting!\n");
+            return EXIT_FAILURE;
+        }
+        processMultiCodeInParallel(stdin, threadCount, sizeof(COUNT),
+                evaluateGraph, handleResult);
+        free(outputGraph);
+        free(outputAdj);
+    } else {
+        unsigned short code[MAXCODELENGTH];
+        int length;
+        while (readMultiCode(code, &length, stdin)) {
+            decodeMultiCode(code, length, graph, adj);
+            handleValue(graph, adj, INVARIANT(graph, adj));
+        }
+    }
+
+    fprintf(stderr, "Read %d graph%s.\n", graphCount, graphCount==1 ? "" : "s");
+    if(doFiltering){
+        fprintf(stderr, "Filtered %d graph%s.\n", graphsFiltered, graphsFiltered==1 ? "" : "s");
+    } else if(findMaximum){
+        fprintf(stderr, "Graph %d has maximum value for " XSTR(INVARIANTNAME) ": %s.\n",
+                extremumGraph, countToString(maximum, buffer));
+    } else if(findMinimum){
+        fprintf(stderr, "Graph %d has minimum value for " XSTR(INVARIANTNAME) ": %s.\n",
+                extremumGraph, countToString(minimum, buffer));
+    }
+
+    return (EXIT_SUCCESS);
+}
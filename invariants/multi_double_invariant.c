@@ -12,23 +12,29 @@
  * 
  * Compile with:
  *     
- *     cc -o multi_invariant_invariantname -O4 \
+ *     cc -o multi_invariant_invariantname -O4 -pthread \
  *     -DINVARIANT=invariantmethod \
  *     multi_double_invariant.c \
  *     ../multicode/shared/multicode_base.c \
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
  *     multi_invariant_invariantname.c
  * 
  * or:
  *     
- *     cc -o multi_invariant_invariantname -O4 \
+ *     cc -o multi_invariant_invariantname -O4 -pthread \
  *     -DINVARIANT=invariantmethod \
  *     -DINVARIANTNAME=invariantname \
  *     multi_double_invariant.c \
  *     ../multicode/shared/multicode_base.c \
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
  *     multi_invariant_invariantname.c
  * 
  */
@@ -50,12 +56,21 @@
 #include "../multicode/shared/multicode_base.h"
 #include "../multicode/shared/multicode_input.h"
 #include "../multicode/shared/multicode_output.h"
+#include "../multicode/shared/multicode_parallel.h"
 
 #define XSTR(s) STR(s)
 #define STR(s) #s
 
 double INVARIANT(GRAPH graph, ADJACENCY adj);
 
+#ifdef PARALLEL_SEARCH
+//the invariant splits the search in a single graph over this number of threads
+extern int searchThreadCount;
+#define SEARCH_OPTIONS "s:"
+#else
+#define SEARCH_OPTIONS ""
+#endif
+
 int graphCount = 0;
 int graphsFiltered = 0;
 
@@ -65,6 +80,68 @@ boolean doubleEqual(double a, double b){
     return fabs(a - b) < epsilon;
 }
 
+double filterValue;
+boolean doFiltering = FALSE;
+boolean findMinimum = FALSE;
+boolean findMaximum = FALSE;
+
+boolean allowEqual = TRUE;
+boolean allowLess = FALSE;
+boolean allowGreater = FALSE;
+
+double maximum = -DBL_MAX;
+double minimum = DBL_MAX;
+int extremumGraph = -1;
+
+//only used when the invariant is computed by several threads
+GRAPH *outputGraph;
+ADJACENCY *outputAdj;
+
+boolean passesFilter(double value){
+    return (allowEqual && doubleEqual(value, filterValue)) ||
+           (allowLess && filterValue > value) ||
+           (allowGreater && filterValue < value);
+}
+
+/* Handles the value of the invariant for the next graph in the input. The
+ * graph is only used when it is written to the output.
+ */
+void handleValue(GRAPH graph, ADJACENCY adj, double value){
+    graphCount++;
+    
+    if(doFiltering){
+        if(passesFilter(value)){
+            graphsFiltered++;
+            writeMultiCode(graph, adj, stdout);
+        }
+    } else if(findMaximum) {
+        if(value>maximum){
+            maximum = value;
+            extremumGraph = graphCount;
+        }
+    } else if(findMinimum) {
+        if(value<minimum){
+            minimum = value;
+            extremumGraph = graphCount;
+        }
+    } else {
+        fprintf(stdout, "Graph %d has " XSTR(INVARIANTNAME) " equal to %f.\n", graphCount, value);
+    }
+}
+
+void evaluateGraph(GRAPH graph, ADJACENCY adj, void *result){
+    *((double *)result) = INVARIANT(graph, adj);
+}
+
+void handleResult(unsigned short *code, int length, void *result){
+    double value = *((double *)result);
+    
+    if(doFiltering && passesFilter(value)){
+        decodeMultiCode(code, length, *outputGraph, *outputAdj);
+    }
+    handleValue(*outputGraph, *outputAdj, value);
+}
+
 //====================== USAGE =======================
 
 void help(char *name) {
@@ -86,6 +163,15 @@ void help(char *name) {
     fprintf(stderr, "       Find the graph with the smallest value.\n");
     fprintf(stderr, "    -M, --maximum\n");
     fprintf(stderr, "       Find the graph with the largest value.\n");
+    fprintf(stderr, "    -t #, --threads #\n");
+    fprintf(stderr, "       Compute the invariant with the specified number of threads. The\n");
+    fprintf(stderr, "       output is the same as when using a single thread.\n");
+#ifdef PARALLEL_SEARCH
+    fprintf(stderr, "    -s #, --search-threads #\n");
+    fprintf(stderr, "       Split the search in each graph over the specified number of threads.\n");
+    fprintf(stderr, "       This is useful for a few hard graphs, while -t is better suited for\n");
+    fprintf(stderr, "       many easy graphs.\n");
+#endif
     fprintf(stderr, "    -h, --help\n");
     fprintf(stderr, "       Print this help and return.\n");
 }
@@ -103,14 +189,7 @@ int main(int argc, char** argv) {
     GRAPH graph;
     ADJACENCY adj;
     
-    double filterValue;
-    boolean doFiltering = FALSE;
-    boolean findMinimum = FALSE;
-    boolean findMaximum = FALSE;
-    
-    boolean allowEqual = TRUE;
-    boolean allowLess = FALSE;
-    boolean allowGreater = FALSE;
+    int threadCount = 1;
 
     /*=========== commandline parsing ===========*/
 
@@ -123,11 +202,15 @@ int main(int argc, char** argv) {
         {"minimum", no_argument, NULL, 'm'},
         {"maximum", no_argument, NULL, 'M'},
         {"filter", required_argument, NULL, 'f'},
+        {"threads", required_argument, NULL, 't'},
+#ifdef PARALLEL_SEARCH
+        {"search-threads", required_argument, NULL, 's'},
+#endif
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "hf:lgnmM", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "hf:lgnmMt:" SEARCH_OPTIONS, long_options, &option_index)) != -1) {
         switch (c) {
             case 'n':
                 allowEqual = FALSE;
@@ -148,6 +231,24 @@ int main(int argc, char** argv) {
             case 'M':
                 findMaximum = TRUE;
                 break;
+            case 't':
+                threadCount = atoi(optarg);
+                if(threadCount < 1){
+                    fprintf(stderr, "The number of threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+#ifdef PARALLEL_SEARCH
+            case 's':
+                searchThreadCount = atoi(optarg);
+                if(searchThreadCount < 1){
+                    fprintf(stderr, "The number of search threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+#endif
             case 'h':
                 help(name);
                 return EXIT_SUCCESS;
@@ -161,39 +262,23 @@ int main(int argc, char** argv) {
         }
     }
     
-    double maximum = -DBL_MAX;
-    double minimum = DBL_MAX;
-    int extremumGraph = -1;
-    unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readMultiCode(code, &length, stdin)) {
-        decodeMultiCode(code, length, graph, adj);
-        graphCount++;
-        
-        double value = INVARIANT(graph, adj);
-        if(doFiltering){
-            if(allowEqual && doubleEqual(value, filterValue)){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            } else if(allowLess && filterValue > value){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            } else if(allowGreater && filterValue < value){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            }
-        } else if(findMaximum) {
-            if(value>maximum){
-                maximum = value;
-                extremumGraph = graphCount;
-            }
-        } else if(findMinimum) {
-            if(value<minimum){
-                minimum = value;
-                extremumGraph = graphCount;
-            }
-        } else {
-            fprintf(stdout, "Graph %d has " XSTR(INVARIANTNAME) " equal to %f.\n", graphCount, value);
+    if(threadCount > 1){
+        outputGraph = (GRAPH *)malloc(sizeof(GRAPH));
+        outputAdj = (ADJACENCY *)malloc(sizeof(ADJACENCY));
+        if(outputGraph == NULL || outputAdj == NULL){
+            fprintf(stderr, "Insufficient memory -- exiting!\n");
+            return EXIT_FAILURE;
+        }
+        processMultiCodeInParallel(stdin, threadCount, sizeof(double),
+                evaluateGraph, handleResult);
+        free(outputGraph);
+        free(outputAdj);
+    } else {
+        unsigned short code[MAXCODELENGTH];
+        int length;
+        while (readMultiCode(code, &length, stdin)) {
+            decodeMultiCode(code, length, graph, adj);
+            handleValue(graph, adj, INVARIANT(graph, adj));
         }
     }
     
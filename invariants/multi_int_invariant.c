@@ -12,23 +12,29 @@
  * 
  * Compile with:
  *     
- *     cc -o multi_invariant_invariantname -O4 \
+ *     cc -o multi_invariant_invariantname -O4 -pthread \
  *     -DINVARIANT=invariantmethod \
  *     multi_int_invariant.c \
  *     ../multicode/shared/multicode_base.c \
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
  *     multi_invariant_invariantname.c
  * 
  * or:
  *     
- *     cc -o multi_invariant_invariantname -O4 \
+ *     cc -o multi_invariant_invariantname -O4 -pthread \
  *     -DINVARIANT=invariantmethod \
  *     -DINVARIANTNAME=invariantname \
  *     multi_int_invariant.c \
  *     ../multicode/shared/multicode_base.c \
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
  *     multi_invariant_invariantname.c
  * 
  */
@@ -48,15 +54,109 @@
 #include "../multicode/shared/multicode_base.h"
 #include "../multicode/shared/multicode_input.h"
 #include "../multicode/shared/multicode_output.h"
+#include "../multicode/shared/multicode_parallel.h"
 
 #define XSTR(s) STR(s)
 #define STR(s) #s
 
 int INVARIANT(GRAPH graph, ADJACENCY adj);
 
+#ifdef PARALLEL_SEARCH
+//the invariant splits the search in a single graph over this number of threads
+extern int searchThreadCount;
+#define SEARCH_OPTIONS "s:"
+#else
+#define SEARCH_OPTIONS ""
+#endif
+
+#ifdef BOUNDED_INVARIANT
+/* When this is positive, the invariant only needs to decide whether its value
+ * is at most this bound. It then returns a value that is at most the bound if
+ * this is the case, and a larger value otherwise.
+ */
+extern int invariantBound;
+#define BOUND_OPTIONS "k:"
+#else
+#define BOUND_OPTIONS ""
+#endif
+
 int graphCount = 0;
 int graphsFiltered = 0;
 
+int filterValue;
+boolean doFiltering = FALSE;
+boolean findMinimum = FALSE;
+boolean findMaximum = FALSE;
+
+boolean allowEqual = TRUE;
+boolean allowLess = FALSE;
+boolean allowGreater = FALSE;
+
+int maximum = INT_MIN;
+int minimum = INT_MAX;
+int extremumGraph = -1;
+
+//only used when the invariant is computed by several threads
+GRAPH *outputGraph;
+ADJACENCY *outputAdj;
+
+boolean passesFilter(int value){
+    return (allowEqual && filterValue == value) ||
+           (allowLess && filterValue > value) ||
+           (allowGreater && filterValue < value);
+}
+
+/* Handles the value of the invariant for the next graph in the input. The
+ * graph is only used when it is written to the output.
+ */
+void handleValue(GRAPH graph, ADJACENCY adj, int value){
+    graphCount++;
+    
+#ifdef BOUNDED_INVARIANT
+    if(invariantBound > 0){
+        //only the answer to the decision problem is known
+        value = value <= invariantBound ? invariantBound : invariantBound + 1;
+    }
+#endif
+    
+    if(doFiltering){
+        if(passesFilter(value)){
+            graphsFiltered++;
+            writeMultiCode(graph, adj, stdout);
+        }
+    } else if(findMaximum) {
+        if(value>maximum){
+            maximum = value;
+            extremumGraph = graphCount;
+        }
+    } else if(findMinimum) {
+        if(value<minimum){
+            minimum = value;
+            extremumGraph = graphCount;
+        }
+#ifdef BOUNDED_INVARIANT
+    } else if(invariantBound > 0) {
+        fprintf(stdout, "Graph %d has " XSTR(INVARIANTNAME) " %s %d.\n", graphCount,
+                value <= invariantBound ? "at most" : "greater than", invariantBound);
+#endif
+    } else {
+        fprintf(stdout, "Graph %d has " XSTR(INVARIANTNAME) " equal to %d.\n", graphCount, value);
+    }
+}
+
+void evaluateGraph(GRAPH graph, ADJACENCY adj, void *result){
+    *((int *)result) = INVARIANT(graph, adj);
+}
+
+void handleResult(unsigned short *code, int length, void *result){
+    int value = *((int *)result);
+    
+    if(doFiltering && passesFilter(value)){
+        decodeMultiCode(code, length, *outputGraph, *outputAdj);
+    }
+    handleValue(*outputGraph, *outputAdj, value);
+}
+
 //====================== USAGE =======================
 
 void help(char *name) {
@@ -78,6 +178,23 @@ void help(char *name) {
     fprintf(stderr, "       Find the graph with the smallest value.\n");
     fprintf(stderr, "    -M, --maximum\n");
     fprintf(stderr, "       Find the graph with the largest value.\n");
+    fprintf(stderr, "    -t #, --threads #\n");
+    fprintf(stderr, "       Compute the invariant with the specified number of threads. The\n");
+    fprintf(stderr, "       output is the same as when using a single thread.\n");
+#ifdef PARALLEL_SEARCH
+    fprintf(stderr, "    -s #, --search-threads #\n");
+    fprintf(stderr, "       Split the search in each graph over the specified number of threads.\n");
+    fprintf(stderr, "       This is useful for a few hard graphs, while -t is better suited for\n");
+    fprintf(stderr, "       many easy graphs.\n");
+#endif
+#ifdef BOUNDED_INVARIANT
+    fprintf(stderr, "    -k #, --bound #\n");
+    fprintf(stderr, "       Only decide whether the invariant is at most the specified value.\n");
+    fprintf(stderr, "       The value of a graph is then replaced by the bound if it is at most\n");
+    fprintf(stderr, "       the bound, and by the bound plus one otherwise. This is faster than\n");
+    fprintf(stderr, "       computing the exact value, e.g., -k 4 -f 4 keeps the graphs with a\n");
+    fprintf(stderr, "       value of at most 4.\n");
+#endif
     fprintf(stderr, "    -h, --help\n");
     fprintf(stderr, "       Print this help and return.\n");
 }
@@ -95,14 +212,7 @@ int main(int argc, char** argv) {
     GRAPH graph;
     ADJACENCY adj;
     
-    int filterValue;
-    boolean doFiltering = FALSE;
-    boolean findMinimum = FALSE;
-    boolean findMaximum = FALSE;
-    
-    boolean allowEqual = TRUE;
-    boolean allowLess = FALSE;
-    boolean allowGreater = FALSE;
+    int threadCount = 1;
 
     /*=========== commandline parsing ===========*/
 
@@ -115,11 +225,18 @@ int main(int argc, char** argv) {
         {"minimum", no_argument, NULL, 'm'},
         {"maximum", no_argument, NULL, 'M'},
         {"filter", required_argument, NULL, 'f'},
+        {"threads", required_argument, NULL, 't'},
+#ifdef PARALLEL_SEARCH
+        {"search-threads", required_argument, NULL, 's'},
+#endif
+#ifdef BOUNDED_INVARIANT
+        {"bound", required_argument, NULL, 'k'},
+#endif
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "hf:lgnmM", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "hf:lgnmMt:" SEARCH_OPTIONS BOUND_OPTIONS, long_options, &option_index)) != -1) {
         switch (c) {
             case 'n':
                 allowEqual = FALSE;
@@ -140,6 +257,34 @@ int main(int argc, char** argv) {
             case 'M':
                 findMaximum = TRUE;
                 break;
+            case 't':
+                threadCount = atoi(optarg);
+                if(threadCount < 1){
+                    fprintf(stderr, "The number of threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+#ifdef PARALLEL_SEARCH
+            case 's':
+                searchThreadCount = atoi(optarg);
+                if(searchThreadCount < 1){
+                    fprintf(stderr, "The number of search threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+#endif
+#ifdef BOUNDED_INVARIANT
+            case 'k':
+                invariantBound = atoi(optarg);
+                if(invariantBound < 1){
+                    fprintf(stderr, "The bound should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+#endif
             case 'h':
                 help(name);
                 return EXIT_SUCCESS;
@@ -153,39 +298,23 @@ int main(int argc, char** argv) {
         }
     }
     
-    int maximum = INT_MIN;
-    int minimum = INT_MAX;
-    int extremumGraph = -1;
-    unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readMultiCode(code, &length, stdin)) {
-        decodeMultiCode(code, length, graph, adj);
-        graphCount++;
-        
-        int value = INVARIANT(graph, adj);
-        if(doFiltering){
-            if(allowEqual && filterValue == value){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            } else if(allowLess && filterValue > value){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            } else if(allowGreater && filterValue < value){
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
-            }
-        } else if(findMaximum) {
-            if(value>maximum){
-                maximum = value;
-                extremumGraph = graphCount;
-            }
-        } else if(findMinimum) {
-            if(value<minimum){
-                minimum = value;
-                extremumGraph = graphCount;
-            }
-        } else {
-            fprintf(stdout, "Graph %d has " XSTR(INVARIANTNAME) " equal to %d.\n", graphCount, value);
+    if(threadCount > 1){
+        outputGraph = (GRAPH *)malloc(sizeof(GRAPH));
+        outputAdj = (ADJACENCY *)malloc(sizeof(ADJACENCY));
+        if(outputGraph == NULL || outputAdj == NULL){
+            fprintf(stderr, "Insufficient memory -- exiting!\n");
+            return EXIT_FAILURE;
+        }
+        processMultiCodeInParallel(stdin, threadCount, sizeof(int),
+                evaluateGraph, handleResult);
+        free(outputGraph);
+        free(outputAdj);
+    } else {
+        unsigned short code[MAXCODELENGTH];
+        int length;
+        while (readMultiCode(code, &length, stdin)) {
+            decodeMultiCode(code, length, graph, adj);
+            handleValue(graph, adj, INVARIANT(graph, adj));
         }
     }
     
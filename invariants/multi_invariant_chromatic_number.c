@@ -10,62 +10,27 @@
  * 
  * Compile like this:
  *     
- *     cc -o multi_invariant_chromatic_number -O4 -DINVARIANT=chromaticNumber \
- *     -DINVARIANTNAME="chromatic number" multi_int_invariant.c \
+ *     cc -o multi_invariant_chromatic_number -O4 -pthread -DINVARIANT=chromaticNumber \
+ *     -DINVARIANTNAME="chromatic number" -DBOUNDED_INVARIANT multi_int_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     ../multicode/shared/multicode_bitset.c \
+ *     colouring/multi_colouring.c \
  *     multi_invariant_chromatic_number.c
+ *
+ * With -DBOUNDED_INVARIANT the option -k # only decides whether the graph can
+ * be coloured with # colours.
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "colouring/multi_colouring.h"
 
-int colourGraph(GRAPH graph, ADJACENCY adj, int* graphPartition, int currentVertex, int maximumColours){
-    int i, j, partitionCount;
-    //first see how many partitions we have
-    partitionCount = 0;
-    for(i = 1; i < currentVertex; i++){
-        if(graphPartition[i]==i){
-            partitionCount++;
-        }
-    }
-    
-    if(partitionCount >= maximumColours){
-        //we won't find anything better with this partition
-        return maximumColours;
-    }
-    if(currentVertex > graph[0][0]){
-        //all vertices have been coloured, and partitionCount is less than maximumColours
-        return partitionCount;
-    }
-    
-    //colour the current vertex
-    
-    //first try all existing colour classes
-    for(i = 1; i < currentVertex; i++){
-        if(graphPartition[i]==i){
-            boolean canGoInThisPartition = TRUE;
-            j = 0;
-            while(canGoInThisPartition && j < adj[currentVertex]){
-                //the vertex can go in this partition if all of its neighbours
-                //are either not in a colour class or in a different colour class
-                canGoInThisPartition = (graph[currentVertex][j] > currentVertex) ||
-                        (graphPartition[graph[currentVertex][j]] != i);
-                j++;
-            }
-            if(canGoInThisPartition){
-                graphPartition[currentVertex] = i;
-                maximumColours = colourGraph(graph, adj, graphPartition, currentVertex + 1, maximumColours);
-            }
-        }
-    }
-    
-    //finally try to put the vertex in a new colour class
-    graphPartition[currentVertex] = currentVertex;
-    maximumColours = colourGraph(graph, adj, graphPartition, currentVertex + 1, maximumColours);
-    
-    return maximumColours;
-}
+//only decide whether the graph can be coloured with this many colours, if positive
+int invariantBound = NO_COLOUR_BOUND;
 
 int chromaticNumber(GRAPH graph, ADJACENCY adj){
     int i, minDeg, maxDeg, n;
@@ -94,12 +59,5 @@ int chromaticNumber(GRAPH graph, ADJACENCY adj){
         return 1; //no edges
     }
     
-    int graphPartition[MAXN + 1];
-    
-    //initially all vertices are in the same partition
-    for(i = 1; i <= MAXN; i++){
-        graphPartition[i] = 1;
-    }
-    
-    return colourGraph(graph, adj, graphPartition, 2, maxDeg + 1);
-}
\ No newline at end of file
+    return findChromaticNumber(graph, adj, invariantBound);
+}
@@ -14,6 +14,7 @@
  *     multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
  *     multi_invariant_contains_wheel.c
  */
@@ -47,12 +48,12 @@ typedef unsigned long long int bitset;
 #define SAFE_REMOVE_ALL(s, elements) ADD_ALL(s, elements); REMOVE_ALL(s, elements)
 
 
-boolean handleSimpleCycle(bitset verticesInCycle, bitset universalNeighbours){
+static boolean handleSimpleCycle(bitset verticesInCycle, bitset universalNeighbours){
     //if there is a universal neighbour then we have a wheel
     return universalNeighbours ? TRUE : FALSE;
 }
 
-boolean checkSimpleCycles_impl(
+static boolean checkSimpleCycles_impl(
             GRAPH graph, ADJACENCY adj, int firstVertex,
             int secondVertex, int currentVertex, bitset *verticesInCycle,
             bitset universalNeighbours, bitset neighbourhoods[]){
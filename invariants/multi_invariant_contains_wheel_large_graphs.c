@@ -16,16 +16,23 @@
  *     multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_bitset.c \
  *     multi_invariant_contains_wheel_large_graphs.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "../multicode/shared/multicode_bitset.h"
 #include <stdio.h>
 
-boolean verticesInCycle[MAXN+1];
-boolean neighbourhoods[MAXN+1][MAXN+1];
-boolean universalNeighbours[MAXN+1][MAXN+1];
+_Thread_local boolean verticesInCycle[MAXN+1];
+_Thread_local BITSET_ADJACENCY *neighbourhoods;
+//universal neighbours of the cycles of each size that are on the current path
+_Thread_local BITSET_WORD *universalNeighbours;
+
+#define UNIVERSAL_NEIGHBOURS(size) \
+    (universalNeighbours + (size_t)(size) * neighbourhoods->wordCount)
 
 boolean handleSimpleCycle(int universalNeighbourCount){
     //if there is a universal neighbour then we have a wheel
@@ -36,7 +43,7 @@ boolean checkSimpleCycles_impl(
             GRAPH graph, ADJACENCY adj, int firstVertex,
             int secondVertex, int currentVertex, int size,
             int universalNeighbourCount){
-    int i, w;
+    int i;
     for(i=0; i<adj[currentVertex]; i++){
         int neighbour = graph[currentVertex][i];
         if((neighbour != firstVertex) && verticesInCycle[neighbour]){
@@ -59,14 +66,9 @@ boolean checkSimpleCycles_impl(
             verticesInCycle[neighbour] = TRUE;
             
             //compute the new universal neighbours
-            int universalNeighbourCount = 0;
-            for(w = 1; w <= graph[0][0]; w++){
-                universalNeighbours[size + 1][w] = universalNeighbours[size][w] &&
-                        neighbourhoods[neighbour][w];
-                if(universalNeighbours[size + 1][w]){
-                    universalNeighbourCount++;
-                }
-            }
+            int universalNeighbourCount = intersectBitsets(
+                    UNIVERSAL_NEIGHBOURS(size + 1), UNIVERSAL_NEIGHBOURS(size),
+                    BITSET_ROW(neighbourhoods, neighbour), neighbourhoods->wordCount);
                 
             if(universalNeighbourCount && 
                     checkSimpleCycles_impl(graph, adj, firstVertex, secondVertex,
@@ -79,22 +81,10 @@ boolean checkSimpleCycles_impl(
     return FALSE;
 }
 
-/* Returns TRUE if the graph contains a wheel. Check all cycles and check whether
- * there is a central vertex adjacent to each vertex of the cycle.
- */
-boolean containsWheel(GRAPH graph, ADJACENCY adj){
-    int v, w, i;
+boolean containsWheel_impl(GRAPH graph, ADJACENCY adj){
+    int v, i;
     int order = graph[0][0];
     
-    for(v = 1; v <= order; v++){
-        for(w=1; w <= order; w++){
-            neighbourhoods[v][w] = FALSE;
-        }
-        for(i=0; i<adj[v]; i++){
-            neighbourhoods[v][graph[v][i]] = TRUE;
-        }
-    }
-    
     for(v = 1; v < order; v++){ //intentionally skip v==order!
         verticesInCycle[v] = TRUE;
         for(i=0; i<adj[v]; i++){
@@ -106,14 +96,9 @@ boolean containsWheel(GRAPH graph, ADJACENCY adj){
                 //start a cycle
                 verticesInCycle[neighbour] = TRUE;
                 
-                int universalNeighbourCount = 0;
-                for(w = 1; w <= order; w++){
-                    universalNeighbours[2][w] = neighbourhoods[v][w] &&
-                            neighbourhoods[neighbour][w];
-                    if(universalNeighbours[2][w]){
-                        universalNeighbourCount++;
-                    }
-                }
+                int universalNeighbourCount = intersectBitsets(
+                        UNIVERSAL_NEIGHBOURS(2), BITSET_ROW(neighbourhoods, v),
+                        BITSET_ROW(neighbourhoods, neighbour), neighbourhoods->wordCount);
                 if(universalNeighbourCount && 
                         checkSimpleCycles_impl(graph, adj, v, neighbour, neighbour,
                         2, universalNeighbourCount)){
@@ -126,3 +111,29 @@ boolean containsWheel(GRAPH graph, ADJACENCY adj){
     }
     return FALSE;
 }
+
+/* Returns TRUE if the graph contains a wheel. Check all cycles and check whether
+ * there is a central vertex adjacent to each vertex of the cycle.
+ */
+boolean containsWheel(GRAPH graph, ADJACENCY adj){
+    int v;
+    int order = graph[0][0];
+    boolean result;
+    
+    for(v = 1; v <= order; v++){
+        //a previous graph might have left vertices marked
+        verticesInCycle[v] = FALSE;
+    }
+    
+    neighbourhoods = newBitsetAdjacency();
+    buildBitsetAdjacency(graph, adj, neighbourhoods);
+    //a cycle contains at most order vertices
+    universalNeighbours = newBitsets(order + 1, neighbourhoods->wordCount);
+    
+    result = containsWheel_impl(graph, adj);
+    
+    free(universalNeighbours);
+    freeBitsetAdjacency(neighbourhoods);
+    
+    return result;
+}
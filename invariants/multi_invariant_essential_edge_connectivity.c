@@ -14,8 +14,10 @@
  *     multi_int_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
  *     connectivity/multi_connectivity.c \
+ *     connectivity/multi_flow.c \
  *     multi_invariant_order.c
  */
 
@@ -11,70 +11,46 @@
  * Compile like this:
  *     
  *     cc -o multi_invariant_hamiltonian_cycles -O4 -DINVARIANT=hamiltonianCycles \
- *     multi_int_invariant.c \
+ *     -DPARALLEL_SEARCH -pthread multi_int_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     hamiltonicity/multi_hamiltonian_search.c \
  *     multi_invariant_hamiltonian_cycles.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "hamiltonicity/multi_hamiltonian_search.h"
 #include <stdio.h>
+#include <stdlib.h>
 
-#if INVARIANT == hamiltonianCyclesEdgeIncidence
-#define CONSTRUCT_CYCLE
-#define HANDLE_CYCLE countCycleEdgeIncidence
-#endif
+#define EDGE_INCIDENCE(matrix, graph, v, w) (matrix)[(v)*((graph)[0][0] + 1) + (w)]
 
-#if INVARIANT == hamiltonianCyclesUniversalEdges
-#define CONSTRUCT_CYCLE
-#define HANDLE_CYCLE countCycleEdgeIncidence
-#endif
-
-#if INVARIANT == hamiltonianCyclesUncoveredEdges
-#define CONSTRUCT_CYCLE
-#define HANDLE_CYCLE countCycleEdgeIncidence
-#endif
-
-#ifndef HANDLE_CYCLE
-#define HANDLE_CYCLE countCycle
-#endif
-
-unsigned int cycleCount;
-boolean currentCycle[MAXN+1];
-
-//this array will only be filled if the macro CONSTRUCT_CYCLE is defined
-int currentCycleVertexOrder[MAXN];
-
-int cycleEdgeIncidence[MAXN][MAXN];
-
-void countCycle(GRAPH graph, ADJACENCY adj){
-    cycleCount++;
-}
-
-void countCycleEdgeIncidence(GRAPH graph, ADJACENCY adj){
-    int i;
-    
-    cycleCount++;
-    
-    for(i = 1; i < graph[0][0]; i++){
-        cycleEdgeIncidence[currentCycleVertexOrder[i-1]][currentCycleVertexOrder[i]]++;
-        cycleEdgeIncidence[currentCycleVertexOrder[i]][currentCycleVertexOrder[i-1]]++;
+//returns an (order+1)x(order+1) matrix which should be freed by the caller
+unsigned long long int *newCycleEdgeIncidence(GRAPH graph){
+    int order = graph[0][0];
+    unsigned long long int *cycleEdgeIncidence = (unsigned long long int *)calloc(
+            (order + 1)*(order + 1), sizeof(unsigned long long int));
+    if(cycleEdgeIncidence == NULL){
+        fprintf(stderr, "Insufficient memory for edge incidences -- exiting!\n");
+        exit(EXIT_FAILURE);
     }
-    cycleEdgeIncidence[currentCycleVertexOrder[0]][currentCycleVertexOrder[graph[0][0]-1]]++;
-    cycleEdgeIncidence[currentCycleVertexOrder[graph[0][0]-1]][currentCycleVertexOrder[0]]++;
-    
+    return cycleEdgeIncidence;
 }
 
-double processCycleEdgeIncidence(GRAPH graph, ADJACENCY adj){
+double processCycleEdgeIncidence(GRAPH graph, ADJACENCY adj,
+        unsigned long long int *cycleEdgeIncidence, unsigned long long int cycleCount){
     int i, j;
     int a = 0, b = 0;
     
     for(i = 1; i <= graph[0][0]; i++){
         for(j = 0; j < adj[i]; j++){
-            if(cycleEdgeIncidence[i][graph[i][j]] == cycleCount){
+            if(EDGE_INCIDENCE(cycleEdgeIncidence, graph, i, graph[i][j]) == cycleCount){
                 a++;
-            } else if(cycleEdgeIncidence[i][graph[i][j]] == 0){
+            } else if(EDGE_INCIDENCE(cycleEdgeIncidence, graph, i, graph[i][j]) == 0){
                 b++;
             }
         }
@@ -83,13 +59,14 @@ double processCycleEdgeIncidence(GRAPH graph, ADJACENCY adj){
     return 1.0*b/a;
 }
 
-int processCycleUniversalEdges(GRAPH graph, ADJACENCY adj){
+int processCycleUniversalEdges(GRAPH graph, ADJACENCY adj,
+        unsigned long long int *cycleEdgeIncidence, unsigned long long int cycleCount){
     int i, j;
     int a = 0;
     
     for(i = 1; i <= graph[0][0]; i++){
         for(j = 0; j < adj[i]; j++){
-            if(cycleEdgeIncidence[i][graph[i][j]] == cycleCount){
+            if(EDGE_INCIDENCE(cycleEdgeIncidence, graph, i, graph[i][j]) == cycleCount){
                 a++;
             }
         }
@@ -98,13 +75,14 @@ int processCycleUniversalEdges(GRAPH graph, ADJACENCY adj){
     return a/2;
 }
 
-int processCycleUncoveredEdges(GRAPH graph, ADJACENCY adj){
+int processCycleUncoveredEdges(GRAPH graph, ADJACENCY adj,
+        unsigned long long int *cycleEdgeIncidence){
     int i, j;
     int b = 0;
     
     for(i = 1; i <= graph[0][0]; i++){
         for(j = 0; j < adj[i]; j++){
-            if(cycleEdgeIncidence[i][graph[i][j]] == 0){
+            if(EDGE_INCIDENCE(cycleEdgeIncidence, graph, i, graph[i][j]) == 0){
                 b++;
             }
         }
@@ -113,158 +91,53 @@ int processCycleUncoveredEdges(GRAPH graph, ADJACENCY adj){
     return b/2;
 }
 
-/**
-  * 
-  */
-void continueCycle(GRAPH graph, ADJACENCY adj, int target, int next, int remaining) {
-    int i;
-    
-    if(target==next){
-        if(remaining==0){
-            HANDLE_CYCLE(graph, adj);
-        }
-        return;
-    }
-    
-#ifdef CONSTRUCT_CYCLE
-    currentCycleVertexOrder[graph[0][0]-remaining] = next;
-#endif
-    
-    for(i = 0; i < adj[next]; i++){
-        if(!currentCycle[graph[next][i]]){
-            currentCycle[graph[next][i]]=TRUE;
-            continueCycle(graph, adj, target, graph[next][i], remaining - 1);
-            currentCycle[graph[next][i]]=FALSE;
-        }
-    }
-    
-}
-
 int hamiltonianCycles(GRAPH graph, ADJACENCY adj){
-    int i, j;
-    int order = graph[0][0];
-    cycleCount = 0;
-    
-    for(i=0; i<=MAXN; i++){
-        currentCycle[i] = FALSE;
-    }
-    
-#ifdef CONSTRUCT_CYCLE
-    currentCycleVertexOrder[1] = 1;
-#endif
-    
-    currentCycle[1] = TRUE;
-    for(i = 1; i < adj[1]; i++){
-        currentCycle[graph[1][i]]=TRUE;
-        for(j = 0; j < i; j++){
-#ifdef CONSTRUCT_CYCLE
-            currentCycleVertexOrder[0] = graph[1][j];
-#endif
-            //search for cycle containing graph[1][i], 1,  graph[1][j]
-            continueCycle(graph, adj, graph[1][j], graph[1][i], order - 2);
-        }
-        currentCycle[graph[1][i]]=FALSE;
-    }
-    
-    return cycleCount;
+    return countHamiltonianCycles(graph, adj, 1, searchThreadCount, NULL);
 }
 
 double hamiltonianCyclesEdgeIncidence(GRAPH graph, ADJACENCY adj){
-    int i, j;
-    int order = graph[0][0];
-    cycleCount = 0;
-    
-    for(i=0; i<=MAXN; i++){
-        currentCycle[i] = FALSE;
-        for(j = 0; j <= MAXN; j++){
-            cycleEdgeIncidence[i][j] = 0;
-        }
-    }
-    
-    currentCycleVertexOrder[1] = 1;
-    
-    currentCycle[1] = TRUE;
-    for(i = 1; i < adj[1]; i++){
-        currentCycle[graph[1][i]]=TRUE;
-        for(j = 0; j < i; j++){
-            currentCycleVertexOrder[0] = graph[1][j];
-            //search for cycle containing graph[1][i], 1,  graph[1][j]
-            continueCycle(graph, adj, graph[1][j], graph[1][i], order - 2);
-        }
-        currentCycle[graph[1][i]]=FALSE;
-    }
+    unsigned long long int *cycleEdgeIncidence = newCycleEdgeIncidence(graph);
+    unsigned long long int cycleCount = countHamiltonianCycles(graph, adj, 1,
+            searchThreadCount, cycleEdgeIncidence);
     
+    double result = 0;
     if(cycleCount>0){
-        return processCycleEdgeIncidence(graph, adj);
-    } else {
-        return 0;
+        result = processCycleEdgeIncidence(graph, adj, cycleEdgeIncidence, cycleCount);
     }
+    free(cycleEdgeIncidence);
+    return result;
 }
 
 int hamiltonianCyclesUniversalEdges(GRAPH graph, ADJACENCY adj){
-    int i, j;
-    int order = graph[0][0];
-    cycleCount = 0;
-    
-    for(i=0; i<=MAXN; i++){
-        currentCycle[i] = FALSE;
-        for(j = 0; j <= MAXN; j++){
-            cycleEdgeIncidence[i][j] = 0;
-        }
-    }
-    
-    currentCycleVertexOrder[1] = 1;
-    
-    currentCycle[1] = TRUE;
-    for(i = 1; i < adj[1]; i++){
-        currentCycle[graph[1][i]]=TRUE;
-        for(j = 0; j < i; j++){
-            currentCycleVertexOrder[0] = graph[1][j];
-            //search for cycle containing graph[1][i], 1,  graph[1][j]
-            continueCycle(graph, adj, graph[1][j], graph[1][i], order - 2);
-        }
-        currentCycle[graph[1][i]]=FALSE;
-    }
+    unsigned long long int *cycleEdgeIncidence = newCycleEdgeIncidence(graph);
+    unsigned long long int cycleCount = countHamiltonianCycles(graph, adj, 1,
+            searchThreadCount, cycleEdgeIncidence);
     
+    int result = 0;
     if(cycleCount>0){
-        return processCycleUniversalEdges(graph, adj);
-    } else {
-        return 0;
+        result = processCycleUniversalEdges(graph, adj, cycleEdgeIncidence, cycleCount);
     }
+    free(cycleEdgeIncidence);
+    return result;
 }
 
 int hamiltonianCyclesUncoveredEdges(GRAPH graph, ADJACENCY adj){
-    int i, j;
+    int i;
     int order = graph[0][0];
-    cycleCount = 0;
-    
-    for(i=0; i<=MAXN; i++){
-        currentCycle[i] = FALSE;
-        for(j = 0; j <= MAXN; j++){
-            cycleEdgeIncidence[i][j] = 0;
-        }
-    }
-    
-    currentCycleVertexOrder[1] = 1;
-    
-    currentCycle[1] = TRUE;
-    for(i = 1; i < adj[1]; i++){
-        currentCycle[graph[1][i]]=TRUE;
-        for(j = 0; j < i; j++){
-            currentCycleVertexOrder[0] = graph[1][j];
-            //search for cycle containing graph[1][i], 1,  graph[1][j]
-            continueCycle(graph, adj, graph[1][j], graph[1][i], order - 2);
-        }
-        currentCycle[graph[1][i]]=FALSE;
-    }
+    unsigned long long int *cycleEdgeIncidence = newCycleEdgeIncidence(graph);
+    unsigned long long int cycleCount = countHamiltonianCycles(graph, adj, 1,
+            searchThreadCount, cycleEdgeIncidence);
     
+    int result;
     if(cycleCount>0){
-        return processCycleUncoveredEdges(graph, adj);
+        result = processCycleUncoveredEdges(graph, adj, cycleEdgeIncidence);
     } else {
         int edgeCount = 0;
         for(i = 1; i < order; i++){
             edgeCount += adj[i];
         }
-        return edgeCount/2;
+        result = edgeCount/2;
     }
-}
\ No newline at end of file
+    free(cycleEdgeIncidence);
+    return result;
+}
@@ -13,129 +13,37 @@
  * Compile like this:
  *     
  *     cc -o multi_invariant_is_2_leaf_stable -O4 -DINVARIANT=is2LeafStable \
- *     multi_boolean_invariant.c \
+ *     -DPARALLEL_SEARCH -DSEARCH_STATISTICS -pthread multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
- *     ../multicode/shared/multicode_output.c
+ *     ../multicode/shared/multicode_scanner.c \
+ *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     hamiltonicity/multi_hamiltonian_search.c \
+ *     hamiltonicity/multi_hamiltonian_pruning.c \
+ *     multi_invariant_is_2_leaf_stable.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "hamiltonicity/multi_hamiltonian_search.h"
 #include <stdio.h>
 
-boolean currentPath[MAXN+1];
-
-/**
-  * 
-  */
-boolean continuePathIncludingCheckForHamiltonianCycle(GRAPH graph, ADJACENCY adj, int last, int remaining, int startVertex, boolean *foundHamiltonianCycle) {
-    int i;
-    
-    if(remaining==0){
-        //we found a hamiltonian path, but we first check whether there is also a hamiltonian cycle
-        for(i = 0; i < adj[last]; i++){
-            if(graph[last][i] == startVertex){
-                *foundHamiltonianCycle = TRUE;
-            }
-        }
-        return TRUE;
-    }
-    
-    boolean traceable = FALSE;
-    for(i = 0; i < adj[last]; i++){
-        if(!currentPath[graph[last][i]]){
-            currentPath[graph[last][i]]=TRUE;
-            if(continuePathIncludingCheckForHamiltonianCycle(graph, adj, graph[last][i], remaining - 1, startVertex, foundHamiltonianCycle)){
-                if(*foundHamiltonianCycle){
-                    return TRUE;
-                } else {
-                    traceable = TRUE;
-                }
-            }
-            currentPath[graph[last][i]]=FALSE;
-        }
-    }
-    
-    return traceable;
-}
-
-/**
-  * 
-  */
-boolean continuePath(GRAPH graph, ADJACENCY adj, int last, int remaining) {
-    int i;
-    
-    if(remaining==0){
-        return TRUE;
-    }
-    
-    for(i = 0; i < adj[last]; i++){
-        if(!currentPath[graph[last][i]]){
-            currentPath[graph[last][i]]=TRUE;
-            if(continuePath(graph, adj, graph[last][i], remaining - 1)){
-                return TRUE;
-            }
-            currentPath[graph[last][i]]=FALSE;
-        }
-    }
-    
-    return FALSE;
-}
-
-boolean isTraceableFromVertexIncludingCheckForHamiltonianCycle_vertexDeleted(GRAPH graph, ADJACENCY adj, int startVertex, boolean *foundHamiltonianCycle, int deletedVertex){
-    int i;
-    
-    for(i=0; i<=MAXN; i++){
-        currentPath[i] = FALSE;
-    }
-    currentPath[deletedVertex] = TRUE;
-    boolean traceable = FALSE;
-    
-    currentPath[startVertex]=TRUE;
-    for(i = 0; i < adj[startVertex]; i++){
-        if(graph[startVertex][i]!=deletedVertex){
-            currentPath[graph[startVertex][i]]=TRUE;
-            //search for path containing the edge (startVertex, graph[startVertex][i])
-            if(continuePathIncludingCheckForHamiltonianCycle(graph, adj, graph[startVertex][i], graph[0][0] - 3, startVertex, foundHamiltonianCycle)){
-                if(*foundHamiltonianCycle){
-                    return TRUE;
-                } else {
-                    traceable = TRUE;
-                }
-            }
-            currentPath[graph[startVertex][i]]=FALSE;
-        }
-    }
-    currentPath[startVertex]=FALSE;
-    
-    return traceable;
-}
-
-
-boolean isTraceableFromVertex_vertexDeleted(GRAPH graph, ADJACENCY adj, int startVertex, int deletedVertex){
-    int i;
-    
-    for(i=0; i<=MAXN; i++){
-        currentPath[i] = FALSE;
-    }
-    currentPath[deletedVertex] = TRUE;
-    
-    currentPath[startVertex]=TRUE;
-    for(i = 0; i < adj[startVertex]; i++){
-        if(graph[startVertex][i]!=deletedVertex){
-            currentPath[graph[startVertex][i]]=TRUE;
-            //search for path containing the edge (startVertex, graph[startVertex][i])
-            if(continuePath(graph, adj, graph[startVertex][i], graph[0][0] - 3)){
-                return TRUE;
-            }
-            currentPath[graph[startVertex][i]]=FALSE;
-        }
+/* Returns TRUE if graph minus removedVertex (0 if no vertex is removed) is
+ * traceable but not hamiltonian.
+ */
+boolean isTraceableNotHamiltonian(GRAPH graph, ADJACENCY adj, int removedVertex,
+        HAMILTONIAN_PROBLEM *problem){
+    setCycleProblem(problem, graph, adj, removedVertex);
+    if(solveHamiltonianProblem(problem, searchThreadCount, NULL)){
+        return FALSE;
     }
-    currentPath[startVertex]=FALSE;
-    
-    return FALSE;
+    setPathProblem(problem, graph, adj, removedVertex);
+    return solveHamiltonianProblem(problem, searchThreadCount, NULL);
 }
 
-boolean removingVertexLeavesTraceableNotHamiltonian(GRAPH graph, ADJACENCY adj, int vertexToRemove){
+boolean removingVertexLeavesTraceableNotHamiltonian(GRAPH graph, ADJACENCY adj, int vertexToRemove,
+        HAMILTONIAN_PROBLEM *problem){
     int i;
     int order = graph[0][0];
     
@@ -148,7 +56,6 @@ boolean removingVertexLeavesTraceableNotHamiltonian(GRAPH graph, ADJACENCY adj,
     }
     
     int minDegree;
-    int minDegreeVertex;
     int minDegreeCount;
     
     //check conditions for Dirac's theorem
@@ -157,7 +64,6 @@ boolean removingVertexLeavesTraceableNotHamiltonian(GRAPH graph, ADJACENCY adj,
         if(i != vertexToRemove){
             if(adj[i] - degreeModification[i] < minDegree){
                 minDegree = adj[i] - degreeModification[i];
-                minDegreeVertex = i;
                 minDegreeCount = 1;
             } else if(adj[i] - degreeModification[i] == minDegree){
                 minDegreeCount++;
@@ -173,97 +79,14 @@ boolean removingVertexLeavesTraceableNotHamiltonian(GRAPH graph, ADJACENCY adj,
         return FALSE;
     }
     
-    if(minDegree == 1){
-        //graph is certainly not hamiltonian and hamiltonian path will start
-        //from vertex of degree 1
-        return isTraceableFromVertex_vertexDeleted(graph, adj, minDegreeVertex, vertexToRemove);
-    } else {
-        //graph might be hamiltonian
-        boolean foundHamiltonianCycle = FALSE;
-        int start = vertexToRemove == 1 ? 2 : 1;
-        boolean isTraceable = isTraceableFromVertexIncludingCheckForHamiltonianCycle_vertexDeleted(graph, adj, start, &foundHamiltonianCycle, vertexToRemove);
-        if(foundHamiltonianCycle){
-            return FALSE;
-        }
-        if(!isTraceable){
-            start++;
-            if(start==vertexToRemove){
-                start++;
-            }
-            /* we don't need to check the last vertex, since a hamiltonian path
-             * starting at that vertex would already have been found from the other
-             * end.
-             */
-            while(start < order && !isTraceableFromVertex_vertexDeleted(graph, adj, start, vertexToRemove)){
-                start++;
-                if(start==vertexToRemove){
-                    start++;
-                }
-            }
-            if(start >= order){
-                //graph is not traceable
-                return FALSE;
-            }
-        }
-    }
-    
-    
-    return TRUE;
-}
-
-
-boolean isTraceableFromVertexIncludingCheckForHamiltonianCycle(GRAPH graph, ADJACENCY adj, int startVertex, boolean *foundHamiltonianCycle){
-    int i;
-    
-    for(i=0; i<=MAXN; i++){
-        currentPath[i] = FALSE;
-    }
-    boolean traceable = FALSE;
-    
-    currentPath[startVertex]=TRUE;
-    for(i = 0; i < adj[startVertex]; i++){
-        currentPath[graph[startVertex][i]]=TRUE;
-        //search for path containing the edge (startVertex, graph[startVertex][i])
-        if(continuePathIncludingCheckForHamiltonianCycle(graph, adj, graph[startVertex][i], graph[0][0] - 2, startVertex, foundHamiltonianCycle)){
-            if(*foundHamiltonianCycle){
-                return TRUE;
-            } else {
-                traceable = TRUE;
-            }
-        }
-        currentPath[graph[startVertex][i]]=FALSE;
-    }
-    currentPath[startVertex]=FALSE;
-    
-    return traceable;
-}
-
-boolean isTraceableFromVertex(GRAPH graph, ADJACENCY adj, int startVertex){
-    int i;
-    
-    for(i=0; i<=MAXN; i++){
-        currentPath[i] = FALSE;
-    }
-    
-    currentPath[startVertex]=TRUE;
-    for(i = 0; i < adj[startVertex]; i++){
-        currentPath[graph[startVertex][i]]=TRUE;
-        //search for path containing the edge (startVertex, graph[startVertex][i])
-        if(continuePath(graph, adj, graph[startVertex][i], graph[0][0] - 2)){
-            return TRUE;
-        }
-        currentPath[graph[startVertex][i]]=FALSE;
-    }
-    currentPath[startVertex]=FALSE;
-    
-    return FALSE;
+    return isTraceableNotHamiltonian(graph, adj, vertexToRemove, problem);
 }
 
 boolean is2LeafStable(GRAPH graph, ADJACENCY adj){
     int i, v;
     int order = graph[0][0];
     int minDegree;
-    int minDegreeVertex;
+    boolean leafStable = TRUE;
     
     if(order<3){
         return FALSE;
@@ -274,7 +97,6 @@ boolean is2LeafStable(GRAPH graph, ADJACENCY adj){
     for(i = 1; i <= order; i++){
         if(adj[i] < minDegree){
             minDegree = adj[i];
-            minDegreeVertex = i;
         }
     }
     
@@ -287,36 +109,26 @@ boolean is2LeafStable(GRAPH graph, ADJACENCY adj){
         return FALSE;
     }
     
-    //check traceable but not hamiltonian
-    boolean foundHamiltonianCycle = FALSE;
-    boolean isTraceable = isTraceableFromVertexIncludingCheckForHamiltonianCycle(graph, adj, 1, &foundHamiltonianCycle);
-    if(foundHamiltonianCycle){
-        return FALSE;
-    }
-    if(!isTraceable){
-        int start = 2;
-        /* we don't need to check the last vertex, since a hamiltonian path
-         * starting at that vertex would already have been found from the other
-         * end.
-         */
-        while(start < order && !isTraceableFromVertex(graph, adj, start)){
-            start++;
-        }
-        if(start == order){
-            //graph is not traceable
-            return FALSE;
-        }
+    HAMILTONIAN_PROBLEM *problem = newHamiltonianProblem();
+    
+    //if removing a vertex disconnects the graph, the remaining graph is not traceable
+    setCycleProblem(problem, graph, adj, 0);
+    if(!passesConnectivityCheck(problem)){
+        leafStable = FALSE;
     }
     
-    //if we got here then the graph is traceable but not hamiltonian
+    //check traceable but not hamiltonian
+    if(leafStable){
+        leafStable = isTraceableNotHamiltonian(graph, adj, 0, problem);
+    }
     
     //try removing each vertex once and check that the resulting graph is 
     //traceable but not hamiltonian
-    for(v = 1; v <= order; v++){
-        if(!removingVertexLeavesTraceableNotHamiltonian(graph, adj, v)){
-            return FALSE;
-        }
+    for(v = 1; v <= order && leafStable; v++){
+        leafStable = removingVertexLeavesTraceableNotHamiltonian(graph, adj, v, problem);
     }
     
-    return TRUE;
+    freeHamiltonianProblem(problem);
+    
+    return leafStable;
 }
\ No newline at end of file
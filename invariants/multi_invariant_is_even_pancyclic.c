@@ -15,6 +15,7 @@
  *     multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
  *     multi_invariant_is_pancyclic.c
  */
@@ -23,12 +24,12 @@
 
 #include "../multicode/shared/multicode_base.h"
 
-boolean verticesInCycle[MAXN + 1];
+static _Thread_local boolean verticesInCycle[MAXN + 1];
 
-boolean observedCycleSizes[MAXN + 1];
-int largestMissingCycle, smallestMissingCycle;
+static _Thread_local boolean observedCycleSizes[MAXN + 1];
+static _Thread_local int largestMissingCycle, smallestMissingCycle;
 
-boolean handleSimpleCycle(int size){
+static boolean handleSimpleCycle(int size){
     if(largestMissingCycle == size && smallestMissingCycle == size){
         return TRUE;
     } else {
@@ -46,7 +47,7 @@ boolean handleSimpleCycle(int size){
     }
 }
 
-boolean checkSimpleCycles_impl(
+static boolean checkSimpleCycles_impl(
             GRAPH graph, ADJACENCY adj, int firstVertex,
             int secondVertex, int currentVertex, int size){
     int i;
@@ -88,6 +89,10 @@ boolean isEvenPancyclic(GRAPH graph, ADJACENCY adj){
     int v, i;
     int order = graph[0][0];
     
+    for(v = 1; v <= order; v++){
+        //a previous graph might have left vertices marked
+        verticesInCycle[v] = FALSE;
+    }
     for(v = 4; v <= order; v+=2){
         observedCycleSizes[v] = FALSE;
     }
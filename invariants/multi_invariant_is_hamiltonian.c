@@ -11,49 +11,27 @@
  * Compile like this:
  *     
  *     cc -o multi_invariant_is_hamiltonian -O4 -DINVARIANT=isHamiltonian \
- *     multi_boolean_invariant.c \
+ *     -DPARALLEL_SEARCH -pthread multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
- *     multi_invariant_hamiltonian_cycles.c
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     hamiltonicity/multi_hamiltonian_search.c \
+ *     hamiltonicity/multi_hamiltonian_pruning.c \
+ *     multi_invariant_is_hamiltonian.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "hamiltonicity/multi_hamiltonian_search.h"
 #include <stdio.h>
 
-boolean currentCycle[MAXN+1];
-
-/**
-  * 
-  */
-boolean continueCycle(GRAPH graph, ADJACENCY adj, int target, int next, int remaining) {
-    int i;
-    
-    if(target==next){
-        if(remaining==0){
-            return TRUE;
-        }
-        return FALSE;
-    }
-    
-    for(i = 0; i < adj[next]; i++){
-        if(!currentCycle[graph[next][i]]){
-            currentCycle[graph[next][i]]=TRUE;
-            if(continueCycle(graph, adj, target, graph[next][i], remaining - 1)){
-                return TRUE;
-            }
-            currentCycle[graph[next][i]]=FALSE;
-        }
-    }
-    
-    return FALSE;
-}
-
 boolean isHamiltonian(GRAPH graph, ADJACENCY adj){
-    int i, j;
+    int i;
     int order = graph[0][0];
     int minDegree;
-    int minDegreeVertex;
+    boolean hamiltonian;
     
     if(order<3){
         return FALSE;
@@ -64,7 +42,6 @@ boolean isHamiltonian(GRAPH graph, ADJACENCY adj){
     for(i = 1; i <= order; i++){
         if(adj[i] < minDegree){
             minDegree = adj[i];
-            minDegreeVertex = i;
         }
     }
     
@@ -75,21 +52,10 @@ boolean isHamiltonian(GRAPH graph, ADJACENCY adj){
     }
     
     //just look for a hamiltonian cycle
-    for(i=0; i<=MAXN; i++){
-        currentCycle[i] = FALSE;
-    }
-    
-    currentCycle[minDegreeVertex] = TRUE;
-    for(i = 1; i < adj[minDegreeVertex]; i++){
-        currentCycle[graph[minDegreeVertex][i]]=TRUE;
-        for(j = 0; j < i; j++){
-            //search for cycle containing graph[minDegreeVertex][i], minDegreeVertex,  graph[minDegreeVertex][j]
-            if(continueCycle(graph, adj, graph[minDegreeVertex][j], graph[minDegreeVertex][i], order - 2)){
-                return TRUE;
-            }
-        }
-        currentCycle[graph[minDegreeVertex][i]]=FALSE;
-    }
+    HAMILTONIAN_PROBLEM *problem = newHamiltonianProblem();
+    setCycleProblem(problem, graph, adj, 0);
+    hamiltonian = solveHamiltonianProblem(problem, searchThreadCount, NULL);
+    freeHamiltonianProblem(problem);
     
-    return FALSE;
+    return hamiltonian;
 }
\ No newline at end of file
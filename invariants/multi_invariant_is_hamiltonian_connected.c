@@ -6,41 +6,44 @@
  */
 
 /*
- * Computes whether a graph in multicode format is traceable (i.e., has a 
- * hamiltonian path)
+ * Computes whether a graph in multicode format is hamiltonian connected (i.e.,
+ * each pair of vertices is connected by a hamiltonian path)
  * 
  * Compile like this:
  *     
- *     cc -o multi_invariant_is_traceable -O4 -DINVARIANT=isTraceable \
- *     multi_boolean_invariant.c \
+ *     cc -o multi_invariant_is_hamiltonian_connected -O4 \
+ *     -DINVARIANT=isHamiltonianConnected \
+ *     -DPARALLEL_SEARCH -DSEARCH_STATISTICS -pthread multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
- *     multi_invariant_hamiltonian_cycles.c
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     hamiltonicity/multi_hamiltonian_search.c \
+ *     hamiltonicity/multi_hamiltonian_pruning.c \
+ *     multi_invariant_is_hamiltonian_connected.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "hamiltonicity/multi_hamiltonian_search.h"
 #include <stdio.h>
 #include <stdlib.h>
 
-boolean currentPath[MAXN+1];
-int pathSequence[MAXN];
-int pathLength;
-boolean *adjacency;
-boolean *connected;
+_Thread_local boolean *adjacency;
+_Thread_local boolean *connected;
 
-void foundPath(){
+void foundPath(int *path, int order){
     int i;
-    int order = pathLength;
-    int start = pathSequence[0];
-    int end = pathSequence[pathLength-1];
+    int start = path[0];
+    int end = path[order-1];
     if(adjacency[start*(order+1) + end]){
         //we found a hamiltonian cycle
         //all adjacent vertices on the cycle are hamiltonian connected
         connected[start*(order+1) + end] = connected[end*(order+1) + start] = TRUE;
-        for(i = 1; i < pathLength; i++){
-            int v1 = pathSequence[i-1];
-            int v2 = pathSequence[i];
+        for(i = 1; i < order; i++){
+            int v1 = path[i-1];
+            int v2 = path[i];
             connected[v1*(order+1) + v2] = connected[v2*(order+1) + v1] = TRUE;
         }
     } else {
@@ -48,74 +51,20 @@ void foundPath(){
     }
 }
 
-/**
-  * 
-  */
-boolean continuePath(GRAPH graph, ADJACENCY adj, int last, int targetVertex, int remaining) {
-    int i;
-    if(remaining > 0 && currentPath[targetVertex]){
-        return FALSE;
-    }
-    
-    if(remaining==0){
-        foundPath();
-        if(last==targetVertex){
-            return TRUE;
-        } else {
-            return FALSE;
-        }
-    }
-    
-    for(i = 0; i < adj[last]; i++){
-        if(!currentPath[graph[last][i]]){
-            currentPath[graph[last][i]]=TRUE;
-            pathSequence[pathLength] = graph[last][i];
-            pathLength++;
-            if(continuePath(graph, adj, graph[last][i], targetVertex, remaining - 1)){
-                return TRUE;
-            }
-            pathLength--;
-            currentPath[graph[last][i]]=FALSE;
-        }
-    }
-    
-    return FALSE;
-}
-
-boolean startPath(GRAPH graph, ADJACENCY adj, int startVertex, int targetVertex, int order){
-    int i;
-    
-    currentPath[startVertex]=TRUE;
-    for(i = 1; i < adj[startVertex]; i++){
-        currentPath[graph[startVertex][i]]=TRUE;
-        pathSequence[0] = startVertex;
-        pathSequence[1] = graph[startVertex][i];
-        pathLength = 2;
-        //search for path containing the edge (v, graph[v][i])
-        if(continuePath(graph, adj, graph[startVertex][i], targetVertex, order - 2)){
-            return TRUE;
-        }
-        currentPath[graph[startVertex][i]]=FALSE;
-    }
-    currentPath[startVertex]=FALSE;
-    
-    return FALSE;
-}
-
-boolean checkHamiltonianConnected(GRAPH graph, ADJACENCY adj){
-    int i, j, k;
+boolean checkHamiltonianConnected(GRAPH graph, ADJACENCY adj, HAMILTONIAN_PROBLEM *problem){
+    int i, j;
     int order = graph[0][0];
+    int path[order];
     
     for(i=1; i<= order-1; i++){
         for(j=i+1; j<= order; j++){
             if(!connected[i*(order+1)+j]){
-                for(k = 0; k < MAXN + 1; k++){
-                    currentPath[k] = FALSE;
-                }
-                if(!startPath(graph, adj, i, j, order)){
+                setPathBetweenProblem(problem, graph, adj, i, j);
+                if(!solveHamiltonianProblem(problem, searchThreadCount, path)){
                     fprintf(stderr, "not connected: %d - %d\n", i, j);
                     return FALSE;
                 }
+                foundPath(path, order);
             }
         }
     }
@@ -124,16 +73,14 @@ boolean checkHamiltonianConnected(GRAPH graph, ADJACENCY adj){
 }
 
 boolean isHamiltonianConnected(GRAPH graph, ADJACENCY adj){
-    int i, j;
+    int i, j, v;
     int order = graph[0][0];
     int minDegree;
-    int minDegreeVertex;
     
     minDegree = order;
     for(i = 1; i <= order; i++){
         if(adj[i] < minDegree){
             minDegree = adj[i];
-            minDegreeVertex = i;
         }
     }
     
@@ -142,8 +89,20 @@ boolean isHamiltonianConnected(GRAPH graph, ADJACENCY adj){
         return FALSE;
     }
     
+    HAMILTONIAN_PROBLEM *problem = newHamiltonianProblem();
+    
+    /* a hamiltonian connected graph is 3-connected: if removing two vertices
+     * disconnects the graph, there is no hamiltonian path between them
+     */
+    for(v = 1; v <= order && order > 3; v++){
+        setCycleProblem(problem, graph, adj, v);
+        if(!passesConnectivityCheck(problem)){
+            freeHamiltonianProblem(problem);
+            return FALSE;
+        }
+    }
+    
     //just look for a hamiltonian paths
-    //TODO: just a quick and dirty version: really should be optimised
     adjacency = (boolean *)malloc(sizeof(boolean)*(order+1)*(order+1));
     connected = (boolean *)malloc(sizeof(boolean)*(order+1)*(order+1));
     
@@ -157,10 +116,11 @@ boolean isHamiltonianConnected(GRAPH graph, ADJACENCY adj){
         }
     }
     
-    boolean hamiltonianConnected = checkHamiltonianConnected(graph, adj);
+    boolean hamiltonianConnected = checkHamiltonianConnected(graph, adj, problem);
     
     free(adjacency);
     free(connected);
+    freeHamiltonianProblem(problem);
     
     return hamiltonianConnected;
 }
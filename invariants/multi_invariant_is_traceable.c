@@ -12,71 +12,34 @@
  * Compile like this:
  *     
  *     cc -o multi_invariant_is_traceable -O4 -DINVARIANT=isTraceable \
- *     multi_boolean_invariant.c \
+ *     -DPARALLEL_SEARCH -DSEARCH_STATISTICS -pthread multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
- *     multi_invariant_hamiltonian_cycles.c
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     hamiltonicity/multi_hamiltonian_search.c \
+ *     hamiltonicity/multi_hamiltonian_pruning.c \
+ *     multi_invariant_is_traceable.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "hamiltonicity/multi_hamiltonian_search.h"
 #include <stdio.h>
 
-boolean currentPath[MAXN+1];
-
-/**
-  * 
-  */
-boolean continuePath(GRAPH graph, ADJACENCY adj, int last, int remaining) {
-    int i;
-    
-    if(remaining==0){
-        return TRUE;
-    }
-    
-    for(i = 0; i < adj[last]; i++){
-        if(!currentPath[graph[last][i]]){
-            currentPath[graph[last][i]]=TRUE;
-            if(continuePath(graph, adj, graph[last][i], remaining - 1)){
-                return TRUE;
-            }
-            currentPath[graph[last][i]]=FALSE;
-        }
-    }
-    
-    return FALSE;
-}
-
-boolean startPath(GRAPH graph, ADJACENCY adj, int startVertex, int order){
-    int i;
-    
-    currentPath[startVertex]=TRUE;
-    for(i = 1; i < adj[startVertex]; i++){
-        currentPath[graph[startVertex][i]]=TRUE;
-        //search for path containing the edge (v, graph[v][i])
-        if(continuePath(graph, adj, graph[startVertex][i], order - 2)){
-            return TRUE;
-        }
-        currentPath[graph[startVertex][i]]=FALSE;
-    }
-    currentPath[startVertex]=FALSE;
-    
-    return FALSE;
-}
-
 boolean isTraceable(GRAPH graph, ADJACENCY adj){
-    int i, v;
+    int i;
     int order = graph[0][0];
     int minDegree;
-    int minDegreeVertex;
     int minDegreeCount;
+    boolean traceable;
     
     //check conditions for Dirac's theorem
     minDegree = order;
     for(i = 1; i <= order; i++){
         if(adj[i] < minDegree){
             minDegree = adj[i];
-            minDegreeVertex = i;
             minDegreeCount = 1;
         } else if(adj[i] == minDegree){
             minDegreeCount++;
@@ -93,21 +56,10 @@ boolean isTraceable(GRAPH graph, ADJACENCY adj){
     }
     
     //just look for a hamiltonian path
-    for(i=0; i<=MAXN; i++){
-        currentPath[i] = FALSE;
-    }
-    
-    if(minDegree > 1){
-        for(v = 1; v < order; v++){
-            //we try to start the path from each vertex (except the last)
-            if(startPath(graph, adj, v, order)){
-                return TRUE;
-            }
-        }
-        return FALSE;
-    } else {
-        //if there is a degree 1 vertex, then any hamiltonian path will start with that vertex
-        return startPath(graph, adj, minDegreeVertex, order);
-    }
+    HAMILTONIAN_PROBLEM *problem = newHamiltonianProblem();
+    setPathProblem(problem, graph, adj, 0);
+    traceable = solveHamiltonianProblem(problem, searchThreadCount, NULL);
+    freeHamiltonianProblem(problem);
     
+    return traceable;
 }
\ No newline at end of file
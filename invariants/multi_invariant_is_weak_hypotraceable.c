@@ -13,80 +13,27 @@
  * Compile like this:
  *     
  *     cc -o multi_invariant_is_weak_hypotraceable -O4 -DINVARIANT=isWeakHypotraceable \
- *     multi_boolean_invariant.c \
+ *     -DPARALLEL_SEARCH -DSEARCH_STATISTICS -pthread multi_boolean_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
- *     multi_invariant_hamiltonian_cycles.c
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     hamiltonicity/multi_hamiltonian_search.c \
+ *     hamiltonicity/multi_hamiltonian_pruning.c \
+ *     multi_invariant_is_weak_hypotraceable.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "hamiltonicity/multi_hamiltonian_search.h"
 #include <stdio.h>
 
-boolean currentPath[MAXN+1];
-
-/**
-  * 
-  */
-boolean continuePath(GRAPH graph, ADJACENCY adj, int last, int remaining) {
-    int i;
-    
-    if(remaining==0){
-        return TRUE;
-    }
-    
-    for(i = 0; i < adj[last]; i++){
-        if(!currentPath[graph[last][i]]){
-            currentPath[graph[last][i]]=TRUE;
-            if(continuePath(graph, adj, graph[last][i], remaining - 1)){
-                return TRUE;
-            }
-            currentPath[graph[last][i]]=FALSE;
-        }
-    }
-    
-    return FALSE;
-}
-
-boolean startPath(GRAPH graph, ADJACENCY adj, int startVertex, int order){
-    int i;
-    //mark the start vertex as being in the path
-    currentPath[startVertex]=TRUE;
-    for(i = 0; i < adj[startVertex]; i++){
-        if(!currentPath[graph[startVertex][i]]){
-            currentPath[graph[startVertex][i]]=TRUE;
-            //search for path containing the edge (v, graph[v][i])
-            if(continuePath(graph, adj, graph[startVertex][i], order - 2)){
-                return TRUE;
-            }
-            currentPath[graph[startVertex][i]]=FALSE;
-        }
-    }
-    currentPath[startVertex]=FALSE;
-    
-    return FALSE;
-}
-
-boolean remainingGraphIsTraceable(GRAPH graph, ADJACENCY adj, int remainingOrder, int removedVertex){
-    int i;
-    
-    for(i = 1; i <= remainingOrder; i++){
-        if(i!=removedVertex){
-            //we try to start the path from each vertex (except the last)
-            if(startPath(graph, adj, i, remainingOrder)){
-                return TRUE;
-            }
-        }
-    }
-    return FALSE;
-}
-
 boolean isWeakHypotraceable(GRAPH graph, ADJACENCY adj){
     int i, v;
     int order = graph[0][0];
     int minDegree;
-    int minDegreeVertex;
-    int minDegreeCount;
+    boolean weakHypotraceable = TRUE;
     
     if(order < 3){
         //not well defined for graphs with less than 3 vertices
@@ -98,10 +45,6 @@ boolean isWeakHypotraceable(GRAPH graph, ADJACENCY adj){
     for(i = 1; i <= order; i++){
         if(adj[i] < minDegree){
             minDegree = adj[i];
-            minDegreeVertex = i;
-            minDegreeCount = 1;
-        } else if(adj[i] == minDegree){
-            minDegreeCount++;
         }
     }
     
@@ -117,20 +60,21 @@ boolean isWeakHypotraceable(GRAPH graph, ADJACENCY adj){
         return TRUE;
     }
     
+    HAMILTONIAN_PROBLEM *problem = newHamiltonianProblem();
+    
+    //if removing a vertex disconnects the graph, the remaining graph is not traceable
+    setCycleProblem(problem, graph, adj, 0);
+    if(!passesConnectivityCheck(problem)){
+        weakHypotraceable = FALSE;
+    }
+    
     //just look for a hamiltonian path in all graphs
-    for(v = 1; v <= order; v++){
-        //clear possible previous path
-        for(i=0; i<=MAXN; i++){
-            currentPath[i] = FALSE;
-        }
-        
-        currentPath[v] = TRUE;
-        //we mark v as visited, so it is as if it got removed
-        if(!remainingGraphIsTraceable(graph, adj, order-1, v)){
-            return FALSE;
-        }
-        currentPath[v] = FALSE;
+    for(v = 1; v <= order && weakHypotraceable; v++){
+        setPathProblem(problem, graph, adj, v);
+        weakHypotraceable = solveHamiltonianProblem(problem, searchThreadCount, NULL);
     }
-    return TRUE;
     
+    freeHamiltonianProblem(problem);
+    
+    return weakHypotraceable;
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
  *     multi_int_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
  *     multi_invariant_maximum_degree.c
  */
@@ -16,117 +16,37 @@
  *     -DINVARIANTNAME="vertex connectivity" multi_int_invariant.c \
  *     ../multicode/shared/multicode_base.c\
  *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
  *     ../multicode/shared/multicode_output.c \
+ *     connectivity/multi_flow.c \
  *     multi_invariant_vertex_connectivity.c
  */
 
 #include "../multicode/shared/multicode_base.h"
+#include "connectivity/multi_flow.h"
+#include <stdio.h>
+#include <stdlib.h>
 
-int directedGraph[2*(MAXN) + 1][2*(MAXN) + 1];
+//the network is reused for all graphs in the same thread
+_Thread_local FLOW_NETWORK *network = NULL;
 
-boolean currentPath[2*(MAXN)+1];
-
-boolean findPath_impl(GRAPH graph, ADJACENCY adj, int currentVertex, int target) {
-    int j;
-    int order = graph[0][0];
-    
-    currentPath[currentVertex]=TRUE;
-    if(currentVertex==target){
-        return TRUE;
-    }
-
-    if(currentVertex <= order){ //in-vertex
-
-        for(j = 0; j < adj[currentVertex]; j++){
-            int nextVertex = graph[currentVertex][j] + order;
-            if(directedGraph[currentVertex][nextVertex]>0 && !currentPath[nextVertex]){
-                directedGraph[currentVertex][nextVertex]--;
-                directedGraph[nextVertex][currentVertex]++;
-                if(findPath_impl(graph, adj, nextVertex, target)){
-                    return TRUE;
-                } else {
-                    directedGraph[currentVertex][nextVertex]++;
-                    directedGraph[nextVertex][currentVertex]--;
-                }
-            }
-        }           
-        int nextVertex = currentVertex + order;
-        if(directedGraph[currentVertex][nextVertex]>0 && !currentPath[nextVertex]){
-            directedGraph[currentVertex][nextVertex]--;
-            directedGraph[nextVertex][currentVertex]++;
-            if(findPath_impl(graph, adj, nextVertex, target)){
-                return TRUE;
-            } else {
-                directedGraph[currentVertex][nextVertex]++;
-                directedGraph[nextVertex][currentVertex]--;
-            }
-        }     
-
-    } else { //out-vertex
-
-        for(j = 0; j < adj[currentVertex - order]; j++){
-            int nextVertex = graph[currentVertex - order][j];
-            if(directedGraph[currentVertex][nextVertex]>0 && !currentPath[nextVertex]){
-                directedGraph[currentVertex][nextVertex]--;
-                directedGraph[nextVertex][currentVertex]++;
-                if(findPath_impl(graph, adj, nextVertex, target)){
-                    return TRUE;
-                } else {
-                    directedGraph[currentVertex][nextVertex]++;
-                    directedGraph[nextVertex][currentVertex]--;
-                }
-            }
-        }           
-        int nextVertex = currentVertex - order;
-        if(directedGraph[currentVertex][nextVertex]>0 && !currentPath[nextVertex]){
-            directedGraph[currentVertex][nextVertex]--;
-            directedGraph[nextVertex][currentVertex]++;
-            if(findPath_impl(graph, adj, nextVertex, target)){
-                return TRUE;
-            } else {
-                directedGraph[currentVertex][nextVertex]++;
-                directedGraph[nextVertex][currentVertex]--;
-            }
-        }     
-
-    }
-
-    currentPath[currentVertex]=FALSE;
-    return FALSE;
-}
-
-//try to find a path from the current vertex to the target
-boolean findPath(GRAPH graph, ADJACENCY adj, int currentVertex, int target) {
-    int i;
-    for(i = 1; i <= 2*(graph[0][0]); i++){
-        currentPath[i] = FALSE;
-    }
-    return findPath_impl(graph, adj, currentVertex, target);
-}
-
-
-//returns the minimum of the maxflow of the st-network and satisfied
-int findMaxFlowInSTNetwork(GRAPH graph, ADJACENCY adj, int source, int target, int satisfied){
+/* Each vertex v is split into an in-vertex v and an out-vertex v + order,
+ * joined by an arc with capacity 1. The arcs of the graph go from the
+ * out-vertex of one end to the in-vertex of the other end.
+ */
+void buildSplitNetwork(GRAPH graph, ADJACENCY adj){
     int i, j, order = graph[0][0];
     
-    //construct directed graph
-    for(i = 1; i <= 2*order; i++){
-        for(j = 1; j <= 2*order; j++){
-            directedGraph[i][j] = 0;
-        }
+    if(network == NULL){
+        network = newFlowNetwork();
     }
+    clearFlowNetwork(network, 2*order + 1);
     for(i=1; i<=order; i++){
         for(j = 0; j < adj[i]; j++){
-            directedGraph[i + order][graph[i][j]]++;
+            addArcPair(network, i + order, graph[i][j], 1, 0);
         }
-        directedGraph[i][i + order] = 1;
-        
-    }
-    int pathCount = 0;
-    while(findPath(graph, adj, source + order, target) && pathCount < satisfied){
-        pathCount++;
+        addArcPair(network, i, i + order, 1, 0);
     }
-    return pathCount;
 }
 
 int vertex_connectivity(GRAPH graph, ADJACENCY adj){
@@ -141,11 +61,14 @@ int vertex_connectivity(GRAPH graph, ADJACENCY adj){
         }
     }
     
+    buildSplitNetwork(graph, adj);
+    
     int minimumCutSize = minDeg;
     for(i = 1; i <= minimumCutSize + 1; i++){
         for(j = i; j <= graph[0][0]; j++){
-            minimumCutSize = findMaxFlowInSTNetwork(graph, adj, i, j, minimumCutSize);
+            minimumCutSize = findMaxFlow(network, i + graph[0][0], j, minimumCutSize);
         }
     }
+    
     return minimumCutSize;
-}
\ No newline at end of file
+}
@@ -0,0 +1,807 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* This program reads graphs in multicode format from standard in and
+ * computes several invariants in a single pass over the input. For each
+ * graph a row with the values of the selected invariants is written to
+ * standard out. With a filter only the graphs that satisfy the filter are
+ * kept.
+ *
+ * Each graph is decoded once and each invariant is computed at most once
+ * per graph, no matter how often it appears in the columns and the filter.
+ * The order, the size and the degrees are computed together in a single
+ * pass over the graph.
+ *
+ * Compile with:
+ *
+ *     cc -o multi_invariants -O4 -pthread multi_invariants.c \
+ *     ../multicode/shared/multicode_base.c \
+ *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
+ *     ../multicode/shared/multicode_output.c \
+ *     ../multicode/shared/multicode_parallel.c \
+ *     ../multicode/shared/multicode_pipeline.c \
+ *     ../multicode/shared/multicode_girth.c \
+ *     ../multicode/shared/multicode_bitset.c \
+ *     connectivity/multi_connectivity.c connectivity/multi_flow.c \
+ *     colouring/multi_colouring.c matchings/multi_perfect_matchings.c \
+ *     hamiltonicity/multi_hamiltonian_search.c \
+ *     hamiltonicity/multi_hamiltonian_pruning.c \
+ *     multi_invariant_girth.c multi_invariant_vertex_connectivity.c \
+ *     multi_invariant_edge_connectivity.c \
+ *     multi_invariant_essential_edge_connectivity.c \
+ *     multi_invariant_chromatic_number.c \
+ *     multi_invariant_number_of_perfect_matchings.c \
+ *     multi_invariant_hamiltonian_cycles.c multi_invariant_is_hamiltonian.c \
+ *     multi_invariant_is_traceable.c multi_invariant_is_hamiltonian_connected.c \
+ *     multi_invariant_is_weak_hypotraceable.c multi_invariant_is_2_leaf_stable.c \
+ *     multi_invariant_is_pancyclic.c multi_invariant_is_even_pancyclic.c \
+ *     multi_invariant_contains_wheel.c -lm
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <getopt.h>
+
+#include "../multicode/shared/multicode_base.h"
+#include "../multicode/shared/multicode_input.h"
+#include "../multicode/shared/multicode_output.h"
+#include "../multicode/shared/multicode_parallel.h"
+#include "matchings/multi_perfect_matchings.h"
+
+//====================== INVARIANTS =======================
+
+int girth(GRAPH graph, ADJACENCY adj);
+int vertex_connectivity(GRAPH graph, ADJACENCY adj);
+int edge_connectivity(GRAPH graph, ADJACENCY adj);
+int essential_edge_connectivity(GRAPH graph, ADJACENCY adj);
+int chromaticNumber(GRAPH graph, ADJACENCY adj);
+MATCHING_COUNT numberPM(GRAPH graph, ADJACENCY adj);
+int hamiltonianCycles(GRAPH graph, ADJACENCY adj);
+double hamiltonianCyclesEdgeIncidence(GRAPH graph, ADJACENCY adj);
+int hamiltonianCyclesUniversalEdges(GRAPH graph, ADJACENCY adj);
+int hamiltonianCyclesUncoveredEdges(GRAPH graph, ADJACENCY adj);
+boolean isHamiltonian(GRAPH graph, ADJACENCY adj);
+boolean isTraceable(GRAPH graph, ADJACENCY adj);
+boolean isHamiltonianConnected(GRAPH graph, ADJACENCY adj);
+boolean isWeakHypotraceable(GRAPH graph, ADJACENCY adj);
+boolean is2LeafStable(GRAPH graph, ADJACENCY adj);
+boolean isPancyclic(GRAPH graph, ADJACENCY adj);
+boolean isEvenPancyclic(GRAPH graph, ADJACENCY adj);
+boolean containsWheel(GRAPH graph, ADJACENCY adj);
+
+/* The order, the size and the degrees of the current graph. These are
+ * computed together the first time one of them is needed.
+ */
+typedef struct {
+    boolean computed;
+    int order;
+    int size;
+    int minimumDegree;
+    int maximumDegree;
+} DEGREE_SUMMARY;
+
+_Thread_local DEGREE_SUMMARY degrees;
+
+DEGREE_SUMMARY *getDegreeSummary(GRAPH graph, ADJACENCY adj){
+    int i;
+
+    if(!degrees.computed){
+        degrees.order = graph[0][0];
+        degrees.size = 0;
+        degrees.minimumDegree = degrees.order ? adj[1] : 0;
+        degrees.maximumDegree = 0;
+        for(i = 1; i <= degrees.order; i++){
+            degrees.size += adj[i];
+            if(adj[i] < degrees.minimumDegree){
+                degrees.minimumDegree = adj[i];
+            }
+            if(adj[i] > degrees.maximumDegree){
+                degrees.maximumDegree = adj[i];
+            }
+        }
+        degrees.size /= 2;
+        degrees.computed = TRUE;
+    }
+
+    return &degrees;
+}
+
+int order(GRAPH graph, ADJACENCY adj){
+    return getDegreeSummary(graph, adj)->order;
+}
+
+int size(GRAPH graph, ADJACENCY adj){
+    return getDegreeSummary(graph, adj)->size;
+}
+
+int minimumDegree(GRAPH graph, ADJACENCY adj){
+    return getDegreeSummary(graph, adj)->minimumDegree;
+}
+
+int maximumDegree(GRAPH graph, ADJACENCY adj){
+    return getDegreeSummary(graph, adj)->maximumDegree;
+}
+
+boolean isOverfull(GRAPH graph, ADJACENCY adj){
+    DEGREE_SUMMARY *summary = getDegreeSummary(graph, adj);
+    return (summary->order % 2) &&
+            2*summary->size > (summary->order - 1)*summary->maximumDegree;
+}
+
+#define INT_VALUE 0
+#define BOOLEAN_VALUE 1
+#define COUNT_VALUE 2
+#define REAL_VALUE 3
+
+/* The cost is a rough class of how expensive an invariant is. Within a
+ * conjunction or disjunction in a filter, the cheapest operands are
+ * evaluated first.
+ */
+typedef struct {
+    char *name;
+    int type;
+    int cost;
+    int (*intInvariant)(GRAPH graph, ADJACENCY adj); //INT_VALUE and BOOLEAN_VALUE
+    MATCHING_COUNT (*countInvariant)(GRAPH graph, ADJACENCY adj);
+    double (*realInvariant)(GRAPH graph, ADJACENCY adj);
+    char *description;
+} INVARIANT_ENTRY;
+
+INVARIANT_ENTRY invariants[] = {
+    {"order", INT_VALUE, 0, order, NULL, NULL, "number of vertices"},
+    {"size", INT_VALUE, 0, size, NULL, NULL, "number of edges"},
+    {"min_degree", INT_VALUE, 0, minimumDegree, NULL, NULL, "minimum degree"},
+    {"max_degree", INT_VALUE, 0, maximumDegree, NULL, NULL, "maximum degree"},
+    {"overfull", BOOLEAN_VALUE, 0, isOverfull, NULL, NULL, "overfull"},
+    {"girth", INT_VALUE, 1, girth, NULL, NULL, "girth (the order for acyclic graphs)"},
+    {"vertex_connectivity", INT_VALUE, 2, vertex_connectivity, NULL, NULL, "vertex connectivity"},
+    {"edge_connectivity", INT_VALUE, 2, edge_connectivity, NULL, NULL, "edge connectivity"},
+    {"essential_edge_connectivity", INT_VALUE, 2, essential_edge_connectivity, NULL, NULL,
+            "essential edge connectivity"},
+    {"chromatic_number", INT_VALUE, 3, chromaticNumber, NULL, NULL, "chromatic number"},
+    {"perfect_matchings", COUNT_VALUE, 3, NULL, numberPM, NULL, "number of perfect matchings"},
+    {"hamiltonian", BOOLEAN_VALUE, 3, isHamiltonian, NULL, NULL, "hamiltonian"},
+    {"traceable", BOOLEAN_VALUE, 3, isTraceable, NULL, NULL, "traceable"},
+    {"hamiltonian_cycles", INT_VALUE, 4, hamiltonianCycles, NULL, NULL,
+            "number of hamiltonian cycles"},
+    {"hamiltonian_edge_incidence", REAL_VALUE, 4, NULL, NULL, hamiltonianCyclesEdgeIncidence,
+            "edges in no hamiltonian cycle per edge in all hamiltonian cycles"},
+    {"hamiltonian_universal_edges", INT_VALUE, 4, hamiltonianCyclesUniversalEdges, NULL, NULL,
+            "number of edges that lie in all hamiltonian cycles"},
+    {"hamiltonian_uncovered_edges", INT_VALUE, 4, hamiltonianCyclesUncoveredEdges, NULL, NULL,
+            "number of edges that do not lie in any hamiltonian cycle"},
+    {"hamiltonian_connected", BOOLEAN_VALUE, 4, isHamiltonianConnected, NULL, NULL,
+            "hamiltonian connected"},
+    {"weak_hypotraceable", BOOLEAN_VALUE, 4, isWeakHypotraceable, NULL, NULL, "weak hypotraceable"},
+    {"two_leaf_stable", BOOLEAN_VALUE, 4, is2LeafStable, NULL, NULL, "2-leaf-stable"},
+    {"pancyclic", BOOLEAN_VALUE, 4, isPancyclic, NULL, NULL, "pancyclic"},
+    {"even_pancyclic", BOOLEAN_VALUE, 4, isEvenPancyclic, NULL, NULL, "even pancyclic"},
+    {"contains_wheel", BOOLEAN_VALUE, 4, containsWheel, NULL, NULL,
+            "contains a wheel as a subgraph (up to 63 vertices)"}
+};
+
+#define INVARIANT_COUNT ((int)(sizeof(invariants)/sizeof(INVARIANT_ENTRY)))
+
+typedef struct {
+    long long int number; //INT_VALUE and BOOLEAN_VALUE
+    MATCHING_COUNT count;
+    double real;
+} VALUE;
+
+//the values that have already been computed for the current graph
+_Thread_local VALUE values[INVARIANT_COUNT];
+_Thread_local boolean computed[INVARIANT_COUNT];
+
+void startGraph(){
+    int i;
+    for(i = 0; i < INVARIANT_COUNT; i++){
+        computed[i] = FALSE;
+    }
+    degrees.computed = FALSE;
+}
+
+VALUE *getValue(int invariant, GRAPH graph, ADJACENCY adj){
+    if(!computed[invariant]){
+        INVARIANT_ENTRY *entry = invariants + invariant;
+        if(entry->type == COUNT_VALUE){
+            values[invariant].count = entry->countInvariant(graph, adj);
+        } else if(entry->type == REAL_VALUE){
+            values[invariant].real = entry->realInvariant(graph, adj);
+        } else {
+            values[invariant].number = entry->intInvariant(graph, adj);
+        }
+        computed[invariant] = TRUE;
+    }
+    return values + invariant;
+}
+
+int findInvariant(char *name, int length){
+    int i;
+    for(i = 0; i < INVARIANT_COUNT; i++){
+        if(strlen(invariants[i].name) == (size_t)length &&
+                !strncmp(invariants[i].name, name, length)){
+            return i;
+        }
+    }
+    return -1;
+}
+
+//====================== FILTER =======================
+
+/* A filter is an expression like
+ *
+ *     girth>=5 && !hamiltonian
+ *
+ * An invariant on its own is true if its value is not zero. Comparisons use
+ * ==, !=, <, <=, > and >=, and can be combined with !, &&, || and
+ * parentheses. && binds stronger than ||.
+ */
+
+#define COMPARISON_NODE 0
+#define NOT_NODE 1
+#define AND_NODE 2
+#define OR_NODE 3
+
+#define NONZERO 0
+#define EQUAL 1
+#define NOT_EQUAL 2
+#define LESS 3
+#define LESS_OR_EQUAL 4
+#define GREATER 5
+#define GREATER_OR_EQUAL 6
+
+typedef struct _expression EXPRESSION;
+
+struct _expression {
+    int type;
+    int cost; //the largest cost of an invariant in this expression
+
+    //only for comparisons
+    int invariant;
+    int operator;
+    long double constant;
+
+    //the operands of a negation, a conjunction or a disjunction
+    EXPRESSION **children;
+    int childCount;
+};
+
+char *filterText;
+int filterPosition;
+
+void filterError(char *message){
+    fprintf(stderr, "Error in filter at position %d: %s.\n", filterPosition + 1, message);
+    fprintf(stderr, "%s\n%*s^\n", filterText, filterPosition, "");
+    exit(EXIT_FAILURE);
+}
+
+void skipSpaces(){
+    while(isspace((unsigned char)filterText[filterPosition])){
+        filterPosition++;
+    }
+}
+
+/* Skips the spaces and then the token if it is next. Returns TRUE if the
+ * token was skipped.
+ */
+boolean acceptToken(char *token){
+    skipSpaces();
+    if(!strncmp(filterText + filterPosition, token, strlen(token))){
+        filterPosition += strlen(token);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+EXPRESSION *newExpression(int type){
+    EXPRESSION *expression = (EXPRESSION *)calloc(1, sizeof(EXPRESSION));
+    if(expression == NULL){
+        fprintf(stderr, "Insufficient memory for filter -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    expression->type = type;
+    return expression;
+}
+
+void addChild(EXPRESSION *expression, EXPRESSION *child){
+    expression->children = (EXPRESSION **)realloc(expression->children,
+            (expression->childCount + 1) * sizeof(EXPRESSION *));
+    if(expression->children == NULL){
+        fprintf(stderr, "Insufficient memory for filter -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    expression->children[expression->childCount++] = child;
+    if(child->cost > expression->cost){
+        expression->cost = child->cost;
+    }
+}
+
+EXPRESSION *parseDisjunction();
+
+EXPRESSION *parseComparison(){
+    static char *operators[] = {"==", "!=", "<=", ">=", "<", ">"};
+    static int operatorCodes[] = {EQUAL, NOT_EQUAL, LESS_OR_EQUAL,
+                                  GREATER_OR_EQUAL, LESS, GREATER};
+    EXPRESSION *expression;
+    int start, i;
+
+    skipSpaces();
+    start = filterPosition;
+    while(isalnum((unsigned char)filterText[filterPosition]) ||
+            filterText[filterPosition] == '_'){
+        filterPosition++;
+    }
+    if(start == filterPosition){
+        filterError("expected the name of an invariant");
+    }
+
+    expression = newExpression(COMPARISON_NODE);
+    expression->invariant = findInvariant(filterText + start, filterPosition - start);
+    if(expression->invariant < 0){
+        filterPosition = start;
+        filterError("unknown invariant (use -l to list the invariants)");
+    }
+    expression->cost = invariants[expression->invariant].cost;
+    expression->operator = NONZERO;
+
+    for(i = 0; i < 6; i++){
+        if(acceptToken(operators[i])){
+            char *end;
+            expression->operator = operatorCodes[i];
+            skipSpaces();
+            expression->constant = strtold(filterText + filterPosition, &end);
+            if(end == filterText + filterPosition){
+                filterError("expected a number");
+            }
+            filterPosition = end - filterText;
+            break;
+        }
+    }
+
+    return expression;
+}
+
+EXPRESSION *parseNegation(){
+    if(acceptToken("!")){
+        EXPRESSION *expression = newExpression(NOT_NODE);
+        addChild(expression, parseNegation());
+        return expression;
+    } else if(acceptToken("(")){
+        EXPRESSION *expression = parseDisjunction();
+        if(!acceptToken(")")){
+            filterError("expected )");
+        }
+        return expression;
+    } else {
+        return parseComparison();
+    }
+}
+
+EXPRESSION *parseConjunction(){
+    EXPRESSION *first = parseNegation();
+    EXPRESSION *expression;
+
+    if(!acceptToken("&&")){
+        return first;
+    }
+    expression = newExpression(AND_NODE);
+    addChild(expression, first);
+    do {
+        addChild(expression, parseNegation());
+    } while(acceptToken("&&"));
+
+    return expression;
+}
+
+EXPRESSION *parseDisjunction(){
+    EXPRESSION *first = parseConjunction();
+    EXPRESSION *expression;
+
+    if(!acceptToken("||")){
+        return first;
+    }
+    expression = newExpression(OR_NODE);
+    addChild(expression, first);
+    do {
+        addChild(expression, parseConjunction());
+    } while(acceptToken("||"));
+
+    return expression;
+}
+
+/* Sorts the operands of each conjunction and disjunction such that the
+ * cheapest operands are evaluated first. The sort is stable, so operands
+ * with the same cost keep the order in which they were given. This does not
+ * change the result since evaluating an invariant has no side effects.
+ */
+void orderByCost(EXPRESSION *expression){
+    int i, j;
+
+    for(i = 0; i < expression->childCount; i++){
+        orderByCost(expression->children[i]);
+    }
+    for(i = 1; i < expression->childCount; i++){
+        EXPRESSION *child = expression->children[i];
+        for(j = i; j > 0 && expression->children[j-1]->cost > child->cost; j--){
+            expression->children[j] = expression->children[j-1];
+        }
+        expression->children[j] = child;
+    }
+}
+
+EXPRESSION *parseFilter(char *text){
+    EXPRESSION *expression;
+
+    filterText = text;
+    filterPosition = 0;
+    expression = parseDisjunction();
+    skipSpaces();
+    if(filterText[filterPosition]){
+        filterError("unexpected character");
+    }
+    orderByCost(expression);
+
+    return expression;
+}
+
+void freeExpression(EXPRESSION *expression){
+    int i;
+    for(i = 0; i < expression->childCount; i++){
+        freeExpression(expression->children[i]);
+    }
+    free(expression->children);
+    free(expression);
+}
+
+long double valueAsNumber(int invariant, VALUE *value){
+    switch(invariants[invariant].type){
+        case COUNT_VALUE:
+            return (long double)value->count;
+        case REAL_VALUE:
+            return value->real;
+        default:
+            return value->number;
+    }
+}
+
+/* Evaluates the expression for the current graph. Conjunctions and
+ * disjunctions stop as soon as their value is known, so the invariants in
+ * the remaining operands are not computed.
+ */
+boolean evaluateExpression(EXPRESSION *expression, GRAPH graph, ADJACENCY adj){
+    long double value;
+    int i;
+
+    switch(expression->type){
+        case NOT_NODE:
+            return !evaluateExpression(expression->children[0], graph, adj);
+        case AND_NODE:
+            for(i = 0; i < expression->childCount; i++){
+                if(!evaluateExpression(expression->children[i], graph, adj)){
+                    return FALSE;
+                }
+            }
+            return TRUE;
+        case OR_NODE:
+            for(i = 0; i < expression->childCount; i++){
+                if(evaluateExpression(expression->children[i], graph, adj)){
+                    return TRUE;
+                }
+            }
+            return FALSE;
+    }
+
+    value = valueAsNumber(expression->invariant,
+            getValue(expression->invariant, graph, adj));
+    switch(expression->operator){
+        case EQUAL:
+            return value == expression->constant;
+        case NOT_EQUAL:
+            return value != expression->constant;
+        case LESS:
+            return value < expression->constant;
+        case LESS_OR_EQUAL:
+            return value <= expression->constant;
+        case GREATER:
+            return value > expression->constant;
+        case GREATER_OR_EQUAL:
+            return value >= expression->constant;
+        default:
+            return value != 0;
+    }
+}
+
+//====================== EVALUATION =======================
+
+int *columns = NULL;
+int columnCount = 0;
+
+EXPRESSION *filter = NULL;
+char separator = '\t';
+
+int graphCount = 0;
+int graphsFiltered = 0;
+
+//only used when the invariants are computed by several threads
+GRAPH *outputGraph;
+ADJACENCY *outputAdj;
+
+#define COUNT_DIGITS 40
+
+/* Writes the decimal representation of value to buffer, which should have
+ * room for COUNT_DIGITS characters, and returns buffer.
+ */
+char *countToString(MATCHING_COUNT value, char *buffer){
+    char digits[COUNT_DIGITS];
+    int length = 0, i;
+
+    do {
+        digits[length++] = '0' + (int)(value % 10);
+        value /= 10;
+    } while(value > 0);
+    for(i = 0; i < length; i++){
+        buffer[i] = digits[length - 1 - i];
+    }
+    buffer[length] = '\0';
+
+    return buffer;
+}
+
+/* The result for a graph is whether it passes the filter, followed by the
+ * values of the columns.
+ */
+size_t resultSize(){
+    return (columnCount + 1) * sizeof(VALUE);
+}
+
+void evaluateGraph(GRAPH graph, ADJACENCY adj, void *result){
+    VALUE *resultValues = (VALUE *)result;
+    int i;
+
+    startGraph();
+    resultValues[0].number = filter == NULL || evaluateExpression(filter, graph, adj);
+    if(resultValues[0].number){
+        for(i = 0; i < columnCount; i++){
+            resultValues[i + 1] = *getValue(columns[i], graph, adj);
+        }
+    }
+}
+
+void writeHeader(){
+    int i;
+    fprintf(stdout, "graph");
+    for(i = 0; i < columnCount; i++){
+        fprintf(stdout, "%c%s", separator, invariants[columns[i]].name);
+    }
+    fprintf(stdout, "\n");
+}
+
+void writeRow(VALUE *resultValues){
+    char buffer[COUNT_DIGITS];
+    int i;
+
+    fprintf(stdout, "%d", graphCount);
+    for(i = 0; i < columnCount; i++){
+        VALUE *value = resultValues + i + 1;
+        switch(invariants[columns[i]].type){
+            case COUNT_VALUE:
+                fprintf(stdout, "%c%s", separator, countToString(value->count, buffer));
+                break;
+            case REAL_VALUE:
+                fprintf(stdout, "%c%f", separator, value->real);
+                break;
+            default:
+                fprintf(stdout, "%c%lld", separator, value->number);
+        }
+    }
+    fprintf(stdout, "\n");
+}
+
+/* Handles the result for the next graph in the input. The graph is only
+ * used when it is written to the output.
+ */
+void handleValues(GRAPH graph, ADJACENCY adj, VALUE *resultValues){
+    graphCount++;
+
+    if(!resultValues[0].number){
+        return;
+    }
+    graphsFiltered++;
+    if(columnCount){
+        writeRow(resultValues);
+    } else {
+        writeMultiCode(graph, adj, stdout);
+    }
+}
+
+void handleResult(unsigned short *code, int length, void *result){
+    VALUE *resultValues = (VALUE *)result;
+
+    if(resultValues[0].number && !columnCount){
+        decodeMultiCode(code, length, *outputGraph, *outputAdj);
+    }
+    handleValues(*outputGraph, *outputAdj, resultValues);
+}
+
+//====================== USAGE =======================
+
+void listInvariants(){
+    int i;
+    fprintf(stderr, "Available invariants\n====================\n");
+    for(i = 0; i < INVARIANT_COUNT; i++){
+        fprintf(stderr, "    %-28s %s%s\n", invariants[i].name, invariants[i].description,
+                invariants[i].type == BOOLEAN_VALUE ? " (1 or 0)" : "");
+    }
+}
+
+void help(char *name) {
+    fprintf(stderr, "The program %s computes several invariants for graphs in multicode\n", name);
+    fprintf(stderr, "format in a single pass over the input.\n\n");
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options] [invariant ...]\n\n", name);
+    fprintf(stderr, "For each graph a row with the number of the graph and the values of the\n");
+    fprintf(stderr, "given invariants is written, separated by tabs. If no invariants are given,\n");
+    fprintf(stderr, "then a filter is required and the graphs that pass it are written in\n");
+    fprintf(stderr, "multicode format.\n");
+    fprintf(stderr, "\nThis program can handle graphs up to %d vertices. Recompile if you need larger\n", MAXN);
+    fprintf(stderr, "graphs.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -f expression, --filter expression\n");
+    fprintf(stderr, "       Only keep the graphs for which the expression is true, e.g.,\n");
+    fprintf(stderr, "       'girth>=5 && !hamiltonian'. An invariant on its own is true if its\n");
+    fprintf(stderr, "       value is not zero. Comparisons use ==, !=, <, <=, > and >=, and can\n");
+    fprintf(stderr, "       be combined with !, &&, || and parentheses. Cheap invariants are\n");
+    fprintf(stderr, "       evaluated first and the evaluation stops as soon as the result is\n");
+    fprintf(stderr, "       known.\n");
+    fprintf(stderr, "    -c, --csv\n");
+    fprintf(stderr, "       Separate the values by commas instead of tabs.\n");
+    fprintf(stderr, "    -H, --no-header\n");
+    fprintf(stderr, "       Do not write a header with the names of the invariants.\n");
+    fprintf(stderr, "    -t #, --threads #\n");
+    fprintf(stderr, "       Compute the invariants with the specified number of threads. The\n");
+    fprintf(stderr, "       output is the same as when using a single thread.\n");
+    fprintf(stderr, "    -l, --list\n");
+    fprintf(stderr, "       List the available invariants and return.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options] [invariant ...]\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+
+    GRAPH graph;
+    ADJACENCY adj;
+
+    int threadCount = 1;
+    boolean writeHeaderRow = TRUE;
+    int i;
+
+    /*=========== commandline parsing ===========*/
+
+    int c;
+    char *name = argv[0];
+    static struct option long_options[] = {
+        {"filter", required_argument, NULL, 'f'},
+        {"csv", no_argument, NULL, 'c'},
+        {"no-header", no_argument, NULL, 'H'},
+        {"threads", required_argument, NULL, 't'},
+        {"list", no_argument, NULL, 'l'},
+        {"help", no_argument, NULL, 'h'}
+    };
+    int option_index = 0;
+
+    while ((c = getopt_long(argc, argv, "hf:cHt:l", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'f':
+                if(filter != NULL){
+                    fprintf(stderr, "Only one filter can be given; combine them with &&.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                filter = parseFilter(optarg);
+                break;
+            case 'c':
+                separator = ',';
+                break;
+            case 'H':
+                writeHeaderRow = FALSE;
+                break;
+            case 't':
+                threadCount = atoi(optarg);
+                if(threadCount < 1){
+                    fprintf(stderr, "The number of threads should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'l':
+                listInvariants();
+                return EXIT_SUCCESS;
+            case 'h':
+                help(name);
+                return EXIT_SUCCESS;
+            case '?':
+                usage(name);
+                return EXIT_FAILURE;
+            default:
+                fprintf(stderr, "Illegal option %c.\n", c);
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    columnCount = argc - optind;
+    if(columnCount == 0 && filter == NULL){
+        fprintf(stderr, "No invariants and no filter were given.\n");
+        usage(name);
+        return EXIT_FAILURE;
+    }
+    columns = (int *)malloc((columnCount ? columnCount : 1) * sizeof(int));
+    if(columns == NULL){
+        fprintf(stderr, "Insufficient memory -- exiting!\n");
+        return EXIT_FAILURE;
+    }
+    for(i = 0; i < columnCount; i++){
+        columns[i] = findInvariant(argv[optind + i], strlen(argv[optind + i]));
+        if(columns[i] < 0){
+            fprintf(stderr, "Unknown invariant %s.\n", argv[optind + i]);
+            listInvariants();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(columnCount && writeHeaderRow){
+        writeHeader();
+    }
+
+    if(threadCount > 1){
+        outputGraph = (GRAPH *)malloc(sizeof(GRAPH));
+        outputAdj = (ADJACENCY *)malloc(sizeof(ADJACENCY));
+        if(outputGraph == NULL || outputAdj == NULL){
+            fprintf(stderr, "Insufficient memory -- exiting!\n");
+            return EXIT_FAILURE;
+        }
+        processMultiCodeInParallel(stdin, threadCount, resultSize(),
+                evaluateGraph, handleResult);
+        free(outputGraph);
+        free(outputAdj);
+    } else {
+        unsigned short code[MAXCODELENGTH];
+        int length;
+        VALUE *resultValues = (VALUE *)malloc(resultSize());
+        if(resultValues == NULL){
+            fprintf(stderr, "Insufficient memory -- exiting!\n");
+            return EXIT_FAILURE;
+        }
+        while (readMultiCode(code, &length, stdin)) {
+            decodeMultiCode(code, length, graph, adj);
+            evaluateGraph(graph, adj, resultValues);
+            handleValues(graph, adj, resultValues);
+        }
+        free(resultValues);
+    }
+
+    fprintf(stderr, "Read %d graph%s.\n", graphCount, graphCount==1 ? "" : "s");
+    if(filter != NULL){
+        fprintf(stderr, "Filtered %d graph%s.\n", graphsFiltered, graphsFiltered==1 ? "" : "s");
+        freeExpression(filter);
+    }
+    free(columns);
+
+    return (EXIT_SUCCESS);
+}
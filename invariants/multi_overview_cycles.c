@@ -12,7 +12,8 @@
  * Compile like this:
  *     
  *     cc -o multi_overview_cycles -O4 ../multicode/shared/multicode_base.c\
- *     ../multicode/shared/multicode_input.c multi_overview_cycles.c
+ *     ../multicode/shared/multicode_input.c multi_overview_cycles.c \
+ *     ../multicode/shared/multicode_scanner.c
  */
 
 #include <stdio.h>
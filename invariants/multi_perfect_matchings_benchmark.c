@@ -0,0 +1,246 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* This program reads a file with graphs in multicode format and compares the
+ * time needed to count the perfect matchings of each graph with the counting
+ * engine and with the enumeration that was used before. The counts of both
+ * methods are checked to be equal.
+ *
+ * Compile with:
+ *
+ *     cc -o multi_perfect_matchings_benchmark -O4 \
+ *     multi_perfect_matchings_benchmark.c \
+ *     ../multicode/shared/multicode_base.c \
+ *     ../multicode/shared/multicode_input.c \
+ *     ../multicode/shared/multicode_scanner.c \
+ *     matchings/multi_perfect_matchings.c
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <time.h>
+
+#include "../multicode/shared/multicode_base.h"
+#include "../multicode/shared/multicode_input.h"
+#include "matchings/multi_perfect_matchings.h"
+
+//enough for the 39 digits of the largest count
+#define COUNT_DIGITS 40
+
+//graphs for which the enumeration takes longer are not enumerated again
+double enumerationLimit = -1;
+boolean verbose = FALSE;
+
+GRAPH graph;
+ADJACENCY adj;
+
+//====================== OLD ENUMERATION =======================
+
+/* The enumeration that was used before the counting engine was introduced.
+ */
+unsigned long long int perfectMatchingCount;
+
+boolean available[MAXN + 1];
+
+void extendPerfectMatching(GRAPH graph, ADJACENCY adj){
+    int i = 1, j;
+
+    while(i <= graph[0][0] && !available[i]){
+        i++;
+    }
+
+    if(i > graph[0][0]){
+        perfectMatchingCount++;
+    } else {
+        available[i] = FALSE;
+        for(j = 0; j < adj[i]; j++){
+            if(available[graph[i][j]]){
+                available[graph[i][j]] = FALSE;
+                extendPerfectMatching(graph, adj);
+                available[graph[i][j]] = TRUE;
+            }
+        }
+        available[i] = TRUE;
+    }
+}
+
+unsigned long long int enumeratePerfectMatchings(GRAPH graph, ADJACENCY adj){
+    int i;
+
+    if(graph[0][0]%2){
+        return 0;
+    }
+
+    perfectMatchingCount = 0;
+    for(i = 1; i <= MAXN; i++){
+        available[i] = TRUE;
+    }
+    extendPerfectMatching(graph, adj);
+
+    return perfectMatchingCount;
+}
+
+//====================== BENCHMARK =======================
+
+double secondsSince(struct timespec *start){
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+char *countToString(MATCHING_COUNT value, char *buffer){
+    char digits[COUNT_DIGITS];
+    int length = 0, i;
+
+    do {
+        digits[length++] = '0' + (int)(value % 10);
+        value /= 10;
+    } while(value > 0);
+    for(i = 0; i < length; i++){
+        buffer[i] = digits[length - 1 - i];
+    }
+    buffer[length] = '\0';
+
+    return buffer;
+}
+
+//====================== USAGE =======================
+
+void help(char *name) {
+    fprintf(stderr, "The program %s compares the counting engine for perfect matchings\n", name);
+    fprintf(stderr, "with the enumeration of all perfect matchings.\n\n");
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options]\n\n", name);
+    fprintf(stderr, "The graphs are read from standard in. The total time for both methods is\n");
+    fprintf(stderr, "reported, and the program fails if the counts differ.\n\n");
+    fprintf(stderr, "\nThis program can handle graphs up to %d vertices. Recompile if you need larger\n", MAXN);
+    fprintf(stderr, "graphs.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -l #, --limit #\n");
+    fprintf(stderr, "       Stop using the enumeration once it took longer than # seconds for a\n");
+    fprintf(stderr, "       single graph. The remaining graphs are only counted by the engine.\n");
+    fprintf(stderr, "    -v, --verbose\n");
+    fprintf(stderr, "       Report the count and both times for each graph.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+
+    /*=========== commandline parsing ===========*/
+
+    int c;
+    char *name = argv[0];
+    static struct option long_options[] = {
+        {"limit", required_argument, NULL, 'l'},
+        {"verbose", no_argument, NULL, 'v'},
+        {"help", no_argument, NULL, 'h'}
+    };
+    int option_index = 0;
+
+    while ((c = getopt_long(argc, argv, "hl:v", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'l':
+                enumerationLimit = atof(optarg);
+                if (enumerationLimit <= 0) {
+                    fprintf(stderr, "The time limit should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'v':
+                verbose = TRUE;
+                break;
+            case 'h':
+                help(name);
+                return EXIT_SUCCESS;
+            case '?':
+                usage(name);
+                return EXIT_FAILURE;
+            default:
+                fprintf(stderr, "Illegal option %c.\n", c);
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    unsigned short code[MAXCODELENGTH];
+    int length;
+    int graphCount = 0, enumeratedCount = 0, mismatchCount = 0;
+    double engineSeconds = 0, enumerationSeconds = 0, enumeratedEngineSeconds = 0;
+    boolean enumerate = TRUE;
+    char buffer[COUNT_DIGITS];
+
+    while (readMultiCode(code, &length, stdin)) {
+        struct timespec start;
+        MATCHING_COUNT count;
+        double seconds;
+
+        decodeMultiCode(code, length, graph, adj);
+        graphCount++;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        count = countPerfectMatchings(graph, adj);
+        seconds = secondsSince(&start);
+        engineSeconds += seconds;
+
+        if (enumerate) {
+            unsigned long long int enumeratedCount64;
+            double enumerationTime;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            enumeratedCount64 = enumeratePerfectMatchings(graph, adj);
+            enumerationTime = secondsSince(&start);
+
+            enumeratedCount++;
+            enumerationSeconds += enumerationTime;
+            enumeratedEngineSeconds += seconds;
+            if (count != enumeratedCount64) {
+                fprintf(stderr, "Graph %d: the engine counts %s perfect matchings, the enumeration %llu.\n",
+                        graphCount, countToString(count, buffer), enumeratedCount64);
+                mismatchCount++;
+            }
+            if (verbose) {
+                fprintf(stdout, "Graph %d: %s perfect matchings, engine %.6f s, enumeration %.6f s\n",
+                        graphCount, countToString(count, buffer), seconds, enumerationTime);
+            }
+            if (enumerationLimit > 0 && enumerationTime > enumerationLimit) {
+                enumerate = FALSE;
+            }
+        } else if (verbose) {
+            fprintf(stdout, "Graph %d: %s perfect matchings, engine %.6f s\n",
+                    graphCount, countToString(count, buffer), seconds);
+        }
+    }
+
+    fprintf(stderr, "Read %d graph%s.\n", graphCount, graphCount==1 ? "" : "s");
+    fprintf(stderr, "engine      %8d graphs %12.3f s\n", graphCount, engineSeconds);
+    fprintf(stderr, "enumeration %8d graphs %12.3f s\n", enumeratedCount, enumerationSeconds);
+    if (enumeratedEngineSeconds > 0) {
+        fprintf(stderr, "Speedup on the enumerated graphs: %.1f\n",
+                enumerationSeconds / enumeratedEngineSeconds);
+    }
+
+    if (mismatchCount) {
+        fprintf(stderr, "The methods do not agree on %d graph%s!\n",
+                mismatchCount, mismatchCount==1 ? "" : "s");
+        return EXIT_FAILURE;
+    }
+
+    return (EXIT_SUCCESS);
+}
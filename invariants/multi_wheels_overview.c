@@ -12,7 +12,9 @@
  * Compile like this:
  *     
  *     cc -o multi_wheels_overview -O4 ../multicode/shared/multicode_base.c\
- *     ../multicode/shared/multicode_input.c multi_wheels_overview.c
+ *     ../multicode/shared/multicode_input.c ../multicode/shared/multicode_bitset.c \
+ *     ../multicode/shared/multicode_scanner.c \
+ *     multi_wheels_overview.c
  */
 
 #include <stdio.h>
@@ -23,6 +25,7 @@
 
 #include "../multicode/shared/multicode_base.h"
 #include "../multicode/shared/multicode_input.h"
+#include "../multicode/shared/multicode_bitset.h"
 
 typedef struct freqTable {
     int key;
@@ -33,8 +36,13 @@ typedef struct freqTable {
 } FREQUENCY_TABLE;
 
 boolean verticesInCycle[MAXN+1];
-boolean neighbourhoods[MAXN+1][MAXN+1];
-boolean universalNeighbours[MAXN+1][MAXN+1];
+BITSET_ADJACENCY *neighbourhoods;
+//universal neighbours of the cycles of each size that are on the current path
+BITSET_WORD *universalNeighbours = NULL;
+int universalNeighboursCapacity = 0;
+
+#define UNIVERSAL_NEIGHBOURS(size) \
+    (universalNeighbours + (size_t)(size) * neighbourhoods->wordCount)
 
 FREQUENCY_TABLE *wheelsTable = NULL;
 
@@ -113,7 +121,7 @@ void checkSimpleCycles_impl(
             GRAPH graph, ADJACENCY adj, int firstVertex,
             int secondVertex, int currentVertex, int size,
             int universalNeighbourCount){
-    int i, w;
+    int i;
     for(i=0; i<adj[currentVertex]; i++){
         int neighbour = graph[currentVertex][i];
         if((neighbour != firstVertex) && verticesInCycle[neighbour]){
@@ -134,14 +142,9 @@ void checkSimpleCycles_impl(
             verticesInCycle[neighbour] = TRUE;
             
             //compute the new universal neighbours
-            int universalNeighbourCount = 0;
-            for(w = 1; w <= graph[0][0]; w++){
-                universalNeighbours[size + 1][w] = universalNeighbours[size][w] &&
-                        neighbourhoods[neighbour][w];
-                if(universalNeighbours[size + 1][w]){
-                    universalNeighbourCount++;
-                }
-            }
+            int universalNeighbourCount = intersectBitsets(
+                    UNIVERSAL_NEIGHBOURS(size + 1), UNIVERSAL_NEIGHBOURS(size),
+                    BITSET_ROW(neighbourhoods, neighbour), neighbourhoods->wordCount);
                 
             if(universalNeighbourCount){
                 checkSimpleCycles_impl(graph, adj, firstVertex, secondVertex,
@@ -154,16 +157,15 @@ void checkSimpleCycles_impl(
 }
 
 void buildWheelsTable(GRAPH graph, ADJACENCY adj){
-    int v, w, i;
+    int v, i;
     int order = graph[0][0];
     
-    for(v = 1; v <= order; v++){
-        for(w=1; w <= order; w++){
-            neighbourhoods[v][w] = FALSE;
-        }
-        for(i=0; i<adj[v]; i++){
-            neighbourhoods[v][graph[v][i]] = TRUE;
-        }
+    buildBitsetAdjacency(graph, adj, neighbourhoods);
+    //a cycle contains at most order vertices
+    if((order + 1) * neighbourhoods->wordCount > universalNeighboursCapacity){
+        free(universalNeighbours);
+        universalNeighboursCapacity = (order + 1) * neighbourhoods->wordCount;
+        universalNeighbours = newBitsets(order + 1, neighbourhoods->wordCount);
     }
     
     for(v = 1; v < order; v++){ //intentionally skip v==order!
@@ -177,14 +179,9 @@ void buildWheelsTable(GRAPH graph, ADJACENCY adj){
                 //start a cycle
                 verticesInCycle[neighbour] = TRUE;
                 
-                int universalNeighbourCount = 0;
-                for(w = 1; w <= order; w++){
-                    universalNeighbours[2][w] = neighbourhoods[v][w] &&
-                            neighbourhoods[neighbour][w];
-                    if(universalNeighbours[2][w]){
-                        universalNeighbourCount++;
-                    }
-                }
+                int universalNeighbourCount = intersectBitsets(
+                        UNIVERSAL_NEIGHBOURS(2), BITSET_ROW(neighbourhoods, v),
+                        BITSET_ROW(neighbourhoods, neighbour), neighbourhoods->wordCount);
                 if(universalNeighbourCount){
                     checkSimpleCycles_impl(graph, adj, v, neighbour, neighbour,
                         2, universalNeighbourCount);
@@ -286,6 +283,8 @@ int main(int argc, char** argv) {
         alarm(timeOut);
     }
     
+    neighbourhoods = newBitsetAdjacency();
+    
     unsigned short code[MAXCODELENGTH];
     int length;
     while (!interrupted && readMultiCode(code, &length, stdin)) {
@@ -298,6 +297,9 @@ int main(int argc, char** argv) {
         freeFrequencyTable(wheelsTable);
         wheelsTable = NULL;
     }
+    
+    free(universalNeighbours);
+    freeBitsetAdjacency(neighbourhoods);
 
     return (EXIT_SUCCESS);
 }
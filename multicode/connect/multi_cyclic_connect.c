@@ -14,6 +14,7 @@
  *     
  *     cc -o multi_cyclic_connect -O4  multi_cyclic_connect.c \
  *     ../shared/multicode_base.c ../shared/multicode_input.c \
+ *     ../shared/multicode_scanner.c \
  *     ../shared/multicode_output.c
  * 
  */
@@ -9,83 +9,276 @@
  * 
  */
 
-#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "multicode_base.h"
+#include "multicode_flow.h"
 #include "multicode_connectivity.h"
+
+/* Returns the minimum of the maxflow of the st-network and max_value, or -1
+ * if there was not enough memory.
+ */
+int find_max_flow_in_st_network(GRAPH *graph, int source, int target, int max_value){
+    int i, j, flow = -1;
+
+    FLOW_NETWORK *network = new_flow_network();
+    if(network == NULL){
+        return -1;
+    }
+    if(!clear_flow_network(network, graph->n)){
+        free_flow_network(network);
+        return -1;
+    }
+    for(i = 0; i < graph->n; i++){
+        for(j = 0; j < graph->degrees[i]; j++){
+            //each edge can be used once, in either direction
+            if(i < NEIGHBOUR(graph, i, j) &&
+                    !add_arc_pair(network, i, NEIGHBOUR(graph, i, j), 1, 1)){
+                free_flow_network(network);
+                return -1;
+            }
+        }
+    }
     
-//try to find a path from the current vertex to the target
-boolean find_path(GRAPH *graph, int current_vertex, int target, int *paths, int order, boolean* current_path, int *capacity) {
-    int i;
-    if(current_vertex==target)
-        return TRUE;
-    current_path[current_vertex]=TRUE;
-    for(i=0; i < graph->degrees[current_vertex]; i++){
-        int next_vertex = NEIGHBOUR(graph, current_vertex, i);
-        if(paths[current_vertex*order + next_vertex]-paths[next_vertex*order + current_vertex]<=capacity[current_vertex*order + next_vertex]-1 && !current_path[next_vertex]){
-            paths[current_vertex*order + next_vertex]++;
-            if(find_path(graph, next_vertex, target, paths, order, current_path, capacity))
-                return TRUE;
-            else
-                paths[current_vertex*order + next_vertex]--;
+    flow = find_max_flow(network, source, target, max_value);
+    free_flow_network(network);
+    return flow;
+}
+
+/* Work space for the minimum cut computation. The vertices that have been
+ * merged into one vertex share a list of edge ends: edge_end[e] is the other
+ * end of the edge end e, and next_edge_end[e] is the next edge end in the
+ * list. The list of each vertex runs from first_edge_end to last_edge_end.
+ */
+typedef struct {
+    int *merged_into;
+    int *first_edge_end;
+    int *last_edge_end;
+    int *edge_end;
+    int *next_edge_end;
+    int *connection;
+    boolean *added;
+    int *heap_keys;
+    int *heap_vertices;
+    int heap_size;
+} CUT_WORK_SPACE;
+
+//returns the vertex into which v has been merged
+static int find_merged_vertex(CUT_WORK_SPACE *space, int v){
+    int *merged_into = space->merged_into;
+    while(merged_into[v] != v){
+        merged_into[v] = merged_into[merged_into[v]];
+        v = merged_into[v];
+    }
+    return v;
+}
+
+static void push_heap(CUT_WORK_SPACE *space, int key, int v){
+    int i = space->heap_size++;
+    while(i > 0 && space->heap_keys[(i - 1)/2] < key){
+        space->heap_keys[i] = space->heap_keys[(i - 1)/2];
+        space->heap_vertices[i] = space->heap_vertices[(i - 1)/2];
+        i = (i - 1)/2;
+    }
+    space->heap_keys[i] = key;
+    space->heap_vertices[i] = v;
+}
+
+static int pop_heap(CUT_WORK_SPACE *space){
+    int top = space->heap_vertices[0];
+    int key = space->heap_keys[--(space->heap_size)];
+    int v = space->heap_vertices[space->heap_size];
+    int i = 0, child;
+    while((child = 2*i + 1) < space->heap_size){
+        if(child + 1 < space->heap_size &&
+                space->heap_keys[child + 1] > space->heap_keys[child]){
+            child++;
+        }
+        if(space->heap_keys[child] <= key){
+            break;
         }
+        space->heap_keys[i] = space->heap_keys[child];
+        space->heap_vertices[i] = space->heap_vertices[child];
+        i = child;
     }
-    current_path[current_vertex]=FALSE;
-    return FALSE;
+    space->heap_keys[i] = key;
+    space->heap_vertices[i] = v;
+    return top;
 }
 
-//returns the minimum of the maxflow of the st-network and max_value
-int find_max_flow_in_st_network(GRAPH *graph, int source, int target, int max_value){
-    int i, j;
+static boolean is_connected(GRAPH *graph, CUT_WORK_SPACE *space){
+    int i, head = 0, tail = 0;
 
-    int order = graph->n;
-    int paths[order*order];
-    int capacity[order*order];
-    for(i=0; i<order*order; i++){
-        paths[i] = 0;
-        capacity[i] = 0;
+    //connection is used as the queue and added marks the visited vertices
+    for(i = 0; i < graph->n; i++){
+        space->added[i] = FALSE;
     }
-    for(i = 0; i < order; i++){
-        for(j = 0; j < graph->degrees[i]; j++){
-            capacity[i*order + NEIGHBOUR(graph, i, j)]++;
+    space->added[0] = TRUE;
+    space->connection[tail++] = 0;
+    while(head < tail){
+        int v = space->connection[head++];
+        for(i = 0; i < graph->degrees[v]; i++){
+            int w = NEIGHBOUR(graph, v, i);
+            if(!space->added[w]){
+                space->added[w] = TRUE;
+                space->connection[tail++] = w;
+            }
         }
     }
-    
-    int path_count = 0;
-    boolean current_path[order];
-    for(i=0; i<order; i++){
-        current_path[i] = FALSE;
-    }
-    while(find_path(graph, source, target, paths, order, current_path, capacity) && path_count < max_value){
-        path_count++;
-        for(i=0; i<order; i++){
-            current_path[i] = FALSE;
+    return tail == graph->n;
+}
+
+/* Returns the weight of the cut that separates the last vertex that is added
+ * in a maximum adjacency ordering of the remaining vertices from the others,
+ * and merges that vertex into the one that was added before it. The graph
+ * should be connected.
+ */
+static int minimum_cut_phase(CUT_WORK_SPACE *space, int order, int start){
+    int i, v, previous = start, last = start;
+    int remaining = 0;
+
+    for(v = 0; v < order; v++){
+        if(space->merged_into[v] == v){
+            space->connection[v] = 0;
+            space->added[v] = FALSE;
+            remaining++;
+        }
+    }
+    space->heap_size = 0;
+
+    v = start;
+    while(TRUE){
+        int edge, previous_edge = -1;
+        space->added[v] = TRUE;
+        remaining--;
+        previous = last;
+        last = v;
+        if(remaining == 0){
+            break;
+        }
+        //update the connections and drop edges that became loops
+        for(edge = space->first_edge_end[v]; edge != -1; edge = space->next_edge_end[edge]){
+            int w = find_merged_vertex(space, space->edge_end[edge]);
+            if(w == v){
+                if(previous_edge == -1){
+                    space->first_edge_end[v] = space->next_edge_end[edge];
+                } else {
+                    space->next_edge_end[previous_edge] = space->next_edge_end[edge];
+                }
+                continue;
+            }
+            previous_edge = edge;
+            if(!space->added[w]){
+                space->connection[w]++;
+                push_heap(space, space->connection[w], w);
+            }
         }
+        space->last_edge_end[v] = previous_edge;
+        //the entries in the heap are not updated, so skip outdated entries
+        do {
+            i = space->heap_keys[0];
+            v = pop_heap(space);
+        } while(space->added[v] || i != space->connection[v]);
+    }
+
+    //merge the last vertex into the previous one
+    space->merged_into[last] = previous;
+    if(space->first_edge_end[previous] == -1){
+        space->first_edge_end[previous] = space->first_edge_end[last];
+        space->last_edge_end[previous] = space->last_edge_end[last];
+    } else if(space->first_edge_end[last] != -1){
+        space->next_edge_end[space->last_edge_end[previous]] = space->first_edge_end[last];
+        space->last_edge_end[previous] = space->last_edge_end[last];
     }
-    return path_count;
+    
+    return space->connection[last];
 }
 
+/* Computes the edge connectivity with the algorithm of Stoer and Wagner: in
+ * each phase a cut is found, and two vertices on the same side of a minimum
+ * cut are merged, until only one vertex is left. Returns -1 if there was not
+ * enough memory.
+ */
 int find_edge_connectivity(GRAPH *graph){
-    int i;
-    int min_degree, vertex_min_degree, minimum_cut_size;
+    int i, j, edge_ends = 0;
+    int min_degree, minimum_cut_size;
+    int order = graph->n;
+    CUT_WORK_SPACE space;
     
-    min_degree = graph->degrees[0];
-    vertex_min_degree = 1;
+    if(order <= 0){
+        return 0;
+    }
     
-    for (i = 1; i < graph->n; i++){
+    min_degree = graph->degrees[0];
+    for (i = 1; i < order; i++){
         if(graph->degrees[i]<min_degree){
             min_degree = graph->degrees[i];
-            vertex_min_degree = i;
         }
     }
+    if(order == 1){
+        return min_degree;
+    }
     
-    minimum_cut_size = min_degree;
-    for (i = 0; i < graph->n; i++){
-        if(i!=vertex_min_degree){
-            minimum_cut_size = find_max_flow_in_st_network(graph, vertex_min_degree, i, minimum_cut_size);
+    for (i = 0; i < order; i++){
+        edge_ends += graph->degrees[i];
+    }
+    space.merged_into = malloc(sizeof(int)*order);
+    space.first_edge_end = malloc(sizeof(int)*order);
+    space.last_edge_end = malloc(sizeof(int)*order);
+    space.connection = malloc(sizeof(int)*order);
+    space.added = malloc(sizeof(boolean)*order);
+    space.edge_end = malloc(sizeof(int)*(edge_ends + 1));
+    space.next_edge_end = malloc(sizeof(int)*(edge_ends + 1));
+    space.heap_keys = malloc(sizeof(int)*(edge_ends + 1));
+    space.heap_vertices = malloc(sizeof(int)*(edge_ends + 1));
+    
+    if(space.merged_into == NULL || space.first_edge_end == NULL ||
+            space.last_edge_end == NULL || space.connection == NULL ||
+            space.added == NULL || space.edge_end == NULL ||
+            space.next_edge_end == NULL || space.heap_keys == NULL ||
+            space.heap_vertices == NULL){
+        fprintf(stderr, "Insufficient memory for minimum cut.\n");
+        minimum_cut_size = -1;
+    } else if(!is_connected(graph, &space)){
+        minimum_cut_size = 0;
+    } else {
+        edge_ends = 0;
+        for (i = 0; i < order; i++){
+            space.merged_into[i] = i;
+            space.first_edge_end[i] = space.last_edge_end[i] = -1;
+            for(j = 0; j < graph->degrees[i]; j++){
+                if(NEIGHBOUR(graph, i, j) != i){
+                    space.edge_end[edge_ends] = NEIGHBOUR(graph, i, j);
+                    space.next_edge_end[edge_ends] = space.first_edge_end[i];
+                    if(space.first_edge_end[i] == -1){
+                        space.last_edge_end[i] = edge_ends;
+                    }
+                    space.first_edge_end[i] = edge_ends;
+                    edge_ends++;
+                }
+            }
+        }
+
+        minimum_cut_size = min_degree;
+        //a connected graph has no cut that is smaller than 1
+        for (i = 1; i < order && minimum_cut_size > 1; i++){
+            int cut = minimum_cut_phase(&space, order, find_merged_vertex(&space, 0));
+            if(cut < minimum_cut_size){
+                minimum_cut_size = cut;
+            }
         }
-        //TODO: add optimalisations
     }
     
+    free(space.merged_into);
+    free(space.first_edge_end);
+    free(space.last_edge_end);
+    free(space.connection);
+    free(space.added);
+    free(space.edge_end);
+    free(space.next_edge_end);
+    free(space.heap_keys);
+    free(space.heap_vertices);
+    
     return minimum_cut_size;
-}
\ No newline at end of file
+}
@@ -0,0 +1,245 @@
+/*
+ * Main developer: Nico Van Cleemput
+ * 
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* Maximum flows are computed with Dinic's algorithm: a breadth-first search
+ * from the source assigns a level to each vertex, and then paths that only
+ * use arcs from one level to the next are augmented until none are left. The
+ * search for augmenting paths uses an explicit stack, so the depth of the
+ * network is not limited by the size of the call stack.
+ */
+
+#include<stdio.h>
+#include<stdlib.h>
+#include "multicode_flow.h"
+
+//on failure the original array is kept
+static boolean resize(int **array, size_t count){
+    int *resized = realloc(*array, sizeof(int)*count);
+    if(resized == NULL){
+        fprintf(stderr, "Insufficient memory for flow network.\n");
+        return FALSE;
+    }
+    *array = resized;
+    return TRUE;
+}
+
+FLOW_NETWORK *new_flow_network(){
+    FLOW_NETWORK *network = malloc(sizeof(FLOW_NETWORK));
+    if(network == NULL){
+        fprintf(stderr, "Insufficient memory for flow network.\n");
+        return NULL;
+    }
+
+    network->vertex_count = 0;
+    network->arc_count = 0;
+    network->head = NULL;
+    network->capacity = NULL;
+    network->residual = NULL;
+    network->first_arc = NULL;
+    network->arcs = NULL;
+    network->arcs_sorted = TRUE;
+    network->level = NULL;
+    network->current_arc = NULL;
+    network->queue = NULL;
+    network->path = NULL;
+    network->vertex_capacity = 0;
+    network->arc_capacity = 0;
+
+    return network;
+}
+
+void free_flow_network(FLOW_NETWORK *network){
+    free(network->head);
+    free(network->capacity);
+    free(network->residual);
+    free(network->first_arc);
+    free(network->arcs);
+    free(network->level);
+    free(network->current_arc);
+    free(network->queue);
+    free(network->path);
+    free(network);
+}
+
+/* Removes all arcs and sets the number of vertices of the network. Returns
+ * FALSE if there was not enough memory.
+ */
+boolean clear_flow_network(FLOW_NETWORK *network, int vertex_count){
+    if(vertex_count > network->vertex_capacity){
+        if(!resize(&(network->first_arc), vertex_count + 1) ||
+                !resize(&(network->level), vertex_count) ||
+                !resize(&(network->current_arc), vertex_count) ||
+                !resize(&(network->queue), vertex_count) ||
+                !resize(&(network->path), vertex_count)){
+            return FALSE;
+        }
+        network->vertex_capacity = vertex_count;
+    }
+    network->vertex_count = vertex_count;
+    network->arc_count = 0;
+    network->arcs_sorted = FALSE;
+    return TRUE;
+}
+
+/* Adds an arc from from to to with the given capacity, and the reverse arc
+ * with capacity reverse_capacity. An undirected edge corresponds to a pair of
+ * arcs with the same capacity. Returns FALSE if there was not enough memory.
+ */
+boolean add_arc_pair(FLOW_NETWORK *network, int from, int to, int capacity, int reverse_capacity){
+    int arc = network->arc_count;
+
+    if(arc + 2 > network->arc_capacity){
+        int arc_capacity = 2*network->arc_capacity + 64;
+        if(!resize(&(network->head), arc_capacity) ||
+                !resize(&(network->capacity), arc_capacity) ||
+                !resize(&(network->residual), arc_capacity) ||
+                !resize(&(network->arcs), arc_capacity)){
+            return FALSE;
+        }
+        network->arc_capacity = arc_capacity;
+    }
+
+    network->head[arc] = to;
+    network->capacity[arc] = capacity;
+    network->head[arc + 1] = from;
+    network->capacity[arc + 1] = reverse_capacity;
+    network->arc_count += 2;
+    network->arcs_sorted = FALSE;
+    return TRUE;
+}
+
+//groups the arcs by the vertex they leave
+static void sort_arcs(FLOW_NETWORK *network){
+    int v, arc;
+    int *first_arc = network->first_arc;
+
+    for(v = 0; v <= network->vertex_count; v++){
+        first_arc[v] = 0;
+    }
+    for(arc = 0; arc < network->arc_count; arc++){
+        //the tail of an arc is the head of its reverse
+        first_arc[network->head[arc ^ 1] + 1]++;
+    }
+    for(v = 0; v < network->vertex_count; v++){
+        first_arc[v + 1] += first_arc[v];
+    }
+    for(arc = 0; arc < network->arc_count; arc++){
+        network->arcs[first_arc[network->head[arc ^ 1]]++] = arc;
+    }
+    //restore the start positions that were shifted while placing the arcs
+    for(v = network->vertex_count; v > 0; v--){
+        first_arc[v] = first_arc[v - 1];
+    }
+    first_arc[0] = 0;
+
+    network->arcs_sorted = TRUE;
+}
+
+//returns TRUE if the target can still be reached from the source
+static boolean assign_levels(FLOW_NETWORK *network, int source, int target){
+    int v, i, head = 0, tail = 0;
+    int *level = network->level;
+
+    for(v = 0; v < network->vertex_count; v++){
+        level[v] = -1;
+    }
+    level[source] = 0;
+    network->queue[tail++] = source;
+    while(head < tail){
+        v = network->queue[head++];
+        for(i = network->first_arc[v]; i < network->first_arc[v + 1]; i++){
+            int arc = network->arcs[i];
+            int w = network->head[arc];
+            if(level[w] < 0 && network->residual[arc] > 0){
+                level[w] = level[v] + 1;
+                if(w == target){
+                    return TRUE;
+                }
+                network->queue[tail++] = w;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/* Returns the minimum of the maximum flow from source to target and limit.
+ * The capacities of the arcs are not changed, so the same network can be
+ * used for several pairs of vertices.
+ */
+int find_max_flow(FLOW_NETWORK *network, int source, int target, int limit){
+    int arc, i, depth, v, flow = 0;
+    int *residual = network->residual;
+    int *path = network->path;
+
+    if(source == target || limit <= 0){
+        return 0;
+    }
+
+    if(!network->arcs_sorted){
+        sort_arcs(network);
+    }
+    for(arc = 0; arc < network->arc_count; arc++){
+        residual[arc] = network->capacity[arc];
+    }
+
+    while(flow < limit && assign_levels(network, source, target)){
+        for(v = 0; v < network->vertex_count; v++){
+            network->current_arc[v] = network->first_arc[v];
+        }
+
+        depth = 0;
+        v = source;
+        while(flow < limit){
+            if(v == target){
+                //augment along the path and retreat to its first saturated arc
+                int bottleneck = limit - flow;
+                for(i = 0; i < depth; i++){
+                    if(residual[path[i]] < bottleneck){
+                        bottleneck = residual[path[i]];
+                    }
+                }
+                for(i = 0; i < depth; i++){
+                    residual[path[i]] -= bottleneck;
+                    residual[path[i] ^ 1] += bottleneck;
+                }
+                flow += bottleneck;
+                if(flow == limit){
+                    break;
+                }
+                for(i = 0; residual[path[i]] > 0; i++);
+                depth = i;
+                v = network->head[path[i] ^ 1];
+                continue;
+            }
+
+            //advance along the current arc of v if it leads to the next level
+            while(network->current_arc[v] < network->first_arc[v + 1]){
+                arc = network->arcs[network->current_arc[v]];
+                if(residual[arc] > 0 &&
+                        network->level[network->head[arc]] == network->level[v] + 1){
+                    break;
+                }
+                network->current_arc[v]++;
+            }
+            if(network->current_arc[v] < network->first_arc[v + 1]){
+                path[depth++] = arc;
+                v = network->head[arc];
+            } else {
+                //the target cannot be reached from v in this phase
+                network->level[v] = -1;
+                if(depth == 0){
+                    break;
+                }
+                depth--;
+                v = network->head[path[depth] ^ 1];
+                network->current_arc[v]++;
+            }
+        }
+    }
+
+    return flow;
+}
@@ -0,0 +1,54 @@
+/*
+ * Main developer: Nico Van Cleemput
+ * 
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_FLOW_H
+#define	MULTICODE_FLOW_H
+
+#include "boolean.h"
+
+/* A flow network with vertices 0 up to vertex_count-1. The arcs are stored in
+ * pairs: arc a and arc a^1 are each other's reverse. The memory that is used
+ * grows with the number of vertices and arcs, and is reused when the network
+ * is cleared.
+ */
+typedef struct __flow_network FLOW_NETWORK;
+
+struct __flow_network {
+    int vertex_count;
+    int arc_count;
+
+    int *head;
+    int *capacity;
+    int *residual;
+
+    //the arcs leaving v are arcs[first_arc[v]] up to arcs[first_arc[v+1]-1]
+    int *first_arc;
+    int *arcs;
+    boolean arcs_sorted;
+
+    //work space for the max flow computation
+    int *level;
+    int *current_arc;
+    int *queue;
+    int *path;
+
+    int vertex_capacity;
+    int arc_capacity;
+};
+
+FLOW_NETWORK *new_flow_network();
+
+void free_flow_network(FLOW_NETWORK *network);
+
+boolean clear_flow_network(FLOW_NETWORK *network, int vertex_count);
+
+boolean add_arc_pair(FLOW_NETWORK *network, int from, int to, int capacity, int reverse_capacity);
+
+int find_max_flow(FLOW_NETWORK *network, int source, int target, int limit);
+
+#endif	/* MULTICODE_FLOW_H */
+
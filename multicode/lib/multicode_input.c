@@ -7,11 +7,52 @@
 
 #include "multicode_input.h"
 #include<string.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
 
-GRAPH *decode_multi_code(unsigned short* code, GRAPH_INPUT_OPTIONS *options) {
+#define READ_BUFFER_SIZE (1 << 20)
+
+#define MAX_STREAM_COUNT 16
+
+/* Regular files are mapped into memory. Other input (e.g., pipes) is read in
+ * large blocks into a buffer that grows when a single code does not fit.
+ * In both cases data[position] is the first byte that has not been handed out
+ * yet and data[end - 1] is the last byte that is available.
+ */
+struct __multicode_reader {
+    FILE *file;
+    boolean contains_header;
+    boolean remove_internal_headers;
+    boolean header_read;
+    boolean failed;
+
+    boolean mapped;
+    off_t mapping_offset;
+
+    unsigned char *data;
+    size_t capacity;
+    size_t position;
+    size_t end;
+    boolean eof;
+};
+
+static inline unsigned short get_entry(MULTICODE_VIEW *view, int i){
+    unsigned short entry;
+    
+    if(view->two_byte_entries){
+        memcpy(&entry, view->data + i*sizeof(unsigned short), sizeof(unsigned short));
+        return entry;
+    } else {
+        return view->data[i];
+    }
+}
+
+GRAPH *decode_multi_code_view(MULTICODE_VIEW *view, GRAPH_INPUT_OPTIONS *options) {
     int i, j, current_vertex, vertex_count, maxn, maxval;
+    unsigned short entry;
     
-    vertex_count = code[0];
+    vertex_count = view->order;
     
     if(options->maxn > 0){
         maxn = options->maxn;
@@ -30,13 +71,14 @@ GRAPH *decode_multi_code(unsigned short* code, GRAPH_INPUT_OPTIONS *options) {
     i = 1;
     current_vertex = 0;
     while(current_vertex < vertex_count - 1) {
-        if (code[i] == 0) {
+        entry = get_entry(view, i);
+        if (entry == 0) {
             if(degrees[current_vertex] > maxval)
                 maxval = degrees[current_vertex];
             current_vertex++;
         } else {
             degrees[current_vertex]++;
-            degrees[code[i]-1]++;
+            degrees[entry-1]++;
         }
         i++;
     }
@@ -59,10 +101,11 @@ GRAPH *decode_multi_code(unsigned short* code, GRAPH_INPUT_OPTIONS *options) {
     i = 1;
     current_vertex = 0;
     while(current_vertex < vertex_count - 1) {
-        if (code[i] == 0) {
+        entry = get_entry(view, i);
+        if (entry == 0) {
             current_vertex++;
         } else {
-            add_edge(graph, current_vertex, code[i] - 1);
+            add_edge(graph, current_vertex, entry - 1);
         }
         i++;
     }
@@ -70,158 +113,332 @@ GRAPH *decode_multi_code(unsigned short* code, GRAPH_INPUT_OPTIONS *options) {
     return graph;
 }
 
-unsigned short *read_multi_code(FILE *file, GRAPH_INPUT_OPTIONS *options) {
-    static boolean first = TRUE;
-    unsigned char c;
-    char testheader[20];
-    int buffer_size = 0, zero_counter = 0;
+GRAPH *decode_multi_code(unsigned short* code, GRAPH_INPUT_OPTIONS *options) {
+    //the length is not needed for decoding
+    MULTICODE_VIEW view = {(const unsigned char *)code, TRUE, code[0], 0};
     
-    int read_count;
+    return decode_multi_code_view(&view, options);
+}
+
+MULTICODE_READER *new_multicode_reader(FILE *file, GRAPH_INPUT_OPTIONS *options) {
+    struct stat file_status;
+    off_t offset, mapping_offset;
+    void *mapping;
     
-    int code_length = options->initial_code_length;
-    unsigned short* code = malloc(code_length*sizeof(unsigned short));
-    if(code == NULL){
-        fprintf(stderr, "Insufficient memory to store code for this graph.\n");
+    MULTICODE_READER *reader = malloc(sizeof(MULTICODE_READER));
+    if(reader == NULL){
+        fprintf(stderr, "Insufficient memory for multicode reader.\n");
+        return NULL;
+    }
+    reader->file = file;
+    reader->contains_header = options->contains_header;
+    reader->remove_internal_headers = options->remove_internal_headers;
+    reader->header_read = FALSE;
+    reader->failed = FALSE;
+    reader->mapped = FALSE;
+    reader->position = 0;
+    reader->end = 0;
+    reader->eof = FALSE;
+    
+    //ftello takes into account anything that was already read through file
+    if(fstat(fileno(file), &file_status) == 0 && S_ISREG(file_status.st_mode) &&
+            (offset = ftello(file)) >= 0 && file_status.st_size > offset){
+        mapping_offset = offset - offset % sysconf(_SC_PAGESIZE);
+        mapping = mmap(NULL, file_status.st_size - mapping_offset, PROT_READ,
+                MAP_PRIVATE, fileno(file), mapping_offset);
+        if(mapping != MAP_FAILED){
+            madvise(mapping, file_status.st_size - mapping_offset, MADV_SEQUENTIAL);
+            reader->mapped = TRUE;
+            reader->mapping_offset = mapping_offset;
+            reader->data = mapping;
+            reader->capacity = reader->end = file_status.st_size - mapping_offset;
+            reader->position = offset - mapping_offset;
+            reader->eof = TRUE;
+            return reader;
+        }
+    }
+    
+    reader->capacity = READ_BUFFER_SIZE;
+    reader->data = malloc(reader->capacity);
+    if(reader->data == NULL){
+        fprintf(stderr, "Insufficient memory for multicode reader.\n");
+        free(reader);
         return NULL;
     }
+    return reader;
+}
 
-    if (first) {
-        first = FALSE;
-        
-        if(options->contains_header){
-            //we check that there is a header
-            if (fread(&testheader, sizeof (unsigned char), 12, file) != 12) {
-                fprintf(stderr, "can't read header: file too small.\n");
-                free(code);
-                return NULL;
-            }
-            testheader[12] = 0;
-            if (strcmp(testheader, ">>multi_code") != 0) {
-                fprintf(stderr, "No multicode header detected.\n");
-                free(code);
-                return NULL;
-            }
+/* For a mapped file the position of the stream is set to the first byte
+ * after the last code that was read. Input that was buffered from other
+ * streams is lost.
+ */
+void free_multicode_reader(MULTICODE_READER *reader) {
+    if(reader->mapped){
+        munmap(reader->data, reader->capacity);
+        fseeko(reader->file, reader->mapping_offset + reader->position, SEEK_SET);
+    } else {
+        free(reader->data);
+    }
+    free(reader);
+}
 
-            //read reminder of header (either empty or le/be specification)
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                fprintf(stderr, "Invalid formatted header.\n");
-                free(code);
-                return NULL;
-            }
-            while (c!='<'){
-                if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                    fprintf(stderr, "Invalid formatted header.\n");
-                    free(code);
-                    return NULL;
-                }
-            }
-            //read one more character (header is closed by <<)
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                fprintf(stderr, "Invalid formatted header.\n");
-                free(code);
-                return NULL;
+/* Makes sure that at least count bytes starting at position are available.
+ * Returns FALSE if the input ends before that or if there is not enough
+ * memory to buffer the input.
+ */
+static boolean ensure_available(MULTICODE_READER *reader, size_t count) {
+    size_t requested, read_count;
+    
+    while(reader->end - reader->position < count){
+        if(reader->eof){
+            return FALSE;
+        }
+        if(reader->position > 0){
+            memmove(reader->data, reader->data + reader->position,
+                    reader->end - reader->position);
+            reader->end -= reader->position;
+            reader->position = 0;
+        }
+        if(reader->capacity < count){
+            size_t new_capacity = 2*reader->capacity < count ? count : 2*reader->capacity;
+            unsigned char *new_data = realloc(reader->data, new_capacity);
+            if(new_data == NULL){
+                fprintf(stderr, "Insufficient memory to store code for this graph.\n");
+                reader->failed = TRUE;
+                return FALSE;
             }
+            reader->data = new_data;
+            reader->capacity = new_capacity;
+        }
+        requested = reader->capacity - reader->end;
+        read_count = fread(reader->data + reader->end, sizeof(unsigned char), requested, reader->file);
+        reader->end += read_count;
+        if(read_count < requested){
+            reader->eof = TRUE;
+        }
+    }
+    
+    return TRUE;
+}
+
+/* Skips the remainder of a header after its first characters have been read.
+ * Returns FALSE if the input ends before the header is closed.
+ */
+static boolean skip_remainder_of_header(MULTICODE_READER *reader) {
+    unsigned char c;
+    
+    do {
+        if(!ensure_available(reader, 1)){
+            return FALSE;
         }
+        c = reader->data[reader->position++];
+    } while(c != '<');
+    
+    return TRUE;
+}
+
+static boolean read_header(MULTICODE_READER *reader) {
+    //we check that there is a header
+    if(!ensure_available(reader, 12)){
+        fprintf(stderr, "can't read header: file too small.\n");
+        return FALSE;
+    }
+    if(memcmp(reader->data + reader->position, ">>multi_code", 12) != 0){
+        fprintf(stderr, "No multicode header detected.\n");
+        return FALSE;
+    }
+    reader->position += 12;
+    
+    //read reminder of header (either empty or le/be specification)
+    //and one more character (header is closed by <<)
+    if(!skip_remainder_of_header(reader) || !ensure_available(reader, 1)){
+        fprintf(stderr, "Invalid formatted header.\n");
+        return FALSE;
     }
+    reader->position++;
+    
+    return TRUE;
+}
 
+/**
+ * Finds the next code in the input and stores a view on it in view.
+ * 
+ * @return returns TRUE if a code was read and FALSE if the input is exhausted
+ *         or in case of error.
+ */
+boolean next_multi_code(MULTICODE_READER *reader, MULTICODE_VIEW *view) {
+    const unsigned char *code;
+    size_t scanned, available;
+    int order, zero_counter;
+    unsigned short entry;
+    
+    if(reader->failed){
+        return FALSE;
+    }
+    
+    if(!reader->header_read){
+        reader->header_read = TRUE;
+        if(reader->contains_header && !read_header(reader)){
+            reader->failed = TRUE;
+            return FALSE;
+        }
+    }
+    
+    if(!ensure_available(reader, 1)){
+        //nothing left in file
+        return FALSE;
+    }
+    
     /* possibly removing interior headers */
-    if(options->remove_internal_headers){
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
+    if(reader->remove_internal_headers && reader->data[reader->position] == '>' &&
+            ensure_available(reader, 3) && reader->data[reader->position + 1] == '>' &&
+            reader->data[reader->position + 2] == 'm'){
+        reader->position += 3;
+        if(!skip_remainder_of_header(reader) || !ensure_available(reader, 1) ||
+                reader->data[reader->position++] != '<'){
+            fprintf(stderr, "Problems with header -- single '<'\n");
+            reader->failed = TRUE;
+            return FALSE;
+        }
+        if(!ensure_available(reader, 1)){
             //nothing left in file
-            return (0);
-        }
-
-        if (c == '>') {
-            // could be a header, or maybe just a 62 (which is also possible for unsigned char
-            code[0] = c;
-            buffer_size = 1;
-            zero_counter = 0;
-            code[1] = (unsigned short) getc(file);
-            if (code[1] == 0) zero_counter++;
-            code[2] = (unsigned short) getc(file);
-            if (code[2] == 0) zero_counter++;
-            buffer_size = 3;
-            // 3 characters were read and stored in buffer
-            if ((code[1] == '>') && (code[2] == 'p')) /*we are sure that we're dealing with a header*/ {
-                while ((c = getc(file)) != '<');
-                /* read 2 more characters: */
-                c = getc(file);
-                if (c != '<') {
-                    fprintf(stderr, "Problems with header -- single '<'\n");
-                    free(code);
-                    return NULL;
-                }
-                if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                    //nothing left in file
-                    code[0] = 0;
-                    return code;
-                }
-                buffer_size = 1;
-                zero_counter = 0;
-            }
-        } else {
-            //no header present
-            buffer_size = 1;
-            zero_counter = 0;
+            return FALSE;
         }
     }
-
+    
     //start reading the graph
-    if (c != 0) {
-        code[0] = c;
-        while (zero_counter < code[0]-1) {
-            if(buffer_size==code_length){
-                code_length = (2*code_length < (code[0]*(code[0] - 1)/2)) ? 2*code_length : code[0]*(code[0] - 1)/2;
-                // code[0]*(code[0] - 1)/2 is the maximum code length for this number of vertices 
-                unsigned short* new_code = realloc(code, code_length*sizeof(unsigned short));
-                if(new_code == NULL){
-                    free(code);
-                    fprintf(stderr, "Insufficient memory to store code for this graph.\n");
-                    return NULL;
-                } else {
-                    code = new_code;
+    zero_counter = 0;
+    if(reader->data[reader->position]){
+        order = reader->data[reader->position];
+        scanned = 1;
+        while(zero_counter < order - 1){
+            if(reader->end - reader->position == scanned && !ensure_available(reader, scanned + 1)){
+                if(!reader->failed){
+                    fprintf(stderr, "Unexpected EOF.\n");
+                    reader->failed = TRUE;
                 }
+                return FALSE;
+            }
+            code = reader->data + reader->position;
+            available = reader->end - reader->position;
+            while(zero_counter < order - 1 && scanned < available){
+                if(code[scanned] == 0) zero_counter++;
+                scanned++;
             }
-            code[buffer_size] = (unsigned short) getc(file);
-            if (code[buffer_size] == 0) zero_counter++;
-            buffer_size++;
         }
+        view->data = reader->data + reader->position;
+        view->two_byte_entries = FALSE;
+        view->length = scanned;
     } else {
-        read_count = fread(code, sizeof (unsigned short), 1, file);
-        if(!read_count){
-            fprintf(stderr, "Unexpected EOF.\n");
-            free(code);
-            return NULL;
-        }
-        buffer_size = 1;
-        zero_counter = 0;
-        while (zero_counter < code[0]-1) {
-            if(buffer_size==code_length){
-                code_length = (2*code_length < (code[0]*(code[0] - 1)/2)) ? 2*code_length : (code[0]*(code[0] - 1)/2);
-                // (code[0]*(code[0] - 1)/2) is the maximum code length for this number of vertices 
-                unsigned short* new_code = realloc(code, code_length*sizeof(unsigned short));
-                if(new_code == NULL){
-                    free(code);
-                    fprintf(stderr, "Insufficient memory to store code for this graph.\n");
-                    return NULL;
-                } else {
-                    code = new_code;
+        if(!ensure_available(reader, 3)){
+            if(!reader->failed){
+                fprintf(stderr, "Unexpected EOF.\n");
+                reader->failed = TRUE;
+            }
+            return FALSE;
+        }
+        memcpy(&entry, reader->data + reader->position + 1, sizeof(unsigned short));
+        order = entry;
+        scanned = 3;
+        while(zero_counter < order - 1){
+            if(reader->end - reader->position < scanned + 2 && !ensure_available(reader, scanned + 2)){
+                if(!reader->failed){
+                    fprintf(stderr, "Unexpected EOF.\n");
+                    reader->failed = TRUE;
                 }
+                return FALSE;
             }
-            read_count = fread(code + buffer_size, sizeof (unsigned short), 1, file);
-            if(!read_count){
-                fprintf(stderr, "Unexpected EOF.\n");
-                free(code);
-                return NULL;
+            code = reader->data + reader->position;
+            available = reader->end - reader->position;
+            while(zero_counter < order - 1 && scanned + 2 <= available){
+                if(code[scanned] == 0 && code[scanned + 1] == 0) zero_counter++;
+                scanned += 2;
             }
-            if (code[buffer_size] == 0) zero_counter++;
-            buffer_size++;
         }
+        view->data = reader->data + reader->position + 1;
+        view->two_byte_entries = TRUE;
+        view->length = (scanned - 1)/2;
     }
+    view->order = order;
+    
+    //the view stays valid because the buffer is only changed in the next call
+    reader->position += scanned;
+    
+    return TRUE;
+}
 
+/* Returns a newly allocated copy of the code in view.
+ */
+unsigned short *copy_multi_code_view(MULTICODE_VIEW *view) {
+    int i;
+    
+    unsigned short* code = malloc(view->length*sizeof(unsigned short));
+    if(code == NULL){
+        fprintf(stderr, "Insufficient memory to store code for this graph.\n");
+        return NULL;
+    }
+    
+    if(view->two_byte_entries){
+        memcpy(code, view->data, view->length*sizeof(unsigned short));
+    } else {
+        for(i = 0; i < view->length; i++){
+            code[i] = view->data[i];
+        }
+    }
+    
     return code;
 }
 
+/* Each stream that is read with read_multi_code gets its own reader. Readers
+ * are never freed, because read_multi_code cannot know whether the caller is
+ * done with a stream. The options that are used for a stream are those that
+ * were passed the first time that stream was read.
+ */
+typedef struct __stream_reader STREAM_READER;
+
+struct __stream_reader {
+    FILE *file;
+    MULTICODE_READER *reader;
+};
+
+static STREAM_READER stream_readers[MAX_STREAM_COUNT];
+static int stream_reader_count = 0;
+
+static MULTICODE_READER *get_stream_reader(FILE *file, GRAPH_INPUT_OPTIONS *options) {
+    int i;
+    
+    for(i = 0; i < stream_reader_count; i++){
+        if(stream_readers[i].file == file){
+            return stream_readers[i].reader;
+        }
+    }
+    
+    if(stream_reader_count == MAX_STREAM_COUNT){
+        fprintf(stderr, "Too many multicode streams (%d).\n", MAX_STREAM_COUNT);
+        return NULL;
+    }
+    MULTICODE_READER *reader = new_multicode_reader(file, options);
+    if(reader == NULL){
+        return NULL;
+    }
+    stream_readers[stream_reader_count].file = file;
+    stream_readers[stream_reader_count].reader = reader;
+    stream_reader_count++;
+    
+    return reader;
+}
+
+unsigned short *read_multi_code(FILE *file, GRAPH_INPUT_OPTIONS *options) {
+    MULTICODE_VIEW view;
+    
+    MULTICODE_READER *reader = get_stream_reader(file, options);
+    if(reader == NULL || !next_multi_code(reader, &view)){
+        return NULL;
+    }
+    
+    return copy_multi_code_view(&view);
+}
+
 GRAPH *read_and_decode_multi_code(FILE *f, GRAPH_INPUT_OPTIONS *options){
     unsigned short *code = read_multi_code(f, options);
     if(code == NULL){
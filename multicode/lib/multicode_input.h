@@ -31,6 +31,34 @@ struct __graph_input_options {
 //the default code length is sufficient to store any graph with less than 100 vertices
 #define DEFAULT_GRAPH_INPUT_OPTIONS(options) GRAPH_INPUT_OPTIONS options = {TRUE, TRUE, 700, 0, 1, 0, 0, 1, 0}
 
+/* A view on a single code inside the input of a multicode reader. The view
+ * refers directly to the bytes of the input and is only valid until the next
+ * call to next_multi_code for the same reader.
+ */
+typedef struct __multicode_view MULTICODE_VIEW;
+
+struct __multicode_view {
+    //points to the entry containing the order of the graph
+    const unsigned char *data;
+    //TRUE if each entry consists of two bytes
+    boolean two_byte_entries;
+    int order;
+    //number of entries, including the order
+    int length;
+};
+
+typedef struct __multicode_reader MULTICODE_READER;
+
+MULTICODE_READER *new_multicode_reader(FILE *file, GRAPH_INPUT_OPTIONS *options);
+
+void free_multicode_reader(MULTICODE_READER *reader);
+
+boolean next_multi_code(MULTICODE_READER *reader, MULTICODE_VIEW *view);
+
+unsigned short *copy_multi_code_view(MULTICODE_VIEW *view);
+
+GRAPH *decode_multi_code_view(MULTICODE_VIEW *view, GRAPH_INPUT_OPTIONS *options);
+
 GRAPH *decode_multi_code(unsigned short* code, GRAPH_INPUT_OPTIONS *options);
 
 unsigned short *read_multi_code(FILE *file, GRAPH_INPUT_OPTIONS *options);
@@ -13,7 +13,8 @@
  * Compile with:
  *     
  *     cc -o multi_add_edges -O4  multi_add_edges.c shared/multicode_base.c \
- *     shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
@@ -12,7 +12,8 @@
  * Compile with:
  *     
  *     cc -o multi_adjacency_matrix -O4  multi_adjacency_matrix.c \
- *     shared/multicode_base.c shared/multicode_input.c
+ *     shared/multicode_base.c shared/multicode_input.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
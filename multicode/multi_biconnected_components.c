@@ -11,7 +11,8 @@
  * Compile with:
  *     
  *     cc -o multi_biconnected_components -O4  multi_biconnected_components.c 
- *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
@@ -13,7 +13,8 @@
  * Compile with:
  *     
  *     cc -o multi_combine -O4  multi_combine.c shared/multicode_base.c \
- *     shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_input.c shared/multicode_output.c shared/multicode_csr.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
@@ -23,26 +24,27 @@
 
 #include "shared/multicode_base.h"
 #include "shared/multicode_input.h"
+#include "shared/multicode_csr.h"
 #include "shared/multicode_output.h"
 
-void combineGraphs(GRAPH graph1, ADJACENCY adj1, GRAPH graph2, ADJACENCY adj2,
+void combineGraphs(CSR_GRAPH *graph1, CSR_GRAPH *graph2,
                    GRAPH combinedGraph, ADJACENCY combinedAdj, int newOrder, int *translations){
     int i, j;
     
     prepareGraph(combinedGraph, combinedAdj, newOrder);
     
-    for(i=1; i<=graph1[0][0]; i++){
-        for(j=0; j<adj1[i]; j++){
-            if(i < graph1[i][j]){
-                addEdge(combinedGraph, combinedAdj, i, graph1[i][j]);
+    for(i=1; i<=graph1->order; i++){
+        for(j=0; j<CSR_DEGREE(graph1, i); j++){
+            if(i < CSR_NEIGHBOUR(graph1, i, j)){
+                addEdge(combinedGraph, combinedAdj, i, CSR_NEIGHBOUR(graph1, i, j));
             }
         }
     }
     
-    for(i=1; i<=graph2[0][0]; i++){
-        for(j=0; j<adj2[i]; j++){
-            if(i < graph2[i][j]){
-                addEdge(combinedGraph, combinedAdj, translations[i], translations[graph2[i][j]]);
+    for(i=1; i<=graph2->order; i++){
+        for(j=0; j<CSR_DEGREE(graph2, i); j++){
+            if(i < CSR_NEIGHBOUR(graph2, i, j)){
+                addEdge(combinedGraph, combinedAdj, translations[i], translations[CSR_NEIGHBOUR(graph2, i, j)]);
             }
         }
     }
@@ -73,11 +75,8 @@ void usage(char *name) {
 int main(int argc, char** argv) {
     int i;
     
-    GRAPH graph1;
-    ADJACENCY adj1;
-    
-    GRAPH graph2;
-    ADJACENCY adj2;
+    CSR_GRAPH *graph1 = newCsrGraph(0, 0);
+    CSR_GRAPH *graph2 = newCsrGraph(0, 0);
     
     GRAPH combinedGraph;
     ADJACENCY combinedAdj;
@@ -110,27 +109,27 @@ int main(int argc, char** argv) {
     
     int identificationCount = argc - optind;
     
-    unsigned short code[MAXCODELENGTH];
-    int length;
-    if (readMultiCode(code, &length, stdin)) {
-        decodeMultiCode(code, length, graph1, adj1);
+    MULTICODE_READER *reader = newMultiCodeReader(stdin);
+    MULTICODE_VIEW code;
+    if (nextMultiCode(reader, &code)) {
+        decodeMultiCodeViewToCsr(&code, graph1);
         
     } else {
         fprintf(stderr, "Error! Could not read first graph.\n");
         return (EXIT_FAILURE);
     }
     
-    if (readMultiCode(code, &length, stdin)) {
-        decodeMultiCode(code, length, graph2, adj2);
+    if (nextMultiCode(reader, &code)) {
+        decodeMultiCodeViewToCsr(&code, graph2);
         
     } else {
         fprintf(stderr, "Error! Could not read second graph.\n");
         return (EXIT_FAILURE);
     }
     
-    int translation[graph2[0][0]+1];
+    int translation[graph2->order+1];
     
-    for (i = 0; i <= graph2[0][0]; i++){
+    for (i = 0; i <= graph2->order; i++){
         translation[i] = 0;
     }
     
@@ -144,21 +143,25 @@ int main(int argc, char** argv) {
         }
         translation[g2] = g1;
     }
-    int vertexCounter = graph1[0][0];
-    for (i = 1; i <= graph2[0][0]; i++){
+    int vertexCounter = graph1->order;
+    for (i = 1; i <= graph2->order; i++){
         if(!translation[i]){
             vertexCounter++;
             translation[i] = vertexCounter;
         }
     }
-    if(vertexCounter != graph1[0][0] + graph2[0][0] - identificationCount){
+    if(vertexCounter != graph1->order + graph2->order - identificationCount){
         fprintf(stderr, "Something went wrong -- exiting!\n");
         exit(EXIT_FAILURE);
     }
     
-    combineGraphs(graph1, adj1, graph2, adj2, combinedGraph, combinedAdj, vertexCounter, translation);
+    combineGraphs(graph1, graph2, combinedGraph, combinedAdj, vertexCounter, translation);
 
     writeMultiCode(combinedGraph, combinedAdj, stdout);
+    
+    freeCsrGraph(graph1);
+    freeCsrGraph(graph2);
+    freeMultiCodeReader(reader);
 
     return (EXIT_SUCCESS);
 }
@@ -11,7 +11,8 @@
  * Compile with:
  *     
  *     cc -o multi_complement -O4  multi_complement.c shared/multicode_base.c \
- *     shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
@@ -11,7 +11,8 @@
  * Compile with:
  *     
  *     cc -o multi_component -O4  multi_component.c shared/multicode_base.c \
- *     shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
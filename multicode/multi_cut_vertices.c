@@ -11,7 +11,7 @@
  * Compile with:
  *     
  *     cc -o multi_cut_vertices -O4  multi_cut_vertices.c shared/multicode_base.c \
- *     shared/multicode_input.c
+ *     shared/multicode_input.c shared/multicode_scanner.c
  * 
  */
 
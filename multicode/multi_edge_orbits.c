@@ -13,6 +13,7 @@
  * 
  *     cc -o multi_edge_orbits -O4 multi_edge_orbits.c \
  *          shared/multicode_base.c shared/multicode_input.c \
+ *          shared/multicode_scanner.c \
  *          ../nauty/nauty.c ../nauty/nautil.c ../nauty/naugraph.c\
  *          ../nauty/schreier.c ../nauty/naurng.c
  * 
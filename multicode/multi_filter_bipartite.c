@@ -11,7 +11,8 @@
  * Compile with:
  *     
  *     cc -o multi_filter_bipartite -O4  multi_filter_bipartite.c \
- *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
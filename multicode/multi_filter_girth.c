@@ -0,0 +1,141 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* This program reads graphs in multicode format from standard in and
+ * writes those that have at least a given girth to standard out in
+ * multicode format.
+ *
+ * Compile with:
+ *
+ *     cc -o multi_filter_girth -O4  multi_filter_girth.c \
+ *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c \
+ *     shared/multicode_girth.c
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include "shared/multicode_base.h"
+#include "shared/multicode_input.h"
+#include "shared/multicode_output.h"
+#include "shared/multicode_girth.h"
+
+boolean onlyCount = FALSE;
+
+//====================== USAGE =======================
+
+void help(char *name) {
+    fprintf(stderr, "The program %s filters out graphs that have at least a given girth.\n\n", name);
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options] -g #\n\n", name);
+    fprintf(stderr, "Loops are cycles of length 1 and parallel edges are cycles of length 2.\n");
+    fprintf(stderr, "Graphs without cycles have any girth.\n");
+    fprintf(stderr, "\nThis program can handle graphs up to %d vertices. Recompile if you need larger\n", MAXN);
+    fprintf(stderr, "graphs.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -g #, --min-girth #\n");
+    fprintf(stderr, "       Accept graphs that contain no cycle shorter than #.\n");
+    fprintf(stderr, "    -c, --count\n");
+    fprintf(stderr, "       Only count the number of graphs that have at least the given girth.\n");
+    fprintf(stderr, "    -i, --invert\n");
+    fprintf(stderr, "       Accept graphs only if they do NOT have at least the given girth.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options] -g #\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+
+    GRAPH graph;
+    ADJACENCY adj;
+
+    int graphsRead = 0;
+    int graphsFiltered = 0;
+
+    boolean invertFilter = FALSE;
+    int minimumGirth = -1;
+
+    /*=========== commandline parsing ===========*/
+
+    int c;
+    char *name = argv[0];
+    static struct option long_options[] = {
+        {"min-girth", required_argument, NULL, 'g'},
+        {"invert", no_argument, NULL, 'i'},
+        {"count", no_argument, NULL, 'c'},
+        {"help", no_argument, NULL, 'h'}
+    };
+    int option_index = 0;
+
+    while ((c = getopt_long(argc, argv, "hcig:", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'g':
+                minimumGirth = atoi(optarg);
+                if(minimumGirth < 1){
+                    fprintf(stderr, "The girth should be at least 1.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'i':
+                invertFilter = TRUE;
+                break;
+            case 'c':
+                onlyCount = TRUE;
+                break;
+            case 'h':
+                help(name);
+                return EXIT_SUCCESS;
+            case '?':
+                usage(name);
+                return EXIT_FAILURE;
+            default:
+                fprintf(stderr, "Illegal option %c.\n", c);
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(minimumGirth < 0){
+        fprintf(stderr, "The minimum girth needs to be specified.\n");
+        usage(name);
+        return EXIT_FAILURE;
+    }
+
+    unsigned short code[MAXCODELENGTH];
+    int length;
+    while (readMultiCode(code, &length, stdin)) {
+        decodeMultiCode(code, length, graph, adj);
+        graphsRead++;
+
+        if(hasGirthAtLeast(graph, adj, minimumGirth) != invertFilter){
+            if(!onlyCount){
+                writeMultiCode(graph, adj, stdout);
+            }
+            graphsFiltered++;
+        }
+    }
+
+    fprintf(stderr, "Read %d graph%s.\n", graphsRead, graphsRead==1 ? "" : "s");
+    fprintf(stderr, "Filtered %d graph%s with%s girth at least %d.\n",
+            graphsFiltered,
+            graphsFiltered==1 ? "" : "s",
+            invertFilter ? "out" : "",
+            minimumGirth);
+
+    return (EXIT_SUCCESS);
+}
@@ -11,7 +11,9 @@
  * Compile with:
  *     
  *     cc -o multi_filter_regular -O4  multi_filter_regular.c \
- *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c \
+ *     shared/multicode_csr.c
  * 
  */
 
@@ -21,6 +23,7 @@
 
 #include "shared/multicode_base.h"
 #include "shared/multicode_input.h"
+#include "shared/multicode_csr.h"
 #include "shared/multicode_output.h"
 
 boolean kRegular = FALSE;
@@ -28,17 +31,20 @@ int k;
 
 boolean onlyCount = FALSE;
 
-boolean isRegular(GRAPH graph, ADJACENCY adj){
+boolean isRegular(CSR_GRAPH *graph){
     int i;
     
-    int order = graph[0][0];
-    int degree = adj[1];
+    int order = graph->order;
+    if(order == 0){
+        return !kRegular;
+    }
+    int degree = CSR_DEGREE(graph, 1);
     if(kRegular && degree != k){
         return FALSE;
     }
     
     for(i=2; i<=order; i++){
-        if(adj[i]!=degree){
+        if(CSR_DEGREE(graph, i)!=degree){
             return FALSE;
         }
     }
@@ -112,20 +118,25 @@ int main(int argc, char** argv) {
         }
     }
     
-    unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readMultiCode(code, &length, stdin)) {
-        decodeMultiCode(code, length, graph, adj);
+    MULTICODE_READER *reader = newMultiCodeReader(stdin);
+    MULTICODE_VIEW code;
+    CSR_GRAPH *csr = newCsrGraph(0, 0);
+    while (nextMultiCode(reader, &code)) {
+        decodeMultiCodeViewToCsr(&code, csr);
         graphsRead++;
         
-        if(isRegular(graph, adj)){
+        if(isRegular(csr)){
             if(!onlyCount){
+                csrToGraph(csr, graph, adj);
                 writeMultiCode(graph, adj, stdout);
             }
             graphsFiltered++;
         }
     }
     
+    freeCsrGraph(csr);
+    freeMultiCodeReader(reader);
+    
     fprintf(stderr, "Read %d graph%s.\n", graphsRead, graphsRead==1 ? "" : "s");
     fprintf(stderr, "Filtered %d graph%s.\n", graphsFiltered, graphsFiltered==1 ? "" : "s");
 
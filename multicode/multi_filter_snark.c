@@ -11,7 +11,10 @@
  * Compile with:
  *     
  *     cc -o multi_filter_snarks -O4  multi_filter_snarks.c \
- *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c \
+ *     shared/multicode_girth.c shared/multicode_bitset.c \
+ *     shared/multicode_edge_colouring.c
  * 
  */
 
@@ -22,9 +25,9 @@
 #include "shared/multicode_base.h"
 #include "shared/multicode_input.h"
 #include "shared/multicode_output.h"
-
-#define DEBUGASSERT(assertion) if(!(assertion)) {fprintf(stderr, "%s:%u Assertion failed: %s\n", __FILE__, __LINE__, #assertion); fflush(stderr); exit(1);}
-//#define DEBUGASSERT(assertion)
+#include "shared/multicode_girth.h"
+#include "shared/multicode_bitset.h"
+#include "shared/multicode_edge_colouring.h"
 
 boolean onlyCount = FALSE;
 
@@ -36,463 +39,227 @@ boolean cyclically4EdgeConnected = TRUE;
 
 //------------------Start connectivity methods--------------------------------
 
-//adapted from snarkhunter
+/* A cubic graph with girth at least 4 is cyclically 4-edge-connected if and
+ * only if it is connected and the only edge cuts with at most three edges are
+ * the sets of three edges at a vertex.
+ *
+ * These edge cuts are found with the cut space of the graph. Each edge gets a
+ * label: the set of edges outside a spanning tree whose fundamental cycle
+ * contains the edge. A set of edges is an edge cut if and only if it meets each
+ * fundamental cycle in an even number of edges, i.e., if and only if the
+ * symmetric difference of the labels of its edges is empty. So an edge with
+ * an empty label is a bridge, two edges with the same label form a 2-edge-cut
+ * and three edges with an empty symmetric difference form a 3-edge-cut. If
+ * there are no bridges and 2-edge-cuts, then the edges of a non-trivial
+ * 3-edge-cut are pairwise disjoint, and three pairwise disjoint edges never
+ * form a trivial 3-edge-cut. So for each pair of disjoint edges a hash table
+ * of the labels is used to look for a third edge that completes it to an edge
+ * cut.
+ */
 
+#define MAXE (3 * MAXN / 2)
+#define MAX_LABEL_WORDS ((MAXE - MAXN + 1 + BITSET_WORD_SIZE - 1) / BITSET_WORD_SIZE)
+//a power of 2 that is at least twice the number of edges
+#define LABEL_TABLE_SIZE (1 << 14)
 
-void label_dfs_cut(GRAPH graph, int vertex, int previous_vertex, int number[], int *new_number, int *cut, int *lowpt) {
-    int i, neighbour, number_neighbour;
-    int locallowpt_vertex, lowpt_neighbour;
+int edgeEnds[MAXE][2];
+int edgesAt[MAXN + 1][3];
+int edgeCount;
 
-    number[vertex] = locallowpt_vertex = *new_number;
-    (*new_number)++;
-    for(i = 0; i < 3; i++) {
-        neighbour = graph[vertex][i];
-        if((number_neighbour = number[neighbour])) {
-            if((neighbour != previous_vertex) && (number_neighbour < locallowpt_vertex))
-                locallowpt_vertex = number_neighbour;
-        } else {
-            label_dfs_cut(graph, neighbour, vertex, number, new_number, cut, &lowpt_neighbour);
-            if(lowpt_neighbour < locallowpt_vertex)
-                locallowpt_vertex = lowpt_neighbour;
-        }
-    }
+int treeEdge[MAXN + 1];
+boolean isTreeEdge[MAXE];
+int treeOrder[MAXN];
 
-    if(locallowpt_vertex == number[vertex])
-        *cut = 1;
-    *lowpt = locallowpt_vertex;
+BITSET_WORD cutLabels[MAXE * MAX_LABEL_WORDS];
+int labelWords;
 
-}
+int labelTable[LABEL_TABLE_SIZE];
+int labelTableMask;
 
-/**
- * Checks if the graph without vertices forbidden_vertex1 and forbidden_vertex2 has a bridge.
- * Returns 0 if it has a bridge, else returns 1.
- *
- * If both forbidden_vertex1 >= 0 and forbidden_vertex2 >= 0, forbidden_vertex1
- * will always be < forbidden_vertex2.
- * If forbidden_vertex1 and forbidden_vertex2 are both < 0, no vertices will be removed.
- * If only forbidden_vertex2 < 0 (and forbidden_vertex1 >= 0), only forbidden_vertex1
- * will be removed.
- * If forbidden_vertex1 < 0, forbidden_vertex2 must also be < 0.
- *
- * Remark: because we're dealing with cubic graphs, a graph has a bridge iff
- * it has a cutvertex.
- */
-int is_twoconnected(GRAPH graph, int forbidden_vertex1, int forbidden_vertex2) {
-    int i, number[graph[0][0]], start;
-    int cut, dummy, nextnumber;
-
-    cut = 0;
-    for(i = 1; i <= graph[0][0]; i++) number[i] = 0;
-    number[forbidden_vertex1] = INT_MAX;
-    if(forbidden_vertex1 >= forbidden_vertex2) {
-        fprintf(stderr, "Error: forbidden_vertex1 must always be smaller than forbidden_vertex2\n");
-        exit(1);
-    }
-    number[forbidden_vertex2] = INT_MAX;
-    if(forbidden_vertex1 == 1) {
-        for(start = 1; start <= graph[0][0]; start++)
-            if(start != forbidden_vertex2)
-                break;
-    } else
-        start = 1;
-    number[start] = 1;
-    nextnumber = 2;
-    if(graph[start][0] != forbidden_vertex1 && graph[start][0] != forbidden_vertex2)
-        label_dfs_cut(graph, graph[start][0], start, number, &nextnumber, &cut, &dummy);
-    else if(graph[start][1] != forbidden_vertex1 && graph[start][1] != forbidden_vertex2)
-        label_dfs_cut(graph, graph[start][1], start, number, &nextnumber, &cut, &dummy);
-    else
-        label_dfs_cut(graph, graph[start][2], start, number, &nextnumber, &cut, &dummy);
-    if(cut || (number[graph[start][1]] == 0) || (number[graph[start][2]] == 0))
-        return 0;
-    
-    return 1;
-
-}
+#define LABEL(e) (cutLabels + (size_t)(e) * labelWords)
 
-boolean haveCommonNeighbour(GRAPH graph, int v1, int v2){
-    int i, j;
-    for(i = 0; i < 3; i++){
-        for(j = 0; j< 3; j++){
-            if(graph[v1][i]==graph[v2][j]) return TRUE;
+/* Computes the labels of the edges for a breadth-first search tree. Returns
+ * FALSE if the graph is not connected. This method only works for simple
+ * cubic graphs.
+ */
+boolean computeCutLabels(GRAPH graph){
+    int order = graph[0][0];
+    int v, i, j, head, tail, cycleCount;
+
+    edgeCount = 0;
+    for(v = 1; v <= order; v++){
+        for(i = 0; i < 3; i++){
+            int w = graph[v][i];
+            if(v < w){
+                edgeEnds[edgeCount][0] = v;
+                edgeEnds[edgeCount][1] = w;
+                edgesAt[v][i] = edgeCount;
+                edgeCount++;
+            } else {
+                for(j = 0; graph[w][j] != v; j++);
+                edgesAt[v][i] = edgesAt[w][j];
+            }
         }
+        treeEdge[v] = -1;
     }
-    return FALSE;
-}
-
-boolean areAdjacent_3regular(GRAPH graph, int v1, int v2){
-    int i;
-    for(i = 0; i < 3; i++){
-        if(graph[v1][i]==v2) return TRUE;
+    for(i = 0; i < edgeCount; i++){
+        isTreeEdge[i] = FALSE;
     }
-    return FALSE;
-}
 
-/**
- * Returns TRUE if current_graph has a nontrivial threecut, else returns FALSE.
- *
- * Algorithm: removes 2 vertices and tests if the resulting graph has a bridge.
- *
- * This algorithm is not very efficient but it's simple.
- */
-int has_nontrivial_threecut(GRAPH graph) {
-
-    int i, j;
-    for(i = 1; i <= graph[0][0] - 1; i++) {
-        for(j = i + 1; j <= graph[0][0]; j++) {
-            if(!haveCommonNeighbour(graph, i, j)) { 
-                //Don't continue if there is a common neighbour: if common neighbour, there will be a trivial threecut
-                //Don't test connectivity if i and j are neighbours, because if it's not twoconnected after
-                //the removal of i and j, there will also be other nonadjacent cutvertices which will yield a bridge
-                if(!areAdjacent_3regular(graph, i, j)&& !is_twoconnected(graph, i, j)) {
-                    return TRUE;
-                }
+    //the root is marked by a tree edge that does not exist
+    treeEdge[1] = edgeCount;
+    treeOrder[0] = 1;
+    head = 0;
+    tail = 1;
+    while(head < tail){
+        int u = treeOrder[head++];
+        for(i = 0; i < 3; i++){
+            int w = graph[u][i];
+            if(treeEdge[w] == -1){
+                treeEdge[w] = edgesAt[u][i];
+                isTreeEdge[treeEdge[w]] = TRUE;
+                treeOrder[tail++] = w;
             }
         }
     }
-
-    return FALSE;
-}
-
-//------------------End connectivity methods--------------------------------
-
-//------------------Start girth methods--------------------------------
-
-/**
-  * Return the minimum of the given girth and the length of the shortest
-  * cycle through the given vertex.
-  */
-int pseudoGirth(GRAPH graph, int v, int girth) {
-    int i;
-    
-    int n = graph[0][0];
-        
-    int queue[n];
-    int head = 0;
-    int tail = 0;
-
-    int levels[n+1];
-    for(i=1; i<=n; i++){
-        levels[i]=-1;
-    }
-    queue[head] = v;
-
-    int lim = girth / 2;
-
-    head ++;
-    levels[v] = 0;
-    while (head > tail) {
-        int vertex = queue[tail];
-        int d = levels[vertex];
-        if (d >= lim)
-            return girth; // can never improve current girth
-        tail ++;
-        for (i=0; i<3; i++) {
-            int nb = graph[vertex][i];
-            int e = levels[nb];
-            if (e < 0) {
-                // not yet encountered
-                levels[nb] = d+1;
-                queue[head] = nb;
-                head ++;
-            } else if (e == d) {
-                // odd cycle
-                return 2*d + 1;
-            } else if (e > d) {
-                // even cycle
-                if (girth > 2*e) {
-                    girth = 2*e; // == 2*d+2
-                }
-            } //else {
-                // returns towards v, ignore
-            //}
-        }
+    if(tail < order){
+        return FALSE;
     }
-    return girth;
-}
 
-/**
-  * Return the minimum of the given upperBound and the girth.
-  */
-int girth(GRAPH graph, int upperBound){
-    int i;
-    int girth = upperBound;
-    
-    for(i=1; i<=graph[0][0]; i++){
-        girth = pseudoGirth(graph, i, girth);
+    cycleCount = edgeCount - order + 1;
+    labelWords = (cycleCount + BITSET_WORD_SIZE - 1) / BITSET_WORD_SIZE;
+    for(i = 0; i < edgeCount * labelWords; i++){
+        cutLabels[i] = 0;
     }
-    
-    return girth;
-}
 
-//------------------End girth methods--------------------------------
-
-//------------------Start colouring methods--------------------------------
-
-/* Store the colouring of the current graph
-* This goes to 4 for efficiency reason, only used until 3 at most
-*/
-int colours[MAXN+1][4];
-
-int coloursAroundVertex[MAXN+1];
-
-int neighbourToIndexMapping[MAXN+1][MAXN+1];
-
-static int markvalue_edges = 3;
-unsigned int marks_edges[MAXN+1][4]; //goes to 4 for efficiency reason, only used until 3 at most
-#define RESETMARKS_EDGES {int mki, mkj; if ((markvalue_edges += 1) > 3) \
-{ markvalue_edges = 1; for(mki=0;mki<MAXN+1;++mki) for(mkj=0;mkj<3;++mkj) marks_edges[mki][mkj]=0;}}
-#define MARK_EDGES(v, w) marks_edges[v][w] = markvalue_edges
-#define UNMARK_EDGES(v, w) marks_edges[v][w] = markvalue_edges - 1
-#define ISMARKED_EDGES(v, w) (marks_edges[v][w] == markvalue_edges)
-
-void initIs3Colourable(GRAPH graph) {
-    RESETMARKS_EDGES;
-    int i, j;
-    for (i = 1; i <= graph[0][0]; i++) {
-        coloursAroundVertex[i] = 0;
-        for(j = 0; j < 3; j++) {
-            neighbourToIndexMapping[i][graph[i][j]] = j;
+    //each edge outside the tree is added to its own label and to the labels of the tree edges above its end points
+    cycleCount = 0;
+    for(i = 0; i < edgeCount; i++){
+        if(!isTreeEdge[i]){
+            BITSET_ADD(LABEL(i), cycleCount);
+            for(j = 0; j < 2; j++){
+                if(edgeEnds[i][j] != 1){
+                    LABEL(treeEdge[edgeEnds[i][j]])[cycleCount / BITSET_WORD_SIZE] ^=
+                            1ULL << (cycleCount % BITSET_WORD_SIZE);
+                }
+            }
+            cycleCount++;
         }
     }
-
-}
-
-int isConflictingColouring(int currentVertex, int colour) {
-    int i;
-    for(i = 0; i < 3; i++) {
-        if(ISMARKED_EDGES(currentVertex, i) && colours[currentVertex][i] == colour)
-            return TRUE;
+    //the label of a tree edge is the sum of these contributions over the subtree below it
+    for(i = order - 1; i > 0; i--){
+        v = treeOrder[i];
+        int parentEdge = treeEdge[v];
+        int parent = edgeEnds[parentEdge][0] == v ? edgeEnds[parentEdge][1] : edgeEnds[parentEdge][0];
+        if(parent != 1){
+            BITSET_WORD *parentLabel = LABEL(treeEdge[parent]);
+            BITSET_WORD *label = LABEL(parentEdge);
+            for(j = 0; j < labelWords; j++){
+                parentLabel[j] ^= label[j];
+            }
+        }
     }
-    return FALSE;
 
+    return TRUE;
 }
 
-
-inline void determineAvailableColours(int usedColour, int *availableColours) {
-    switch(usedColour) {
-        case 1:
-            availableColours[0] = 2;
-            availableColours[1] = 3;
-            break;
-        case 2:
-            availableColours[0] = 1;
-            availableColours[1] = 3;
-            break;
-        case 3:
-            availableColours[0] = 1;
-            availableColours[1] = 2;
-            break;
-        default:
-            fprintf(stdout, "Invalid previous colour");
-            exit(0);
+/* The fingerprint of a label is the exclusive or of its words, where word i
+ * is first rotated over i bits. The fingerprint of the symmetric difference
+ * of two labels is the exclusive or of their fingerprints, so the hash table
+ * can be searched without computing the symmetric difference. Labels with
+ * the same fingerprint are compared word by word.
+ */
+BITSET_WORD fingerprints[MAXE];
+
+void computeFingerprints(){
+    int e, i;
+    for(e = 0; e < edgeCount; e++){
+        BITSET_WORD *label = LABEL(e);
+        fingerprints[e] = label[0];
+        for(i = 1; i < labelWords; i++){
+            int shift = i % BITSET_WORD_SIZE;
+            fingerprints[e] ^= shift ? (label[i] << shift) | (label[i] >> (BITSET_WORD_SIZE - shift)) : label[i];
+        }
     }
 }
 
-void determineUncolouredVertex(int vertex, int *uncolouredVertex, int *missingColour, GRAPH graph) {
-    DEBUGASSERT(coloursAroundVertex[vertex] == 2);
+#define HASH_FINGERPRINT(fingerprint) \
+    ((unsigned int)(((fingerprint) * 0x9E3779B97F4A7C15ULL) >> 32) & labelTableMask)
 
+/* Returns TRUE if the label of g is the symmetric difference of the labels
+ * of e and f. If f is -1, then the label of g is compared to the label of e.
+ */
+boolean isLabelSum(int g, int e, int f){
     int i;
-    int sum_colours = 0;
-    for(i = 0; i < 3; i++) {
-        if(!ISMARKED_EDGES(vertex, i)) {
-            *uncolouredVertex = graph[vertex][i];
-        } else {
-            sum_colours += colours[vertex][i];
+    for(i = 0; i < labelWords; i++){
+        if(LABEL(g)[i] != (f == -1 ? LABEL(e)[i] : LABEL(e)[i] ^ LABEL(f)[i])){
+            return FALSE;
         }
     }
-    switch(sum_colours) {
-        case 3:
-            *missingColour = 3;
-            break;
-        case 4:
-            *missingColour = 2;
-            break;
-        case 5:
-            *missingColour = 1;
-            break;
-        default:
-            fprintf(stderr, "Invalid sum_colours: %d\n", sum_colours);
-            fprintf(stderr, "vertex %d\n", vertex);
-            exit(0);
-    }
-
+    return TRUE;
 }
 
-void unmarkColours(int nonfree_labelled[][2], int nonfree_labelled_size) {
-    int i;
-    int vertex0, vertex1;
-    for(i = 0; i < nonfree_labelled_size; i++) {
-        vertex0 = nonfree_labelled[i][0];
-        vertex1 = nonfree_labelled[i][1];
-        UNMARK_EDGES(vertex0, neighbourToIndexMapping[vertex0][vertex1]);
-        UNMARK_EDGES(vertex1, neighbourToIndexMapping[vertex1][vertex0]);
-        coloursAroundVertex[vertex0]--;
-        coloursAroundVertex[vertex1]--;
-    }
-}
+/**
+ * Returns TRUE if the graph has an edge cut with at most three edges that
+ * is not the set of edges at a vertex, else returns FALSE. The graph should
+ * be cubic and have girth at least 4.
+ */
+boolean hasNontrivialThreeCut(GRAPH graph) {
+    int e, f, i;
 
-/*
-* Starts from currentvertex and sets colours that are fixed by the current colours.
-* The edges that are coloured are stored, so this can be rolled back in case of a conflict.
-*/
-boolean propagateFixedColours(int currentVertex, int nonfree_labelled[][2], int *nonfree_labelled_size, GRAPH graph) {
-    int uncolouredVertex, missingColour;
-    //while the colour is fixed for currentVertex
-    while(coloursAroundVertex[currentVertex] == 2) {
-        //find the colour of the remaining edge
-        determineUncolouredVertex(currentVertex, &uncolouredVertex, &missingColour, graph);
-        //check that this colour gives no conflicts
-        if(!isConflictingColouring(uncolouredVertex, missingColour)) {
-            int indexUncolouredVertex = neighbourToIndexMapping[currentVertex][uncolouredVertex];
-            int indexCurrentVertex = neighbourToIndexMapping[uncolouredVertex][currentVertex];
-            colours[currentVertex][indexUncolouredVertex] = missingColour;
-            colours[uncolouredVertex][indexCurrentVertex] = missingColour;
-
-            MARK_EDGES(currentVertex, indexUncolouredVertex);
-            MARK_EDGES(uncolouredVertex, indexCurrentVertex);
-            coloursAroundVertex[currentVertex] = 3;
-            coloursAroundVertex[uncolouredVertex]++;
-
-            nonfree_labelled[*nonfree_labelled_size][0] = currentVertex;
-            nonfree_labelled[*nonfree_labelled_size][1] = uncolouredVertex;
-            (*nonfree_labelled_size)++;
-
-            currentVertex = uncolouredVertex;
-        } else {
-            //in case of conflicts: remove colours and return FALSE
-            unmarkColours(nonfree_labelled, *nonfree_labelled_size);
-            return FALSE;
-        }
+    if(!computeCutLabels(graph)){
+        return TRUE;
     }
-    return TRUE;
+    computeFingerprints();
 
-}
-
-/*
-* For this method we assume that the graph is a simple graph.
-*/
-int tryExtendingColouring(int numberOfColouredEdges, int numberOfEdges, GRAPH graph) {
-    if(numberOfColouredEdges != numberOfEdges) {
-        int currentVertex;
-
-        //look for vertex with uncoloured edges
-        //edges around vertex 1 are always coloured
-        for(currentVertex = 2; currentVertex <= graph[0][0]; currentVertex++) {
-            if(coloursAroundVertex[currentVertex] == 1) {
-                break;
-            }
-            DEBUGASSERT(coloursAroundVertex[currentVertex] != 2)
+    for(labelTableMask = 1; labelTableMask < 2*edgeCount; labelTableMask <<= 1);
+    labelTableMask--;
+    for(i = 0; i <= labelTableMask; i++){
+        labelTable[i] = -1;
+    }
+    for(e = 0; e < edgeCount; e++){
+        unsigned int slot = HASH_FINGERPRINT(fingerprints[e]);
+        for(i = 0; i < labelWords && !LABEL(e)[i]; i++);
+        if(i == labelWords){
+            //bridge
+            return TRUE;
         }
-        DEBUGASSERT(currentVertex <= graph[0][0]);
-
-        int usedColour; //the colour already used at this vertex
-        int i;
-        for(i = 0; i < 3; i++) {
-            if(ISMARKED_EDGES(currentVertex, i)) {
-                usedColour = colours[currentVertex][i];
-                break;
+        while(labelTable[slot] != -1){
+            if(fingerprints[labelTable[slot]] == fingerprints[e] &&
+                    isLabelSum(labelTable[slot], e, -1)){
+                //2-edge-cut
+                return TRUE;
             }
+            slot = (slot + 1) & labelTableMask;
         }
-        DEBUGASSERT(i < 3);
-
-        int availableVertices[2];
-        int indexAvailableVertex0 = (i + 1) % 3;
-        int indexAvailableVertex1 = (i + 2) % 3;
-        availableVertices[0] = graph[currentVertex][indexAvailableVertex0];
-        availableVertices[1] = graph[currentVertex][indexAvailableVertex1];
-
-        int availableColours[2];
-        determineAvailableColours(usedColour, availableColours);
-
-        DEBUGASSERT((availableColours[0] > 0 && availableColours[0] < 4) && (availableColours[1] > 0 && availableColours[1] < 4));
+        labelTable[slot] = e;
+    }
 
-        int nonfree_labelled[numberOfEdges - numberOfColouredEdges][2];
-        int j;
-        for(i = 0; i < 2; i++) {
-            if(isConflictingColouring(availableVertices[0], availableColours[i]) ||
-                    isConflictingColouring(availableVertices[1], availableColours[(i + 1) % 2])) {
+    for(e = 0; e < edgeCount; e++){
+        int e0 = edgeEnds[e][0], e1 = edgeEnds[e][1];
+        for(f = e + 1; f < edgeCount; f++){
+            BITSET_WORD fingerprint;
+            unsigned int slot;
+            if(e0 == edgeEnds[f][0] || e0 == edgeEnds[f][1] ||
+                    e1 == edgeEnds[f][0] || e1 == edgeEnds[f][1]){
                 continue;
             }
-
-            int indexCurrentVertex0 = neighbourToIndexMapping[availableVertices[0]][currentVertex];
-            int indexCurrentVertex1 = neighbourToIndexMapping[availableVertices[1]][currentVertex];
-
-            colours[availableVertices[0]][indexCurrentVertex0] = availableColours[i];
-            colours[availableVertices[1]][indexCurrentVertex1] = availableColours[(i + 1) % 2];
-
-            MARK_EDGES(availableVertices[0], indexCurrentVertex0);
-            MARK_EDGES(availableVertices[1], indexCurrentVertex1);
-
-            coloursAroundVertex[availableVertices[0]]++;
-            coloursAroundVertex[availableVertices[1]]++;
-
-            int nonfree_labelled_size = 0;
-            boolean abort = 0;
-            for(j = 0; j < 2;j++) {
-                if(!propagateFixedColours(availableVertices[j], nonfree_labelled, &nonfree_labelled_size, graph)) {
-                    DEBUGASSERT(nonfree_labelled_size <= numberOfEdges - numberOfColouredEdges)
-                    abort = TRUE;
-                    break;
-                }
-                DEBUGASSERT(nonfree_labelled_size <= numberOfEdges - numberOfColouredEdges)
-            }
-            //fprintf(stderr, "nonfree_labelled_size: %d and abort == %d \n", nonfree_labelled_size, abort);
-            if(!abort) {
-                colours[currentVertex][indexAvailableVertex0] = availableColours[i];
-                colours[currentVertex][indexAvailableVertex1] = availableColours[(i + 1) % 2];
-                MARK_EDGES(currentVertex, indexAvailableVertex0);
-                MARK_EDGES(currentVertex, indexAvailableVertex1);
-                coloursAroundVertex[currentVertex] = 3;
-
-                if(tryExtendingColouring(numberOfColouredEdges + nonfree_labelled_size + 2, numberOfEdges, graph)) {
+            fingerprint = fingerprints[e] ^ fingerprints[f];
+            slot = HASH_FINGERPRINT(fingerprint);
+            while(labelTable[slot] != -1){
+                if(fingerprints[labelTable[slot]] == fingerprint &&
+                        isLabelSum(labelTable[slot], e, f)){
                     return TRUE;
-                } else {
-                    unmarkColours(nonfree_labelled, nonfree_labelled_size);
                 }
-                UNMARK_EDGES(currentVertex, indexAvailableVertex0);
-                UNMARK_EDGES(currentVertex, indexAvailableVertex1);
-                coloursAroundVertex[currentVertex] = 1;
+                slot = (slot + 1) & labelTableMask;
             }
-
-            UNMARK_EDGES(availableVertices[0], indexCurrentVertex0);
-            UNMARK_EDGES(availableVertices[1], indexCurrentVertex1);
-
-            //number_of_colours_snarks[current_vertex] = 1;
-            coloursAroundVertex[availableVertices[0]]--;
-            coloursAroundVertex[availableVertices[1]]--;
         }
-        return FALSE;
-    } else {
-        return TRUE;
     }
-}
 
-/*
-* This method only works for simple graphs!
-* Stores the colouring in the array
-*/
-boolean is3ColourableGraph(GRAPH graph) {
-    initIs3Colourable(graph);
-
-    int currentVertex = 1;
-    int i, neighbour, currentIndex;
-    for(i = 0; i < 3; i++) {
-        colours[currentVertex][i] = i + 1;
-        neighbour = graph[currentVertex][i];
-        currentIndex = neighbourToIndexMapping[neighbour][currentVertex];
-        colours[neighbour][currentIndex] = i + 1;
-
-        MARK_EDGES(currentVertex, i);
-        MARK_EDGES(neighbour, currentIndex);
-        coloursAroundVertex[neighbour] = 1;
-    }
-    coloursAroundVertex[currentVertex] = 3;
-    int numberOfEdges = (3*graph[0][0])/2;
-    return tryExtendingColouring(3, numberOfEdges, graph);
+    return FALSE;
 }
 
-//------------------end colouring methods--------------------------------
+//------------------End connectivity methods--------------------------------
 
 boolean is3Regular(int order, ADJACENCY adj){
     int i;
@@ -514,7 +281,7 @@ boolean isSnark(GRAPH graph, ADJACENCY adj){
         return FALSE;
     }
     
-    if(is3ColourableGraph(graph)){
+    if(isThreeEdgeColourableCubicGraph(graph, adj)){
         if(verbose){
             fprintf(stderr, "Graph is 3-edge-colourable.\n");
         }
@@ -523,7 +290,7 @@ boolean isSnark(GRAPH graph, ADJACENCY adj){
     
     if(girthAtLeast5 || cyclically4EdgeConnected){
 
-        int g = girth(graph, 5); //calculate the minimum of the girth and 5
+        int g = computeGirth(graph, adj, 5); //calculate the minimum of the girth and 5
 
         if(girthAtLeast5 && g<5){
             if(verbose){
@@ -547,7 +314,7 @@ boolean isSnark(GRAPH graph, ADJACENCY adj){
                 return FALSE;
             }
             
-            if(has_nontrivial_threecut(graph)){
+            if(hasNontrivialThreeCut(graph)){
                 if(verbose){
                     fprintf(stderr, "Graph has non-trivial 3-cut.\n");
                 }
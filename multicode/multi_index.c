@@ -0,0 +1,116 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* This program reads a file with graphs in multicode format and writes an
+ * index for that file, which stores where the code of each graph starts.
+ * Programs like multi_select use this index to read only the graphs they
+ * need.
+ *
+ * Compile with:
+ *
+ *     cc -o multi_index -O4  multi_index.c \
+ *     shared/multicode_scanner.c shared/multicode_index.c
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <sys/stat.h>
+
+#include "shared/multicode_scanner.h"
+#include "shared/multicode_index.h"
+
+//====================== USAGE =======================
+
+void help(char *name) {
+    fprintf(stderr, "The program %s builds an index for a file of graphs in multicode format.\n\n", name);
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options] file\n\n", name);
+    fprintf(stderr, "The index is written to file.idx, unless another name is given.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -o, --output name\n");
+    fprintf(stderr, "       Write the index to the file with the given name.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options] file\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+
+    char *indexFileName = NULL;
+
+    /*=========== commandline parsing ===========*/
+
+    int c;
+    char *name = argv[0];
+    static struct option long_options[] = {
+        {"output", required_argument, NULL, 'o'},
+        {"help", no_argument, NULL, 'h'}
+    };
+    int option_index = 0;
+
+    while ((c = getopt_long(argc, argv, "ho:", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'o':
+                indexFileName = optarg;
+                break;
+            case 'h':
+                help(name);
+                return EXIT_SUCCESS;
+            case '?':
+                usage(name);
+                return EXIT_FAILURE;
+            default:
+                fprintf(stderr, "Illegal option %c.\n", c);
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind != 1) {
+        usage(name);
+        return EXIT_FAILURE;
+    }
+
+    char *codeFileName = argv[optind];
+    FILE *codeFile = fopen(codeFileName, "rb");
+    if (codeFile == NULL) {
+        fprintf(stderr, "Could not open %s to read graphs -- exiting!\n", codeFileName);
+        return EXIT_FAILURE;
+    }
+    struct stat codeFileStatus;
+    if (fstat(fileno(codeFile), &codeFileStatus) || !S_ISREG(codeFileStatus.st_mode)) {
+        fprintf(stderr, "An index can only be built for a regular file -- exiting!\n");
+        return EXIT_FAILURE;
+    }
+    if (indexFileName == NULL) {
+        indexFileName = getCodeIndexName(codeFileName);
+    }
+
+    CODE_INDEX_WRITER *writer = newCodeIndexWriter(indexFileName, MULTICODE_FORMAT);
+    CODE_SCANNER *scanner = newCodeScanner(codeFile, MULTICODE_FORMAT);
+    CODE_RECORD code;
+    while (nextCodeRecord(scanner, &code)) {
+        addToCodeIndex(writer, code.offset, code.length, code.order);
+    }
+    freeCodeScanner(scanner);
+
+    unsigned long long graphsRead = finishCodeIndex(writer, codeFileStatus.st_size);
+    fclose(codeFile);
+
+    fprintf(stderr, "Indexed %llu graph%s.\n", graphsRead, graphsRead==1 ? "" : "s");
+
+    return (EXIT_SUCCESS);
+}
@@ -13,7 +13,8 @@
  * Compile with:
  *     
  *     cc -o multi_multiply -O4  multi_multiply.c shared/multicode_base.c \
- *     shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
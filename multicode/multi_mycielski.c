@@ -12,7 +12,8 @@
  * Compile with:
  *     
  *     cc -o multi_mycielski -O4  multi_mycielski.c shared/multicode_base.c \
- *     shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
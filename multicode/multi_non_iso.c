@@ -1,9 +1,12 @@
-// cc -O4 -o multi_non_iso multi_non_iso.c nautil.c nauty.c
+// cc -O4 -pthread -DUSE_TLS -o multi_non_iso multi_non_iso.c shared/multicode_dedup.c shared/multicode_pipeline.c nautil.c nauty.c naugraph.c schreier.c naurng.c
 
 #include<stdio.h>
 #include<stdlib.h>
 #include<memory.h>
+#include<getopt.h>
 #include "nauty.h"
+#include "shared/multicode_dedup.h"
+#include "shared/multicode_pipeline.h"
 
 #define leer 0
 #define nil 0
@@ -12,22 +15,51 @@
 #define reg 3
 #define MAXVAL knoten-1
 
+/* number of setwords in a row of the nauty graph */
+#define NAUTYWORDS ((knoten+WORDSIZE-1)/WORDSIZE)
+
 
 typedef unsigned char GRAPH[knoten+1][MAXVAL];
 typedef unsigned char ADJAZENZ[knoten+1];
-typedef unsigned long *NAUTYGRAPH;
-typedef struct le { NAUTYGRAPH nautyg;
-		    int knotenzahl;
-		    struct le *smaller;
-		    struct le *larger;
-			int id;} LISTENTRY;
+typedef setword *NAUTYGRAPH;
+
+/* The canonical form of a graph and its fingerprint. In the parallel mode
+ * the worker threads compute these and the main thread inserts them in the
+ * table in the order of the input.
+ */
+typedef struct {
+    FINGERPRINT fingerprint;
+    int m;
+    setword canong[knoten*NAUTYWORDS];
+} KANONISCH;
+
+/* scratch memory of a worker thread */
+typedef struct {
+    GRAPH gr;
+    ADJAZENZ adj;
+} GRAPHPUFFER;
+
+/* maximal length of a code */
+#define MAXCODELAENGE (knoten*(knoten-1)/2+knoten)
+
+/* The canonical forms that have been seen are stored in a hash table keyed
+ * by a 128-bit fingerprint of the canonical form (see shared/multicode_dedup.h).
+ *
+ * With a memory budget the fingerprints are deduplicated externally
+ * instead.
+ */
 
 int  zaehlen=0;
 
 int graphenzahl=0, noniso, debugzaehler=0, ausgabezaehler=0;
-LISTENTRY *arbeitsliste;
 GRAPH global_puffer_gr;
 
+int writethem=0, info=0;
+boolean fingerprintOnly = FALSE;
+EXTERNAL_DEDUP *externalDedup = NULL;
+
+FORM_TABLE *formTable = NULL;
+
 /*extern UPROC distances();*/
 
 void schreibegraph(g)
@@ -112,64 +144,21 @@ for (i=0; i<g[0][0]; i++) {
 }
 
 
-/**************************EINBAUEN********************************/
-void einbauen(LISTENTRY *el, NAUTYGRAPH canong,int m, int knotenzahl)
+/**************************IN_LISTE********************************/
 
+int in_liste(NAUTYGRAPH canong, int m, int knotenzahl, FINGERPRINT fingerprint)
+/* schaut nach, ob canong schon in der Tabelle ist und schreibt ihn eventuell
+  rein */
+/* returns 0 if the form wasn't in the table, otherwise the id of the stored copy */
 {
+int copy;
 
-debugzaehler++;
-     el->nautyg= canong;
-     el->knotenzahl=knotenzahl;
-     el->smaller=nil;
-     el->larger=nil;
-	 el->id=zaehlen;
-   }
-
-
-
-/**************************IN_LISTE********************************/
+if (formTable==nil) formTable=newFormTable(fingerprintOnly);
 
-void in_liste(LISTENTRY *el, NAUTYGRAPH canong,int m, int knotenzahl, int *test, int *copy)
-/* schaut nach, ob canong schon in der Liste ist und schreibt ihn eventuell
-  rein */
-{ int compare;
- int n;
-
-
-
- compare = knotenzahl - el->knotenzahl;
- if (compare==0)
-   compare=memcmp(canong,el->nautyg,m*knotenzahl*sizeof(unsigned long));
- if (compare==0) {
-     *test=0;
-	 *copy=el->id;
- } else if (compare<0){
-	if (el->smaller==nil){
-		*test=1; 
-		*copy=0;
-		el->smaller=(LISTENTRY *)malloc(sizeof(LISTENTRY));
-		if (el->smaller==nil) {
-			fprintf(stderr,"Can not get more memory !\n"); exit(99);
-		}
-		einbauen(el->smaller,canong,m,knotenzahl);
-	} else {
-		in_liste(el->smaller,canong,m,knotenzahl,test,copy);
-	}
- } else { /* compare > 0 */
-   if (el->larger==nil){
-		*test=1;
-		*copy=0; 
-		el->larger=(LISTENTRY *)malloc(sizeof(LISTENTRY));
-		if (el->larger==nil) {
-			fprintf(stderr,"Can not get more memory !\n");
-			exit(99);
-		}
-		einbauen(el->larger,canong,m,knotenzahl);
-	} else {
-		in_liste(el->larger,canong,m,knotenzahl,test,copy);
-	}
- }
+copy=addToFormTable(formTable,fingerprint,canong,(size_t)m*knotenzahl*sizeof(setword),zaehlen);
+if (!copy) { debugzaehler++; noniso++; }
 
+return copy;
 }
 
 
@@ -177,17 +166,15 @@ void in_liste(LISTENTRY *el, NAUTYGRAPH canong,int m, int knotenzahl, int *test,
 
 /**************************NEU*************************************/
 
-int add_to_list(GRAPH gr, LISTENTRY **liste)
-/* Entscheidet, ob ein graph schon in der Liste behandelter Graphen ist 
-  und fuegt ihn ein, wenn nicht */
-/* returns 0 if the graph wasn't in the list, otherwise returns the number of the graph of which it is a copy*/
+int kanonisiere(GRAPH gr, NAUTYGRAPH canong)
+/* berechnet die kanonische Form und gibt m zurueck */
 {
-NAUTYGRAPH nautyg, canong;
+static TLS_ATTR setword nautyg[knoten*NAUTYWORDS];
 nvector lab[knoten], ptn[knoten], orbits[knoten];
-static DEFAULTOPTIONS(options);
+static TLS_ATTR DEFAULTOPTIONS(options);
 statsblk(stats);
 setword workspace[100*knoten];
-int m,n,test,knotenzahl,copy;
+int m,knotenzahl;
 
 knotenzahl=gr[0][0];
 /*options.invarproc= &distances;*/
@@ -195,12 +182,7 @@ options.getcanon=TRUE;
 options.writeautoms=FALSE;
 options.writemarkers=FALSE;
 
-if ((gr[0][0]%32)==0) m=gr[0][0]/32; else m=gr[0][0]/32+1;
-
-nautyg= (NAUTYGRAPH)calloc(m*knotenzahl,sizeof(unsigned long));
-canong= (NAUTYGRAPH)calloc(m*knotenzahl,sizeof(unsigned long));
-if ((nautyg==nil) || (canong==nil) )
-	    { fprintf(stderr,"Can not get more memory (1)!\n"); exit(99); }
+m=SETWORDSNEEDED(knotenzahl);
 
 umwandeln(gr,nautyg,m);
 nauty(nautyg,lab,ptn,NILSET,orbits,&options, &stats,workspace,100,
@@ -211,20 +193,12 @@ for (n=0; n<gr[0][0]; n++) fprintf(stderr," %d ",canong[n]);
 fprintf(stderr,"\n");
 */
 
-if ((*liste)==nil)
-	{ test=1; 
-	  *liste =(LISTENTRY *)malloc(sizeof(LISTENTRY));
-	  if (*liste==nil) 
-	    { fprintf(stderr,"Can not get more memory (0)!\n"); exit(99); }
-	  einbauen(*liste,canong,m,knotenzahl); 
-	}
-else in_liste(*liste,canong,m,gr[0][0],&test,&copy);
-
-
-free(nautyg); 
-if (test==0) free(canong); /* sonst wurde er in die Liste geschrieben */
+return m;
+}
 
-return copy;
+void write_survivor(const void *code, size_t codelaenge, void *context)
+{
+fwrite(code,sizeof(unsigned char),codelaenge,stdout);
 }
 
 
@@ -317,7 +291,7 @@ int i,j,m;
 ADJAZENZ adj;
 
 
-if ((knotenzahl%32)==0) m=knotenzahl/32; else m=knotenzahl/32+1;
+m=SETWORDSNEEDED(knotenzahl);
 
 for (i=0; i<=knoten; i++) 
   { for (j=0;j<MAXVAL; j++) gr[i][j]=leer;
@@ -333,30 +307,6 @@ for (i=0; i<knotenzahl; i++)
 
 }
 
-/*********************AUSGABE***********************************/
-
-void ausgabe(LISTENTRY *liste)
-
-{ 
-
-/* GRAPH gr;  muss global gehandhabt werden, um beim iterierten aufruf Platz zu
-sparen */
-if (liste==nil) return;
-
-ausgabezaehler++;
-
-if (liste->larger != nil) ausgabe(liste->larger);
-
-//nauty_to_graph(liste->nautyg,global_puffer_gr,liste->knotenzahl);
-noniso++;
-//codiere_und_schreibe(global_puffer_gr);
-
-if (liste->smaller != nil) ausgabe(liste->smaller); 
-
-}
-
-
-
 /****************************LESE_MULTICODE************************/
 
 int lese_multicode(unsigned char**code, int *codelaenge, FILE *fil)
@@ -416,63 +366,211 @@ return 1;
 
 
 
-/******************************MAIN************************************/
+/****************************KANONISCHE_FORM************************/
 
-int main(argc,argv)
+void kanonische_form(unsigned char *code, int codelaenge, GRAPH gr, ADJAZENZ adj,
+                     KANONISCH *form)
+/* berechnet die kanonische Form und den Fingerprint des Graphen mit dem
+  gegebenen code */
+{
+decodiere(code,gr,adj,codelaenge);
+form->m=kanonisiere(gr,form->canong);
+form->fingerprint=computeFingerprint(form->canong,
+        (size_t)form->m*gr[0][0]*sizeof(setword),gr[0][0]);
+}
 
-int argc;
-char *argv[];
+/****************************VERARBEITE*****************************/
 
+void verarbeite(unsigned char *code, int codelaenge, KANONISCH *form)
+/* Entscheidet, ob der Graph schon in der Tabelle behandelter Graphen ist,
+  fuegt ihn ein, wenn nicht, und schreibt die Ausgabe */
+{
+int copy;
 
+zaehlen++;
+if (externalDedup)
+ { /* schreibt den Fingerprint (und eventuell den code) in die temporaeren Dateien */
+   addToExternalDedup(externalDedup, form->fingerprint, code, writethem ? codelaenge : 0);
+   return;
+ }
+copy = in_liste(form->canong,form->m,code[0],form->fingerprint);
+if (!copy && writethem) fwrite(code,sizeof(unsigned char),codelaenge,stdout);
+if (info){
+   if(!copy){
+     fprintf(stdout, "Graph %d is new.\n", zaehlen);
+   } else {
+     fprintf(stdout, "Graph %d is not new, copy is %d.\n", zaehlen, copy);
+   }
+}
+}
+
+/****************************PARALLEL*******************************/
+
+/* In the parallel mode the codes are read by a reader thread, the canonical
+  forms are computed by the worker threads and the main thread inserts them
+  in the order of the input, so the output is the same as without threads. */
+
+int lese_code(unsigned char *item, size_t *length, void *context)
+{
+static unsigned char *code=NULL;
+int codelaenge;
+
+if (lese_multicode(&code, &codelaenge, stdin) == EOF) return 0;
+memcpy(item, code, codelaenge);
+*length = codelaenge;
+return 1;
+}
+
+void kanonisiere_code(const unsigned char *item, size_t length, void *result,
+                      void *scratch, void *context)
+{
+GRAPHPUFFER *puffer = (GRAPHPUFFER *)scratch;
+
+kanonische_form((unsigned char *)item, length, puffer->gr, puffer->adj, (KANONISCH *)result);
+}
+
+void verarbeite_code(const unsigned char *item, size_t length, void *result, void *context)
+{
+verarbeite((unsigned char *)item, length, (KANONISCH *)result);
+}
+
+/******************************USAGE************************************/
+
+void help(char *name) {
+    fprintf(stderr, "The program %s reads multigraph codes from stdin and keeps one\n", name);
+    fprintf(stderr, "graph of each isomorphism class.\n\n");
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options]\n\n", name);
+    fprintf(stderr, "ONLY FOR SIMPLE GRAPHS !!\n");
+    fprintf(stderr, "\nThis program can handle graphs up to %d vertices. Recompile if you need larger\n", knoten);
+    fprintf(stderr, "graphs.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -w, --write\n");
+    fprintf(stderr, "       Write one graph of each isomorphism class to stdout in the order\n");
+    fprintf(stderr, "       that they were read.\n");
+    fprintf(stderr, "    -i, --info\n");
+    fprintf(stderr, "       Report for each graph whether it is new or of which graph it is a copy.\n");
+    fprintf(stderr, "    -f, --fingerprint-only\n");
+    fprintf(stderr, "       Only store a 128-bit fingerprint of each canonical form instead of\n");
+    fprintf(stderr, "       the canonical form itself. This uses less memory, but two graphs with\n");
+    fprintf(stderr, "       the same fingerprint are considered to be isomorphic.\n");
+    fprintf(stderr, "    -m #, --memory #\n");
+    fprintf(stderr, "       Deduplicate in external memory using at most # bytes (e.g. 512M or 16G)\n");
+    fprintf(stderr, "       of memory for the deduplication. The fingerprints are written to\n");
+    fprintf(stderr, "       temporary files in $TMPDIR (or /tmp) and deduplicated after all\n");
+    fprintf(stderr, "       graphs are read. This implies -f and cannot be combined with -i.\n");
+    fprintf(stderr, "    -t #, --threads #\n");
+    fprintf(stderr, "       Compute the canonical forms using # threads. The output is the same\n");
+    fprintf(stderr, "       as with a single thread.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/******************************MAIN************************************/
+
+int main(int argc, char *argv[])
 {
 GRAPH gr;
 ADJAZENZ adj;
+static KANONISCH form;
 unsigned char *code=NULL;
-int  number=0, after=0, codelaenge;
-int dreier=0, vierer=0, dummy, writethem, info;
-int i,j, nuller;
-int anzB=0, anzC=0, anzS=0;
-
-
+int codelaenge;
+size_t memoryBudget=0;
+int threadCount=1;
+
+int c;
+char *name = argv[0];
+static struct option long_options[] = {
+    {"write", no_argument, NULL, 'w'},
+    {"info", no_argument, NULL, 'i'},
+    {"fingerprint-only", no_argument, NULL, 'f'},
+    {"memory", required_argument, NULL, 'm'},
+    {"threads", required_argument, NULL, 't'},
+    {"help", no_argument, NULL, 'h'}
+};
+int option_index = 0;
+
+while ((c = getopt_long(argc, argv, "hwifm:t:", long_options, &option_index)) != -1) {
+    switch (c) {
+        case 'w':
+            writethem = 1;
+            break;
+        case 'i':
+            info = 1;
+            break;
+        case 'f':
+            fingerprintOnly = TRUE;
+            break;
+        case 'm':
+            memoryBudget = parseMemorySize(optarg);
+            if (memoryBudget == 0) {
+                fprintf(stderr, "Illegal memory size %s.\n", optarg);
+                usage(name);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            threadCount = atoi(optarg);
+            if (threadCount < 1) {
+                fprintf(stderr, "The number of threads should be at least 1.\n");
+                usage(name);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'h':
+            help(name);
+            return EXIT_SUCCESS;
+        case '?':
+            usage(name);
+            return EXIT_FAILURE;
+        default:
+            fprintf(stderr, "Illegal option %c.\n", c);
+            usage(name);
+            return EXIT_FAILURE;
+    }
+}
 
-arbeitsliste=nil;
+/* the old way of passing w or i as the only argument */
+if (argc - optind == 1 && argc == 2 && (argv[1][0]=='w' || argv[1][0]=='i')) {
+    if (argv[1][0]=='w') writethem=1; else info=1;
+} else if (argc - optind > 0) {
+    usage(name);
+    return EXIT_FAILURE;
+}
 
-if (argc==2 && argv[1][0]=='w') writethem=1; else writethem=0;
-if (argc==2 && argv[1][0]=='i') info=1; else info=0;
 
-if (argc > 2 || (argc==2 && (argv[1][0]!='w' && argv[1][0]!='i'))) 
-{ fprintf(stderr,"usage: mu_non_iso [w]");
- fprintf(stderr,"It reads multigraph codes from stdin, and writes them --\n");
- fprintf(stderr,"In case option w is given -- \n");
- fprintf(stderr,"one of each isomorphism class -- on stdout and in the order \n");
- fprintf(stderr,"that they were read.\n");
- fprintf(stderr,"ONLY FOR SIMPLE GRAPHS !! \n");
-     exit(0); }
+if (memoryBudget && info) {
+    fprintf(stderr, "The options -i and -m cannot be combined.\n");
+    usage(name);
+    return EXIT_FAILURE;
+}
+if (memoryBudget) externalDedup = newExternalDedup(memoryBudget, writethem);
 
 
 zaehlen=noniso=0;
 
-while(lese_multicode(&code, &codelaenge, stdin) != EOF)
- {
-   zaehlen++; 
-   decodiere(code,gr,adj,codelaenge);
-   //schreibegraph(gr);
-   int copy = add_to_list(gr,&arbeitsliste);
-   if (!copy && writethem) fwrite(code,sizeof(unsigned char),codelaenge,stdout);
-   if (info){
-      if(!copy){
-		fprintf(stdout, "Graph %d is new.\n", zaehlen);
-	  } else {
-		fprintf(stdout, "Graph %d is not new, copy is %d.\n", zaehlen, copy);
-	  }
-   }
+if (threadCount > 1)
+   runOrderedPipeline(threadCount, MAXCODELAENGE, sizeof(KANONISCH), sizeof(GRAPHPUFFER),
+                      lese_code, kanonisiere_code, verarbeite_code, NULL);
+else
+ { while(lese_multicode(&code, &codelaenge, stdin) != EOF)
+    {
+      kanonische_form(code,codelaenge,gr,adj,&form);
+      //schreibegraph(gr);
+      verarbeite(code,codelaenge,&form);
+    }
  }
 
-  if (arbeitsliste != nil) ausgabe(arbeitsliste);
+if (externalDedup)
+   noniso = finishExternalDedup(externalDedup, writethem ? write_survivor : NULL, NULL);
 
 fprintf(stderr,"Gelesen: %d Graphen, davon %d paarweise nicht isomorph.\n",zaehlen,noniso);
 
 return(0);
 
 }
-
@@ -0,0 +1,334 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* This program reads a file with graphs in multicode format several times
+ * and reports the throughput of the multicode reader. The reader that reads
+ * the code entry by entry from the stream is included for comparison.
+ *
+ * Compile with:
+ *
+ *     cc -o multi_read_benchmark -O4  multi_read_benchmark.c \
+ *     shared/multicode_base.c shared/multicode_input.c \
+ *     shared/multicode_scanner.c
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+
+#include "shared/multicode_base.h"
+#include "shared/multicode_input.h"
+
+int repetitions = 3;
+boolean decode = FALSE;
+
+GRAPH graph;
+ADJACENCY adj;
+
+typedef struct {
+    unsigned long long int graphCount;
+    //sum of all code entries: used to check that both readers agree
+    unsigned long long int checksum;
+} READ_RESULT;
+
+/* The reader that was used before the buffered reader was introduced.
+ */
+int readMultiCodePerEntry(unsigned short code[], int *length, FILE *file, boolean *first) {
+    unsigned char c;
+    char testheader[20];
+    int bufferSize, zeroCounter;
+
+    int readCount;
+
+
+    if (*first) {
+        *first = FALSE;
+
+        if (fread(&testheader, sizeof (unsigned char), 12, file) != 12) {
+            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
+            exit(1);
+        }
+        testheader[12] = 0;
+        if (strcmp(testheader, ">>multi_code") == 0) {
+
+        } else {
+            fprintf(stderr, "No multicode header detected -- exiting!\n");
+            exit(1);
+        }
+        //read reminder of header (either empty or le/be specification)
+        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
+            return FALSE;
+        }
+        while (c!='<'){
+            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
+                return FALSE;
+            }
+        }
+        //read one more character
+        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
+            return FALSE;
+        }
+    }
+
+    /* possibly removing interior headers -- only done for multicode */
+    if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
+        //nothing left in file
+        return (0);
+    }
+
+    if (c == '>') {
+        // could be a header, or maybe just a 62 (which is also possible for unsigned char
+        code[0] = c;
+        bufferSize = 1;
+        zeroCounter = 0;
+        code[1] = (unsigned short) getc(file);
+        if (code[1] == 0) zeroCounter++;
+        code[2] = (unsigned short) getc(file);
+        if (code[2] == 0) zeroCounter++;
+        bufferSize = 3;
+        // 3 characters were read and stored in buffer
+        if ((code[1] == '>') && (code[2] == 'm')) /*we are sure that we're dealing with a header*/ {
+            while ((c = getc(file)) != '<');
+            /* read 2 more characters: */
+            c = getc(file);
+            if (c != '<') {
+                fprintf(stderr, "Problems with header -- single '<'\n");
+                exit(1);
+            }
+            if (!fread(&c, sizeof (unsigned char), 1, file)) {
+                //nothing left in file
+                return (0);
+            }
+            bufferSize = 1;
+            zeroCounter = 0;
+        }
+    } else {
+        //no header present
+        bufferSize = 1;
+        zeroCounter = 0;
+    }
+
+    if (c != 0) /* unsigned chars would be sufficient */ {
+        code[0] = c;
+        if (code[0] > MAXN) {
+            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
+            exit(1);
+        }
+        while (zeroCounter < code[0]-1) {
+            code[bufferSize] = (unsigned short) getc(file);
+            if (code[bufferSize] == 0) zeroCounter++;
+            bufferSize++;
+        }
+    } else {
+        readCount = fread(code, sizeof (unsigned short), 1, file);
+        if(!readCount){
+            fprintf(stderr, "Unexpected EOF.\n");
+            exit(1);
+        }
+        if (code[0] > MAXN) {
+            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
+            exit(1);
+        }
+        bufferSize = 1;
+        zeroCounter = 0;
+        while (zeroCounter < code[0]-1) {
+            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
+            if(!readCount){
+                fprintf(stderr, "Unexpected EOF.\n");
+                exit(1);
+            }
+            if (code[bufferSize] == 0) zeroCounter++;
+            bufferSize++;
+        }
+    }
+
+    *length = bufferSize;
+    return (1);
+}
+
+void readPerEntry(FILE *file, READ_RESULT *result) {
+    static unsigned short code[MAXCODELENGTH];
+    int i, length;
+    boolean first = TRUE;
+
+    while (readMultiCodePerEntry(code, &length, file, &first)) {
+        result->graphCount++;
+        if (decode) {
+            decodeMultiCode(code, length, graph, adj);
+        }
+        for (i = 0; i < length; i++) {
+            result->checksum += code[i];
+        }
+    }
+}
+
+void readWithReader(FILE *file, READ_RESULT *result) {
+    MULTICODE_VIEW code;
+    int i;
+
+    MULTICODE_READER *reader = newMultiCodeReader(file);
+    while (nextMultiCode(reader, &code)) {
+        result->graphCount++;
+        if (decode) {
+            decodeMultiCodeView(&code, graph, adj);
+        }
+        if (code.twoByteEntries) {
+            unsigned short entry;
+            for (i = 0; i < code.length; i++) {
+                memcpy(&entry, code.data + i * sizeof (unsigned short), sizeof (unsigned short));
+                result->checksum += entry;
+            }
+        } else {
+            for (i = 0; i < code.length; i++) {
+                result->checksum += code.data[i];
+            }
+        }
+    }
+    freeMultiCodeReader(reader);
+}
+
+/* Runs the given reader on the file the requested number of times and
+ * returns the best time in seconds.
+ */
+double benchmark(char *fileName, void (*read)(FILE *, READ_RESULT *), READ_RESULT *result) {
+    struct timespec start, end;
+    double seconds, best = -1;
+    int i;
+
+    for (i = 0; i < repetitions; i++) {
+        FILE *file = fopen(fileName, "rb");
+        if (file == NULL) {
+            fprintf(stderr, "Could not open %s -- exiting!\n", fileName);
+            exit(EXIT_FAILURE);
+        }
+        result->graphCount = 0;
+        result->checksum = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        read(file, result);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        fclose(file);
+
+        seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if (best < 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+
+    return best;
+}
+
+void report(char *readerName, double seconds, long long int fileSize, READ_RESULT *result) {
+    fprintf(stderr, "%-10s %12llu graphs %10.3f s %10.1f MB/s %10.0f graphs/s\n",
+            readerName, result->graphCount, seconds,
+            seconds > 0 ? fileSize / seconds / 1e6 : 0,
+            seconds > 0 ? result->graphCount / seconds : 0);
+}
+
+//====================== USAGE =======================
+
+void help(char *name) {
+    fprintf(stderr, "The program %s measures the throughput of the multicode reader.\n\n", name);
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options] file\n\n", name);
+    fprintf(stderr, "The file is read several times by the reader that reads one entry at a time\n");
+    fprintf(stderr, "and by the buffered reader. The best time for each reader is reported.\n\n");
+    fprintf(stderr, "\nThis program can handle graphs up to %d vertices. Recompile if you need larger\n", MAXN);
+    fprintf(stderr, "graphs.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -r #, --repetitions #\n");
+    fprintf(stderr, "       Read the file # times with each reader (default: 3).\n");
+    fprintf(stderr, "    -d, --decode\n");
+    fprintf(stderr, "       Also decode each graph.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options] file\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+
+    /*=========== commandline parsing ===========*/
+
+    int c;
+    char *name = argv[0];
+    static struct option long_options[] = {
+        {"repetitions", required_argument, NULL, 'r'},
+        {"decode", no_argument, NULL, 'd'},
+        {"help", no_argument, NULL, 'h'}
+    };
+    int option_index = 0;
+
+    while ((c = getopt_long(argc, argv, "hr:d", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'r':
+                repetitions = atoi(optarg);
+                if (repetitions < 1) {
+                    fprintf(stderr, "The number of repetitions should be positive.\n");
+                    usage(name);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'd':
+                decode = TRUE;
+                break;
+            case 'h':
+                help(name);
+                return EXIT_SUCCESS;
+            case '?':
+                usage(name);
+                return EXIT_FAILURE;
+            default:
+                fprintf(stderr, "Illegal option %c.\n", c);
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind != 1) {
+        usage(name);
+        return EXIT_FAILURE;
+    }
+    char *fileName = argv[optind];
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open %s -- exiting!\n", fileName);
+        return EXIT_FAILURE;
+    }
+    fseek(file, 0, SEEK_END);
+    long long int fileSize = ftell(file);
+    fclose(file);
+
+    READ_RESULT perEntryResult, readerResult;
+    double perEntrySeconds = benchmark(fileName, readPerEntry, &perEntryResult);
+    double readerSeconds = benchmark(fileName, readWithReader, &readerResult);
+
+    report("per entry", perEntrySeconds, fileSize, &perEntryResult);
+    report("buffered", readerSeconds, fileSize, &readerResult);
+    if (readerSeconds > 0) {
+        fprintf(stderr, "Speedup: %.2f\n", perEntrySeconds / readerSeconds);
+    }
+
+    if (perEntryResult.graphCount != readerResult.graphCount ||
+            perEntryResult.checksum != readerResult.checksum) {
+        fprintf(stderr, "The readers do not agree on the contents of the file!\n");
+        return EXIT_FAILURE;
+    }
+
+    return (EXIT_SUCCESS);
+}
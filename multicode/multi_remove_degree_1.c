@@ -14,6 +14,7 @@
  *     
  *     cc -o multi_remove_degree_1 -O4  multi_remove_degree_1.c\
  *     shared/multicode_base.c shared/multicode_input.c\
+ *     shared/multicode_scanner.c \
  *     shared/multicode_output.c
  * 
  */
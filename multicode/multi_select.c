@@ -11,7 +11,9 @@
  * Compile with:
  *     
  *     cc -o multi_select -O4  multi_select.c \
- *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_base.c shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c \
+ *     shared/multicode_index.c
  * 
  */
 
@@ -22,6 +24,7 @@
 #include "shared/multicode_base.h"
 #include "shared/multicode_input.h"
 #include "shared/multicode_output.h"
+#include "shared/multicode_index.h"
 
 //====================== USAGE =======================
 
@@ -34,6 +37,9 @@ void help(char *name) {
     fprintf(stderr, "Valid options\n=============\n");
     fprintf(stderr, "    -m, --modulo r:m\n");
     fprintf(stderr, "       Split the input into m parts and only output part r (0<=r<m).\n");
+    fprintf(stderr, "    -I, --index file\n");
+    fprintf(stderr, "       Use the given index (see multi_index) to read only the selected graphs.\n");
+    fprintf(stderr, "       Standard in should be the file for which the index was built.\n");
     fprintf(stderr, "    -h, --help\n");
     fprintf(stderr, "       Print this help and return.\n");
 }
@@ -59,17 +65,20 @@ int main(int argc, char** argv) {
     int moduloRest;
     int moduloMod;
 
+    char *indexFileName = NULL;
+
     /*=========== commandline parsing ===========*/
 
     int c;
     char *name = argv[0];
     static struct option long_options[] = {
         {"modulo", required_argument, NULL, 'm'},
+        {"index", required_argument, NULL, 'I'},
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "hm:", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "hm:I:", long_options, &option_index)) != -1) {
         switch (c) {
             case 'm':
                 moduloEnabled = TRUE;
@@ -79,6 +88,9 @@ int main(int argc, char** argv) {
                     return EXIT_FAILURE;
                 }
                 break;
+            case 'I':
+                indexFileName = optarg;
+                break;
             case 'h':
                 help(name);
                 return EXIT_SUCCESS;
@@ -106,24 +118,65 @@ int main(int argc, char** argv) {
         selectedGraphs[i] = atoi(argv[i + optind]);
     }
     
-
-    
-    unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readMultiCode(code, &length, stdin)) {
-        graphsRead++;
+    if(indexFileName != NULL){
+        static unsigned short code[MAXCODELENGTH];
+        CODE_INDEX_ENTRY entry;
+        CODE_INDEX *index = openCodeIndex(indexFileName, MULTICODE_FORMAT, fileno(stdin));
+        if(index == NULL){
+            fprintf(stderr, "Could not open %s to read index -- exiting!\n", indexFileName);
+            return EXIT_FAILURE;
+        }
+        graphsRead = getCodeIndexSize(index);
         
+        //the graphs are numbered starting from 1
+        unsigned long long graphNumber = 0;
         if(moduloEnabled){
-            if(graphsRead % moduloMod == moduloRest){
-                decodeMultiCode(code, length, graph, adj);
-                graphsFiltered++;
-                writeMultiCode(graph, adj, stdout);
+            graphNumber = moduloRest == 0 ? moduloMod : moduloRest;
+        }
+        while(TRUE){
+            if(!moduloEnabled){
+                //just like without an index, the selection stops at a number that is not larger
+                if(graphsFiltered == argc - optind || selectedGraphs[graphsFiltered] <= graphNumber){
+                    break;
+                }
+                graphNumber = selectedGraphs[graphsFiltered];
+            } else if(graphNumber % moduloMod != moduloRest){
+                break;
             }
-        } else if (graphsFiltered < argc - optind && (graphsRead == selectedGraphs[graphsFiltered])) {
+            if(graphNumber > graphsRead){
+                break;
+            }
+            getCodeIndexEntry(index, graphNumber - 1, &entry);
+            int length = readIndexedCode(index, &entry, code, MAXCODELENGTH);
             decodeMultiCode(code, length, graph, adj);
             graphsFiltered++;
             writeMultiCode(graph, adj, stdout);
+            if(moduloEnabled){
+                graphNumber += moduloMod;
+            }
+        }
+        
+        closeCodeIndex(index);
+    } else {
+        MULTICODE_READER *reader = newMultiCodeReader(stdin);
+        MULTICODE_VIEW code;
+        while (nextMultiCode(reader, &code)) {
+            graphsRead++;
+
+            if(moduloEnabled){
+                if(graphsRead % moduloMod == moduloRest){
+                    decodeMultiCodeView(&code, graph, adj);
+                    graphsFiltered++;
+                    writeMultiCode(graph, adj, stdout);
+                }
+            } else if (graphsFiltered < argc - optind && (graphsRead == selectedGraphs[graphsFiltered])) {
+                decodeMultiCodeView(&code, graph, adj);
+                graphsFiltered++;
+                writeMultiCode(graph, adj, stdout);
+            }
         }
+
+        freeMultiCodeReader(reader);
     }
     
     fprintf(stderr, "Read %llu graph%s.\n", graphsRead, graphsRead==1 ? "" : "s");
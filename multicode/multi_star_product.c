@@ -14,7 +14,8 @@
  * Compile with:
  *     
  *     cc -o multi_star_product -O4  multi_star_product.c shared/multicode_base.c \
- *     shared/multicode_input.c shared/multicode_output.c
+ *     shared/multicode_input.c shared/multicode_output.c \
+ *     shared/multicode_scanner.c
  * 
  */
 
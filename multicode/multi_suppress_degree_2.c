@@ -16,6 +16,7 @@
  *     
  *     cc -o multi_suppress_degree_2 -O4  multi_suppress_degree_2.c\
  *     shared/multicode_base.c shared/multicode_input.c\
+ *     shared/multicode_scanner.c \
  *     shared/multicode_output.c
  * 
  */
@@ -103,7 +103,7 @@ void writeGraph(GRAPH g) {
 int main(int argc, char *argv[]) {
     GRAPH graph;
     ADJACENCY adj;
-    int graphCount, i;
+    int graphCount, i, j;
     int codeLength;
     unsigned short code[MAXCODELENGTH];
 
@@ -125,6 +125,12 @@ int main(int argc, char *argv[]) {
                     maxvalence = adj[i];
                 }
             }
+            //decoding does not clear the unused entries
+            for (i = 1; i <= graph[0][0]; i++) {
+                for (j = adj[i]; j < maxvalence; j++) {
+                    graph[i][j] = EMPTY;
+                }
+            }
             printf("\n\n\n Graph Nr: %d \n\n", graphCount);
             writeGraph(graph);
         }
@@ -29,6 +29,10 @@ typedef int boolean;
 #define MAXCODELENGTH (MAXN * MAXVAL + MAXN)
 #define EMPTY USHRT_MAX
 
+/* graph[0][0] contains the order of the graph and graph[v][0] up to
+ * graph[v][adj[v]-1] contain the neighbours of v. The remaining entries of a
+ * row are only guaranteed to be EMPTY after prepareGraph.
+ */
 typedef unsigned short GRAPH[MAXN + 1][MAXVAL + 1];
 typedef unsigned short ADJACENCY[MAXN + 1];
 
@@ -0,0 +1,73 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#include "multicode_bitset.h"
+
+/* Allocates count sets of wordCount words. The memory is aligned to the size
+ * of a block. All sets are empty.
+ */
+BITSET_WORD *newBitsets(int count, int wordCount) {
+    BITSET_WORD *sets;
+    size_t size = sizeof(BITSET_WORD) * (size_t)count * wordCount;
+
+    if (size == 0) {
+        size = sizeof(BITSET_WORD) * BITSET_BLOCK_SIZE;
+    }
+    sets = (BITSET_WORD *)aligned_alloc(sizeof(BITSET_WORD) * BITSET_BLOCK_SIZE, size);
+    if (sets == NULL) {
+        fprintf(stderr, "Insufficient memory for bitsets -- exiting!\n");
+        exit(1);
+    }
+    clearBitset(sets, size / sizeof(BITSET_WORD));
+
+    return sets;
+}
+
+BITSET_ADJACENCY *newBitsetAdjacency() {
+    BITSET_ADJACENCY *matrix = (BITSET_ADJACENCY *)malloc(sizeof(BITSET_ADJACENCY));
+    if (matrix == NULL) {
+        fprintf(stderr, "Insufficient memory for bitsets -- exiting!\n");
+        exit(1);
+    }
+    matrix->order = 0;
+    matrix->wordCount = 0;
+    matrix->rows = NULL;
+    matrix->capacity = 0;
+
+    return matrix;
+}
+
+void freeBitsetAdjacency(BITSET_ADJACENCY *matrix) {
+    free(matrix->rows);
+    free(matrix);
+}
+
+/* Stores the adjacency matrix of graph in matrix. The memory of matrix is
+ * reused if it is large enough.
+ */
+void buildBitsetAdjacency(GRAPH graph, ADJACENCY adj, BITSET_ADJACENCY *matrix) {
+    int v, i;
+    int order = graph[0][0];
+    int wordCount = BITSET_WORD_COUNT(order);
+
+    if ((order + 1) * wordCount > matrix->capacity) {
+        free(matrix->rows);
+        matrix->capacity = (order + 1) * wordCount;
+        matrix->rows = newBitsets(order + 1, wordCount);
+    } else {
+        clearBitset(matrix->rows, (order + 1) * wordCount);
+    }
+    matrix->order = order;
+    matrix->wordCount = wordCount;
+
+    for (v = 1; v <= order; v++) {
+        BITSET_WORD *row = BITSET_ROW(matrix, v);
+        for (i = 0; i < adj[v]; i++) {
+            BITSET_ADD(row, graph[v][i]);
+        }
+    }
+}
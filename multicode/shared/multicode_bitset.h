@@ -0,0 +1,133 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_BITSET_H
+#define	MULTICODE_BITSET_H
+
+#include "multicode_base.h"
+#include<stdio.h>
+
+#ifdef __AVX2__
+#include<immintrin.h>
+#endif
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Sets of vertices of arbitrary size that are stored as arrays of 64-bit
+ * words. All sets that are used together should have the same number of
+ * words. The number of words is always a multiple of 4, so that four words
+ * can be handled at once when the code is compiled with AVX2 support
+ * (e.g., with -mavx2 or -march=native).
+ */
+typedef unsigned long long int BITSET_WORD;
+
+#define BITSET_WORD_SIZE 64
+#define BITSET_BLOCK_SIZE 4
+
+//the number of words needed to store the vertices 0 up to order
+#define BITSET_WORD_COUNT(order) \
+    ((((order) / BITSET_WORD_SIZE + 1) + BITSET_BLOCK_SIZE - 1) / BITSET_BLOCK_SIZE * BITSET_BLOCK_SIZE)
+
+#define BITSET_ADD(s, el) ((s)[(el) / BITSET_WORD_SIZE] |= 1ULL << ((el) % BITSET_WORD_SIZE))
+#define BITSET_REMOVE(s, el) ((s)[(el) / BITSET_WORD_SIZE] &= ~(1ULL << ((el) % BITSET_WORD_SIZE)))
+#define BITSET_CONTAINS(s, el) (((s)[(el) / BITSET_WORD_SIZE] >> ((el) % BITSET_WORD_SIZE)) & 1ULL)
+
+/* The adjacency matrix of a graph: row v is the neighbourhood of v.
+ */
+typedef struct {
+    int order;
+    int wordCount;
+
+    BITSET_WORD *rows;
+
+    int capacity;
+} BITSET_ADJACENCY;
+
+#define BITSET_ROW(matrix, v) ((matrix)->rows + (size_t)(v) * (matrix)->wordCount)
+
+BITSET_ADJACENCY *newBitsetAdjacency();
+
+void freeBitsetAdjacency(BITSET_ADJACENCY *matrix);
+
+void buildBitsetAdjacency(GRAPH graph, ADJACENCY adj, BITSET_ADJACENCY *matrix);
+
+BITSET_WORD *newBitsets(int count, int wordCount);
+
+static inline void clearBitset(BITSET_WORD *s, int wordCount) {
+    int i;
+    for (i = 0; i < wordCount; i++) {
+        s[i] = 0;
+    }
+}
+
+static inline int bitsetSize(const BITSET_WORD *s, int wordCount) {
+    int i, count = 0;
+    for (i = 0; i < wordCount; i++) {
+        count += __builtin_popcountll(s[i]);
+    }
+    return count;
+}
+
+/* Stores the intersection of s1 and s2 in target and returns the size of
+ * the intersection.
+ */
+static inline int intersectBitsets(BITSET_WORD *target, const BITSET_WORD *s1,
+        const BITSET_WORD *s2, int wordCount) {
+    int i, count = 0;
+#ifdef __AVX2__
+    for (i = 0; i < wordCount; i += BITSET_BLOCK_SIZE) {
+        __m256i block = _mm256_and_si256(
+                _mm256_loadu_si256((const __m256i *)(s1 + i)),
+                _mm256_loadu_si256((const __m256i *)(s2 + i)));
+        _mm256_storeu_si256((__m256i *)(target + i), block);
+        if (!_mm256_testz_si256(block, block)) {
+            count += __builtin_popcountll(target[i]) +
+                    __builtin_popcountll(target[i + 1]) +
+                    __builtin_popcountll(target[i + 2]) +
+                    __builtin_popcountll(target[i + 3]);
+        }
+    }
+#else
+    for (i = 0; i < wordCount; i++) {
+        target[i] = s1[i] & s2[i];
+        count += __builtin_popcountll(target[i]);
+    }
+#endif
+    return count;
+}
+
+/* Returns TRUE if s1 and s2 have an element in common.
+ */
+static inline boolean bitsetsIntersect(const BITSET_WORD *s1, const BITSET_WORD *s2,
+        int wordCount) {
+    int i;
+#ifdef __AVX2__
+    for (i = 0; i < wordCount; i += BITSET_BLOCK_SIZE) {
+        if (!_mm256_testz_si256(
+                _mm256_loadu_si256((const __m256i *)(s1 + i)),
+                _mm256_loadu_si256((const __m256i *)(s2 + i)))) {
+            return TRUE;
+        }
+    }
+#else
+    for (i = 0; i < wordCount; i++) {
+        if (s1[i] & s2[i]) {
+            return TRUE;
+        }
+    }
+#endif
+    return FALSE;
+}
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_BITSET_H */
+
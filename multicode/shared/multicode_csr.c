@@ -0,0 +1,190 @@
+/*
+ * Main developer: Nico Van Cleemput
+ * 
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#include "multicode_csr.h"
+#include<string.h>
+
+static void ensureCsrCapacity(CSR_GRAPH *graph, int order, int size) {
+    if (order + 2 > graph->vertexCapacity) {
+        free(graph->offsets);
+        graph->vertexCapacity = order + 2;
+        graph->offsets = (int *)malloc(sizeof(int) * graph->vertexCapacity);
+    }
+    if (2 * size > graph->edgeCapacity) {
+        free(graph->neighbours);
+        graph->edgeCapacity = 2 * size;
+        graph->neighbours = (unsigned short *)malloc(sizeof(unsigned short) * graph->edgeCapacity);
+    }
+    if (graph->offsets == NULL || (graph->edgeCapacity > 0 && graph->neighbours == NULL)) {
+        fprintf(stderr, "Insufficient memory for graph -- exiting!\n");
+        exit(1);
+    }
+}
+
+CSR_GRAPH *newCsrGraph(int order, int size) {
+    CSR_GRAPH *graph = (CSR_GRAPH *)malloc(sizeof(CSR_GRAPH));
+    if (graph == NULL) {
+        fprintf(stderr, "Insufficient memory for graph -- exiting!\n");
+        exit(1);
+    }
+    graph->order = graph->size = 0;
+    graph->offsets = NULL;
+    graph->neighbours = NULL;
+    graph->vertexCapacity = graph->edgeCapacity = 0;
+
+    ensureCsrCapacity(graph, order, size);
+
+    return graph;
+}
+
+void freeCsrGraph(CSR_GRAPH *graph) {
+    free(graph->offsets);
+    free(graph->neighbours);
+    free(graph);
+}
+
+static inline unsigned short getEntry(const unsigned char *data, boolean twoByteEntries, int i) {
+    unsigned short entry;
+
+    if (twoByteEntries) {
+        memcpy(&entry, data + i * sizeof (unsigned short), sizeof (unsigned short));
+        return entry;
+    }
+    return data[i];
+}
+
+/* Decodes the code in two passes: the first pass determines the degrees and
+ * the second pass stores the neighbours. The neighbours of each vertex are
+ * stored in the same order as decodeMultiCode stores them. This function is
+ * always inlined with a constant value for twoByteEntries, so the test on the
+ * size of the entries disappears from the loops.
+ */
+static inline void decodeEntries(const unsigned char *data, int length,
+        boolean twoByteEntries, CSR_GRAPH *graph) {
+    int i, v;
+    unsigned short entry;
+    int *offsets = graph->offsets;
+    unsigned short *neighbours = graph->neighbours;
+
+    //count the degrees: the degree of v is stored in offsets[v+1]
+    for (v = 0; v <= graph->order + 1; v++) {
+        offsets[v] = 0;
+    }
+    v = 1;
+    for (i = 1; i < length; i++) {
+        entry = getEntry(data, twoByteEntries, i);
+        if (entry == 0) {
+            v++;
+        } else {
+            offsets[v + 1]++;
+            offsets[entry + 1]++;
+        }
+    }
+    for (v = 1; v <= graph->order; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    //store the neighbours: offsets[v] is used as the next free position of v
+    v = 1;
+    for (i = 1; i < length; i++) {
+        entry = getEntry(data, twoByteEntries, i);
+        if (entry == 0) {
+            v++;
+        } else {
+            neighbours[offsets[v]++] = entry;
+            neighbours[offsets[entry]++] = v;
+        }
+    }
+
+    //now offsets[v] is the start of v+1, so shift everything back
+    for (v = graph->order; v > 1; v--) {
+        offsets[v] = offsets[v - 1];
+    }
+    offsets[1] = 0;
+}
+
+void decodeMultiCodeViewToCsr(MULTICODE_VIEW *view, CSR_GRAPH *graph) {
+    int order = view->order;
+    //each entry is either a neighbour or closes the list of a vertex
+    int size = view->length - 1 - (order > 0 ? order - 1 : 0);
+
+    ensureCsrCapacity(graph, order, size);
+    graph->order = order;
+    graph->size = size;
+
+    if (view->twoByteEntries) {
+        decodeEntries(view->data, view->length, TRUE, graph);
+    } else {
+        decodeEntries(view->data, view->length, FALSE, graph);
+    }
+}
+
+void decodeMultiCodeToCsr(unsigned short* code, int length, CSR_GRAPH *graph) {
+    MULTICODE_VIEW view = {(const unsigned char *)code, TRUE, code[0], length};
+
+    decodeMultiCodeViewToCsr(&view, graph);
+}
+
+boolean csrAreAdjacent(CSR_GRAPH *graph, int v, int w) {
+    int i, end;
+
+    //search the shortest list
+    if (CSR_DEGREE(graph, w) < CSR_DEGREE(graph, v)) {
+        int temp = v;
+        v = w;
+        w = temp;
+    }
+
+    end = graph->offsets[v + 1];
+    for (i = graph->offsets[v]; i < end; i++) {
+        if (graph->neighbours[i] == w) return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* Stores csr in graph and adj, so that it can be used with the functions that
+ * work on GRAPH. Only the rows of the vertices of csr are written.
+ */
+void csrToGraph(CSR_GRAPH *csr, GRAPH graph, ADJACENCY adj) {
+    int v, i;
+
+    graph[0][0] = csr->order;
+
+    for (v = 1; v <= csr->order; v++) {
+        adj[v] = CSR_DEGREE(csr, v);
+        if (adj[v] > MAXVAL) {
+            fprintf(stderr, "MAXVAL too small (%d)!\n", MAXVAL);
+            exit(0);
+        }
+        for (i = 0; i < adj[v]; i++) {
+            graph[v][i] = CSR_NEIGHBOUR(csr, v, i);
+        }
+    }
+}
+
+void graphToCsr(GRAPH graph, ADJACENCY adj, CSR_GRAPH *csr) {
+    int v, i, order, size;
+
+    order = graph[0][0];
+    size = 0;
+    for (v = 1; v <= order; v++) {
+        size += adj[v];
+    }
+    size /= 2;
+    ensureCsrCapacity(csr, order, size);
+    csr->order = order;
+    csr->size = size;
+
+    csr->offsets[1] = 0;
+    for (v = 1; v <= order; v++) {
+        csr->offsets[v + 1] = csr->offsets[v] + adj[v];
+        for (i = 0; i < adj[v]; i++) {
+            csr->neighbours[csr->offsets[v] + i] = graph[v][i];
+        }
+    }
+}
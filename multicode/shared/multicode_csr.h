@@ -0,0 +1,57 @@
+/*
+ * Main developer: Nico Van Cleemput
+ * 
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_CSR_H
+#define	MULTICODE_CSR_H
+
+#include "multicode_base.h"
+#include "multicode_input.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* A graph in compressed sparse row format. The neighbours of vertex v
+ * (1 <= v <= order) are stored in neighbours[offsets[v]] up to
+ * neighbours[offsets[v+1]-1]. In contrast to GRAPH the memory that is used
+ * only depends on the order and the size of the graph. The arrays are reused
+ * when a new graph is decoded into the same CSR_GRAPH.
+ */
+typedef struct {
+    int order;
+    int size;
+
+    int *offsets;
+    unsigned short *neighbours;
+
+    int vertexCapacity;
+    int edgeCapacity;
+} CSR_GRAPH;
+
+#define CSR_DEGREE(g, v) ((g)->offsets[(v)+1] - (g)->offsets[v])
+#define CSR_NEIGHBOUR(g, v, i) ((g)->neighbours[(g)->offsets[v] + (i)])
+
+CSR_GRAPH *newCsrGraph(int order, int size);
+
+void freeCsrGraph(CSR_GRAPH *graph);
+
+void decodeMultiCodeViewToCsr(MULTICODE_VIEW *view, CSR_GRAPH *graph);
+
+void decodeMultiCodeToCsr(unsigned short* code, int length, CSR_GRAPH *graph);
+
+boolean csrAreAdjacent(CSR_GRAPH *graph, int v, int w);
+
+void csrToGraph(CSR_GRAPH *csr, GRAPH graph, ADJACENCY adj);
+
+void graphToCsr(GRAPH graph, ADJACENCY adj, CSR_GRAPH *csr);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_CSR_H */
+
@@ -0,0 +1,498 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The records (fingerprint, input index) are partitioned over the shards by
+ * the first byte of the fingerprint. Each shard is read in input order and
+ * its distinct fingerprints are collected in a hash table, so the first
+ * graph with a given fingerprint is the one that is kept. A bitmap with a
+ * bit for each graph records the kept graphs. If the distinct fingerprints
+ * of a shard do not fit in the memory budget, the shard is partitioned
+ * again by the next byte of the fingerprint.
+ */
+
+#include "multicode_dedup.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SHARD_COUNT 256
+#define FINGERPRINT_BYTES 16
+#define RECORD_BUFFER_SIZE 4096
+#define MINIMUM_TABLE_SIZE 1024
+#define INITIAL_FORM_TABLE_SIZE (1<<12)
+#define INITIAL_ARENA_SIZE (1<<20)
+
+typedef struct {
+    FINGERPRINT fingerprint;
+    unsigned long long index;
+} DEDUP_RECORD;
+
+struct EXTERNAL_DEDUP {
+    size_t memoryBudget;
+    int keepPayloads;
+    unsigned long long graphCount;
+
+    FILE *shards[SHARD_COUNT];
+    unsigned long long shardSizes[SHARD_COUNT];
+
+    FILE *payloads;
+};
+
+typedef struct {
+    FINGERPRINT fingerprint;
+    int id; /* 0 for an empty slot */
+} FORM_TABLE_ENTRY;
+
+/* The position of a form in the arena. These are kept apart from the
+ * entries, so they need no memory if only fingerprints are kept.
+ */
+typedef struct {
+    size_t offset;
+    size_t length;
+} FORM_LOCATION;
+
+struct FORM_TABLE {
+    int fingerprintOnly;
+
+    FORM_TABLE_ENTRY *entries;
+    FORM_LOCATION *locations;
+    size_t size;
+    size_t count;
+
+    unsigned char *arena;
+    size_t arenaSize;
+    size_t arenaUsed;
+};
+
+//====================== FINGERPRINTS =======================
+
+static unsigned long long mix64(unsigned long long x){
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+FINGERPRINT computeFingerprint(const void *data, size_t length, unsigned long long seed){
+    const unsigned char *bytes = (const unsigned char *)data;
+    unsigned long long high = 0x9e3779b97f4a7c15ULL ^ seed;
+    unsigned long long low = 0xc2b2ae3d27d4eb4fULL + seed;
+    FINGERPRINT fingerprint;
+    size_t i;
+
+    for(i = 0; i < length; i += sizeof(unsigned long long)){
+        unsigned long long word = 0;
+        size_t chunk = length - i < sizeof(word) ? length - i : sizeof(word);
+        memcpy(&word, bytes + i, chunk);
+        high = mix64(high ^ word) + 0x632be59bd9b4e019ULL;
+        low = mix64(low + word * 0x165667b19e3779f9ULL) ^ (low >> 29);
+    }
+
+    fingerprint.high = mix64(high ^ length);
+    fingerprint.low = mix64(low ^ fingerprint.high);
+    return fingerprint;
+}
+
+//====================== IN-MEMORY TABLE =======================
+
+static void allocateFormTable(FORM_TABLE *table, size_t size){
+    table->entries = (FORM_TABLE_ENTRY *)calloc(size, sizeof(FORM_TABLE_ENTRY));
+    if(table->entries == NULL){
+        fprintf(stderr, "Insufficient memory for the form table -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    if(!table->fingerprintOnly){
+        table->locations = (FORM_LOCATION *)malloc(size * sizeof(FORM_LOCATION));
+        if(table->locations == NULL){
+            fprintf(stderr, "Insufficient memory for the form table -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    table->size = size;
+}
+
+static void growFormTable(FORM_TABLE *table){
+    FORM_TABLE_ENTRY *oldEntries = table->entries;
+    FORM_LOCATION *oldLocations = table->locations;
+    size_t oldSize = table->size;
+    size_t i;
+
+    allocateFormTable(table, 2*oldSize);
+    for(i = 0; i < oldSize; i++){
+        size_t slot;
+        if(oldEntries[i].id == 0) continue;
+        slot = oldEntries[i].fingerprint.low & (table->size - 1);
+        while(table->entries[slot].id) slot = (slot + 1) & (table->size - 1);
+        table->entries[slot] = oldEntries[i];
+        if(!table->fingerprintOnly) table->locations[slot] = oldLocations[i];
+    }
+    free(oldEntries);
+    free(oldLocations);
+}
+
+/* Copies the form to the arena and returns its offset.
+ */
+static size_t storeForm(FORM_TABLE *table, const void *form, size_t length){
+    size_t offset = table->arenaUsed;
+
+    if(offset + length > table->arenaSize){
+        size_t newSize = table->arenaSize ? 2*table->arenaSize : INITIAL_ARENA_SIZE;
+        while(newSize < offset + length) newSize *= 2;
+        unsigned char *arena = (unsigned char *)realloc(table->arena, newSize);
+        if(arena == NULL){
+            fprintf(stderr, "Insufficient memory for the forms -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+        table->arena = arena;
+        table->arenaSize = newSize;
+    }
+    memcpy(table->arena + offset, form, length);
+    table->arenaUsed += length;
+    return offset;
+}
+
+FORM_TABLE *newFormTable(int fingerprintOnly){
+    FORM_TABLE *table = (FORM_TABLE *)calloc(1, sizeof(FORM_TABLE));
+    if(table == NULL){
+        fprintf(stderr, "Insufficient memory -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    table->fingerprintOnly = fingerprintOnly;
+    allocateFormTable(table, INITIAL_FORM_TABLE_SIZE);
+    return table;
+}
+
+int addToFormTable(FORM_TABLE *table, FINGERPRINT fingerprint,
+        const void *form, size_t length, int id){
+    size_t slot = fingerprint.low & (table->size - 1);
+
+    while(table->entries[slot].id){
+        if(table->entries[slot].fingerprint.high == fingerprint.high &&
+                table->entries[slot].fingerprint.low == fingerprint.low){
+            if(table->fingerprintOnly) return table->entries[slot].id;
+            FORM_LOCATION *location = table->locations + slot;
+            if(location->length == length &&
+                    !memcmp(table->arena + location->offset, form, length)){
+                return table->entries[slot].id;
+            }
+        }
+        slot = (slot + 1) & (table->size - 1);
+    }
+
+    table->entries[slot].fingerprint = fingerprint;
+    table->entries[slot].id = id;
+    if(!table->fingerprintOnly){
+        table->locations[slot].offset = storeForm(table, form, length);
+        table->locations[slot].length = length;
+    }
+    table->count++;
+
+    //keep the load factor at most 3/4
+    if(4*table->count > 3*table->size) growFormTable(table);
+
+    return 0;
+}
+
+void freeFormTable(FORM_TABLE *table){
+    free(table->entries);
+    free(table->locations);
+    free(table->arena);
+    free(table);
+}
+
+//====================== TEMPORARY FILES =======================
+
+static FILE *openTemporaryFile(){
+    const char *directory = getenv("TMPDIR");
+    char *name;
+    FILE *file;
+    int descriptor;
+
+    if(directory == NULL || *directory == '\0'){
+        directory = "/tmp";
+    }
+    name = (char *)malloc(strlen(directory) + 20);
+    if(name == NULL){
+        fprintf(stderr, "Insufficient memory -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    sprintf(name, "%s/dedupXXXXXX", directory);
+    descriptor = mkstemp(name);
+    if(descriptor < 0){
+        fprintf(stderr, "Could not create a temporary file in %s -- exiting!\n", directory);
+        exit(EXIT_FAILURE);
+    }
+    //the file disappears as soon as it is closed
+    unlink(name);
+    free(name);
+
+    file = fdopen(descriptor, "w+b");
+    if(file == NULL){
+        fprintf(stderr, "Could not open a temporary file -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+static void writeTemporary(const void *data, size_t size, size_t count, FILE *file){
+    if(fwrite(data, size, count, file) != count){
+        fprintf(stderr, "Could not write to a temporary file -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void readTemporary(void *data, size_t size, size_t count, FILE *file){
+    if(fread(data, size, count, file) != count){
+        fprintf(stderr, "Could not read from a temporary file -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+//====================== PASS ONE =======================
+
+size_t parseMemorySize(const char *text){
+    char *end;
+    unsigned long long size = strtoull(text, &end, 10);
+
+    switch(*end){
+        case 'T': case 't':
+            size <<= 10;
+            /* fall through */
+        case 'G': case 'g':
+            size <<= 10;
+            /* fall through */
+        case 'M': case 'm':
+            size <<= 10;
+            /* fall through */
+        case 'K': case 'k':
+            size <<= 10;
+            end++;
+            break;
+    }
+    if(*end != '\0' || end == text){
+        return 0;
+    }
+    return (size_t)size;
+}
+
+EXTERNAL_DEDUP *newExternalDedup(size_t memoryBudget, int keepPayloads){
+    EXTERNAL_DEDUP *dedup = (EXTERNAL_DEDUP *)malloc(sizeof(EXTERNAL_DEDUP));
+    int i;
+
+    if(dedup == NULL){
+        fprintf(stderr, "Insufficient memory -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    dedup->memoryBudget = memoryBudget;
+    dedup->keepPayloads = keepPayloads;
+    dedup->graphCount = 0;
+    for(i = 0; i < SHARD_COUNT; i++){
+        dedup->shards[i] = openTemporaryFile();
+        dedup->shardSizes[i] = 0;
+    }
+    dedup->payloads = keepPayloads ? openTemporaryFile() : NULL;
+
+    return dedup;
+}
+
+/* Returns the given byte of the fingerprint, starting from the most
+ * significant byte of high.
+ */
+static int fingerprintByte(FINGERPRINT fingerprint, int byte){
+    if(byte < 8){
+        return (int)((fingerprint.high >> (56 - 8*byte)) & 0xff);
+    }
+    return (int)((fingerprint.low >> (56 - 8*(byte - 8))) & 0xff);
+}
+
+void addToExternalDedup(EXTERNAL_DEDUP *dedup, FINGERPRINT fingerprint,
+        const void *payload, size_t length){
+    DEDUP_RECORD record;
+    int shard;
+
+    //the zero fingerprint marks an empty slot in the hash tables
+    if(fingerprint.high == 0 && fingerprint.low == 0){
+        fingerprint.low = 1;
+    }
+    record.fingerprint = fingerprint;
+    record.index = dedup->graphCount++;
+
+    shard = fingerprintByte(fingerprint, 0);
+    writeTemporary(&record, sizeof(DEDUP_RECORD), 1, dedup->shards[shard]);
+    dedup->shardSizes[shard]++;
+
+    if(dedup->keepPayloads){
+        writeTemporary(&length, sizeof(size_t), 1, dedup->payloads);
+        writeTemporary(payload, 1, length, dedup->payloads);
+    }
+}
+
+//====================== PASS TWO =======================
+
+static void partitionShard(FILE *shard, unsigned long long size, int level,
+        unsigned char *kept, size_t tableBudget);
+
+/* Marks the first record of each fingerprint in the shard as kept. The
+ * records of the shard are partitioned on byte level of the fingerprint if
+ * its distinct fingerprints do not fit in the budget.
+ */
+static void deduplicateShard(FILE *shard, unsigned long long size, int level,
+        unsigned char *kept, size_t tableBudget){
+    static DEDUP_RECORD buffer[RECORD_BUFFER_SIZE];
+    FINGERPRINT *table;
+    size_t tableSize = MINIMUM_TABLE_SIZE;
+    size_t distinct = 0;
+    unsigned long long done = 0;
+
+    if(size == 0){
+        return;
+    }
+
+    //the table is at most three quarters full
+    while(3*(unsigned long long)tableSize < 4*size &&
+            2*tableSize*sizeof(FINGERPRINT) <= tableBudget){
+        tableSize *= 2;
+    }
+    table = (FINGERPRINT *)calloc(tableSize, sizeof(FINGERPRINT));
+    if(table == NULL){
+        fprintf(stderr, "Insufficient memory for the deduplication table -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    rewind(shard);
+    while(done < size){
+        size_t count = size - done < RECORD_BUFFER_SIZE ? size - done : RECORD_BUFFER_SIZE;
+        size_t i;
+
+        readTemporary(buffer, sizeof(DEDUP_RECORD), count, shard);
+        for(i = 0; i < count; i++){
+            FINGERPRINT fingerprint = buffer[i].fingerprint;
+            size_t slot = fingerprint.low & (tableSize - 1);
+
+            while((table[slot].high || table[slot].low) &&
+                    (table[slot].high != fingerprint.high || table[slot].low != fingerprint.low)){
+                slot = (slot + 1) & (tableSize - 1);
+            }
+            if(table[slot].high || table[slot].low){
+                continue;
+            }
+            if(4*(distinct + 1) > 3*tableSize){
+                //too many distinct fingerprints: split the shard
+                free(table);
+                partitionShard(shard, size, level, kept, tableBudget);
+                return;
+            }
+            table[slot] = fingerprint;
+            distinct++;
+            kept[buffer[i].index >> 3] |= 1 << (buffer[i].index & 7);
+        }
+        done += count;
+    }
+
+    free(table);
+}
+
+static void partitionShard(FILE *shard, unsigned long long size, int level,
+        unsigned char *kept, size_t tableBudget){
+    static DEDUP_RECORD buffer[RECORD_BUFFER_SIZE];
+    FILE *parts[SHARD_COUNT];
+    unsigned long long partSizes[SHARD_COUNT];
+    unsigned long long done = 0;
+    int i;
+
+    if(level >= FINGERPRINT_BYTES){
+        fprintf(stderr, "The memory budget is too small -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(i = 0; i < SHARD_COUNT; i++){
+        parts[i] = openTemporaryFile();
+        partSizes[i] = 0;
+    }
+    rewind(shard);
+    while(done < size){
+        size_t count = size - done < RECORD_BUFFER_SIZE ? size - done : RECORD_BUFFER_SIZE;
+        size_t j;
+
+        readTemporary(buffer, sizeof(DEDUP_RECORD), count, shard);
+        for(j = 0; j < count; j++){
+            int part = fingerprintByte(buffer[j].fingerprint, level);
+            writeTemporary(buffer + j, sizeof(DEDUP_RECORD), 1, parts[part]);
+            partSizes[part]++;
+        }
+        done += count;
+    }
+
+    for(i = 0; i < SHARD_COUNT; i++){
+        deduplicateShard(parts[i], partSizes[i], level + 1, kept, tableBudget);
+        fclose(parts[i]);
+    }
+}
+
+//====================== PASS THREE =======================
+
+unsigned long long finishExternalDedup(EXTERNAL_DEDUP *dedup,
+        SURVIVOR_CALLBACK survivor, void *context){
+    size_t bitmapSize = (size_t)((dedup->graphCount + 7) / 8);
+    unsigned char *kept;
+    unsigned long long keptCount = 0;
+    unsigned long long i;
+    int shard;
+
+    if(bitmapSize + MINIMUM_TABLE_SIZE*sizeof(FINGERPRINT) > dedup->memoryBudget){
+        fprintf(stderr, "The memory budget is too small for %llu graphs -- exiting!\n",
+                dedup->graphCount);
+        exit(EXIT_FAILURE);
+    }
+    kept = (unsigned char *)calloc(bitmapSize + 1, 1);
+    if(kept == NULL){
+        fprintf(stderr, "Insufficient memory -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(shard = 0; shard < SHARD_COUNT; shard++){
+        deduplicateShard(dedup->shards[shard], dedup->shardSizes[shard], 1, kept,
+                dedup->memoryBudget - bitmapSize);
+        fclose(dedup->shards[shard]);
+    }
+
+    if(dedup->keepPayloads){
+        size_t capacity = 0;
+        unsigned char *payload = NULL;
+
+        rewind(dedup->payloads);
+        for(i = 0; i < dedup->graphCount; i++){
+            size_t length;
+            readTemporary(&length, sizeof(size_t), 1, dedup->payloads);
+            if(length > capacity){
+                capacity = 2*length;
+                payload = (unsigned char *)realloc(payload, capacity);
+                if(payload == NULL){
+                    fprintf(stderr, "Insufficient memory -- exiting!\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            readTemporary(payload, 1, length, dedup->payloads);
+            if((kept[i >> 3] >> (i & 7)) & 1 && survivor != NULL){
+                survivor(payload, length, context);
+            }
+        }
+        free(payload);
+        fclose(dedup->payloads);
+    }
+
+    for(i = 0; i < bitmapSize; i++){
+        keptCount += __builtin_popcount(kept[i]);
+    }
+
+    free(kept);
+    free(dedup);
+    return keptCount;
+}
@@ -0,0 +1,86 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_DEDUP_H
+#define	MULTICODE_DEDUP_H
+
+#include <stdio.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* This module does not depend on multicode_base.h, so that it can also be
+ * used by the programs for plane graphs, which have their own definitions
+ * of GRAPH and MAXN.
+ */
+
+typedef struct {
+    unsigned long long high;
+    unsigned long long low;
+} FINGERPRINT;
+
+/* Returns a 128-bit fingerprint of the length bytes starting at data. Two
+ * independent 64-bit hashes are combined, so a false match needs both of
+ * them to collide.
+ */
+FINGERPRINT computeFingerprint(const void *data, size_t length, unsigned long long seed);
+
+/* In-memory deduplication: an open addressing hash table keyed by the
+ * fingerprint of each form. Unless only fingerprints are kept, the forms
+ * themselves are copied one after the other to an arena and are only
+ * compared when two fingerprints are equal.
+ */
+typedef struct FORM_TABLE FORM_TABLE;
+
+FORM_TABLE *newFormTable(int fingerprintOnly);
+
+/* Returns 0 if the form of length bytes was not in the table and stores it
+ * with the given id, which should be positive. Otherwise the id of the
+ * stored form is returned.
+ */
+int addToFormTable(FORM_TABLE *table, FINGERPRINT fingerprint,
+        const void *form, size_t length, int id);
+
+void freeFormTable(FORM_TABLE *table);
+
+/* External deduplication: the fingerprints of all graphs are written to
+ * temporary shard files while the input is read, and each shard is
+ * deduplicated in memory afterwards. The first graph with a given
+ * fingerprint is kept. Optionally a payload (e.g. the code of the graph) is
+ * stored for each graph, and the payloads of the kept graphs are returned
+ * in input order by finishExternalDedup.
+ *
+ * The temporary files are created in the directory given by the environment
+ * variable TMPDIR, or in /tmp, and are removed when they are closed.
+ */
+typedef struct EXTERNAL_DEDUP EXTERNAL_DEDUP;
+
+typedef void (*SURVIVOR_CALLBACK)(const void *payload, size_t length, void *context);
+
+/* Parses a memory size like 512M or 16G. Returns 0 if the size is invalid.
+ */
+size_t parseMemorySize(const char *text);
+
+EXTERNAL_DEDUP *newExternalDedup(size_t memoryBudget, int keepPayloads);
+
+void addToExternalDedup(EXTERNAL_DEDUP *dedup, FINGERPRINT fingerprint,
+        const void *payload, size_t length);
+
+/* Deduplicates the shards, calls survivor for each kept graph in input
+ * order (only if payloads are kept and survivor is not NULL) and returns the
+ * number of kept graphs. The EXTERNAL_DEDUP is freed.
+ */
+unsigned long long finishExternalDedup(EXTERNAL_DEDUP *dedup,
+        SURVIVOR_CALLBACK survivor, void *context);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_DEDUP_H */
+
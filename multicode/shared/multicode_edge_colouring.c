@@ -0,0 +1,269 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The 3-edge-colourings of a cubic graph are searched for by a backtracking
+ * over the edges with unit propagation. The three colours are the bits of a
+ * bitmask, and for each vertex the colours of its coloured edges are stored
+ * as such a mask. The colours that are still possible for an uncoloured edge
+ * are the colours that are missing at both its end points. Each time an edge
+ * gets a colour, the uncoloured edges that share an end point with it are
+ * checked: an edge without possible colours is a conflict and an edge with
+ * one possible colour gets that colour. All coloured edges are stored on a
+ * trail, which is at the same time the queue of the propagation and the undo
+ * log of the backtracking.
+ *
+ * The edges are numbered in the order of a breadth-first search and are
+ * branched on in that order, so the next edge always shares an end point
+ * with a coloured edge and has at most two possible colours. The three edges
+ * at the first vertex of each component get a fixed colour, which removes the
+ * symmetry between the colours.
+ *
+ * Most cubic graphs are colourable, so before the search the edges are
+ * coloured greedily. When the end points of an edge miss different colours a
+ * and b, the Kempe chain of a and b that starts at one end point is swapped,
+ * unless it ends at the other end point. Only when this fails for all pairs
+ * of missing colours are the greedy colours removed and the search started.
+ */
+
+#include "multicode_edge_colouring.h"
+
+#define MAXE (3 * MAXN / 2)
+
+#define ALL_COLOURS 7
+#define IS_SINGLE_COLOUR(colours) (((colours) & ((colours) - 1)) == 0)
+
+static _Thread_local int vertexCount;
+static _Thread_local int edgeCount;
+
+static _Thread_local unsigned short edgeEnds[MAXE][2];
+static _Thread_local unsigned short incidentEdges[MAXN + 1][3];
+
+static _Thread_local unsigned char edgeColour[MAXE];
+static _Thread_local unsigned char coloursAt[MAXN + 1];
+
+static _Thread_local unsigned short trail[MAXE];
+static _Thread_local int trailSize;
+
+static _Thread_local unsigned short kempeChain[MAXE];
+
+static _Thread_local unsigned short vertexQueue[MAXN];
+static _Thread_local boolean dequeued[MAXN + 1];
+
+#define NO_EDGE USHRT_MAX
+
+/* Numbers the edges in the order in which they are reached by a
+ * breadth-first search, which is restarted for each component, and colours
+ * the edges at the first vertex of each component. Returns FALSE if the
+ * graph contains a loop.
+ */
+static boolean buildEdges(GRAPH graph){
+    int v, i, j, head = 0, tail = 0;
+
+    vertexCount = graph[0][0];
+    edgeCount = 0;
+    trailSize = 0;
+    for(v = 1; v <= vertexCount; v++){
+        incidentEdges[v][0] = incidentEdges[v][1] = incidentEdges[v][2] = NO_EDGE;
+        dequeued[v] = FALSE;
+        coloursAt[v] = 0;
+    }
+    for(v = 1; v <= vertexCount; v++){
+        boolean root = TRUE;
+        if(dequeued[v]){
+            continue;
+        }
+        vertexQueue[tail++] = v;
+        while(head < tail){
+            int u = vertexQueue[head++];
+            dequeued[u] = TRUE;
+            for(i = 0; i < 3; i++){
+                int w = graph[u][i];
+                if(w == u){
+                    return FALSE;
+                }
+                if(incidentEdges[u][i] != NO_EDGE){
+                    continue;
+                }
+                //parallel edges are matched in the order of the adjacency lists
+                for(j = 0; graph[w][j] != u || incidentEdges[w][j] != NO_EDGE; j++);
+                if(incidentEdges[w][0] == NO_EDGE && incidentEdges[w][1] == NO_EDGE &&
+                        incidentEdges[w][2] == NO_EDGE){
+                    vertexQueue[tail++] = w;
+                }
+                edgeEnds[edgeCount][0] = u;
+                edgeEnds[edgeCount][1] = w;
+                incidentEdges[u][i] = incidentEdges[w][j] = edgeCount;
+                edgeColour[edgeCount] = 0;
+                if(root){
+                    int colour = 1 << i;
+                    edgeColour[edgeCount] = colour;
+                    coloursAt[u] |= colour;
+                    coloursAt[w] |= colour;
+                    trail[trailSize++] = edgeCount;
+                }
+                edgeCount++;
+            }
+            root = FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static inline void colourEdge(int e, int colour){
+    edgeColour[e] = colour;
+    coloursAt[edgeEnds[e][0]] |= colour;
+    coloursAt[edgeEnds[e][1]] |= colour;
+    trail[trailSize++] = e;
+}
+
+/* Removes the colours of the edges that were coloured after the trail had
+ * the given size.
+ */
+static inline void uncolourEdges(int size){
+    while(trailSize > size){
+        int e = trail[--trailSize];
+        coloursAt[edgeEnds[e][0]] &= ~edgeColour[e];
+        coloursAt[edgeEnds[e][1]] &= ~edgeColour[e];
+        edgeColour[e] = 0;
+    }
+}
+
+/* Propagates the colours of the edges on the trail starting from the given
+ * position. Returns FALSE if an uncoloured edge has no possible colours.
+ */
+static boolean propagateColours(int position){
+    for(; position < trailSize; position++){
+        int e = trail[position];
+        int k, i;
+        for(k = 0; k < 2; k++){
+            int v = edgeEnds[e][k];
+            for(i = 0; i < 3; i++){
+                int f = incidentEdges[v][i];
+                if(!edgeColour[f]){
+                    int possible = ALL_COLOURS &
+                            ~(coloursAt[edgeEnds[f][0]] | coloursAt[edgeEnds[f][1]]);
+                    if(!possible){
+                        return FALSE;
+                    } else if(IS_SINGLE_COLOUR(possible)){
+                        colourEdge(f, possible);
+                    }
+                }
+            }
+        }
+    }
+    return TRUE;
+}
+
+/* Swaps the colours a and b on the path of edges with these colours that
+ * starts at start with an edge of colour a. Returns FALSE without changing
+ * any colour if this path ends at avoid.
+ */
+static boolean swapKempeChain(int start, int a, int b, int avoid){
+    int length = 0, v = start, colour = a, i;
+    while(TRUE){
+        int e = NO_EDGE;
+        for(i = 0; i < 3; i++){
+            if(edgeColour[incidentEdges[v][i]] == colour){
+                e = incidentEdges[v][i];
+                break;
+            }
+        }
+        if(e == NO_EDGE){
+            break;
+        }
+        kempeChain[length++] = e;
+        v = edgeEnds[e][0] ^ edgeEnds[e][1] ^ v;
+        if(v == avoid){
+            return FALSE;
+        }
+        colour ^= a ^ b;
+    }
+    for(i = 0; i < length; i++){
+        edgeColour[kempeChain[i]] ^= a ^ b;
+    }
+    //only the end points of the path see a different set of colours
+    coloursAt[start] ^= a ^ b;
+    coloursAt[v] ^= a ^ b;
+    return TRUE;
+}
+
+/* Colours the uncoloured edges greedily in order, using Kempe chains when
+ * the end points of an edge have no common missing colour. Returns FALSE
+ * if no Kempe chain could be swapped for some edge.
+ */
+static boolean colourWithKempeChains(){
+    int e, a, b;
+    for(e = 0; e < edgeCount; e++){
+        int u = edgeEnds[e][0], w = edgeEnds[e][1];
+        int possible, missingAtU, missingAtW, colour = 0;
+        if(edgeColour[e]){
+            continue;
+        }
+        possible = ALL_COLOURS & ~(coloursAt[u] | coloursAt[w]);
+        if(possible){
+            colourEdge(e, possible & -possible);
+            continue;
+        }
+        //a is missing at u and present at w, b is missing at w
+        missingAtU = ALL_COLOURS & ~coloursAt[u];
+        missingAtW = ALL_COLOURS & ~coloursAt[w];
+        for(a = 1; a < ALL_COLOURS && !colour; a <<= 1){
+            for(b = 1; b < ALL_COLOURS && !colour; b <<= 1){
+                if((missingAtU & a) && (missingAtW & b) && swapKempeChain(w, a, b, u)){
+                    colour = a;
+                }
+            }
+        }
+        if(!colour){
+            return FALSE;
+        }
+        colourEdge(e, colour);
+    }
+    return TRUE;
+}
+
+/* Tries to colour the uncoloured edges. All edges with an index smaller
+ * than position are coloured.
+ */
+static boolean extendColouring(int position){
+    int e, possible, colour, size;
+
+    while(position < edgeCount && edgeColour[position]){
+        position++;
+    }
+    if(position == edgeCount){
+        return TRUE;
+    }
+
+    e = position;
+    possible = ALL_COLOURS & ~(coloursAt[edgeEnds[e][0]] | coloursAt[edgeEnds[e][1]]);
+    size = trailSize;
+    for(colour = 1; colour < ALL_COLOURS; colour <<= 1){
+        if(possible & colour){
+            colourEdge(e, colour);
+            if(propagateColours(size) && extendColouring(position + 1)){
+                return TRUE;
+            }
+            uncolourEdges(size);
+        }
+    }
+    return FALSE;
+}
+
+boolean isThreeEdgeColourableCubicGraph(GRAPH graph, ADJACENCY adj){
+    int fixedEdges;
+    if(!buildEdges(graph)){
+        return FALSE;
+    }
+    fixedEdges = trailSize;
+    if(colourWithKempeChains()){
+        return TRUE;
+    }
+    //the swaps keep the colours at each first vertex different
+    uncolourEdges(fixedEdges);
+    return propagateColours(0) && extendColouring(0);
+}
@@ -0,0 +1,26 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_EDGE_COLOURING_H
+#define	MULTICODE_EDGE_COLOURING_H
+
+#include "multicode_base.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Returns TRUE if the cubic graph has a 3-edge-colouring. The graph may
+ * contain parallel edges. A graph with a loop has no 3-edge-colouring.
+ */
+boolean isThreeEdgeColourableCubicGraph(GRAPH graph, ADJACENCY adj);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_EDGE_COLOURING_H */
@@ -0,0 +1,138 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The girth is found by a breadth-first search from each vertex: the search
+ * from v finds a cycle of length 2d+1 when two adjacent vertices both have
+ * distance d to v, and a cycle of length 2d+2 when a vertex at distance d+1
+ * is reached along two edges. Taken over all vertices v, the shortest cycle
+ * that is found in this way is a shortest cycle of the graph.
+ *
+ * The searches from 64 vertices are performed at once: for each vertex there
+ * is a word with a bit for each of these roots. All searches of a batch
+ * advance one level at a time, so the first cycle that is found is the
+ * shortest cycle through any of the roots. The length of the shortest cycle
+ * so far bounds the depth of the following batches.
+ */
+
+#include "multicode_girth.h"
+
+#define ROOTS_PER_BATCH 64
+
+typedef unsigned long long int ROOT_SET;
+
+//the roots of the current batch for which the vertex has been reached
+static _Thread_local ROOT_SET visited[MAXN + 1];
+//the roots for which the vertex is at the current distance
+static _Thread_local ROOT_SET frontier[MAXN + 1];
+//the roots for which the vertex is reached along at least one or two edges from the frontier
+static _Thread_local ROOT_SET reachedOnce[MAXN + 1];
+static _Thread_local ROOT_SET reachedTwice[MAXN + 1];
+
+static _Thread_local unsigned short frontierVertices[MAXN];
+static _Thread_local unsigned short reachedVertices[MAXN];
+static _Thread_local boolean reached[MAXN + 1];
+
+/* Returns the minimum of bound and the length of a shortest cycle. If
+ * stopAtFirst is TRUE, the first cycle that is shorter than bound is
+ * returned instead, which need not be a shortest cycle.
+ */
+static int findShortestCycle(GRAPH graph, ADJACENCY adj, int bound, boolean stopAtFirst){
+    int v, i, first;
+    int order = graph[0][0];
+    int best = bound;
+
+    for(v = 1; v <= order; v++){
+        frontier[v] = 0;
+        reached[v] = FALSE;
+    }
+
+    for(first = 1; first <= order; first += ROOTS_PER_BATCH){
+        int last = first + ROOTS_PER_BATCH - 1 < order ? first + ROOTS_PER_BATCH - 1 : order;
+        int frontierCount = 0;
+        int depth = 0;
+
+        for(v = 1; v <= order; v++){
+            visited[v] = 0;
+        }
+        for(v = first; v <= last; v++){
+            frontier[v] = visited[v] = 1ULL << (v - first);
+            frontierVertices[frontierCount++] = v;
+        }
+
+        while(frontierCount > 0 && 2*depth + 1 < best){
+            ROOT_SET oddCycles = 0, evenCycles = 0;
+            int reachedCount = 0;
+            int j;
+
+            for(j = 0; j < frontierCount; j++){
+                int u = frontierVertices[j];
+                ROOT_SET roots = frontier[u];
+                for(i = 0; i < adj[u]; i++){
+                    int w = graph[u][i];
+                    //u and w both have distance depth to the same root
+                    oddCycles |= roots & frontier[w];
+                    if(!reached[w]){
+                        reached[w] = TRUE;
+                        reachedOnce[w] = reachedTwice[w] = 0;
+                        reachedVertices[reachedCount++] = w;
+                    }
+                    reachedTwice[w] |= reachedOnce[w] & roots;
+                    reachedOnce[w] |= roots;
+                }
+            }
+
+            for(j = 0; j < frontierCount; j++){
+                frontier[frontierVertices[j]] = 0;
+            }
+            frontierCount = 0;
+            for(j = 0; j < reachedCount; j++){
+                int w = reachedVertices[j];
+                ROOT_SET newRoots = reachedOnce[w] & ~visited[w];
+                evenCycles |= reachedTwice[w] & ~visited[w];
+                reached[w] = FALSE;
+                if(newRoots){
+                    visited[w] |= newRoots;
+                    frontier[w] = newRoots;
+                    frontierVertices[frontierCount++] = w;
+                }
+            }
+
+            if(oddCycles){
+                best = 2*depth + 1;
+            } else if(evenCycles && 2*depth + 2 < best){
+                best = 2*depth + 2;
+            }
+            if(best < bound && stopAtFirst){
+                break;
+            }
+            depth++;
+        }
+
+        for(i = 0; i < frontierCount; i++){
+            frontier[frontierVertices[i]] = 0;
+        }
+        if(best < bound && stopAtFirst){
+            break;
+        }
+    }
+
+    return best;
+}
+
+/* Returns the minimum of upperBound and the girth of the graph. The search
+ * never looks for cycles that are not shorter than upperBound.
+ */
+int computeGirth(GRAPH graph, ADJACENCY adj, int upperBound){
+    return findShortestCycle(graph, adj, upperBound, FALSE);
+}
+
+/* Returns TRUE if the graph contains no cycle that is shorter than
+ * minimumGirth. The search stops at the first shorter cycle.
+ */
+boolean hasGirthAtLeast(GRAPH graph, ADJACENCY adj, int minimumGirth){
+    return findShortestCycle(graph, adj, minimumGirth, TRUE) >= minimumGirth;
+}
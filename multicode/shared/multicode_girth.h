@@ -0,0 +1,28 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_GIRTH_H
+#define	MULTICODE_GIRTH_H
+
+#include "multicode_base.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Loops are cycles of length 1 and parallel edges are cycles of length 2.
+ */
+
+int computeGirth(GRAPH graph, ADJACENCY adj, int upperBound);
+
+boolean hasGirthAtLeast(GRAPH graph, ADJACENCY adj, int minimumGirth);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_GIRTH_H */
@@ -0,0 +1,231 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* An index file consists of a header followed by one record for each graph.
+ * All numbers are stored in the byte order of the machine, just like the
+ * two-byte entries of the codes themselves. The records are read with pread
+ * in blocks, so reading the entries of a range of graphs or of every m-th
+ * graph only touches the part of the index that contains them.
+ */
+
+#include "multicode_index.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INDEX_MAGIC ">>code_index<<"
+#define INDEX_BLOCK_ENTRIES 256
+
+typedef struct {
+    char magic[16];
+    char format[16];
+    unsigned long long graphCount;
+    unsigned long long codeFileSize;
+} INDEX_HEADER;
+
+struct CODE_INDEX_WRITER {
+    FILE *file;
+    char *name;
+    INDEX_HEADER header;
+};
+
+struct CODE_INDEX {
+    int file;
+    int codeFile;
+    char *name;
+    INDEX_HEADER header;
+
+    //the entries of the graphs firstCachedGraph up to firstCachedGraph + cachedCount
+    CODE_INDEX_ENTRY cache[INDEX_BLOCK_ENTRIES];
+    unsigned long long firstCachedGraph;
+    int cachedCount;
+
+    unsigned char *buffer;
+    size_t bufferSize;
+};
+
+static void *allocateForIndex(size_t size){
+    void *memory = malloc(size);
+    if(memory == NULL){
+        fprintf(stderr, "Insufficient memory for code index -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+char *getCodeIndexName(const char *codeFileName){
+    char *name = (char *)allocateForIndex(strlen(codeFileName) + 5);
+    strcpy(name, codeFileName);
+    strcat(name, ".idx");
+    return name;
+}
+
+//====================== WRITING =======================
+
+CODE_INDEX_WRITER *newCodeIndexWriter(const char *indexFileName, const char *format){
+    CODE_INDEX_WRITER *writer = (CODE_INDEX_WRITER *)allocateForIndex(sizeof(CODE_INDEX_WRITER));
+
+    writer->file = fopen(indexFileName, "wb");
+    if(writer->file == NULL){
+        fprintf(stderr, "Could not open %s to write index -- exiting!\n", indexFileName);
+        exit(EXIT_FAILURE);
+    }
+    writer->name = strdup(indexFileName);
+    memset(&(writer->header), 0, sizeof(INDEX_HEADER));
+    strncpy(writer->header.magic, INDEX_MAGIC, sizeof(writer->header.magic));
+    strncpy(writer->header.format, format, sizeof(writer->header.format) - 1);
+
+    //the header is written again when the number of graphs is known
+    if(fwrite(&(writer->header), sizeof(INDEX_HEADER), 1, writer->file) != 1){
+        fprintf(stderr, "Could not write to %s -- exiting!\n", writer->name);
+        exit(EXIT_FAILURE);
+    }
+    return writer;
+}
+
+void addToCodeIndex(CODE_INDEX_WRITER *writer, unsigned long long offset,
+        unsigned int length, unsigned int order){
+    CODE_INDEX_ENTRY entry;
+    entry.offset = offset;
+    entry.length = length;
+    entry.order = order;
+    if(fwrite(&entry, sizeof(CODE_INDEX_ENTRY), 1, writer->file) != 1){
+        fprintf(stderr, "Could not write to %s -- exiting!\n", writer->name);
+        exit(EXIT_FAILURE);
+    }
+    writer->header.graphCount++;
+}
+
+unsigned long long finishCodeIndex(CODE_INDEX_WRITER *writer,
+        unsigned long long codeFileSize){
+    unsigned long long graphCount = writer->header.graphCount;
+
+    writer->header.codeFileSize = codeFileSize;
+    if(fseeko(writer->file, 0, SEEK_SET) ||
+            fwrite(&(writer->header), sizeof(INDEX_HEADER), 1, writer->file) != 1 ||
+            fclose(writer->file)){
+        fprintf(stderr, "Could not write to %s -- exiting!\n", writer->name);
+        exit(EXIT_FAILURE);
+    }
+    free(writer->name);
+    free(writer);
+    return graphCount;
+}
+
+//====================== READING =======================
+
+/* Reads size bytes at the given offset of the index or of the code file.
+ */
+static void readFromIndex(CODE_INDEX *index, int file, void *buffer, size_t size, off_t offset){
+    ssize_t readCount;
+    while(size > 0){
+        readCount = pread(file, buffer, size, offset);
+        if(readCount <= 0){
+            if(readCount < 0 && errno == EINTR){
+                continue;
+            }
+            fprintf(stderr, "Could not read %s file at position %lld -- exiting!\n",
+                    file == index->file ? "index" : "code", (long long)offset);
+            exit(EXIT_FAILURE);
+        }
+        buffer = (char *)buffer + readCount;
+        size -= readCount;
+        offset += readCount;
+    }
+}
+
+CODE_INDEX *openCodeIndex(const char *indexFileName, const char *format, int codeFile){
+    struct stat codeFileStatus;
+    CODE_INDEX *index;
+    int file = open(indexFileName, O_RDONLY);
+
+    if(file < 0){
+        if(errno == ENOENT){
+            return NULL;
+        }
+        fprintf(stderr, "Could not open %s to read index -- exiting!\n", indexFileName);
+        exit(EXIT_FAILURE);
+    }
+
+    index = (CODE_INDEX *)allocateForIndex(sizeof(CODE_INDEX));
+    index->file = file;
+    index->codeFile = codeFile;
+    index->name = strdup(indexFileName);
+    index->cachedCount = 0;
+    index->firstCachedGraph = 0;
+    index->buffer = NULL;
+    index->bufferSize = 0;
+
+    if(pread(file, &(index->header), sizeof(INDEX_HEADER), 0) != sizeof(INDEX_HEADER) ||
+            strncmp(index->header.magic, INDEX_MAGIC, sizeof(index->header.magic))){
+        fprintf(stderr, "%s is not a code index -- exiting!\n", indexFileName);
+        exit(EXIT_FAILURE);
+    }
+    if(strncmp(index->header.format, format, sizeof(index->header.format))){
+        fprintf(stderr, "%s is not an index of a %s file -- exiting!\n", indexFileName, format);
+        exit(EXIT_FAILURE);
+    }
+    if(fstat(codeFile, &codeFileStatus) || !S_ISREG(codeFileStatus.st_mode)){
+        fprintf(stderr, "An index can only be used when the graphs are read from a file -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    if(codeFileStatus.st_size != index->header.codeFileSize){
+        fprintf(stderr, "%s does not belong to the given graphs: it was built for a file of %llu bytes -- exiting!\n",
+                indexFileName, index->header.codeFileSize);
+        exit(EXIT_FAILURE);
+    }
+
+    return index;
+}
+
+void closeCodeIndex(CODE_INDEX *index){
+    close(index->file);
+    free(index->name);
+    free(index->buffer);
+    free(index);
+}
+
+unsigned long long getCodeIndexSize(CODE_INDEX *index){
+    return index->header.graphCount;
+}
+
+void getCodeIndexEntry(CODE_INDEX *index, unsigned long long graph, CODE_INDEX_ENTRY *entry){
+    if(graph >= index->header.graphCount){
+        fprintf(stderr, "Graph %llu is not in %s, which contains %llu graphs -- exiting!\n",
+                graph + 1, index->name, index->header.graphCount);
+        exit(EXIT_FAILURE);
+    }
+    if(graph < index->firstCachedGraph || graph >= index->firstCachedGraph + index->cachedCount){
+        unsigned long long remaining;
+        index->firstCachedGraph = graph - graph % INDEX_BLOCK_ENTRIES;
+        remaining = index->header.graphCount - index->firstCachedGraph;
+        index->cachedCount = remaining < INDEX_BLOCK_ENTRIES ? remaining : INDEX_BLOCK_ENTRIES;
+        readFromIndex(index, index->file, index->cache,
+                index->cachedCount * sizeof(CODE_INDEX_ENTRY),
+                sizeof(INDEX_HEADER) + index->firstCachedGraph * sizeof(CODE_INDEX_ENTRY));
+    }
+    *entry = index->cache[graph - index->firstCachedGraph];
+}
+
+void readIndexedBytes(CODE_INDEX *index, CODE_INDEX_ENTRY *entry, unsigned char *buffer){
+    readFromIndex(index, index->codeFile, buffer, entry->length, entry->offset);
+}
+
+int readIndexedCode(CODE_INDEX *index, CODE_INDEX_ENTRY *entry,
+        unsigned short code[], int maxLength){
+    if(index->bufferSize < entry->length){
+        free(index->buffer);
+        index->bufferSize = 2 * entry->length;
+        index->buffer = (unsigned char *)allocateForIndex(index->bufferSize);
+    }
+    readIndexedBytes(index, entry, index->buffer);
+    return copyCodeEntries(index->buffer, entry->length, code, maxLength);
+}
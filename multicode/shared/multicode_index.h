@@ -0,0 +1,93 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_INDEX_H
+#define	MULTICODE_INDEX_H
+
+#include <stdio.h>
+
+#include "multicode_scanner.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* This module does not depend on multicode_base.h, so that it can also be
+ * used by the programs for plane graphs, which have their own definitions
+ * of GRAPH and MAXN.
+ *
+ * A code index is a sidecar file (by convention the name of the code file
+ * followed by .idx) that stores for each graph in a file of codes where its
+ * code starts, how many bytes it has and the order of the graph. The index
+ * also stores the format and the size of the code file, so an index that
+ * belongs to another file is detected.
+ */
+
+typedef struct {
+    //the position in the code file of the first byte of the code
+    unsigned long long offset;
+    //the number of bytes of the code
+    unsigned int length;
+    unsigned int order;
+} CODE_INDEX_ENTRY;
+
+typedef struct CODE_INDEX_WRITER CODE_INDEX_WRITER;
+
+/* Returns the name of the index that belongs to the given code file. The
+ * caller should free the name.
+ */
+char *getCodeIndexName(const char *codeFileName);
+
+/* The format is MULTICODE_FORMAT or PLANARCODE_FORMAT.
+ */
+CODE_INDEX_WRITER *newCodeIndexWriter(const char *indexFileName, const char *format);
+
+void addToCodeIndex(CODE_INDEX_WRITER *writer, unsigned long long offset,
+        unsigned int length, unsigned int order);
+
+/* Completes the index and frees the writer. The size of the code file
+ * is stored, so it can be checked when the index is opened. Returns the
+ * number of graphs in the index.
+ */
+unsigned long long finishCodeIndex(CODE_INDEX_WRITER *writer,
+        unsigned long long codeFileSize);
+
+typedef struct CODE_INDEX CODE_INDEX;
+
+/* Opens the index with the given name for the code file that is open as the
+ * file descriptor codeFile. Returns NULL if the index does not exist. Exits
+ * if the index is not an index of the given format or if its size does not
+ * match the size of the code file.
+ */
+CODE_INDEX *openCodeIndex(const char *indexFileName, const char *format, int codeFile);
+
+void closeCodeIndex(CODE_INDEX *index);
+
+unsigned long long getCodeIndexSize(CODE_INDEX *index);
+
+/* Stores the entry of the given graph in entry. The graphs are numbered
+ * starting from 0.
+ */
+void getCodeIndexEntry(CODE_INDEX *index, unsigned long long graph, CODE_INDEX_ENTRY *entry);
+
+/* Reads the bytes of the code described by entry from the code file. The
+ * buffer should have room for entry->length bytes.
+ */
+void readIndexedBytes(CODE_INDEX *index, CODE_INDEX_ENTRY *entry, unsigned char *buffer);
+
+/* Reads the code described by entry from the code file and stores its
+ * entries in code, starting with the order. Returns the number of entries.
+ * Exits if the code has more than maxLength entries.
+ */
+int readIndexedCode(CODE_INDEX *index, CODE_INDEX_ENTRY *entry,
+        unsigned short code[], int maxLength);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_INDEX_H */
@@ -6,40 +6,188 @@
  */
 
 #include "multicode_input.h"
+#include "multicode_scanner.h"
 #include<string.h>
 
-void decodeMultiCode(unsigned short* code, int length, GRAPH graph, ADJACENCY adj) {
-    int i, j, currentVertex;
-    unsigned short vertexCount;
+#define MAX_STREAM_COUNT 16
+
+/* The boundaries of the codes are found by a code scanner, which maps
+ * regular files into memory and reads other input in large blocks.
+ */
+struct _multicodeReader {
+    CODE_SCANNER *scanner;
+};
+
+MULTICODE_READER *newMultiCodeReader(FILE *file) {
+    MULTICODE_READER *reader = (MULTICODE_READER *)malloc(sizeof(MULTICODE_READER));
+    if (reader == NULL) {
+        fprintf(stderr, "Insufficient memory for multicode reader -- exiting!\n");
+        exit(1);
+    }
+    reader->scanner = newCodeScanner(file, MULTICODE_FORMAT);
+    return reader;
+}
+
+/* For a mapped file the position of the stream is set to the first byte
+ * after the last code that was read. Input that was buffered from other
+ * streams is lost.
+ */
+void freeMultiCodeReader(MULTICODE_READER *reader) {
+    freeCodeScanner(reader->scanner);
+    free(reader);
+}
 
-    graph[0][0] = vertexCount = code[0];
+/**
+ * Finds the next code in the input and stores a view on it in view.
+ * 
+ * @param reader
+ * @param view
+ * @return returns TRUE if a code was read and FALSE otherwise. Exits in case of error.
+ */
+boolean nextMultiCode(MULTICODE_READER *reader, MULTICODE_VIEW *view) {
+    CODE_RECORD record;
+
+    if (!nextCodeRecord(reader->scanner, &record)) {
+        //nothing left in file
+        return FALSE;
+    }
+    if (record.order > MAXN) {
+        fprintf(stderr, "Constant N too small %d > %d \n", record.order, MAXN);
+        exit(1);
+    }
+
+    view->order = record.order;
+    view->twoByteEntries = record.twoByteEntries;
+    if (record.twoByteEntries) {
+        view->data = record.data + 1;
+        view->length = (record.length - 1) / 2;
+    } else {
+        view->data = record.data;
+        view->length = record.length;
+    }
+
+    return TRUE;
+}
+
+/* Copies the code in view to code and returns the length of the code.
+ */
+int copyMultiCodeView(MULTICODE_VIEW *view, unsigned short code[]) {
+    int i;
+
+    if (view->length > MAXCODELENGTH) {
+        fprintf(stderr, "Constant MAXCODELENGTH too small %d > %d \n", view->length, MAXCODELENGTH);
+        exit(1);
+    }
+
+    if (view->twoByteEntries) {
+        memcpy(code, view->data, view->length * sizeof (unsigned short));
+    } else {
+        for (i = 0; i < view->length; i++) {
+            code[i] = view->data[i];
+        }
+    }
+
+    return view->length;
+}
+
+/* Only the degrees are reset: the rows of the vertices are not cleared, so
+ * decoding a graph takes time proportional to its order and size.
+ */
+static void clearGraph(GRAPH graph, ADJACENCY adj, unsigned short vertexCount) {
+    int i, j;
+
+    graph[0][0] = vertexCount;
 
     //mark all vertices as having degree 0
     for (i = 1; i <= vertexCount; i++) {
         adj[i] = 0;
-        for (j = 0; j <= MAXVAL; j++) {
-            graph[i][j] = EMPTY;
-        }
     }
     //clear first row
     for (j = 1; j <= MAXVAL; j++) {
         graph[0][j] = 0;
     }
+}
+
+/* Handles a single entry of a code and returns the vertex whose neighbours
+ * are listed next.
+ */
+static inline int decodeEntry(GRAPH graph, ADJACENCY adj, int currentVertex, unsigned short entry) {
+    if (entry == 0) {
+        return currentVertex + 1;
+    }
+    addEdge(graph, adj, currentVertex, (int) entry);
+    if ((adj[entry] > MAXVAL) || (adj[currentVertex] > MAXVAL)) {
+        fprintf(stderr, "MAXVAL too small (%d)!\n", MAXVAL);
+        exit(0);
+    }
+    return currentVertex;
+}
+
+/* Decodes the code in view directly from the input without copying it.
+ */
+void decodeMultiCodeView(MULTICODE_VIEW *view, GRAPH graph, ADJACENCY adj) {
+    int i, currentVertex;
+    unsigned short entry;
+
+    clearGraph(graph, adj, view->order);
+
+    //go through code and add edges
+    currentVertex = 1;
+
+    if (view->twoByteEntries) {
+        for (i = 1; i < view->length; i++) {
+            memcpy(&entry, view->data + i * sizeof (unsigned short), sizeof (unsigned short));
+            currentVertex = decodeEntry(graph, adj, currentVertex, entry);
+        }
+    } else {
+        for (i = 1; i < view->length; i++) {
+            currentVertex = decodeEntry(graph, adj, currentVertex, view->data[i]);
+        }
+    }
+}
+
+void decodeMultiCode(unsigned short* code, int length, GRAPH graph, ADJACENCY adj) {
+    int i, currentVertex;
+
+    clearGraph(graph, adj, code[0]);
 
     //go through code and add edges
     currentVertex = 1;
 
     for (i = 1; i < length; i++) {
-        if (code[i] == 0) {
-            currentVertex++;
-        } else {
-            addEdge(graph, adj, currentVertex, (int) code[i]);
-            if ((adj[code[i]] > MAXVAL) || (adj[currentVertex] > MAXVAL)) {
-                fprintf(stderr, "MAXVAL too small (%d)!\n", MAXVAL);
-                exit(0);
-            }
+        currentVertex = decodeEntry(graph, adj, currentVertex, code[i]);
+    }
+}
+
+/* Each stream that is read with readMultiCode gets its own reader. Readers
+ * are never freed, because readMultiCode cannot know whether the caller is
+ * done with a stream.
+ */
+typedef struct {
+    FILE *file;
+    MULTICODE_READER *reader;
+} STREAM_READER;
+
+static STREAM_READER streamReaders[MAX_STREAM_COUNT];
+static int streamReaderCount = 0;
+
+static MULTICODE_READER *getStreamReader(FILE *file) {
+    int i;
+
+    for (i = 0; i < streamReaderCount; i++) {
+        if (streamReaders[i].file == file) {
+            return streamReaders[i].reader;
         }
     }
+
+    if (streamReaderCount == MAX_STREAM_COUNT) {
+        fprintf(stderr, "Too many multicode streams (%d) -- exiting!\n", MAX_STREAM_COUNT);
+        exit(1);
+    }
+    streamReaders[streamReaderCount].file = file;
+    streamReaders[streamReaderCount].reader = newMultiCodeReader(file);
+
+    return streamReaders[streamReaderCount++].reader;
 }
 
 /**
@@ -50,117 +198,12 @@ void decodeMultiCode(unsigned short* code, int length, GRAPH graph, ADJACENCY ad
  * @return returns 1 if a code was read and 0 otherwise. Exits in case of error.
  */
 int readMultiCode(unsigned short code[], int *length, FILE *file) {
-    static int first = 1;
-    unsigned char c;
-    char testheader[20];
-    int bufferSize, zeroCounter;
-    
-    int readCount;
-
+    MULTICODE_VIEW view;
 
-    if (first) {
-        first = 0;
-
-        if (fread(&testheader, sizeof (unsigned char), 12, file) != 12) {
-            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
-            exit(1);
-        }
-        testheader[12] = 0;
-        if (strcmp(testheader, ">>multi_code") == 0) {
-
-        } else {
-            fprintf(stderr, "No multicode header detected -- exiting!\n");
-            exit(1);
-        }
-        //read reminder of header (either empty or le/be specification)
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-        while (c!='<'){
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                return FALSE;
-            }
-        }
-        //read one more character
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-    }
-
-    /* possibly removing interior headers -- only done for multicode */
-    if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-        //nothing left in file
+    if (!nextMultiCode(getStreamReader(file), &view)) {
         return (0);
     }
 
-    if (c == '>') {
-        // could be a header, or maybe just a 62 (which is also possible for unsigned char
-        code[0] = c;
-        bufferSize = 1;
-        zeroCounter = 0;
-        code[1] = (unsigned short) getc(file);
-        if (code[1] == 0) zeroCounter++;
-        code[2] = (unsigned short) getc(file);
-        if (code[2] == 0) zeroCounter++;
-        bufferSize = 3;
-        // 3 characters were read and stored in buffer
-        if ((code[1] == '>') && (code[2] == 'm')) /*we are sure that we're dealing with a header*/ {
-            while ((c = getc(file)) != '<');
-            /* read 2 more characters: */
-            c = getc(file);
-            if (c != '<') {
-                fprintf(stderr, "Problems with header -- single '<'\n");
-                exit(1);
-            }
-            if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                //nothing left in file
-                return (0);
-            }
-            bufferSize = 1;
-            zeroCounter = 0;
-        }
-    } else {
-        //no header present
-        bufferSize = 1;
-        zeroCounter = 0;
-    }
-
-    if (c != 0) /* unsigned chars would be sufficient */ {
-        code[0] = c;
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        while (zeroCounter < code[0]-1) {
-            code[bufferSize] = (unsigned short) getc(file);
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    } else {
-        readCount = fread(code, sizeof (unsigned short), 1, file);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            exit(1);
-        }
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        bufferSize = 1;
-        zeroCounter = 0;
-        while (zeroCounter < code[0]-1) {
-            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                exit(1);
-            }
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    }
-
-    *length = bufferSize;
+    *length = copyMultiCodeView(&view, code);
     return (1);
-
-
 }
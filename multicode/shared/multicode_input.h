@@ -15,6 +15,32 @@
 extern "C" {
 #endif
 
+/* A view on a single code inside the input of a multicode reader. The view
+ * refers directly to the bytes of the input and is only valid until the next
+ * call to nextMultiCode for the same reader.
+ */
+typedef struct {
+    //points to the entry containing the order of the graph
+    const unsigned char *data;
+    //TRUE if each entry consists of two bytes
+    boolean twoByteEntries;
+    int order;
+    //number of entries, including the order
+    int length;
+} MULTICODE_VIEW;
+
+typedef struct _multicodeReader MULTICODE_READER;
+
+MULTICODE_READER *newMultiCodeReader(FILE *file);
+
+void freeMultiCodeReader(MULTICODE_READER *reader);
+
+boolean nextMultiCode(MULTICODE_READER *reader, MULTICODE_VIEW *view);
+
+int copyMultiCodeView(MULTICODE_VIEW *view, unsigned short code[]);
+
+void decodeMultiCodeView(MULTICODE_VIEW *view, GRAPH graph, ADJACENCY adj);
+
 void decodeMultiCode(unsigned short* code, int length, GRAPH graph, ADJACENCY adj);
 
 int readMultiCode(unsigned short code[], int *length, FILE *file);
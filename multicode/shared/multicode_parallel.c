@@ -0,0 +1,73 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The graphs are read, evaluated and handled by an ordered pipeline (see
+ * multicode_pipeline.h): the items of the pipeline are the codes of the
+ * graphs, and each worker decodes the graphs in its own GRAPH.
+ */
+
+#include "multicode_parallel.h"
+#include "multicode_input.h"
+#include "multicode_pipeline.h"
+
+typedef struct {
+    GRAPH graph;
+    ADJACENCY adj;
+} WORKER_GRAPH;
+
+typedef struct {
+    MULTICODE_READER *reader;
+    GRAPH_EVALUATOR evaluate;
+    RESULT_HANDLER handle;
+} PARALLEL_CONTEXT;
+
+static int readCode(unsigned char *item, size_t *length, void *context){
+    PARALLEL_CONTEXT *parallel = (PARALLEL_CONTEXT *)context;
+    MULTICODE_VIEW code;
+
+    if(!nextMultiCode(parallel->reader, &code)){
+        return FALSE;
+    }
+    *length = sizeof(unsigned short) * copyMultiCodeView(&code, (unsigned short *)item);
+    return TRUE;
+}
+
+static void evaluateCode(const unsigned char *item, size_t length,
+        void *result, void *scratch, void *context){
+    PARALLEL_CONTEXT *parallel = (PARALLEL_CONTEXT *)context;
+    WORKER_GRAPH *graph = (WORKER_GRAPH *)scratch;
+
+    decodeMultiCode((unsigned short *)item, length / sizeof(unsigned short),
+            graph->graph, graph->adj);
+    parallel->evaluate(graph->graph, graph->adj, result);
+}
+
+static void handleCode(const unsigned char *item, size_t length,
+        void *result, void *context){
+    PARALLEL_CONTEXT *parallel = (PARALLEL_CONTEXT *)context;
+
+    parallel->handle((unsigned short *)item, length / sizeof(unsigned short), result);
+}
+
+/* Reads all graphs from file, evaluates them with threadCount worker threads
+ * and calls handle for each graph in the order of the input. Each result
+ * occupies resultSize bytes.
+ */
+void processMultiCodeInParallel(FILE *file, int threadCount, size_t resultSize,
+        GRAPH_EVALUATOR evaluate, RESULT_HANDLER handle){
+    PARALLEL_CONTEXT context;
+
+    context.reader = newMultiCodeReader(file);
+    context.evaluate = evaluate;
+    context.handle = handle;
+
+    runOrderedPipeline(threadCount, sizeof(unsigned short)*MAXCODELENGTH,
+            resultSize, sizeof(WORKER_GRAPH), readCode, evaluateCode,
+            handleCode, &context);
+
+    freeMultiCodeReader(context.reader);
+}
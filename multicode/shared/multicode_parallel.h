@@ -0,0 +1,39 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_PARALLEL_H
+#define	MULTICODE_PARALLEL_H
+
+#include "multicode_base.h"
+#include<stdio.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Computes the result for one graph. This function is called concurrently
+ * from several worker threads, so it should only use its arguments and
+ * thread-local data. The result should be written to the memory pointed to
+ * by result.
+ */
+typedef void (*GRAPH_EVALUATOR)(GRAPH graph, ADJACENCY adj, void *result);
+
+/* Handles the result for one graph. This function is only called from the
+ * thread that called processMultiCodeInParallel and is called for the graphs
+ * in the order in which they appear in the input.
+ */
+typedef void (*RESULT_HANDLER)(unsigned short *code, int length, void *result);
+
+void processMultiCodeInParallel(FILE *file, int threadCount, size_t resultSize,
+        GRAPH_EVALUATOR evaluate, RESULT_HANDLER handle);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_PARALLEL_H */
+
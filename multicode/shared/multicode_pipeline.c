@@ -0,0 +1,283 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The input is split into batches by a reader thread. The items of a batch
+ * are processed by a pool of worker threads, and the calling thread hands the
+ * results to the consumer once a complete batch has been processed. A fixed
+ * number of batches is in use at any time, so the reader can stay ahead of
+ * the workers without reading the whole input into memory.
+ */
+
+#include "multicode_pipeline.h"
+#include<stdio.h>
+#include<stdlib.h>
+#include<pthread.h>
+#include<sys/resource.h>
+
+#define BATCH_COUNT 4
+#define BATCH_SIZE 1024
+//room for the small items of a full batch on top of two maximal items
+#define SMALL_ITEM_LENGTH 128
+
+//the items in a batch start at a multiple of this alignment
+#define ITEM_ALIGNMENT 8
+
+#define DEFAULT_WORKER_STACK_SIZE (64*1024*1024)
+
+#define BATCH_FREE 0
+#define BATCH_FILLED 1
+
+typedef struct {
+    int state;
+    long sequenceNumber;
+    int last;
+
+    int itemCount;
+    int processedCount;
+
+    unsigned char *items;
+    size_t offsets[BATCH_SIZE];
+    size_t lengths[BATCH_SIZE];
+
+    char *results;
+} BATCH;
+
+typedef struct {
+    size_t maximumItemLength;
+    size_t batchLength;
+    size_t resultSize;
+    size_t scratchSize;
+    ITEM_READER read;
+    ITEM_WORKER work;
+    void *context;
+
+    BATCH batches[BATCH_COUNT];
+
+    //the next item that will be handed to a worker
+    long claimSequenceNumber;
+    int claimIndex;
+
+    pthread_mutex_t lock;
+    pthread_cond_t batchFilled;
+    pthread_cond_t batchProcessed;
+    pthread_cond_t batchFreed;
+} PIPELINE;
+
+static void *readBatches(void *arg){
+    PIPELINE *pipeline = (PIPELINE *)arg;
+    long sequenceNumber;
+    size_t used;
+    int last;
+
+    for(sequenceNumber = 0; ; sequenceNumber++){
+        BATCH *batch = pipeline->batches + (sequenceNumber % BATCH_COUNT);
+
+        pthread_mutex_lock(&(pipeline->lock));
+        while(batch->state != BATCH_FREE){
+            pthread_cond_wait(&(pipeline->batchFreed), &(pipeline->lock));
+        }
+        pthread_mutex_unlock(&(pipeline->lock));
+
+        //the batch is free, so nobody else is using it while we fill it
+        batch->itemCount = 0;
+        used = 0;
+        last = 0;
+        while(batch->itemCount < BATCH_SIZE &&
+                used + pipeline->maximumItemLength <= pipeline->batchLength){
+            size_t length;
+            if(!pipeline->read(batch->items + used, &length, pipeline->context)){
+                last = 1;
+                break;
+            }
+            batch->offsets[batch->itemCount] = used;
+            batch->lengths[batch->itemCount] = length;
+            used += (length + ITEM_ALIGNMENT - 1) / ITEM_ALIGNMENT * ITEM_ALIGNMENT;
+            batch->itemCount++;
+        }
+
+        pthread_mutex_lock(&(pipeline->lock));
+        batch->sequenceNumber = sequenceNumber;
+        batch->last = last;
+        batch->processedCount = 0;
+        batch->state = BATCH_FILLED;
+        pthread_cond_broadcast(&(pipeline->batchFilled));
+        if(batch->itemCount == 0){
+            //no worker will finish an item of this batch to wake the consumer
+            pthread_cond_broadcast(&(pipeline->batchProcessed));
+        }
+        pthread_mutex_unlock(&(pipeline->lock));
+
+        if(last){
+            return NULL;
+        }
+    }
+}
+
+static void *processBatches(void *arg){
+    PIPELINE *pipeline = (PIPELINE *)arg;
+    BATCH *batch;
+    int index;
+
+    void *scratch = malloc(pipeline->scratchSize ? pipeline->scratchSize : 1);
+    if(scratch == NULL){
+        fprintf(stderr, "Insufficient memory for worker thread -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while(1){
+        pthread_mutex_lock(&(pipeline->lock));
+        batch = pipeline->batches + (pipeline->claimSequenceNumber % BATCH_COUNT);
+        while(batch->state != BATCH_FILLED ||
+                batch->sequenceNumber != pipeline->claimSequenceNumber){
+            pthread_cond_wait(&(pipeline->batchFilled), &(pipeline->lock));
+            batch = pipeline->batches + (pipeline->claimSequenceNumber % BATCH_COUNT);
+        }
+        if(pipeline->claimIndex == batch->itemCount){
+            //only happens for the last batch: there is nothing left to do
+            pthread_mutex_unlock(&(pipeline->lock));
+            break;
+        }
+        index = pipeline->claimIndex++;
+        if(pipeline->claimIndex == batch->itemCount && !batch->last){
+            /* move on to the next batch immediately: this batch might be
+             * reused before another worker comes back to claim an item
+             */
+            pipeline->claimSequenceNumber++;
+            pipeline->claimIndex = 0;
+        }
+        pthread_mutex_unlock(&(pipeline->lock));
+
+        pipeline->work(batch->items + batch->offsets[index], batch->lengths[index],
+                batch->results + index*pipeline->resultSize, scratch,
+                pipeline->context);
+
+        pthread_mutex_lock(&(pipeline->lock));
+        batch->processedCount++;
+        if(batch->processedCount == batch->itemCount){
+            pthread_cond_broadcast(&(pipeline->batchProcessed));
+        }
+        pthread_mutex_unlock(&(pipeline->lock));
+    }
+
+    free(scratch);
+
+    return NULL;
+}
+
+/* Workers get the same stack size as the main thread, so recursive workers
+ * can handle the same items as in the single-threaded case.
+ */
+static size_t getWorkerStackSize(){
+    struct rlimit limit;
+
+    if(getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+            limit.rlim_cur > DEFAULT_WORKER_STACK_SIZE){
+        return limit.rlim_cur;
+    }
+
+    return DEFAULT_WORKER_STACK_SIZE;
+}
+
+/* Reads all items with read, processes them with threadCount worker threads
+ * and calls consume for each item in the order of the input. Each result
+ * occupies resultSize bytes and each worker has scratchSize bytes of scratch
+ * memory.
+ */
+void runOrderedPipeline(int threadCount, size_t maximumItemLength,
+        size_t resultSize, size_t scratchSize, ITEM_READER read,
+        ITEM_WORKER work, ITEM_CONSUMER consume, void *context){
+    int i;
+    long sequenceNumber;
+    PIPELINE pipeline;
+    pthread_t reader;
+    pthread_t workers[threadCount];
+    pthread_attr_t attributes;
+
+    pipeline.maximumItemLength = maximumItemLength;
+    pipeline.batchLength = 2*maximumItemLength + BATCH_SIZE*SMALL_ITEM_LENGTH;
+    pipeline.resultSize = resultSize;
+    pipeline.scratchSize = scratchSize;
+    pipeline.read = read;
+    pipeline.work = work;
+    pipeline.context = context;
+    pipeline.claimSequenceNumber = 0;
+    pipeline.claimIndex = 0;
+
+    for(i = 0; i < BATCH_COUNT; i++){
+        pipeline.batches[i].state = BATCH_FREE;
+        pipeline.batches[i].items = (unsigned char *)malloc(pipeline.batchLength);
+        pipeline.batches[i].results = (char *)malloc(resultSize*BATCH_SIZE);
+        if(pipeline.batches[i].items == NULL || pipeline.batches[i].results == NULL){
+            fprintf(stderr, "Insufficient memory for batches -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    pthread_mutex_init(&(pipeline.lock), NULL);
+    pthread_cond_init(&(pipeline.batchFilled), NULL);
+    pthread_cond_init(&(pipeline.batchProcessed), NULL);
+    pthread_cond_init(&(pipeline.batchFreed), NULL);
+
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, getWorkerStackSize());
+
+    if(pthread_create(&reader, NULL, readBatches, &pipeline)){
+        fprintf(stderr, "Could not start reader thread -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    for(i = 0; i < threadCount; i++){
+        if(pthread_create(workers + i, &attributes, processBatches, &pipeline)){
+            fprintf(stderr, "Could not start worker thread -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    //hand the results to the consumer in the order of the input
+    for(sequenceNumber = 0; ; sequenceNumber++){
+        BATCH *batch = pipeline.batches + (sequenceNumber % BATCH_COUNT);
+
+        pthread_mutex_lock(&(pipeline.lock));
+        while(batch->state != BATCH_FILLED ||
+                batch->sequenceNumber != sequenceNumber ||
+                batch->processedCount < batch->itemCount){
+            pthread_cond_wait(&(pipeline.batchProcessed), &(pipeline.lock));
+        }
+        pthread_mutex_unlock(&(pipeline.lock));
+
+        for(i = 0; i < batch->itemCount; i++){
+            consume(batch->items + batch->offsets[i], batch->lengths[i],
+                    batch->results + i*resultSize, context);
+        }
+        if(batch->last){
+            /* the last batch is not freed: the workers use it to detect that
+             * the input is exhausted
+             */
+            break;
+        }
+
+        pthread_mutex_lock(&(pipeline.lock));
+        batch->state = BATCH_FREE;
+        pthread_cond_broadcast(&(pipeline.batchFreed));
+        pthread_mutex_unlock(&(pipeline.lock));
+    }
+
+    pthread_join(reader, NULL);
+    for(i = 0; i < threadCount; i++){
+        pthread_join(workers[i], NULL);
+    }
+
+    pthread_attr_destroy(&attributes);
+    pthread_mutex_destroy(&(pipeline.lock));
+    pthread_cond_destroy(&(pipeline.batchFilled));
+    pthread_cond_destroy(&(pipeline.batchProcessed));
+    pthread_cond_destroy(&(pipeline.batchFreed));
+
+    for(i = 0; i < BATCH_COUNT; i++){
+        free(pipeline.batches[i].items);
+        free(pipeline.batches[i].results);
+    }
+}
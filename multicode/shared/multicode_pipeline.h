@@ -0,0 +1,51 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_PIPELINE_H
+#define	MULTICODE_PIPELINE_H
+
+#include<stddef.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* An ordered pipeline: a reader thread reads the items, a pool of worker
+ * threads processes them and the calling thread consumes the results in the
+ * order of the input. The items are opaque byte strings, so this module does
+ * not depend on multicode_base.h and can also be used by the programs for
+ * plane graphs.
+ */
+
+/* Reads the next item into item (at most the maximum item length given to
+ * runOrderedPipeline) and stores its length. Returns 0 if there are no more
+ * items. This function is only called from the reader thread.
+ */
+typedef int (*ITEM_READER)(unsigned char *item, size_t *length, void *context);
+
+/* Processes one item and writes the result to result. This function is called
+ * concurrently from several worker threads. scratch points to scratchSize
+ * bytes that belong to the calling worker thread.
+ */
+typedef void (*ITEM_WORKER)(const unsigned char *item, size_t length,
+        void *result, void *scratch, void *context);
+
+/* Consumes the result of one item. This function is only called from the
+ * thread that called runOrderedPipeline, for the items in input order.
+ */
+typedef void (*ITEM_CONSUMER)(const unsigned char *item, size_t length,
+        void *result, void *context);
+
+void runOrderedPipeline(int threadCount, size_t maximumItemLength,
+        size_t resultSize, size_t scratchSize, ITEM_READER read,
+        ITEM_WORKER work, ITEM_CONSUMER consume, void *context);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_PIPELINE_H */
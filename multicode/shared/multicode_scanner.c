@@ -0,0 +1,404 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The end of a code is found by counting its zero entries. With SSE2 (or
+ * AVX2 when the compiler targets it), blocks of 64 bytes are compared to
+ * zero at once and the resulting bit masks are counted with popcount, so
+ * only the block that contains the last zero entry is inspected bit by bit.
+ * For two-byte entries the comparison is done per 16-bit lane, which is
+ * aligned with the entries because the loads start at an entry.
+ */
+
+#include "multicode_scanner.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define READ_BUFFER_SIZE (1 << 20)
+#define MAX_HEADER_LENGTH 16
+
+/* data[position] is the first byte that has not been handed out yet and
+ * data[end - 1] is the last byte that is available. data[0] is the byte at
+ * dataOffset in the stream.
+ */
+struct CODE_SCANNER {
+    FILE *file;
+    int headerRead;
+
+    //">>" followed by the format
+    char header[MAX_HEADER_LENGTH];
+    int headerLength;
+    //the name of the format in messages
+    char name[MAX_HEADER_LENGTH];
+    //the number of zero entries of a code is the order minus this number
+    int zeroEntryDeficit;
+
+    int mapped;
+    off_t dataOffset;
+
+    unsigned char *data;
+    size_t capacity;
+    size_t position;
+    size_t end;
+    int eof;
+};
+
+//====================== ZERO COUNTING =======================
+
+/* Returns the position after the count-th set bit of mask, where each bit
+ * stands for bitWidth bytes.
+ */
+static inline size_t positionAfterSetBit(unsigned long long mask, int count, int bitWidth){
+    while(--count){
+        mask &= mask - 1;
+    }
+    return (__builtin_ctzll(mask) / bitWidth + 1) * bitWidth;
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+/* Returns a mask with bit i set if data[i] is zero, for 0 <= i < 64. If
+ * words is non-zero, the bytes are compared per aligned pair and both bits of
+ * a zero pair are set.
+ */
+static inline unsigned long long zeroMask(const unsigned char *data, int words){
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i low = _mm256_loadu_si256((const __m256i *)data);
+    __m256i high = _mm256_loadu_si256((const __m256i *)(data + 32));
+    if(words){
+        low = _mm256_cmpeq_epi16(low, zero);
+        high = _mm256_cmpeq_epi16(high, zero);
+    } else {
+        low = _mm256_cmpeq_epi8(low, zero);
+        high = _mm256_cmpeq_epi8(high, zero);
+    }
+    return (unsigned int)_mm256_movemask_epi8(low) |
+            ((unsigned long long)(unsigned int)_mm256_movemask_epi8(high) << 32);
+#else
+    const __m128i zero = _mm_setzero_si128();
+    unsigned long long mask = 0;
+    int i;
+    for(i = 0; i < 4; i++){
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + 16*i));
+        block = words ? _mm_cmpeq_epi16(block, zero) : _mm_cmpeq_epi8(block, zero);
+        mask |= (unsigned long long)_mm_movemask_epi8(block) << (16*i);
+    }
+    return mask;
+#endif
+}
+#endif
+
+size_t scanZeroBytes(const unsigned char *data, size_t size, int *count){
+    size_t i = 0;
+    if(*count <= 0){
+        return 0;
+    }
+#if defined(__AVX2__) || defined(__SSE2__)
+    for(; i + 64 <= size; i += 64){
+        unsigned long long mask = zeroMask(data + i, 0);
+        int zeros = __builtin_popcountll(mask);
+        if(zeros >= *count){
+            i += positionAfterSetBit(mask, *count, 1);
+            *count = 0;
+            return i;
+        }
+        *count -= zeros;
+    }
+#endif
+    for(; i < size; i++){
+        if(data[i] == 0 && --*count == 0){
+            return i + 1;
+        }
+    }
+    return size;
+}
+
+size_t scanZeroWords(const unsigned char *data, size_t size, int *count){
+    size_t i = 0;
+    if(*count <= 0){
+        return 0;
+    }
+#if defined(__AVX2__) || defined(__SSE2__)
+    for(; i + 64 <= size; i += 64){
+        //only the first bit of each pair is kept
+        unsigned long long mask = zeroMask(data + i, 1) & 0x5555555555555555ULL;
+        int zeros = __builtin_popcountll(mask);
+        if(zeros >= *count){
+            i += positionAfterSetBit(mask, *count, 2);
+            *count = 0;
+            return i;
+        }
+        *count -= zeros;
+    }
+#endif
+    for(; i + 2 <= size; i += 2){
+        if(data[i] == 0 && data[i + 1] == 0 && --*count == 0){
+            return i + 2;
+        }
+    }
+    return size;
+}
+
+//====================== INPUT =======================
+
+static void *allocateForScanner(size_t size){
+    void *memory = malloc(size);
+    if(memory == NULL){
+        fprintf(stderr, "Insufficient memory for code scanner -- exiting!\n");
+        exit(1);
+    }
+    return memory;
+}
+
+CODE_SCANNER *newCodeScanner(FILE *file, const char *format){
+    struct stat fileStatus;
+    off_t offset, mappingOffset;
+    void *mapping;
+    const char *c;
+    char *name;
+
+    CODE_SCANNER *scanner = (CODE_SCANNER *)allocateForScanner(sizeof(CODE_SCANNER));
+    scanner->file = file;
+    scanner->headerRead = 0;
+    scanner->headerLength = snprintf(scanner->header, MAX_HEADER_LENGTH, ">>%s", format);
+    for(c = format, name = scanner->name; *c; c++){
+        if(*c != '_'){
+            *name++ = *c;
+        }
+    }
+    *name = 0;
+    scanner->zeroEntryDeficit = strcmp(format, MULTICODE_FORMAT) ? 0 : 1;
+    scanner->mapped = 0;
+    scanner->dataOffset = 0;
+    scanner->position = 0;
+    scanner->end = 0;
+    scanner->eof = 0;
+
+    //ftello takes into account anything that was already read through file
+    if(fstat(fileno(file), &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) &&
+            (offset = ftello(file)) >= 0 && fileStatus.st_size > offset){
+        mappingOffset = offset - offset % sysconf(_SC_PAGESIZE);
+        mapping = mmap(NULL, fileStatus.st_size - mappingOffset, PROT_READ,
+                MAP_PRIVATE, fileno(file), mappingOffset);
+        if(mapping != MAP_FAILED){
+            madvise(mapping, fileStatus.st_size - mappingOffset, MADV_SEQUENTIAL);
+            scanner->mapped = 1;
+            scanner->dataOffset = mappingOffset;
+            scanner->data = (unsigned char *)mapping;
+            scanner->capacity = scanner->end = fileStatus.st_size - mappingOffset;
+            scanner->position = offset - mappingOffset;
+            scanner->eof = 1;
+            return scanner;
+        }
+    }
+
+    //for a pipe ftello fails and positions are counted from this point
+    if((offset = ftello(file)) > 0){
+        scanner->dataOffset = offset;
+    }
+    scanner->capacity = READ_BUFFER_SIZE;
+    scanner->data = (unsigned char *)allocateForScanner(scanner->capacity);
+    return scanner;
+}
+
+void freeCodeScanner(CODE_SCANNER *scanner){
+    if(scanner->mapped){
+        munmap(scanner->data, scanner->capacity);
+        fseeko(scanner->file, scanner->dataOffset + scanner->position, SEEK_SET);
+    } else {
+        free(scanner->data);
+    }
+    free(scanner);
+}
+
+/* Makes sure that at least count bytes starting at position are available.
+ * Returns 0 if the input ends before that.
+ */
+static int ensureAvailable(CODE_SCANNER *scanner, size_t count){
+    size_t requested, readCount;
+
+    while(scanner->end - scanner->position < count){
+        if(scanner->eof){
+            return 0;
+        }
+        if(scanner->position > 0){
+            memmove(scanner->data, scanner->data + scanner->position,
+                    scanner->end - scanner->position);
+            scanner->end -= scanner->position;
+            scanner->dataOffset += scanner->position;
+            scanner->position = 0;
+        }
+        if(scanner->capacity < count){
+            scanner->capacity = 2*scanner->capacity < count ? count : 2*scanner->capacity;
+            unsigned char *newData = (unsigned char *)realloc(scanner->data, scanner->capacity);
+            if(newData == NULL){
+                fprintf(stderr, "Insufficient memory for code scanner -- exiting!\n");
+                exit(1);
+            }
+            scanner->data = newData;
+        }
+        requested = scanner->capacity - scanner->end;
+        readCount = fread(scanner->data + scanner->end, sizeof(unsigned char), requested, scanner->file);
+        scanner->end += readCount;
+        if(readCount < requested){
+            scanner->eof = 1;
+        }
+    }
+
+    return 1;
+}
+
+static void unexpectedEOF(){
+    fprintf(stderr, "Unexpected EOF.\n");
+    exit(1);
+}
+
+/* Skips the remainder of a header after its first characters have been read.
+ * Returns 0 if the input ends before the header is closed.
+ */
+static int skipRemainderOfHeader(CODE_SCANNER *scanner){
+    unsigned char c;
+
+    do {
+        if(!ensureAvailable(scanner, 1)){
+            return 0;
+        }
+        c = scanner->data[scanner->position++];
+    } while(c != '<');
+
+    return 1;
+}
+
+static void readHeader(CODE_SCANNER *scanner){
+    if(!ensureAvailable(scanner, scanner->headerLength)){
+        fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
+        exit(1);
+    }
+    if(memcmp(scanner->data + scanner->position, scanner->header, scanner->headerLength)){
+        fprintf(stderr, "No %s header detected -- exiting!\n", scanner->name);
+        exit(1);
+    }
+    scanner->position += scanner->headerLength;
+
+    //read remainder of header (either empty or le/be specification)
+    if(!skipRemainderOfHeader(scanner)){
+        return;
+    }
+    //read one more character
+    if(ensureAvailable(scanner, 1)){
+        scanner->position++;
+    }
+}
+
+int nextCodeRecord(CODE_SCANNER *scanner, CODE_RECORD *record){
+    size_t scanned, available;
+    int remaining;
+    unsigned short entry;
+
+    if(!scanner->headerRead){
+        scanner->headerRead = 1;
+        readHeader(scanner);
+    }
+
+    if(!ensureAvailable(scanner, 1)){
+        //nothing left in file
+        return 0;
+    }
+
+    /* possibly removing interior headers */
+    if(scanner->data[scanner->position] == '>' && ensureAvailable(scanner, 3) &&
+            scanner->data[scanner->position + 1] == '>' &&
+            scanner->data[scanner->position + 2] == scanner->header[2]){
+        scanner->position += 3;
+        if(!skipRemainderOfHeader(scanner)){
+            unexpectedEOF();
+        }
+        if(!ensureAvailable(scanner, 1) || scanner->data[scanner->position++] != '<'){
+            fprintf(stderr, "Problems with header -- single '<'\n");
+            exit(1);
+        }
+        if(!ensureAvailable(scanner, 1)){
+            //nothing left in file
+            return 0;
+        }
+    }
+
+    if(scanner->data[scanner->position]){
+        record->order = scanner->data[scanner->position];
+        record->twoByteEntries = 0;
+        remaining = record->order - scanner->zeroEntryDeficit;
+        scanned = 1;
+        while(remaining > 0){
+            available = scanner->end - scanner->position;
+            if(available == scanned){
+                if(!ensureAvailable(scanner, scanned + 1)){
+                    unexpectedEOF();
+                }
+                available = scanner->end - scanner->position;
+            }
+            scanned += scanZeroBytes(scanner->data + scanner->position + scanned,
+                    available - scanned, &remaining);
+        }
+    } else {
+        if(!ensureAvailable(scanner, 3)){
+            unexpectedEOF();
+        }
+        memcpy(&entry, scanner->data + scanner->position + 1, sizeof(unsigned short));
+        record->order = entry;
+        record->twoByteEntries = 1;
+        remaining = record->order - scanner->zeroEntryDeficit;
+        scanned = 3;
+        while(remaining > 0){
+            available = scanner->end - scanner->position;
+            if(available < scanned + 2){
+                if(!ensureAvailable(scanner, scanned + 2)){
+                    unexpectedEOF();
+                }
+                available = scanner->end - scanner->position;
+            }
+            scanned += scanZeroWords(scanner->data + scanner->position + scanned,
+                    (available - scanned) & ~(size_t)1, &remaining);
+        }
+    }
+
+    //the record stays valid because the buffer is only changed in the next call
+    record->data = scanner->data + scanner->position;
+    record->offset = scanner->dataOffset + scanner->position;
+    record->length = scanned;
+    scanner->position += scanned;
+
+    return 1;
+}
+
+int copyCodeEntries(const unsigned char *data, size_t length,
+        unsigned short code[], int maxLength){
+    int i;
+    //a code with two-byte entries starts with a zero byte
+    int entryCount = data[0] ? length : (length - 1) / 2;
+
+    if(entryCount > maxLength){
+        fprintf(stderr, "Constant MAXCODELENGTH too small %d > %d \n", entryCount, maxLength);
+        exit(1);
+    }
+    if(data[0]){
+        for(i = 0; i < entryCount; i++){
+            code[i] = data[i];
+        }
+    } else {
+        memcpy(code, data + 1, entryCount * sizeof(unsigned short));
+    }
+    return entryCount;
+}
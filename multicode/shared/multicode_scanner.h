@@ -0,0 +1,86 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef MULTICODE_SCANNER_H
+#define	MULTICODE_SCANNER_H
+
+#include <stdio.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* This module does not depend on multicode_base.h, so that it can also be
+ * used by the programs for plane graphs, which have their own definitions
+ * of GRAPH and MAXN.
+ *
+ * A code scanner finds the boundaries of the codes in a stream of multicode
+ * or planarcode without decoding them. Both formats store a code either
+ * with one byte per entry, or with a zero byte followed by two bytes per
+ * entry. The first entry is the order n and the lists of neighbours are
+ * closed by a zero entry: n - 1 of them in multicode and n in planarcode.
+ * Headers at the start of the stream and inside the stream are skipped.
+ */
+
+#define MULTICODE_FORMAT "multi_code"
+#define PLANARCODE_FORMAT "planar_code"
+
+typedef struct {
+    //points to the first byte of the code, i.e., the order or the zero byte
+    //that precedes a two-byte order
+    const unsigned char *data;
+    //the position of the first byte of the code in the stream
+    unsigned long long offset;
+    //the number of bytes of the code
+    size_t length;
+    int order;
+    int twoByteEntries;
+} CODE_RECORD;
+
+typedef struct CODE_SCANNER CODE_SCANNER;
+
+/* Creates a scanner for the given format (MULTICODE_FORMAT or
+ * PLANARCODE_FORMAT). Regular files are mapped into memory, other streams
+ * are read in large blocks.
+ */
+CODE_SCANNER *newCodeScanner(FILE *file, const char *format);
+
+/* For a mapped file the position of the stream is set to the first byte
+ * after the last code that was scanned. Input that was buffered from other
+ * streams is lost.
+ */
+void freeCodeScanner(CODE_SCANNER *scanner);
+
+/* Finds the next code and stores its boundaries in record. The data of the
+ * record is only valid until the next call for the same scanner. Returns 0
+ * if there are no codes left. Exits in case of error.
+ */
+int nextCodeRecord(CODE_SCANNER *scanner, CODE_RECORD *record);
+
+/* Stores the entries of the code of length bytes at data in code, starting
+ * with the order, and returns the number of entries. Exits if the code has
+ * more than maxLength entries.
+ */
+int copyCodeEntries(const unsigned char *data, size_t length,
+        unsigned short code[], int maxLength);
+
+/* Returns the number of bytes in data[0..size-1] up to and including the
+ * count-th zero byte, and sets count to 0. If there are fewer zero bytes,
+ * size is returned and count is decreased by their number.
+ */
+size_t scanZeroBytes(const unsigned char *data, size_t size, int *count);
+
+/* Does the same as scanZeroBytes for the two-byte entries that start at
+ * data. size should be even.
+ */
+size_t scanZeroWords(const unsigned char *data, size_t size, int *count);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* MULTICODE_SCANNER_H */
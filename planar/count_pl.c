@@ -11,7 +11,8 @@
  * 
  * Compile with:
  *     
- *     cc -o count_pl -O4 count_pl.c
+ *     cc -o count_pl -O4 count_pl.c ../multicode/shared/multicode_scanner.c \
+ *     ../multicode/shared/multicode_index.c
  * 
  */
 
@@ -20,147 +21,10 @@
 #include <getopt.h>
 #include <string.h>
 
-#ifndef MAXN
-#define MAXN 64            /* the maximum number of vertices */
-#endif
-#define MAXE (6*MAXN-12)    /* the maximum number of oriented edges */
-#define MAXF (2*MAXN-4)      /* the maximum number of faces */
-#define MAXVAL (MAXN-1)  /* the maximum degree of a vertex */
-#define MAXCODELENGTH (MAXN+MAXE+3)
+#include "../multicode/shared/multicode_scanner.h"
+#include "../multicode/shared/multicode_index.h"
 
-#define INFI (MAXN + 1)
-
-#undef FALSE
-#undef TRUE
-#define FALSE 0
-#define TRUE  1
-
-int numberOfGraphs = 0;
-
-//=============== Reading and decoding planarcode ===========================
-
-/**
- * 
- * @param code
- * @param laenge
- * @param file
- * @return returns 1 if a code was read and 0 otherwise. Exits in case of error.
- */
-int readPlanarCode(unsigned short code[], int *length, FILE *file) {
-    static int first = 1;
-    unsigned char c;
-    char testheader[20];
-    int bufferSize, zeroCounter;
-    
-    int readCount;
-
-
-    if (first) {
-        first = 0;
-
-        if (fread(&testheader, sizeof (unsigned char), 13, file) != 13) {
-            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
-            exit(1);
-        }
-        testheader[13] = 0;
-        if (strcmp(testheader, ">>planar_code") == 0) {
-
-        } else {
-            fprintf(stderr, "No planarcode header detected -- exiting!\n");
-            exit(1);
-        }
-        //read reminder of header (either empty or le/be specification)
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-        while (c!='<'){
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                return FALSE;
-            }
-        }
-        //read one more character
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-    }
-
-    /* possibly removing interior headers -- only done for planarcode */
-    if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-        //nothing left in file
-        return (0);
-    }
-
-    if (c == '>') {
-        // could be a header, or maybe just a 62 (which is also possible for unsigned char
-        code[0] = c;
-        bufferSize = 1;
-        zeroCounter = 0;
-        code[1] = (unsigned short) getc(file);
-        if (code[1] == 0) zeroCounter++;
-        code[2] = (unsigned short) getc(file);
-        if (code[2] == 0) zeroCounter++;
-        bufferSize = 3;
-        // 3 characters were read and stored in buffer
-        if ((code[1] == '>') && (code[2] == 'p')) /*we are sure that we're dealing with a header*/ {
-            while ((c = getc(file)) != '<');
-            /* read 2 more characters: */
-            c = getc(file);
-            if (c != '<') {
-                fprintf(stderr, "Problems with header -- single '<'\n");
-                exit(1);
-            }
-            if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                //nothing left in file
-                return (0);
-            }
-            bufferSize = 1;
-            zeroCounter = 0;
-        }
-    } else {
-        //no header present
-        bufferSize = 1;
-        zeroCounter = 0;
-    }
-
-    if (c != 0) /* unsigned chars would be sufficient */ {
-        code[0] = c;
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        while (zeroCounter < code[0]) {
-            code[bufferSize] = (unsigned short) getc(file);
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    } else {
-        readCount = fread(code, sizeof (unsigned short), 1, file);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            exit(1);
-        }
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        bufferSize = 1;
-        zeroCounter = 0;
-        while (zeroCounter < code[0]) {
-            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                exit(1);
-            }
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    }
-
-    *length = bufferSize;
-    return (1);
-
-
-}
+unsigned long long numberOfGraphs = 0;
 
 //====================== USAGE =======================
 
@@ -168,9 +32,11 @@ void help(char *name) {
     fprintf(stderr, "The program %s counts the number of planar graphs in a file.\n\n", name);
     fprintf(stderr, "Usage\n=====\n");
     fprintf(stderr, " %s\n\n", name);
-    fprintf(stderr, "\nThis program can handle graphs up to %d vertices.\n", MAXN);
-    fprintf(stderr, "Recompile with a larger value for MAXN if you need larger graphs.\n\n");
     fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, " -I, --index file\n");
+    fprintf(stderr, "    Take the number of graphs from the given index (see index_pl) instead of\n");
+    fprintf(stderr, "    reading the graphs. Standard in should be the file for which the index\n");
+    fprintf(stderr, "    was built.\n");
     fprintf(stderr, " -h, --help\n");
     fprintf(stderr, "    Print this help and return.\n");
 }
@@ -184,17 +50,23 @@ int main(int argc, char *argv[]) {
 
     /*=========== commandline parsing ===========*/
 
+    char *indexFileName = NULL;
+
     int c;
     char *name = argv[0];
     static struct option long_options[] = {
+        {"index", required_argument, NULL, 'I'},
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "h", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "hI:", long_options, &option_index)) != -1) {
         switch (c) {
             case 0:
                 break;
+            case 'I':
+                indexFileName = optarg;
+                break;
             case 'h':
                 help(name);
                 return EXIT_SUCCESS;
@@ -208,12 +80,25 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (indexFileName != NULL) {
+        CODE_INDEX *index = openCodeIndex(indexFileName, PLANARCODE_FORMAT, fileno(stdin));
+        if (index == NULL) {
+            fprintf(stderr, "Could not open %s to read index -- exiting!\n", indexFileName);
+            return EXIT_FAILURE;
+        }
+        fprintf(stdout, "%llu\n", getCodeIndexSize(index));
+        closeCodeIndex(index);
+        return EXIT_SUCCESS;
+    }
+
     /*=========== read planar graphs ===========*/
 
-    unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readPlanarCode(code, &length, stdin)) {
+    //only the boundaries of the codes are needed
+    CODE_SCANNER *scanner = newCodeScanner(stdin, PLANARCODE_FORMAT);
+    CODE_RECORD code;
+    while (nextCodeRecord(scanner, &code)) {
         numberOfGraphs++;
     }
-    fprintf(stdout, "%d\n", numberOfGraphs);
+    freeCodeScanner(scanner);
+    fprintf(stdout, "%llu\n", numberOfGraphs);
 }
@@ -11,7 +11,9 @@
  * 
  * Compile with:
  *     
- *     cc -o group_pl -O4 group_pl.c
+ *     cc -o group_pl -O4 group_pl.c shared/planar_base.c shared/planar_input.c \
+ *     shared/planar_output.c shared/planar_automorphismgroup.c \
+ *     ../multicode/shared/multicode_scanner.c
  * 
  */
 
@@ -21,6 +23,11 @@
 #include <string.h>
 #include <ctype.h>
 
+#include "shared/planar_base.h"
+#include "shared/planar_input.h"
+#include "shared/planar_output.h"
+#include "shared/planar_automorphismgroup.h"
+
 #define UNKNOWN 0
 #define Cn__    1
 #define Cnh__   2
@@ -37,7 +44,6 @@
 #define I__    13
 #define Ih__   14
 
-
 #ifndef MAXN
 #define MAXN 1000            /* the maximum number of vertices */
 #endif
@@ -48,52 +54,9 @@
 
 #define INFI (MAXN + 1)
 
-typedef int boolean;
-
-#undef FALSE
-#undef TRUE
-#define FALSE 0
-#define TRUE  1
-
-typedef struct e /* The data type used for edges */ {
-    int start;       /* vertex where the edge starts */
-    int end;         /* vertex where the edge ends */
-    int rightface;   /* face on the right side of the edge
-                        note: only valid if make_dual() called */
-    struct e *prev;  /* previous edge in clockwise direction */
-    struct e *next;  /* next edge in clockwise direction */
-    struct e *inverse; /* the edge that is inverse to this one */
-    int mark, index; /* two ints for temporary use;
-                          Only access mark via the MARK macros. */
-} EDGE;
-
-EDGE *firstedge[MAXN]; /* pointer to arbitrary edge out of vertex i. */
-int degree[MAXN];
-
-EDGE *facestart[MAXF]; /* pointer to arbitrary edge of face i. */
-int faceSize[MAXF]; /* pointer to arbitrary edge of face i. */
+PLANE_GRAPH *pg;
 
-EDGE edges[MAXE];
-
-static int markvalue = 30000;
-#define RESETMARKS {int mki; if ((markvalue += 2) > 30000) \
-       { markvalue = 2; for (mki=0;mki<MAXE;++mki) edges[mki].mark=0;}}
-#define MARK(e) (e)->mark = markvalue
-#define MARKLO(e) (e)->mark = markvalue
-#define MARKHI(e) (e)->mark = markvalue+1
-#define UNMARK(e) (e)->mark = markvalue-1
-#define ISMARKED(e) ((e)->mark >= markvalue)
-#define ISMARKEDLO(e) ((e)->mark == markvalue)
-#define ISMARKEDHI(e) ((e)->mark > markvalue)
-
-int nv;
-int ne;
-int nf;
-
-int automorphisms[2*MAXE][MAXN]; //there are at most 2e automorphisms (e = #arcs)
-int automorphismsCount;
-int orientationPreservingAutomorphismsCount;
-int orientationReversingAutomorphismsCount;
+PG_AUTOMORPHISM_GROUP *automorphismGroup = NULL;
 
 boolean groupHasParameter[15] = {FALSE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE, TRUE,
                                  FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE};
@@ -377,288 +340,10 @@ void printGroupList(FILE *f, GROUPLIST *list, int minimumGroupNameLength,
 
 //////////////////////////////////////////////////////////////////////////////
 
-int certificate[MAXE+MAXN];
-int canonicalLabelling[MAXN];
-int reverseCanonicalLabelling[MAXN];
-EDGE *canonicalFirstedge[MAXN];
-int alternateLabelling[MAXN];
-EDGE *alternateFirstedge[MAXN];
-int queue[MAXN];
-boolean hasChiralGroup;
-
-EDGE *orientationPreservingStartingEdges[MAXE];
-EDGE *orientationReversingStartingEdges[MAXE];
-int startingEdgesCount; //the number of starting edges is always the same for both orientations
-
-void findStartingEdges(){
-    int i, startingDegree, startingFaceSize, minimumFrequency;
-    int degreeFrequency[MAXN] = {0};
-    int faceSizeFrequency[MAXN] = {0};
-    EDGE *start, *edge;
-    
-    startingEdgesCount = 0;
-    
-    //build the degree frequency table
-    for(i = 0; i < nv; i++){
-        degreeFrequency[degree[i]]++;
-    }
-    
-    //find the smallest degree with the lowest frequency
-    minimumFrequency = MAXN;
-    for(i = 0; i < MAXN; i++){
-        if(degreeFrequency[i] && degreeFrequency[i] < minimumFrequency){
-            startingDegree = i;
-            minimumFrequency = degreeFrequency[i];
-        }
-    }
-    
-    //build the frequency table of face sizes incident to a vertex with startingDegree
-    for(i = 0; i < nv; i++){
-        if(degree[i] == startingDegree){
-            start = edge = firstedge[i];
-            
-            do {
-                faceSizeFrequency[faceSize[edge->rightface]]++;
-                edge = edge->next;
-            } while (start != edge);
-        }
-    }
-    
-    //find the smallest face size incident with a vertex of startingDegree and with smallest frequency
-    minimumFrequency = MAXE;
-    for(i = 0; i < MAXN; i++){
-        if(faceSizeFrequency[i] && faceSizeFrequency[i] < minimumFrequency){
-            startingFaceSize = i;
-            minimumFrequency = faceSizeFrequency[i];
-        }
-    }
-    
-    //store all starting edges
-    for(i = 0; i < nv; i++){
-        if(degree[i] == startingDegree){
-            start = edge = firstedge[i];
-            
-            do {
-                if(faceSize[edge->rightface] == startingFaceSize){
-                    orientationPreservingStartingEdges[startingEdgesCount] = edge;
-                    orientationReversingStartingEdges[startingEdgesCount] = edge->next;
-                    startingEdgesCount++;
-                }
-                edge = edge->next;
-            } while (start != edge);
-        }
-    }
-}
-
-void constructCertificate(EDGE *eStart){
-    int i;
-    for(i=0; i<MAXN; i++){
-        canonicalLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int position = 0;
-    queue[0] = eStart->start;
-    canonicalFirstedge[eStart->start] = eStart;
-    canonicalLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = canonicalFirstedge[currentVertex];
-        do {
-            if(canonicalLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                canonicalLabelling[e->end] = vertexCounter++;
-                canonicalFirstedge[e->end] = e->inverse;
-            }
-            certificate[position++] = canonicalLabelling[e->end];
-            e = e->next;
-        } while (e!=elast);
-        certificate[position++] = MAXN;
-    }
-    for(i = 0; i < nv; i++){
-        reverseCanonicalLabelling[canonicalLabelling[i]] = i;
-    }
-}
-
-void constructCertificateOrientationReversed(EDGE *eStart){
-    int i;
-    for(i=0; i<MAXN; i++){
-        canonicalLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int position = 0;
-    queue[0] = eStart->start;
-    canonicalFirstedge[eStart->start] = eStart;
-    canonicalLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = canonicalFirstedge[currentVertex];
-        do {
-            if(canonicalLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                canonicalLabelling[e->end] = vertexCounter++;
-                canonicalFirstedge[e->end] = e->inverse;
-            }
-            certificate[position++] = canonicalLabelling[e->end];
-            e = e->prev;
-        } while (e!=elast);
-        certificate[position++] = MAXN;
-    }
-    for(i = 0; i < nv; i++){
-       reverseCanonicalLabelling[canonicalLabelling[i]] = i;
-    }
-}
-
-/* returns 1 if this edge leads to a better certificate
- * returns 0 if this edge leads to the same certificate
- * returns -1 if this edge leads to a worse certificate
- */
-int hasBetterCertificateOrientationPreserving(EDGE *eStart){
-    int i, j;
-    for(i=0; i<MAXN; i++){
-        alternateLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int currentPos = 0;
-    queue[0] = eStart->start;
-    alternateFirstedge[eStart->start] = eStart;
-    alternateLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = alternateFirstedge[currentVertex];
-        do {
-            if(alternateLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                alternateLabelling[e->end] = vertexCounter++;
-                alternateFirstedge[e->end] = e->inverse;
-            }
-            if(alternateLabelling[e->end] < certificate[currentPos]){
-                constructCertificate(eStart);
-                automorphismsCount = 1;
-                orientationPreservingAutomorphismsCount = 1;
-                return 1;
-            } else if(alternateLabelling[e->end] > certificate[currentPos]){
-                return -1;
-            }
-            currentPos++;
-            e = e->next;
-        } while (e!=elast);
-        //MAXN will always be at least the value of certificate[currentPos]
-        if(MAXN > certificate[currentPos]){
-            return -1;
-        }
-        currentPos++;
-    }
-    for(j = 0; j < nv; j++){
-        automorphisms[automorphismsCount][j] 
-                = reverseCanonicalLabelling[alternateLabelling[j]];
-    }
-    automorphismsCount++;
-    orientationPreservingAutomorphismsCount++;
-    return 0;
-}
-
-int hasBetterCertificateOrientationReversing(EDGE *eStart){
-    int i, j;
-    for(i=0; i<MAXN; i++){
-        alternateLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int currentPos = 0;
-    queue[0] = eStart->start;
-    alternateFirstedge[eStart->start] = eStart;
-    alternateLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = alternateFirstedge[currentVertex];
-        do {
-            if(alternateLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                alternateLabelling[e->end] = vertexCounter++;
-                alternateFirstedge[e->end] = e->inverse;
-            }
-            if(alternateLabelling[e->end] < certificate[currentPos]){
-                constructCertificateOrientationReversed(eStart);
-                hasChiralGroup = TRUE;
-                automorphismsCount = 1;
-                orientationPreservingAutomorphismsCount = 1;
-                orientationReversingAutomorphismsCount = 0;
-                return 1;
-            } else if(alternateLabelling[e->end] > certificate[currentPos]){
-                return -1;
-            }
-            currentPos++;
-            e = e->prev;
-        } while (e!=elast);
-        //MAXN will always be at least the value of certificate[currentPos]
-        if(MAXN > certificate[currentPos]){
-            return -1;
-        }
-        currentPos++;
-    }
-    for(j = 0; j < nv; j++){
-        automorphisms[automorphismsCount][j] 
-                = reverseCanonicalLabelling[alternateLabelling[j]];
-    }
-    if(hasChiralGroup){
-        orientationPreservingAutomorphismsCount++;
-    } else {
-        orientationReversingAutomorphismsCount++;
-    }
-    automorphismsCount++;
-    return 0;
-}
-
-void determineAutomorphisms(){
-    int i;
-    
-    hasChiralGroup = FALSE;
-    
-    //identity
-    for(i = 0; i < nv; i++){
-        automorphisms[0][i] = i;
-    }
-    
-    automorphismsCount = 1;
-    orientationPreservingAutomorphismsCount = 1;
-    orientationReversingAutomorphismsCount = 0;
-    
-    //find starting edges
-    findStartingEdges();
-    
-    //construct initial certificate
-    constructCertificate(orientationPreservingStartingEdges[0]);
-    
-    //look for better automorphism
-    for(i = 1; i < startingEdgesCount; i++){
-        int result = hasBetterCertificateOrientationPreserving(
-                                orientationPreservingStartingEdges[i]);
-        //if result == 1, then the counts are already reset and the new certificate is stored
-        //if result == 0, then the automorphism is already stored
-    }
-    for(i = 0; i < startingEdgesCount; i++){
-        int result = hasBetterCertificateOrientationReversing(
-                                orientationReversingStartingEdges[i]);
-        //if result == 1, then the counts are already reset and the new certificate is stored
-        //if result == 0, then the automorphism is already stored
-    }
-}
-
 boolean hasOrientationPreservingSymmetryWithGivenAction(int v, int w, int vImage, int wImage){
     int i = 0;
-    while(i < orientationPreservingAutomorphismsCount){
-        if(automorphisms[i][v] == vImage && automorphisms[i][w] == wImage){
+    while(i < automorphismGroup->orientationPreservingCount){
+        if(automorphismGroup->automorphisms[i][v] == vImage && automorphismGroup->automorphisms[i][w] == wImage){
             return TRUE;
         }
         i++;
@@ -668,11 +353,11 @@ boolean hasOrientationPreservingSymmetryWithGivenAction(int v, int w, int vImage
 }
 
 int identifyRotationalSymmetryThroughVertex(int v){
-    EDGE *edge;
+    PG_EDGE *edge;
     int deg, neighbour, i;
     
-    deg = degree[v];
-    edge = firstedge[v];
+    deg = pg->degree[v];
+    edge = pg->firstedge[v];
     i = 0;
     neighbour = edge->end;
     
@@ -688,11 +373,11 @@ int identifyRotationalSymmetryThroughVertex(int v){
 }
 
 int identifyRotationalSymmetryThroughFace(int f){
-    EDGE *edge;
+    PG_EDGE *edge;
     int deg, i, v, w;
     
-    deg = faceSize[f];
-    edge = facestart[f];
+    deg = pg->faceSize[f];
+    edge = pg->facestart[f];
     i = 0;
     v = edge->start;
     w = edge->end;
@@ -708,7 +393,7 @@ int identifyRotationalSymmetryThroughFace(int f){
     return 1;
 }
 
-boolean hasRotationalSymmetryThroughEdge(EDGE *e){
+boolean hasRotationalSymmetryThroughEdge(PG_EDGE *e){
     return hasOrientationPreservingSymmetryWithGivenAction(e->start, e->end, e->end, e->start);
 }
 
@@ -718,8 +403,8 @@ boolean hasRotationalSymmetryThroughEdge(EDGE *e){
 boolean hasOrientationReversingSymmetryStabilisingGivenVertex(int v){
     int i;
     
-    for(i = orientationPreservingAutomorphismsCount; i < automorphismsCount; i++){
-        if(automorphisms[i][v] == v){
+    for(i = automorphismGroup->orientationPreservingCount; i < automorphismGroup->size; i++){
+        if(automorphismGroup->automorphisms[i][v] == v){
             return TRUE;
         }
     }
@@ -732,13 +417,13 @@ boolean hasOrientationReversingSymmetryStabilisingGivenVertex(int v){
  */
 boolean hasOrientationReversingSymmetryStabilisingGivenFace(int f){
     int i, from, to;
-    EDGE *e;
+    PG_EDGE *e;
     
-    for(i = orientationPreservingAutomorphismsCount; i < automorphismsCount; i++){
-        e = facestart[f];
-        from = automorphisms[i][e->start];
-        to = automorphisms[i][e->end];
-        e = firstedge[from];
+    for(i = automorphismGroup->orientationPreservingCount; i < automorphismGroup->size; i++){
+        e = pg->facestart[f];
+        from = automorphismGroup->automorphisms[i][e->start];
+        to = automorphismGroup->automorphisms[i][e->end];
+        e = pg->firstedge[from];
         while(e->end != to) {
             e = e->next;
         }
@@ -755,11 +440,11 @@ boolean hasOrientationReversingSymmetryStabilisingGivenFace(int f){
  */
 boolean hasOrientationReversingSymmetryStabilisingGivenEdge(int e){
     int i, from, to;
-    EDGE *edge = edges+e;
+    PG_EDGE *edge = pg->edges+e;
     
-    for(i = orientationPreservingAutomorphismsCount; i < automorphismsCount; i++){
-        from = automorphisms[i][edge->start];
-        to = automorphisms[i][edge->end];
+    for(i = automorphismGroup->orientationPreservingCount; i < automorphismGroup->size; i++){
+        from = automorphismGroup->automorphisms[i][edge->start];
+        to = automorphismGroup->automorphisms[i][edge->end];
         if((edge->start == from && edge->end == to) ||
                 (edge->start == to && edge->end == from)){
             return TRUE;
@@ -773,9 +458,9 @@ boolean hasOrientationReversingSymmetryWithFixPoint(){
     int i, j;
     
     //first check if any vertices are fixed
-    for(i = orientationPreservingAutomorphismsCount; i < automorphismsCount; i++){
-        for(j = 0; j < nv; j++){
-            if(automorphisms[i][j] == j){
+    for(i = automorphismGroup->orientationPreservingCount; i < automorphismGroup->size; i++){
+        for(j = 0; j < pg->nv; j++){
+            if(automorphismGroup->automorphisms[i][j] == j){
                 return TRUE;
             }
         }
@@ -784,13 +469,13 @@ boolean hasOrientationReversingSymmetryWithFixPoint(){
     //next we check if any edge is fixed as a set
     //we don't need to check that a directed edge is fixed
     //because in that case also the vertices are fixed
-    for(i = orientationPreservingAutomorphismsCount; i < automorphismsCount; i++){
-        for(j = 0; j < ne; j++){
-            if(j < edges[j].inverse->index){
-                int start = edges[j].start;
-                int end = edges[j].end;
-                if(automorphisms[i][start] == end &&
-                        automorphisms[i][end] == start){
+    for(i = automorphismGroup->orientationPreservingCount; i < automorphismGroup->size; i++){
+        for(j = 0; j < pg->ne; j++){
+            if(j < pg->edges[j].inverse->index){
+                int start = pg->edges[j].start;
+                int end = pg->edges[j].end;
+                if(automorphismGroup->automorphisms[i][start] == end &&
+                        automorphismGroup->automorphisms[i][end] == start){
                     return TRUE;
                 }
             }
@@ -807,8 +492,8 @@ boolean isSymmetryWithFixPoint(int i){
     int j;
         
     //first check if any vertices are fixed
-    for(j = 0; j < nv; j++){
-        if(automorphisms[i][j] == j){
+    for(j = 0; j < pg->nv; j++){
+        if(automorphismGroup->automorphisms[i][j] == j){
             return TRUE;
         }
     }
@@ -816,12 +501,12 @@ boolean isSymmetryWithFixPoint(int i){
     //next we check if any edge is fixed as a set
     //we don't need to check that a directed edge is fixed
     //because in that case also the vertices are fixed
-    for(j = 0; j < ne; j++){
-        if(j < edges[j].inverse->index){
-            int start = edges[j].start;
-            int end = edges[j].end;
-            if(automorphisms[i][start] == end &&
-                    automorphisms[i][end] == start){
+    for(j = 0; j < pg->ne; j++){
+        if(j < pg->edges[j].inverse->index){
+            int start = pg->edges[j].start;
+            int end = pg->edges[j].end;
+            if(automorphismGroup->automorphisms[i][start] == end &&
+                    automorphismGroup->automorphisms[i][end] == start){
                 return TRUE;
             }
         }
@@ -839,7 +524,7 @@ int countOrientationReversingSymmetriesWithFixPoints(){
     count = 0;
     
     //first check if any vertices are fixed
-    for(i = orientationPreservingAutomorphismsCount; i < automorphismsCount; i++){
+    for(i = automorphismGroup->orientationPreservingCount; i < automorphismGroup->size; i++){
         if(isSymmetryWithFixPoint(i)){
             count++;
         }
@@ -851,17 +536,17 @@ int countOrientationReversingSymmetriesWithFixPoints(){
 void determineAutomorphismGroupInfiniteFamilies(int *groupId,
         int *groupParameter, int rotDegree, int center, boolean centerIsVertex,
         boolean centerIsEdge){
-    if(orientationReversingAutomorphismsCount==0){
-        if(automorphismsCount==rotDegree){
+    if(automorphismGroup->orientationReversingCount==0){
+        if(automorphismGroup->size==rotDegree){
             *groupId = Cn__;
-        } else if(automorphismsCount==2*rotDegree){
+        } else if(automorphismGroup->size==2*rotDegree){
             *groupId = Dn__;
         } else {
-            fprintf(stderr, "Illegal order for chiral axial symmetry group containing a %d-fold rotation: %d -- exiting!\n", rotDegree, automorphismsCount);
+            fprintf(stderr, "Illegal order for chiral axial symmetry group containing a %d-fold rotation: %d -- exiting!\n", rotDegree, automorphismGroup->size);
             exit(EXIT_FAILURE);
         }
         *groupParameter = rotDegree;
-    } else if(automorphismsCount == 4*rotDegree){
+    } else if(automorphismGroup->size == 4*rotDegree){
         int orientationReversingSymmetriesWithFixPoints = 
                       countOrientationReversingSymmetriesWithFixPoints();
         if(orientationReversingSymmetriesWithFixPoints == rotDegree){
@@ -871,10 +556,10 @@ void determineAutomorphismGroupInfiniteFamilies(int *groupId,
             *groupId = Dnh__;
             *groupParameter = rotDegree;
         } else {
-            fprintf(stderr, "Illegal number of orientation reversing automorphisms with fixpoints for chiral axial symmetry group containing a %d-fold rotation that has order %d: %d -- exiting!\n", rotDegree, automorphismsCount, orientationReversingSymmetriesWithFixPoints);
+            fprintf(stderr, "Illegal number of orientation reversing automorphisms with fixpoints for chiral axial symmetry group containing a %d-fold rotation that has order %d: %d -- exiting!\n", rotDegree, automorphismGroup->size, orientationReversingSymmetriesWithFixPoints);
             exit(EXIT_FAILURE);
         }
-    } else if(automorphismsCount == 2*rotDegree){
+    } else if(automorphismGroup->size == 2*rotDegree){
         if(centerIsVertex){
             if(hasOrientationReversingSymmetryStabilisingGivenVertex(center)){
                 *groupId = Cnv__;
@@ -904,7 +589,7 @@ void determineAutomorphismGroupInfiniteFamilies(int *groupId,
             *groupParameter = rotDegree;
         }
     } else {
-        fprintf(stderr, "Illegal order for achiral axial symmetry group containing a %d-fold rotation: %d -- exiting!\n", rotDegree, automorphismsCount);
+        fprintf(stderr, "Illegal order for achiral axial symmetry group containing a %d-fold rotation: %d -- exiting!\n", rotDegree, automorphismGroup->size);
         exit(EXIT_FAILURE);
     }
 }
@@ -914,14 +599,14 @@ void determineAutomorphismGroupOther(int *groupId, int *groupParameter){
     //or the size of the group combined with the chirality
     //the only exceptions are Td and Th. These have the same size and the same
     //chirality.
-    if(automorphismsCount==120){
+    if(automorphismGroup->size==120){
         *groupId = Ih__;
-    } else if(automorphismsCount==60){
+    } else if(automorphismGroup->size==60){
         *groupId = I__;
-    } else if(automorphismsCount==48){
+    } else if(automorphismGroup->size==48){
         *groupId = Oh__;
-    } else if(automorphismsCount==24){
-        if(orientationReversingAutomorphismsCount==0){
+    } else if(automorphismGroup->size==24){
+        if(automorphismGroup->orientationReversingCount==0){
             *groupId = O__;
         } else {
             int orientationReversingSymmetriesWithFixPoints = 
@@ -935,7 +620,7 @@ void determineAutomorphismGroupOther(int *groupId, int *groupParameter){
                 exit(EXIT_FAILURE);
             }
         }
-    } else if(automorphismsCount==12){
+    } else if(automorphismGroup->size==12){
         *groupId = T__;
     } else {
         fprintf(stderr, "Illegal order for a non-axial symmetry group -- exiting!\n");
@@ -950,16 +635,17 @@ void determineAutomorphismGroup(int *groupId, int *groupParameter){
     maxRotation = -1;
     
     //we start by determining all automorphisms
-    determineAutomorphisms();
+    automorphismGroup = determineAutomorphismsReusing(pg, automorphismGroup);
+    expandAutomorphismGroup(automorphismGroup);
     
     //if the group is chiral and has an odd order or an order less than 4
     //then it is a cyclic group. (since D1 is equal to C2)
-    if(orientationReversingAutomorphismsCount == 0 && 
-            (automorphismsCount < 4 || automorphismsCount%2 == 1)){
+    if(automorphismGroup->orientationReversingCount == 0 && 
+            (automorphismGroup->size < 4 || automorphismGroup->size%2 == 1)){
         *groupId = Cn__;
-        *groupParameter = automorphismsCount;
+        *groupParameter = automorphismGroup->size;
         return;
-    } else if(orientationReversingAutomorphismsCount == 1 && automorphismsCount == 2){
+    } else if(automorphismGroup->orientationReversingCount == 1 && automorphismGroup->size == 2){
         if(hasOrientationReversingSymmetryWithFixPoint()){
             *groupId = Cnh__;
             *groupParameter = 1;
@@ -980,7 +666,7 @@ void determineAutomorphismGroup(int *groupId, int *groupParameter){
     }
     
     //first we look for rotational axis through a vertex
-    for(i = 0; i < nv; i++){
+    for(i = 0; i < pg->nv; i++){
         int rotDegree = identifyRotationalSymmetryThroughVertex(i);
         
         //if the order of the rotation is larger than 5, then we known that it 
@@ -1022,7 +708,7 @@ void determineAutomorphismGroup(int *groupId, int *groupParameter){
         }
     }
     
-    for(i = 0; i < nf; i++){
+    for(i = 0; i < pg->nf; i++){
         int rotDegree = identifyRotationalSymmetryThroughFace(i);
         
         //if the order of the rotation is larger than 5, then we known that it 
@@ -1065,9 +751,9 @@ void determineAutomorphismGroup(int *groupId, int *groupParameter){
     
     if(foldCount[3]<=2){
         //first we also check all edges, so that we also have all 2-fold rotations
-        for(i = 0; i < ne; i++){
-            if(i < edges[i].inverse->index 
-                    && hasRotationalSymmetryThroughEdge(edges+i)){
+        for(i = 0; i < pg->ne; i++){
+            if(i < pg->edges[i].inverse->index 
+                    && hasRotationalSymmetryThroughEdge(pg->edges+i)){
                 foldCount[2]++;
                 
                 //store the maxRotationCenter
@@ -1090,302 +776,6 @@ void determineAutomorphismGroup(int *groupId, int *groupParameter){
 
 //////////////////////////////////////////////////////////////////////////////
 
-//=============== Writing planarcode of graph ===========================
-
-void writePlanarCodeChar(){
-    int i;
-    EDGE *e, *elast;
-    
-    //write the number of vertices
-    fputc(nv, stdout);
-    
-    for(i=0; i<nv; i++){
-        e = elast = firstedge[i];
-        do {
-            fputc(e->end + 1, stdout);
-            e = e->next;
-        } while (e != elast);
-        fputc(0, stdout);
-    }
-}
-
-void writeShort(unsigned short value){
-    if (fwrite(&value, sizeof (unsigned short), 1, stdout) != 1) {
-        fprintf(stderr, "fwrite() failed -- exiting!\n");
-        exit(-1);
-    }
-}
-
-void writePlanarCodeShort(){
-    int i;
-    EDGE *e, *elast;
-    
-    //write the number of vertices
-    fputc(0, stdout);
-    writeShort(nv);
-    
-    
-    for(i=0; i<nv; i++){
-        e = elast = firstedge[i];
-        do {
-            writeShort(e->end + 1);
-            e = e->next;
-        } while (e != elast);
-        writeShort(0);
-    }
-}
-
-void writePlanarCode(){
-    static int first = TRUE;
-    
-    if(first){
-        first = FALSE;
-        
-        fprintf(stdout, ">>planar_code<<");
-    }
-    
-    if (nv + 1 <= 255) {
-        writePlanarCodeChar();
-    } else if (nv + 1 <= 65535) {
-        writePlanarCodeShort();
-    } else {
-        fprintf(stderr, "Graphs of that size are currently not supported -- exiting!\n");
-        exit(-1);
-    }
-    
-}
-
-//=============== Reading and decoding planarcode ===========================
-
-EDGE *findEdge(int from, int to) {
-    EDGE *e, *elast;
-
-    e = elast = firstedge[from];
-    do {
-        if (e->end == to) {
-            return e;
-        }
-        e = e->next;
-    } while (e != elast);
-    fprintf(stderr, "error while looking for edge from %d to %d.\n", from, to);
-    exit(0);
-}
-
-/* Store in the rightface field of each edge the number of the face on
-   the right hand side of that edge.  Faces are numbered 0,1,....  Also
-   store in facestart[i] an example of an edge in the clockwise orientation
-   of the face boundary, and the size of the face in facesize[i], for each i.
-   Returns the number of faces. */
-void makeDual() {
-    register int i, sz;
-    register EDGE *e, *ex, *ef, *efx;
-
-    RESETMARKS;
-
-    nf = 0;
-    for (i = 0; i < nv; ++i) {
-
-        e = ex = firstedge[i];
-        do {
-            if (!ISMARKEDLO(e)) {
-                facestart[nf] = ef = efx = e;
-                sz = 0;
-                do {
-                    ef->rightface = nf;
-                    MARKLO(ef);
-                    ef = ef->inverse->prev;
-                    ++sz;
-                } while (ef != efx);
-                faceSize[nf] = sz;
-                ++nf;
-            }
-            e = e->next;
-        } while (e != ex);
-    }
-}
-
-void decodePlanarCode(unsigned short* code) {
-    /* complexity of method to determine inverse isn't that good, but will have to satisfy for now
-     */
-    int i, j, codePosition;
-    int edgeCounter = 0;
-    EDGE *inverse;
-
-    nv = code[0];
-    codePosition = 1;
-
-    for (i = 0; i < nv; i++) {
-        degree[i] = 0;
-        firstedge[i] = edges + edgeCounter;
-        edges[edgeCounter].start = i;
-        edges[edgeCounter].end = code[codePosition] - 1;
-        edges[edgeCounter].next = edges + edgeCounter + 1;
-        if (code[codePosition] - 1 < i) {
-            inverse = findEdge(code[codePosition] - 1, i);
-            edges[edgeCounter].inverse = inverse;
-            inverse->inverse = edges + edgeCounter;
-        } else {
-            edges[edgeCounter].inverse = NULL;
-        }
-        edges[edgeCounter].index = edgeCounter;
-        edgeCounter++;
-        codePosition++;
-        for (j = 1; code[codePosition]; j++, codePosition++) {
-            if (j == MAXVAL) {
-                fprintf(stderr, "MAXVAL too small: %d\n", MAXVAL);
-                exit(0);
-            }
-            edges[edgeCounter].start = i;
-            edges[edgeCounter].end = code[codePosition] - 1;
-            edges[edgeCounter].prev = edges + edgeCounter - 1;
-            edges[edgeCounter].next = edges + edgeCounter + 1;
-            if (code[codePosition] - 1 < i) {
-                inverse = findEdge(code[codePosition] - 1, i);
-                edges[edgeCounter].inverse = inverse;
-                inverse->inverse = edges + edgeCounter;
-            } else {
-                edges[edgeCounter].inverse = NULL;
-            }
-            edges[edgeCounter].index = edgeCounter;
-            edgeCounter++;
-        }
-        firstedge[i]->prev = edges + edgeCounter - 1;
-        edges[edgeCounter - 1].next = firstedge[i];
-        degree[i] = j;
-
-        codePosition++; /* read the closing 0 */
-    }
-
-    ne = edgeCounter;
-
-    makeDual();
-
-    // nv - ne/2 + nf = 2
-}
-
-/**
- * 
- * @param code
- * @param laenge
- * @param file
- * @return returns 1 if a code was read and 0 otherwise. Exits in case of error.
- */
-int readPlanarCode(unsigned short code[], int *length, FILE *file) {
-    static int first = 1;
-    unsigned char c;
-    char testheader[20];
-    int bufferSize, zeroCounter;
-    
-    int readCount;
-
-
-    if (first && !oldStyleInput) {
-        first = 0;
-
-        if (fread(&testheader, sizeof (unsigned char), 13, file) != 13) {
-            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
-            exit(1);
-        }
-        testheader[13] = 0;
-        if (strcmp(testheader, ">>planar_code") == 0) {
-
-        } else {
-            fprintf(stderr, "No planarcode header detected -- exiting!\n");
-            exit(1);
-        }
-        //read reminder of header (either empty or le/be specification)
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-        while (c!='<'){
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                return FALSE;
-            }
-        }
-        //read one more character
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-    }
-
-    /* possibly removing interior headers -- only done for planarcode */
-    if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-        //nothing left in file
-        return (0);
-    }
-
-    if (c == '>') {
-        // could be a header, or maybe just a 62 (which is also possible for unsigned char
-        code[0] = c;
-        bufferSize = 1;
-        zeroCounter = 0;
-        code[1] = (unsigned short) getc(file);
-        if (code[1] == 0) zeroCounter++;
-        code[2] = (unsigned short) getc(file);
-        if (code[2] == 0) zeroCounter++;
-        bufferSize = 3;
-        // 3 characters were read and stored in buffer
-        if ((code[1] == '>') && (code[2] == 'p')) /*we are sure that we're dealing with a header*/ {
-            while ((c = getc(file)) != '<');
-            /* read 2 more characters: */
-            c = getc(file);
-            if (c != '<') {
-                fprintf(stderr, "Problems with header -- single '<'\n");
-                exit(1);
-            }
-            if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                //nothing left in file
-                return (0);
-            }
-            bufferSize = 1;
-            zeroCounter = 0;
-        }
-    } else {
-        //no header present
-        bufferSize = 1;
-        zeroCounter = 0;
-    }
-
-    if (c != 0) /* unsigned chars would be sufficient */ {
-        code[0] = c;
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        while (zeroCounter < code[0]) {
-            code[bufferSize] = (unsigned short) getc(file);
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    } else {
-        readCount = fread(code, sizeof (unsigned short), 1, file);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            exit(1);
-        }
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        bufferSize = 1;
-        zeroCounter = 0;
-        while (zeroCounter < code[0]) {
-            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                exit(1);
-            }
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    }
-
-    *length = bufferSize;
-    return (1);
-
-
-}
-
 //================== PARSE GROUP NAME ================
 
 int parseGroupParameter(char* input, int* groupParameter, boolean *anyParameterAllowed){
@@ -1531,6 +921,15 @@ void parseGroup(char* input, int* groupId, int* groupParameter, boolean* anyPara
     }
 }
 
+/* Stores the position of each edge in the index field of that edge.
+ */
+void numberEdges(){
+    int i;
+    for(i = 0; i < pg->ne; i++){
+        pg->edges[i].index = i;
+    }
+}
+
 //====================== USAGE =======================
 
 void help(char *name) {
@@ -1669,10 +1068,16 @@ int main(int argc, char *argv[]) {
 
     /*=========== read planar graphs ===========*/
 
+    pg = newPlaneGraph(MAXN, MAXE);
+    if (pg == NULL) {
+        exit(EXIT_FAILURE);
+    }
+
     unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readPlanarCode(code, &length, stdin)) {
-        decodePlanarCode(code);
+    while (readPlanarCodeInto(stdin, code, MAXCODELENGTH)) {
+        decodePlanarCodeInto(code, pg);
+        makeDual(pg);
+        numberEdges();
         numberOfGraphs++;
         int groupId = UNKNOWN;
         int groupParameter = 0;
@@ -1680,12 +1085,12 @@ int main(int argc, char *argv[]) {
         if(filterEnabled){
             if(inverted){
                 if(!groupIncludedInList(filterList, groupId, groupParameter)){
-                    writePlanarCode();
+                    writePlanarCode(pg, stdout);
                     graphsWritten++;
                 }
             } else {
                 if(groupIncludedInList(filterList, groupId, groupParameter)){
-                    writePlanarCode();
+                    writePlanarCode(pg, stdout);
                     graphsWritten++;
                 }
             }
@@ -21,9 +21,10 @@ UNIONFIND *get_orbits(PLANE_GRAPH *pg, PG_AUTOMORPHISM_GROUP *aut_group){
     
     int i, j;
     
-    for(i = 0; i < aut_group->size; i++){
+    //the orbits of the group are the orbits of its generators
+    for(i = 0; i < aut_group->generatorCount; i++){
         for(j = 0; j < pg->nv; j++){
-            unionfind_union(orbits, j, aut_group->automorphisms[i][j]);
+            unionfind_union(orbits, j, aut_group->generators[i][j]);
         }
     }
     
@@ -273,7 +274,7 @@ char *name_uniform_polyhedron(PLANE_GRAPH *pg){
     if(orbitsDual->setCount == 1){
         unionfind_free(orbitsDual);
         freeAutomorphismGroup(autGroupDual);
-        free(dual);
+        freePlaneGraph(dual);
         return name_platonic(pg);
     } else if(orbitsDual->setCount == 2){
         int minSetSize = dual->nv;
@@ -464,8 +465,14 @@ int main(int argc, char** argv) {
     
     DEFAULT_PG_INPUT_OPTIONS(options);
     options.computeDual = TRUE;
-    PLANE_GRAPH *pg;
-    while ((pg = readAndDecodePlanarCode(stdin, &options))) {
+    unsigned short *code = NULL;
+    int codeSize = 0;
+    PLANE_GRAPH *pg = NULL;
+    while (readPlanarCodeReusing(stdin, &code, &codeSize)) {
+        pg = decodePlanarCodeReusing(code, pg, &options);
+        if(pg == NULL){
+            return EXIT_FAILURE;
+        }
         graph_count++;
         char *graph_name = name_graph(pg);
         if(graph_name==NULL){
@@ -475,7 +482,6 @@ int main(int argc, char** argv) {
             fprintf(stdout, "%s\n", graph_name);
             free(graph_name);
         }
-        freePlaneGraph(pg);
     }
     
     fprintf(stderr, "Read %d graph%s.\n", graph_count, graph_count==1 ? "" : "s");
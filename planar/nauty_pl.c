@@ -11,7 +11,8 @@
  * 
  * Compile with:
  *     
- *     cc -o nauty_pl -O4 nauty_pl.c nauty/nauty.c nauty/nautil.c nauty/naugraph.c nauty/schreier.c nauty/naurng.c
+ *     cc -o nauty_pl -O4 nauty_pl.c nauty/nauty.c nauty/nautil.c nauty/naugraph.c nauty/schreier.c nauty/naurng.c \
+ *     ../multicode/shared/multicode_scanner.c
  * 
  * A recent version of nauty is assumed to be present in a directory called nauty.
  */
@@ -24,18 +25,21 @@
 #ifndef MAXN
 #define MAXN 64            /* the maximum number of vertices */
 #endif
+#define MAXE (6*MAXN-12)    /* the maximum number of oriented edges */
+#define MAXCODELENGTH (MAXN+MAXE+3)
 
 #include "nauty/nauty.h"
+#include "../multicode/shared/multicode_scanner.h"
 
 int nv;
 
 int numberOfGraphs = 0;
 
 boolean readPlanarCode(FILE *f){
-    static int first = 1;
-    unsigned char c;
-    char testheader[20];
-    int zeroCounter;
+    static CODE_SCANNER *scanner = NULL;
+    CODE_RECORD record;
+    unsigned short code[MAXCODELENGTH];
+    int zeroCounter, position;
     graph g[MAXN*MAXM];
         
     int i;
@@ -45,83 +49,36 @@ boolean readPlanarCode(FILE *f){
         EMPTYSET(v, MAXM);
     }
     
-    if (first) {
-        first = 0;
-
-        if (fread(&testheader, sizeof (unsigned char), 13, f) != 13) {
-            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
-            exit(1);
-        }
-        testheader[13] = 0;
-        if (strcmp(testheader, ">>planar_code") != 0) {
-            fprintf(stderr, "No planarcode header detected -- exiting!\n");
-            exit(1);
-        }
-        //read reminder of header (either empty or le/be specification)
-        if (fread(&c, sizeof (unsigned char), 1, f) == 0) {
-            return FALSE;
-        }
-        while (c!='<'){
-            if (fread(&c, sizeof (unsigned char), 1, f) == 0) {
-                return FALSE;
-            }
-        }
-        //read one more character
-        if (fread(&c, sizeof (unsigned char), 1, f) == 0) {
-            return FALSE;
-        }
+    if (scanner == NULL) {
+        scanner = newCodeScanner(f, PLANARCODE_FORMAT);
     }
-    
 
-    if (fread(&c, sizeof (unsigned char), 1, f) == 0) {
+    if (!nextCodeRecord(scanner, &record)) {
         //nothing left in file
         return (0);
     }
+    copyCodeEntries(record.data, record.length, code, MAXCODELENGTH);
 
-    if (c != 0) /* unsigned chars would be sufficient */ {
-        int order = c;
-        nv = order;
-        
-        zeroCounter = 0;
-        while (zeroCounter < order) {
-            int neighbour = (unsigned short) getc(f);
-            if (neighbour == 0) {
-                zeroCounter++;
-            } else {
+    nv = code[0];
+    if (nv > MAXN) {
+        fprintf(stderr, "Constant N too small %d > %d \n", nv, MAXN);
+        exit(1);
+    }
+
+    zeroCounter = 0;
+    for (position = 1; zeroCounter < nv; position++) {
+        int neighbour = code[position];
+        if (neighbour == 0) {
+            zeroCounter++;
+        } else {
+            if (!record.twoByteEntries) {
                 fprintf(stderr, "%d - %d\n", zeroCounter, neighbour-1);
-                set *gv, *gn;
-                gv = GRAPHROW(g, zeroCounter, MAXM);
-                gn = GRAPHROW(g, neighbour-1, MAXM);
-                ADDELEMENT(gv, neighbour-1);
-                ADDELEMENT(gn, zeroCounter);
-            }
-        }
-    } else {
-        int order = 0;
-        int readCount = fread(&order, sizeof (unsigned short), 1, f);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            exit(1);
-        }
-        nv = order;
-        
-        int neighbour = 0;
-        zeroCounter = 0;
-        while (zeroCounter < order) {
-            readCount = fread(&neighbour, sizeof (unsigned short), 1, f);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                exit(1);
-            }
-            if (neighbour == 0) {
-                zeroCounter++;
-            } else {
-                set *gv, *gn;
-                gv = GRAPHROW(g, zeroCounter, MAXM);
-                gn = GRAPHROW(g, neighbour-1, MAXM);
-                ADDELEMENT(gv, neighbour-1);
-                ADDELEMENT(gn, zeroCounter);
             }
+            set *gv, *gn;
+            gv = GRAPHROW(g, zeroCounter, MAXM);
+            gn = GRAPHROW(g, neighbour-1, MAXM);
+            ADDELEMENT(gv, neighbour-1);
+            ADDELEMENT(gn, zeroCounter);
         }
     }
     
@@ -19,6 +19,8 @@
 //#include "md5c.c"
 #endif
 #include "hashfunction.c"
+#include "../../multicode/shared/multicode_dedup.h"
+#include "../../multicode/shared/multicode_pipeline.h"
 
 #define N 200     /* Maximal moegliche Anzahl der Knoten KN_MAX-2*/
 #define MAXVAL 10 //MAXE  /* maximale valenz */
@@ -45,7 +47,7 @@
 
 
 #define SUBDIVISION (1<<17)
-int nvbeforesubdiv=INT_MAX, numbersubdivided=0;
+_Thread_local int nvbeforesubdiv=INT_MAX, numbersubdivided=0;
 #define ISSUBDIVVERTEX(i) ((i)>nvbeforesubdiv) 
 /* this depends on the order in which edges are subdivided! */
 
@@ -99,11 +101,16 @@ int without_mirror=0, do_rooted=0, do_rooted_v=0, do_rooted_e=0;
 int do_rooted_f=0, do_rooted_fl=0, write_roots=0, only_roots=0;
 int rest=0, mod=0;
 int use_hash=0;
+EXTERNAL_DEDUP *externaldedup=NULL; /* deduplicate the fingerprints in external memory */
 int print_ascii=0, print_ascii_short=0, md5out=0;
 unsigned long long int numrootedf=0, numrootedv=0, numrootede=0, numrootedfl=0;
-int nv, ne; /* Knoten und Kantenzahl des Graphen -- noch aus historischen Gruenden aus
+/* The graph that is decoded and canonically labelled is global, but every
+  thread has its own copy, so that canon_form() can run in several worker
+  threads (option threads). */
+_Thread_local int nv, ne; /* Knoten und Kantenzahl des Graphen -- noch aus historischen Gruenden aus
 	       plantri.c global */
 char codetype=0;
+int zaehlen, zaehlen2, non_iso, globaltest=0;
 
 /* extra arguments to pass to scan procedure */
 #define SCAN_ARGS
@@ -129,15 +136,15 @@ static int canon_form();
 void new_splaynode();
 void old_splaynode();
 
-PLANMAP map;
+_Thread_local PLANMAP map;
 
-EDGE *firstedge[MAXN+1];
-int degree[MAXN+1];
+_Thread_local EDGE *firstedge[MAXN+1];
+_Thread_local int degree[MAXN+1];
 
 //static EDGE *numbering[2*MAXE][MAXE]; 
  /* holds numberings produced by canon() or canon_edge() */
 
-static int markvalue = 300000;
+static _Thread_local int markvalue = 300000;
 #define RESETMARKS {int mki,mkj; if ((markvalue += 2) > 300000) \
       { markvalue = 2; \
 	 for (mki=1;mki<=N;++mki) for (mkj=0;mkj<MAXVAL;++mkj) \
@@ -151,8 +158,8 @@ static int markvalue = 300000;
 
 /* and the same for vertices */
 
-static int markvalue_v = 300000;
-static int marks__v[MAXN+1];
+static _Thread_local int markvalue_v = 300000;
+static _Thread_local int marks__v[MAXN+1];
 #define RESETMARKS_V {int mki; if ((markvalue_v += 2) > 300000) \
       { markvalue_v = 1; for (mki=0;mki<MAXN;++mki) marks__v[mki]=0;}}
 #define UNMARK_V(x) (marks__v[x] = 0)
@@ -163,8 +170,8 @@ static int marks__v[MAXN+1];
 #define ISMARKEDHI_V(x) (marks__v[x] == markvalue_v+1)
 #define MARKHI_V(x) (marks__v[x] = markvalue_v+1)
 
-int elmarkvalue=INT_MAX;
-int elmarks[MAXE+1];
+_Thread_local int elmarkvalue=INT_MAX;
+_Thread_local int elmarks[MAXE+1];
 #define RESETMARKS_EL {if (elmarkvalue==INT_MAX) \
                        {int i; for (i=0;i<=MAXE;i++) elmarks[i]=0; elmarkvalue=1; }\
                   else elmarkvalue++; }
@@ -590,32 +597,21 @@ md5tos(char *md5, char *s)
 #endif
 
 
-/**************************NEU*************************************/
+/**************************INSERTCANONICAL*************************/
 
-int neu( int laenge, int nummer, int colour[])
-/* Entscheidet, ob ein graph schon in der Liste behandelter Graphen ist 
-  und fuegt ihn ein, wenn nicht
+int insertcanonical(short *can_form, int laenge, int nummer)
+/* Entscheidet, ob die kanonische Form can_form (alloziert mit canformmalloc)
+  schon in der Liste behandelter Graphen ist und fuegt sie ein, wenn nicht
 
-  Im Falle von print_ascii==1 wird nur die kanonische Form berechnet und 
-  geschrieben.
+  Im Falle von print_ascii==1 wird die kanonische Form nur geschrieben.
 
 */
 {
-short *can_form;
 uint32_t hashvalues[2*NUMBERHASHES];
-int m,n,test,test2, auts, auts_or_pres;
+int m,n,test,test2;
 unsigned char charbuffer[33],printbuffer[17];
 
 
-can_form=(short *)canformmalloc(laenge,0);
-//if (can_form==NULL) { fprintf(stderr,"Don't get more space...\n"); exit(1); }
-//if (do_rooted) canon_form(colour, numbering, &auts, &auts_or_pres, can_form);
-//else 
-
-canon_form(colour, NULL, &auts, &auts_or_pres, can_form);
-
-
-
 if (print_ascii) { 
 #ifdef MD5
   if (md5out)
@@ -648,6 +644,14 @@ canformmalloc(0,1);
 return 0;
 }/* end print ascii */
 
+if (externaldedup)
+  { addToExternalDedup(externaldedup,
+			computeFingerprint(can_form,laenge*sizeof(short),laenge),
+			can_form, output ? laenge*sizeof(short) : 0);
+    canformmalloc(0,1);
+    return 0;
+  }
+
 if (use_hash)
   { int i;
   for (i=0;i<2*NUMBERHASHES;i++)
@@ -701,9 +705,34 @@ if (write_roots) fprintf(stderr,"Number %d vertex roots %d \n",nummer,test2);
 return(test);
 }
 
-/*********************OUTPUTNODE***********************************/
+/**************************NEU*************************************/
 
-void outputnode(SPLAYNODE *liste)
+int neu( int laenge, int nummer, int colour[])
+/* Entscheidet, ob ein graph schon in der Liste behandelter Graphen ist 
+  und fuegt ihn ein, wenn nicht
+
+  Im Falle von print_ascii==1 wird nur die kanonische Form berechnet und 
+  geschrieben.
+
+*/
+{
+short *can_form;
+int auts, auts_or_pres;
+
+
+can_form=(short *)canformmalloc(laenge,0);
+//if (can_form==NULL) { fprintf(stderr,"Don't get more space...\n"); exit(1); }
+//if (do_rooted) canon_form(colour, numbering, &auts, &auts_or_pres, can_form);
+//else 
+
+canon_form(colour, NULL, &auts, &auts_or_pres, can_form);
+
+return insertcanonical(can_form, laenge, nummer);
+}
+
+/*********************WRITECANONICAL***********************************/
+
+void writecanonical(short *graph, int length)
 
 {
 static char first=1;
@@ -711,12 +740,28 @@ int i;
 
 if (first) { first=0; fprintf(stdout,">>planar_code<<"); }
 
-if ((liste->graph)[0]>250)
+if (graph[0]>250)
  { putc(0,stdout);
-   fwrite(liste->graph,sizeof(unsigned short),liste->length,stdout);
+   fwrite(graph,sizeof(unsigned short),length,stdout);
  }
 else
- for (i=0;i<liste->length; i++) putc((liste->graph)[i],stdout);
+ for (i=0;i<length; i++) putc(graph[i],stdout);
+}
+
+/*********************OUTPUTNODE***********************************/
+
+void outputnode(SPLAYNODE *liste)
+
+{
+writecanonical(liste->graph,liste->length);
+}
+
+/*********************OUTPUTSURVIVOR***********************************/
+
+void outputsurvivor(const void *graph, size_t size, void *context)
+/* writes a graph that was kept by the external deduplication */
+{
+writecanonical((short *)graph,size/sizeof(short));
 }
 
 
@@ -2017,6 +2062,87 @@ void  subdividedubbelandloop(int colour[])
 
 }
 
+/*********************DECODIERE_CODE***********************************/
+
+int decodiere_code(unsigned short code[], int lauf, int colour[], int *renumbered)
+/* Decodes the code into map and computes the colours of the vertices.
+  Returns 1 if the graph is selected by the option mod and 0 otherwise.
+  renumbered is set to 1 if the vertices had to be renumbered. */
+{
+unsigned short neuer_code[MAXCODELENGTH];
+int i;
+
+*renumbered=0;
+if ((mod!=0) && (codetype=='e') && ((invariant_code(code, lauf)%mod)!=rest)) return 0;
+
+if (codetype=='p')
+  {
+    if (check_code(code,neuer_code)) decodiereplanar(code,map,degree);
+    else { decodiereplanar(neuer_code,map,degree); *renumbered=1; }
+    for (i=1;i<=nv;i++) colour[i]=degree[i];
+  }
+else // type=='e'
+  {
+    decode_edgecode(code, lauf);
+    for (i=1;i<=nv;i++) colour[i]=degree[i];
+    //writemap();
+    subdividedubbelandloop(colour);
+  }
+
+return ((mod==0) || (codetype=='e') || ((invariant()%mod)==rest));
+}
+
+/*********************PARALLEL***********************************/
+
+/* With the option threads the codes are read by a reader thread, decoded and
+  canonically labelled by worker threads -- each with its own map -- and the
+  canonical forms are inserted by the main thread in the order of the input,
+  so the result is the same as with a single thread. */
+
+typedef struct {
+  int selected, renumbered, laenge;
+  short can_form[MAXCODELENGTH];
+} CANONICALRESULT;
+
+int readgraph(unsigned char *item, size_t *length, void *context)
+{
+int lauf;
+
+if (!lesecode((unsigned short *)item, &lauf, stdin, &codetype)) return 0;
+*length=lauf*sizeof(unsigned short);
+return 1;
+}
+
+void canonicalgraph(const unsigned char *item, size_t length, void *result,
+		    void *scratch, void *context)
+{
+CANONICALRESULT *canonical=(CANONICALRESULT *)result;
+int colour[MAXN];
+int auts, auts_or_pres;
+
+canonical->selected=decodiere_code((unsigned short *)item, length/sizeof(unsigned short),
+				   colour, &(canonical->renumbered));
+if (canonical->selected)
+  { canonical->laenge=nv+ne+1;
+    canon_form(colour, NULL, &auts, &auts_or_pres, canonical->can_form);
+  }
+}
+
+void insertgraph(const unsigned char *item, size_t length, void *result, void *context)
+{
+CANONICALRESULT *canonical=(CANONICALRESULT *)result;
+short *can_form;
+
+zaehlen++;
+globaltest+=canonical->renumbered;
+if (canonical->selected)
+  { zaehlen2++;
+    can_form=(short *)canformmalloc(canonical->laenge,0);
+    memcpy(can_form,canonical->can_form,canonical->laenge*sizeof(short));
+    if (insertcanonical(can_form,canonical->laenge,zaehlen)) non_iso++;
+  }
+}
+
 /*******************MAIN********************************/
 
 int main(argc,argv)
@@ -2028,18 +2154,18 @@ char *argv[];
 {
 GRAPH graph;
 int colour[MAXN];
-int zaehlen, zaehlen2, non_iso;
 unsigned short code[MAXCODELENGTH];
-unsigned short neuer_code[MAXCODELENGTH];
 int lauf, nullenzaehler;
 unsigned char ucharpuffer;
-int too_large, i, test, globaltest=0;
+int too_large, i, test;
 
 char outputstring[300];
 int first_call=1;
 int auts, auts_or_pres;
 short *can_form;
 int return_total = 0;
+size_t memorybudget = 0;
+int threadcount = 1;
 
 
 fprintf(stderr,"Use for double edges and loops only with edgecode.\n");
@@ -2071,6 +2197,16 @@ if (strcmp(argv[i],"md5")==0) {print_ascii=md5out=1; } else
 		//if (strcmp(argv[i],"rf")==0) { do_rooted=1; do_rooted_f=1;} else
 		//if (strcmp(argv[i],"ro")==0) { only_roots=1; } else
 		  if (strcmp(argv[i],"hash")==0) { use_hash=1; } else
+		  if ((strcmp(argv[i],"memory")==0) || (strcmp(argv[i],"--memory")==0))
+		    { i++; 
+		      if ((i>=argc) || ((memorybudget=parseMemorySize(argv[i]))==0))
+			{ fprintf(stderr,"memory needs a size like 512M or 16G.\n"); exit(1); }
+		    } else
+		  if ((strcmp(argv[i],"threads")==0) || (strcmp(argv[i],"--threads")==0))
+		    { i++; 
+		      if ((i>=argc) || ((threadcount=atoi(argv[i]))<1))
+			{ fprintf(stderr,"threads needs a number of threads.\n"); exit(1); }
+		    } else
 		  if (strcmp(argv[i],"t")==0) { return_total=1; } else
 		    if (strcmp(argv[i],"mod")==0) { i++; rest=atoi(argv[i]);
                                                    i++; mod=atoi(argv[i]); } else
@@ -2084,6 +2220,12 @@ fprintf(stderr,"in ascii format)\n");
 fprintf(stderr,"md5 (print an ascii md5 representation to stdout)\n");
 fprintf(stderr,"hash (use a hash value instead of the real canonical form)\n");
 fprintf(stderr,"In case hash is used no output of the graph is possible.\n");
+fprintf(stderr,"memory x (deduplicate hash values in external memory, using at most x bytes\n");
+fprintf(stderr,"  (e.g. 512M or 16G) of memory -- the hash values are written to temporary\n");
+fprintf(stderr,"  files in $TMPDIR or /tmp. With f the non-isomorphic ones are written in the\n");
+fprintf(stderr,"  order in which they were read. Cannot be combined with o, n, wo, wn or hash.)\n");
+fprintf(stderr,"threads x (compute the canonical forms with x threads -- the result is the same\n");
+fprintf(stderr,"  as with one thread. Cannot be combined with wo or wn.)\n");
 		fprintf(stderr,"wo wn (write the map if old/new)\n");
 		fprintf(stderr,"or (don't regard orientation reversing automorphisms)\n");
 		//fprintf(stderr,"rv, re, rfl, rf (count the rooted nonisomorphic structures)\n");
@@ -2106,6 +2248,15 @@ if (use_hash)
 
   }
 
+if (memorybudget)
+  { if (write_old || write_new || writemap_old || writemap_new || use_hash)
+      { fprintf(stderr,"memory cannot be combined with o, n, wo, wn or hash.\n"); exit(1); }
+    if (!print_ascii) externaldedup=newExternalDedup(memorybudget,output);
+  }
+
+if ((threadcount>1) && (writemap_old || writemap_new))
+  { fprintf(stderr,"threads cannot be combined with wo or wn.\n"); exit(1); }
+
 if (mod) { fprintf(stderr,"Note: modulo saves memory -- but time is a bad.\n");
 fprintf(stderr,"The sum of the runs takes MUCH more times than a single one! \n"); }
 
@@ -2115,46 +2266,25 @@ if (do_rooted_v || do_rooted_f || do_rooted_e)
     fprintf(stderr,"__DO__ test it against known numbers before using the results!\n"); }
 */
 
-while (lesecode(code, &lauf, stdin, &codetype))
-  { zaehlen++; 
-  if ((mod==0) || (codetype!='e') || ((invariant_code(code, lauf)%mod)==rest))
- { 
-
-
-   //fprintf(stderr,"number %d\n",zaehlen);
-
-   if (codetype=='p')
-     {
-	if ((test=check_code(code,neuer_code))) decodiereplanar(code,map,degree);
-	else { decodiereplanar(neuer_code,map,degree); globaltest++; }
-	for (i=1;i<=nv;i++) colour[i]=degree[i];
-     }
-   else // type=='e'
-     {
-	decode_edgecode(code, lauf);
-	for (i=1;i<=nv;i++) colour[i]=degree[i];
-	//writemap();
-	subdividedubbelandloop(colour);
-	/*	if (zaehlen==2 || zaehlen==5) 
-	  	  { int i; 
-fprintf(stderr,"colours: ");for (i=1;i<=nv;i++) fprintf(stderr," %d",colour[i]); fprintf(stderr,"\n");
-writemap(); }*/
-     }
-
-
-
-
-   if ((mod==0) || (codetype=='e') || ((invariant()%mod)==rest))
-     { zaehlen2++;
-     if (neu(nv+ne+1,zaehlen,colour)) non_iso++;
-     }
-
- }
-  }
+if (threadcount>1)
+  runOrderedPipeline(threadcount, MAXCODELENGTH*sizeof(unsigned short),
+		     sizeof(CANONICALRESULT), 0, readgraph, canonicalgraph, insertgraph, NULL);
+else
+  while (lesecode(code, &lauf, stdin, &codetype))
+    { zaehlen++; 
+    //fprintf(stderr,"number %d\n",zaehlen);
+    if (decodiere_code(code, lauf, colour, &test))
+      { zaehlen2++;
+      if (neu(nv+ne+1,zaehlen,colour)) non_iso++;
+      }
+    globaltest+=test;
+    }
 
 
 
-if (output && !use_hash) splay_scan(worklist);
+if (externaldedup)
+  non_iso=finishExternalDedup(externaldedup, output ? outputsurvivor : NULL, NULL);
+else if (output && !use_hash) splay_scan(worklist);
 
 if (globaltest!=0)
 fprintf(stderr,"WARNING !! %d graphs had to be renumbered, since there was a vertex\n different from 1 not adjacent to a smaller one ! \n",globaltest);
@@ -11,7 +11,8 @@
  * 
  * Compile with:
  *     
- *     cc -o select_pl -O4 select_pl.c
+ *     cc -o select_pl -O4 select_pl.c shared/planar_output.c \
+ *     ../multicode/shared/multicode_scanner.c ../multicode/shared/multicode_index.c
  * 
  */
 
@@ -20,6 +21,10 @@
 #include <getopt.h>
 #include <string.h>
 
+#include "shared/planar_base.h"
+#include "shared/planar_output.h"
+#include "../multicode/shared/multicode_scanner.h"
+#include "../multicode/shared/multicode_index.h"
 
 #ifndef MAXN
 #define MAXN 200            /* the maximum number of vertices */
@@ -31,298 +36,35 @@
 
 #define INFI (MAXN + 1)
 
-#undef FALSE
-#undef TRUE
-#define FALSE 0
-#define TRUE  1
+//=============== Writing the selected graphs ===========================
 
-typedef int boolean;
-
-typedef struct e /* The data type used for edges */ {
-    int start; /* vertex where the edge starts */
-    int end; /* vertex where the edge ends */
-    
-    struct e *prev; /* previous edge in clockwise direction */
-    struct e *next; /* next edge in clockwise direction */
-    struct e *inverse; /* the edge that is inverse to this one */
-    int mark, index; /* two ints for temporary use;
-                          Only access mark via the MARK macros. */
-} EDGE;
-
-EDGE *firstedge[MAXN]; /* pointer to arbitrary edge out of vertex i. */
-int degree[MAXN];
-
-EDGE edges[MAXE];
-
-static int markvalue = 30000;
-#define RESETMARKS {int mki; if ((markvalue += 2) > 30000) \
-       { markvalue = 2; for (mki=0;mki<MAXE;++mki) edges[mki].mark=0;}}
-#define MARK(e) (e)->mark = markvalue
-#define MARKLO(e) (e)->mark = markvalue
-#define MARKHI(e) (e)->mark = markvalue+1
-#define UNMARK(e) (e)->mark = markvalue-1
-#define ISMARKED(e) ((e)->mark >= markvalue)
-#define ISMARKEDLO(e) ((e)->mark == markvalue)
-#define ISMARKEDHI(e) ((e)->mark > markvalue)
-
-int nv;
-int ne;
-
-//=============== Writing planarcode of graph ===========================
-
-void writePlanarCodeChar(){
-    int i;
-    EDGE *e, *elast;
-    
-    //write the number of vertices
-    fputc(nv, stdout);
-    
-    for(i=0; i<nv; i++){
-        e = elast = firstedge[i];
-        do {
-            fputc(e->end + 1, stdout);
-            e = e->next;
-        } while (e != elast);
-        fputc(0, stdout);
-    }
-}
-
-void writeShort(unsigned short value){
-    if (fwrite(&value, sizeof (unsigned short), 1, stdout) != 1) {
-        fprintf(stderr, "fwrite() failed -- exiting!\n");
-        exit(-1);
-    }
-}
-
-void writePlanarCodeShort(){
-    int i;
-    EDGE *e, *elast;
-    
-    //write the number of vertices
-    fputc(0, stdout);
-    writeShort(nv);
-    
-    
-    for(i=0; i<nv; i++){
-        e = elast = firstedge[i];
-        do {
-            writeShort(e->end + 1);
-            e = e->next;
-        } while (e != elast);
-        writeShort(0);
-    }
-}
-
-void writePlanarCode(){
-    static int first = TRUE;
-    
-    if(first){
-        first = FALSE;
-        
-        fprintf(stdout, ">>planar_code<<");
-    }
-    
-    if (nv + 1 <= 255) {
-        writePlanarCodeChar();
-    } else if (nv + 1 <= 65535) {
-        writePlanarCodeShort();
-    } else {
-        fprintf(stderr, "Graphs of that size are currently not supported -- exiting!\n");
-        exit(-1);
-    }
-    
-}
-
-//=============== Reading and decoding planarcode ===========================
-
-EDGE *findEdge(int from, int to) {
-    EDGE *e, *elast;
-
-    e = elast = firstedge[from];
-    do {
-        if (e->end == to) {
-            return e;
-        }
-        e = e->next;
-    } while (e != elast);
-    fprintf(stderr, "error while looking for edge from %d to %d.\n", from, to);
-    exit(0);
-}
-
-void decodePlanarCode(unsigned short* code) {
-    /* complexity of method to determine inverse isn't that good, but will have to satisfy for now
-     */
-    int i, j, codePosition;
-    int edgeCounter = 0;
-    EDGE *inverse;
-
-    nv = code[0];
-    codePosition = 1;
-
-    for (i = 0; i < nv; i++) {
-        degree[i] = 0;
-        firstedge[i] = edges + edgeCounter;
-        edges[edgeCounter].start = i;
-        edges[edgeCounter].end = code[codePosition] - 1;
-        edges[edgeCounter].next = edges + edgeCounter + 1;
-        if (code[codePosition] - 1 < i) {
-            inverse = findEdge(code[codePosition] - 1, i);
-            edges[edgeCounter].inverse = inverse;
-            inverse->inverse = edges + edgeCounter;
-        } else {
-            edges[edgeCounter].inverse = NULL;
-        }
-        edgeCounter++;
-        codePosition++;
-        for (j = 1; code[codePosition]; j++, codePosition++) {
-            if (j == MAXVAL) {
-                fprintf(stderr, "MAXVAL too small: %d\n", MAXVAL);
-                exit(0);
-            }
-            edges[edgeCounter].start = i;
-            edges[edgeCounter].end = code[codePosition] - 1;
-            edges[edgeCounter].prev = edges + edgeCounter - 1;
-            edges[edgeCounter].next = edges + edgeCounter + 1;
-            if (code[codePosition] - 1 < i) {
-                inverse = findEdge(code[codePosition] - 1, i);
-                edges[edgeCounter].inverse = inverse;
-                inverse->inverse = edges + edgeCounter;
-            } else {
-                edges[edgeCounter].inverse = NULL;
-            }
-            edgeCounter++;
-        }
-        firstedge[i]->prev = edges + edgeCounter - 1;
-        edges[edgeCounter - 1].next = firstedge[i];
-        degree[i] = j;
+/* Writes the graph of the given record.
+ */
+void filterGraph(CODE_RECORD *record) {
+    static unsigned short code[MAXCODELENGTH];
 
-        codePosition++; /* read the closing 0 */
+    copyCodeEntries(record->data, record->length, code, MAXCODELENGTH);
+    if (code[0] > MAXN) {
+        fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
+        exit(1);
     }
-
-    ne = edgeCounter;
+    writePlanarCodeEntries(code, stdout);
 }
 
-/**
- * 
- * @param code
- * @param laenge
- * @param file
- * @return returns 1 if a code was read and 0 otherwise. Exits in case of error.
+/* Reads the given graph with the index and writes it. The graphs are
+ * numbered starting from 1.
  */
-int readPlanarCode(unsigned short code[], int *length, FILE *file) {
-    static int first = 1;
-    unsigned char c;
-    char testheader[20];
-    int bufferSize, zeroCounter;
-    
-    int readCount;
-
-
-    if (first) {
-        first = 0;
-
-        if (fread(&testheader, sizeof (unsigned char), 13, file) != 13) {
-            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
-            exit(1);
-        }
-        testheader[13] = 0;
-        if (strcmp(testheader, ">>planar_code") == 0) {
-
-        } else {
-            fprintf(stderr, "No planarcode header detected -- exiting!\n");
-            exit(1);
-        }
-        //read reminder of header (either empty or le/be specification)
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-        while (c!='<'){
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                return FALSE;
-            }
-        }
-        //read one more character
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
+void filterIndexedGraph(CODE_INDEX *codeIndex, unsigned long long graph) {
+    static unsigned short code[MAXCODELENGTH];
+    CODE_INDEX_ENTRY entry;
+
+    getCodeIndexEntry(codeIndex, graph - 1, &entry);
+    if (entry.order > MAXN) {
+        fprintf(stderr, "Constant N too small %d > %d \n", entry.order, MAXN);
+        exit(1);
     }
-
-    /* possibly removing interior headers -- only done for planarcode */
-    if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-        //nothing left in file
-        return (0);
-    }
-
-    if (c == '>') {
-        // could be a header, or maybe just a 62 (which is also possible for unsigned char
-        code[0] = c;
-        bufferSize = 1;
-        zeroCounter = 0;
-        code[1] = (unsigned short) getc(file);
-        if (code[1] == 0) zeroCounter++;
-        code[2] = (unsigned short) getc(file);
-        if (code[2] == 0) zeroCounter++;
-        bufferSize = 3;
-        // 3 characters were read and stored in buffer
-        if ((code[1] == '>') && (code[2] == 'p')) /*we are sure that we're dealing with a header*/ {
-            while ((c = getc(file)) != '<');
-            /* read 2 more characters: */
-            c = getc(file);
-            if (c != '<') {
-                fprintf(stderr, "Problems with header -- single '<'\n");
-                exit(1);
-            }
-            if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                //nothing left in file
-                return (0);
-            }
-            bufferSize = 1;
-            zeroCounter = 0;
-        }
-    } else {
-        //no header present
-        bufferSize = 1;
-        zeroCounter = 0;
-    }
-
-    if (c != 0) /* unsigned chars would be sufficient */ {
-        code[0] = c;
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        while (zeroCounter < code[0]) {
-            code[bufferSize] = (unsigned short) getc(file);
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    } else {
-        readCount = fread(code, sizeof (unsigned short), 1, file);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            exit(1);
-        }
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        bufferSize = 1;
-        zeroCounter = 0;
-        while (zeroCounter < code[0]) {
-            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                exit(1);
-            }
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    }
-
-    *length = bufferSize;
-    return (1);
-
-
+    readIndexedCode(codeIndex, &entry, code, MAXCODELENGTH);
+    writePlanarCodeEntries(code, stdout);
 }
 
 //====================== USAGE =======================
@@ -343,6 +85,10 @@ void help(char *name) {
     fprintf(stderr, "    are read from the file provided and not from stdin. Instead the numbers of\n");
     fprintf(stderr, "    the graphs that should be filtered are read from stdin. The numbers should\n");
     fprintf(stderr, "    be given in ascending order and at least one number should be given.\n");
+    fprintf(stderr, "    If file.idx exists, it is used as index for the file (see -I).\n");
+    fprintf(stderr, " -I, --index file\n");
+    fprintf(stderr, "    Use the given index (see index_pl) to read only the selected graphs. The\n");
+    fprintf(stderr, "    graphs should be read from the file for which the index was built.\n");
     fprintf(stderr, " --skip-remainder\n");
     fprintf(stderr, "    Immediately return after filtering the last graph.\n");
     fprintf(stderr, " -h, --help\n");
@@ -370,6 +116,10 @@ int main(int argc, char** argv) {
     int moduloRest;
     int moduloMod;
 
+    char *indexFileName = NULL;
+    CODE_INDEX *codeIndex = NULL;
+    FILE *graphsIn = stdin;
+
     /*=========== commandline parsing ===========*/
 
     int c;
@@ -378,11 +128,12 @@ int main(int argc, char** argv) {
         {"skip-remainder", no_argument, NULL, 0},
         {"modulo", required_argument, NULL, 'm'},
         {"from-file", required_argument, NULL, 'F'},
+        {"index", required_argument, NULL, 'I'},
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "hm:F:", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "hm:F:I:", long_options, &option_index)) != -1) {
         switch (c) {
             case 0:
                 switch (option_index) {
@@ -406,6 +157,9 @@ int main(int argc, char** argv) {
                 fromFile = TRUE;
                 fromFile_fileName = optarg;
                 break;
+            case 'I':
+                indexFileName = optarg;
+                break;
             case 'h':
                 help(name);
                 return EXIT_SUCCESS;
@@ -430,39 +184,81 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
     
-    if(!fromFile){
+    if(fromFile){
+        //open file containing graphs
+        graphsIn = fopen(fromFile_fileName, "r");
+        
+        if(graphsIn == NULL){
+            fprintf(stderr, "Could not open %s to read graphs -- exiting!\n", fromFile_fileName);
+            return EXIT_FAILURE;
+        }
+        
+        if(indexFileName == NULL){
+            codeIndex = openCodeIndex(getCodeIndexName(fromFile_fileName),
+                    PLANARCODE_FORMAT, fileno(graphsIn));
+        }
+    }
+    if(indexFileName != NULL){
+        codeIndex = openCodeIndex(indexFileName, PLANARCODE_FORMAT, fileno(graphsIn));
+        if(codeIndex == NULL){
+            fprintf(stderr, "Could not open %s to read index -- exiting!\n", indexFileName);
+            return EXIT_FAILURE;
+        }
+    }
+    
+    if(!fromFile && codeIndex != NULL){
+        int i;
+        graphsRead = getCodeIndexSize(codeIndex);
+        
+        //the graphs are numbered starting from 1
+        unsigned long long graph = 0;
+        if(moduloEnabled){
+            graph = moduloRest == 0 ? moduloMod : moduloRest;
+        }
+        for(i = optind; ; i++){
+            if(!moduloEnabled){
+                //just like without an index, the selection stops at a number that is not larger
+                if(i == argc || atoi(argv[i]) <= graph){
+                    break;
+                }
+                graph = atoi(argv[i]);
+            } else if(graph % moduloMod != moduloRest){
+                break;
+            }
+            if(graph > graphsRead){
+                break;
+            }
+            filterIndexedGraph(codeIndex, graph);
+            graphsFiltered++;
+            if(moduloEnabled){
+                graph += moduloMod;
+            }
+        }
+    } else if(!fromFile){
         int i;
         int selectedGraphs[argc - optind];
         for (i = 0; i < argc - optind; i++){
             selectedGraphs[i] = atoi(argv[i + optind]);
         }
 
-        unsigned short code[MAXCODELENGTH];
-        int length;
-        while (readPlanarCode(code, &length, stdin)) {
+        //only the selected graphs are decoded
+        CODE_SCANNER *scanner = newCodeScanner(stdin, PLANARCODE_FORMAT);
+        CODE_RECORD code;
+        while (nextCodeRecord(scanner, &code)) {
             graphsRead++;
 
             if(moduloEnabled){
                 if(graphsRead % moduloMod == moduloRest){
-                    decodePlanarCode(code);
+                    filterGraph(&code);
                     graphsFiltered++;
-                    writePlanarCode();
                 }
             } else if (graphsFiltered < argc - optind && (graphsRead == selectedGraphs[graphsFiltered])) {
-                decodePlanarCode(code);
+                filterGraph(&code);
                 graphsFiltered++;
-                writePlanarCode();
             }
         }
+        freeCodeScanner(scanner);
     } else {
-        //open file containing graphs
-        FILE *graphsIn = fopen(fromFile_fileName, "r");
-        
-        if(graphsIn == NULL){
-            fprintf(stderr, "Could not open %s to read graphs -- exiting!\n", fromFile_fileName);
-            return EXIT_FAILURE;
-        }
-        
         char line[20];
         int nextGraph = -1;
         if(fgets(line, sizeof(line), stdin)){
@@ -473,32 +269,53 @@ int main(int argc, char** argv) {
             return EXIT_FAILURE;
         }
         
-        
-        unsigned short code[MAXCODELENGTH];
-        int length;
-        while (readPlanarCode(code, &length, graphsIn)) {
-            graphsRead++;
-
-            if (graphsRead == nextGraph) {
-                decodePlanarCode(code);
+        if(codeIndex != NULL){
+            graphsRead = getCodeIndexSize(codeIndex);
+            while(nextGraph > 0 && nextGraph <= graphsRead){
+                filterIndexedGraph(codeIndex, nextGraph);
                 graphsFiltered++;
-                writePlanarCode();
                 //read number of next graph
                 if(fgets(line, sizeof(line), stdin)){
+                    int previousGraph = nextGraph;
                     nextGraph = atoi(line);
-                    if(nextGraph < graphsRead){
+                    if(nextGraph < previousGraph){
                         fprintf(stderr, "Numbers should be given in ascending order -- exiting!");
                         return EXIT_FAILURE;
+                    } else if(nextGraph == previousGraph){
+                        //just like without an index, the selection stops at a repeated number
+                        nextGraph = -1;
                     }
-                } else if(skipRemainder) {
-                    //last graph was filtered
-                    //skipping remainder
-                    break;
                 } else {
-                    //no graphs left to filter
                     nextGraph = -1;
                 }
             }
+        } else {
+            CODE_SCANNER *scanner = newCodeScanner(graphsIn, PLANARCODE_FORMAT);
+            CODE_RECORD code;
+            while (nextCodeRecord(scanner, &code)) {
+                graphsRead++;
+
+                if (graphsRead == nextGraph) {
+                    filterGraph(&code);
+                    graphsFiltered++;
+                    //read number of next graph
+                    if(fgets(line, sizeof(line), stdin)){
+                        nextGraph = atoi(line);
+                        if(nextGraph < graphsRead){
+                            fprintf(stderr, "Numbers should be given in ascending order -- exiting!");
+                            return EXIT_FAILURE;
+                        }
+                    } else if(skipRemainder) {
+                        //last graph was filtered
+                        //skipping remainder
+                        break;
+                    } else {
+                        //no graphs left to filter
+                        nextGraph = -1;
+                    }
+                }
+            }
+            freeCodeScanner(scanner);
         }
     }
     
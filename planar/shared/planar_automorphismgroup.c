@@ -1,20 +1,34 @@
 /*
  * Main developer: Nico Van Cleemput
- * 
+ *
  * Copyright (C) 2016 Nico Van Cleemput.
  * Licensed under the GNU GPL, read the file LICENSE.txt for details.
  */
 
 #include <stdlib.h>
 #include <stdio.h>
-#include <limits.h>
+#include <string.h>
 
 #include "planar_automorphismgroup.h"
 
-#define ABORT_IF_NULL(pointer) if(pointer==NULL){exit(-1);}
+#define ABORT_IF_NULL(pointer) if(pointer==NULL){fprintf(stderr, "Insufficient memory to determine automorphism group -- exiting!\n"); exit(EXIT_FAILURE);}
+
+/* A flag is an edge together with an orientation: 2*edge for the orientation
+ * of the embedding and 2*edge+1 for the mirror image. Each automorphism is
+ * determined by the image of one flag.
+ */
+#define FLAG(pg, e, mirrored) (2*((e) - (pg)->edges) + ((mirrored) ? 1 : 0))
 
 //////////////////////////////////////////////////////////////////////////////
 
+/* The workspace is shared by all calls. The arrays only grow, so computing
+ * the automorphism group does not allocate memory unless the graph is larger
+ * than all graphs that were handled before.
+ *
+ * A vertex is labelled in the current BFS if its mark equals vertexMarkValue,
+ * and a flag belongs to the orbit of the canonical starting flag if its mark
+ * equals flagMarkValue. This avoids clearing arrays for each starting edge.
+ */
 typedef struct __pg_aut_comp_data PG_AUT_COMP_DATA;
 
 struct __pg_aut_comp_data {
@@ -24,364 +38,612 @@ struct __pg_aut_comp_data {
     PG_EDGE **canonicalFirstEdge;
     int *alternateLabelling;
     PG_EDGE **alternateFirstEdge;
-    
+    int *queue;
+    unsigned int *vertexMarks;
+    unsigned int vertexMarkValue;
+
+    //the canonical starting edge and its orientation
+    PG_EDGE *canonicalStart;
+    boolean canonicalMirrored;
+
+    //the flags that are images of the canonical starting flag
+    //under the automorphisms generated so far
+    int *orbit;
+    int orbitSize;
+    unsigned int *flagMarks;
+    unsigned int flagMarkValue;
+
+    unsigned int *vertexInvariant;
+    unsigned int *edgeInvariant;
+    unsigned int *mirrorEdgeInvariant;
+
+    //a hash table that stores the frequency of each edge invariant
+    unsigned int *invariantTable;
+    int *invariantFrequency;
+    unsigned int *invariantTableMarks;
+    unsigned int invariantTableMarkValue;
+    int invariantTableSize;
+
     PG_EDGE **orientationPreservingStartingEdges;
     PG_EDGE **orientationReversingStartingEdges;
-    int startingEdgesCount; //the number of starting edges is always the same for both orientations
-    
-    int *queue;
-    
-    boolean hasChiralGroup;
+    int orientationPreservingStartingEdgesCount;
+    int orientationReversingStartingEdgesCount;
+
+    int vertexCapacity;
+    int edgeCapacity;
+    int certificateCapacity;
 };
 
-PG_AUT_COMP_DATA *getAutomorphismComputationWorkspace(PLANE_GRAPH *pg){
-    int e, n;
-    
-    e = pg->ne;
-    n = pg->nv;
-    
-    PG_AUT_COMP_DATA *workspace = malloc(sizeof(PG_AUT_COMP_DATA));
-    ABORT_IF_NULL(workspace);
-    
-    workspace->certificate = malloc(sizeof(int)*(e+n));
-    ABORT_IF_NULL(workspace->certificate);
-    workspace->canonicalLabelling = malloc(sizeof(int)*n);
-    ABORT_IF_NULL(workspace->canonicalLabelling);
-    workspace->reverseCanonicalLabelling = malloc(sizeof(int)*n);
-    ABORT_IF_NULL(workspace->reverseCanonicalLabelling);
-    workspace->canonicalFirstEdge = malloc(sizeof(PG_EDGE*)*n);
-    ABORT_IF_NULL(workspace->canonicalFirstEdge);
-    workspace->alternateLabelling = malloc(sizeof(int)*n);
-    ABORT_IF_NULL(workspace->alternateLabelling);
-    workspace->alternateFirstEdge = malloc(sizeof(PG_EDGE*)*n);
-    ABORT_IF_NULL(workspace->alternateFirstEdge);
-    
-    workspace->orientationPreservingStartingEdges = malloc(sizeof(PG_EDGE*)*e);
-    ABORT_IF_NULL(workspace->orientationPreservingStartingEdges);
-    workspace->orientationReversingStartingEdges = malloc(sizeof(PG_EDGE*)*e);
-    ABORT_IF_NULL(workspace->orientationReversingStartingEdges);
-    
-    workspace->queue = malloc(sizeof(int)*n);
-    ABORT_IF_NULL(workspace->queue);
-    
-    return workspace;
+static PG_AUT_COMP_DATA workspace;
+
+static void ensureWorkspaceSize(PLANE_GRAPH *pg){
+    int n = pg->nv;
+    int e = pg->ne;
+
+    if(n > workspace.vertexCapacity){
+        free(workspace.canonicalLabelling);
+        free(workspace.reverseCanonicalLabelling);
+        free(workspace.canonicalFirstEdge);
+        free(workspace.alternateLabelling);
+        free(workspace.alternateFirstEdge);
+        free(workspace.queue);
+        free(workspace.vertexMarks);
+        free(workspace.vertexInvariant);
+        workspace.canonicalLabelling = malloc(sizeof(int)*n);
+        ABORT_IF_NULL(workspace.canonicalLabelling);
+        workspace.reverseCanonicalLabelling = malloc(sizeof(int)*n);
+        ABORT_IF_NULL(workspace.reverseCanonicalLabelling);
+        workspace.canonicalFirstEdge = malloc(sizeof(PG_EDGE*)*n);
+        ABORT_IF_NULL(workspace.canonicalFirstEdge);
+        workspace.alternateLabelling = malloc(sizeof(int)*n);
+        ABORT_IF_NULL(workspace.alternateLabelling);
+        workspace.alternateFirstEdge = malloc(sizeof(PG_EDGE*)*n);
+        ABORT_IF_NULL(workspace.alternateFirstEdge);
+        workspace.queue = malloc(sizeof(int)*n);
+        ABORT_IF_NULL(workspace.queue);
+        workspace.vertexMarks = calloc(n, sizeof(unsigned int));
+        ABORT_IF_NULL(workspace.vertexMarks);
+        workspace.vertexInvariant = malloc(sizeof(unsigned int)*n);
+        ABORT_IF_NULL(workspace.vertexInvariant);
+        workspace.vertexMarkValue = 0;
+        workspace.vertexCapacity = n;
+    }
+
+    if(e > workspace.edgeCapacity){
+        free(workspace.orbit);
+        free(workspace.flagMarks);
+        free(workspace.edgeInvariant);
+        free(workspace.mirrorEdgeInvariant);
+        free(workspace.invariantTable);
+        free(workspace.invariantFrequency);
+        free(workspace.invariantTableMarks);
+        free(workspace.orientationPreservingStartingEdges);
+        free(workspace.orientationReversingStartingEdges);
+        workspace.orbit = malloc(sizeof(int)*2*e);
+        ABORT_IF_NULL(workspace.orbit);
+        workspace.flagMarks = calloc(2*e, sizeof(unsigned int));
+        ABORT_IF_NULL(workspace.flagMarks);
+        workspace.edgeInvariant = malloc(sizeof(unsigned int)*e);
+        ABORT_IF_NULL(workspace.edgeInvariant);
+        workspace.mirrorEdgeInvariant = malloc(sizeof(unsigned int)*e);
+        ABORT_IF_NULL(workspace.mirrorEdgeInvariant);
+        workspace.invariantTableSize = 1;
+        while(workspace.invariantTableSize < 2*e){
+            workspace.invariantTableSize *= 2;
+        }
+        workspace.invariantTable = malloc(sizeof(unsigned int)*workspace.invariantTableSize);
+        ABORT_IF_NULL(workspace.invariantTable);
+        workspace.invariantFrequency = malloc(sizeof(int)*workspace.invariantTableSize);
+        ABORT_IF_NULL(workspace.invariantFrequency);
+        workspace.invariantTableMarks = calloc(workspace.invariantTableSize, sizeof(unsigned int));
+        ABORT_IF_NULL(workspace.invariantTableMarks);
+        workspace.invariantTableMarkValue = 0;
+        workspace.orientationPreservingStartingEdges = malloc(sizeof(PG_EDGE*)*e);
+        ABORT_IF_NULL(workspace.orientationPreservingStartingEdges);
+        workspace.orientationReversingStartingEdges = malloc(sizeof(PG_EDGE*)*e);
+        ABORT_IF_NULL(workspace.orientationReversingStartingEdges);
+        workspace.flagMarkValue = 0;
+        workspace.edgeCapacity = e;
+    }
+
+    if(n + e > workspace.certificateCapacity){
+        free(workspace.certificate);
+        workspace.certificate = malloc(sizeof(int)*(n + e));
+        ABORT_IF_NULL(workspace.certificate);
+        workspace.certificateCapacity = n + e;
+    }
 }
 
-PG_AUTOMORPHISM_GROUP *allocateAutomorphismGroup(PLANE_GRAPH *pg){
-    int i;
-    
-    PG_AUTOMORPHISM_GROUP *aut = (PG_AUTOMORPHISM_GROUP *)malloc(sizeof(PG_AUTOMORPHISM_GROUP));
-    
-    aut->automorphisms = (int **)malloc(sizeof(int *)*(pg->ne)*2);
-    
-    for(i = 0; i < (pg->ne)*2; i++){
-        aut->automorphisms[i] = (int *)malloc(sizeof(int)*(pg->nv));
-    }
-    
-    aut->allocatedSize = (pg->ne)*2;
+static void nextVertexMark(){
+    if(++workspace.vertexMarkValue == 0){
+        memset(workspace.vertexMarks, 0, sizeof(unsigned int)*workspace.vertexCapacity);
+        workspace.vertexMarkValue = 1;
+    }
+}
+
+static void nextFlagMark(){
+    if(++workspace.flagMarkValue == 0){
+        memset(workspace.flagMarks, 0, sizeof(unsigned int)*2*workspace.edgeCapacity);
+        workspace.flagMarkValue = 1;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void prepareAutomorphismGroup(PG_AUTOMORPHISM_GROUP *aut, PLANE_GRAPH *pg){
+    int i, maximumGeneratorCount, generatorSize;
+
+    //each generator at least doubles the order of the group, and the order
+    //is at most the number of flags
+    maximumGeneratorCount = 1;
+    while((1 << (maximumGeneratorCount - 1)) < 2*pg->ne){
+        maximumGeneratorCount++;
+    }
+    generatorSize = pg->nv + pg->ne;
+
+    if(maximumGeneratorCount > aut->allocatedGenerators){
+        free(aut->generators);
+        free(aut->generatorEdgeImages);
+        free(aut->generatorIsOrientationReversing);
+        aut->generators = malloc(sizeof(int *)*maximumGeneratorCount);
+        ABORT_IF_NULL(aut->generators);
+        aut->generatorEdgeImages = malloc(sizeof(int *)*maximumGeneratorCount);
+        ABORT_IF_NULL(aut->generatorEdgeImages);
+        aut->generatorIsOrientationReversing = malloc(sizeof(boolean)*maximumGeneratorCount);
+        ABORT_IF_NULL(aut->generatorIsOrientationReversing);
+        aut->allocatedGenerators = maximumGeneratorCount;
+    }
+    if(maximumGeneratorCount*generatorSize > aut->generatorStorageSize){
+        free(aut->generatorStorage);
+        aut->generatorStorage = malloc(sizeof(int)*maximumGeneratorCount*generatorSize);
+        ABORT_IF_NULL(aut->generatorStorage);
+        aut->generatorStorageSize = maximumGeneratorCount*generatorSize;
+    }
+    for(i = 0; i < maximumGeneratorCount; i++){
+        aut->generators[i] = aut->generatorStorage + i*generatorSize;
+        aut->generatorEdgeImages[i] = aut->generators[i] + pg->nv;
+    }
+
     aut->graph = pg;
-    
-    aut->size = 0;
-    aut->orientationPreservingCount = 0;
+    aut->generatorCount = 0;
+    aut->expanded = FALSE;
+
+    //identity
+    aut->size = 1;
+    aut->orientationPreservingCount = 1;
     aut->orientationReversingCount = 0;
-    
-    return aut;
 }
 
-void trimAutomorphismGroup(PG_AUTOMORPHISM_GROUP *aut){
-    int i;
-    
-    for(i = aut->size; i < aut->allocatedSize; i++){
-        free(aut->automorphisms[i]);
-    }
-    
-    aut->automorphisms = (int **)realloc(aut->automorphisms, sizeof(int *)*(aut->size));
-    aut->allocatedSize = aut->size;
+static PG_AUTOMORPHISM_GROUP *allocateAutomorphismGroup(){
+    PG_AUTOMORPHISM_GROUP *aut = (PG_AUTOMORPHISM_GROUP *)malloc(sizeof(PG_AUTOMORPHISM_GROUP));
+    ABORT_IF_NULL(aut);
+
+    aut->automorphisms = NULL;
+    aut->allocatedSize = 0;
+    aut->automorphismStorage = NULL;
+    aut->automorphismStorageSize = 0;
+
+    aut->generators = NULL;
+    aut->generatorEdgeImages = NULL;
+    aut->generatorIsOrientationReversing = NULL;
+    aut->allocatedGenerators = 0;
+    aut->generatorStorage = NULL;
+    aut->generatorStorageSize = 0;
+
+    aut->generatorCount = 0;
+    aut->expanded = FALSE;
+    aut->graph = NULL;
+
+    return aut;
 }
 
 void freeAutomorphismGroup(PG_AUTOMORPHISM_GROUP *aut){
-    int i;
-    
-    for(i = 0; i < aut->allocatedSize; i++){
-        free(aut->automorphisms[i]);
-    }
-    
     free(aut->automorphisms);
+    free(aut->automorphismStorage);
+    free(aut->generators);
+    free(aut->generatorEdgeImages);
+    free(aut->generatorIsOrientationReversing);
+    free(aut->generatorStorage);
     free(aut);
 }
 
-void findStartingEdges(PLANE_GRAPH *pg, PG_AUT_COMP_DATA *workspace){
-    int i, startingDegree, startingFaceSize, minimumFrequency;
-    int degreeFrequency[pg->nv];
-    int faceSizeFrequency[pg->nv];
+//////////////////////////////////////////////////////////////////////////////
+
+static unsigned int combineInvariant(unsigned int invariant, unsigned int value){
+    return (invariant ^ value) * 16777619u;
+}
+
+static unsigned int spreadInvariant(unsigned int value){
+    value = (value ^ (value >> 16)) * 0x45d9f3bu;
+    return value ^ (value >> 16);
+}
+
+/* Returns the position of the invariant in the hash table. If the invariant
+ * is not in the table yet, it is added with frequency 0.
+ */
+static int findInvariant(unsigned int invariant){
+    int mask = workspace.invariantTableSize - 1;
+    int position = spreadInvariant(invariant) & mask;
+
+    while(workspace.invariantTableMarks[position] == workspace.invariantTableMarkValue){
+        if(workspace.invariantTable[position] == invariant){
+            return position;
+        }
+        position = (position + 1) & mask;
+    }
+    workspace.invariantTableMarks[position] = workspace.invariantTableMarkValue;
+    workspace.invariantTable[position] = invariant;
+    workspace.invariantFrequency[position] = 0;
+    return position;
+}
+
+/* Only edges whose invariant occurs least often are used as starting edges.
+ * The invariant of an edge combines the degrees of its end points, the face
+ * sizes around these end points and the sizes of the faces on both sides of
+ * the edge. The mirror invariant is the invariant of the edge in the mirror
+ * image, so an orientation reversing automorphism maps the edges with a given
+ * invariant to the edges with that mirror invariant.
+ */
+static void findStartingEdges(PLANE_GRAPH *pg){
+    int i, frequency, minimumFrequency;
+    unsigned int invariant, startingInvariant;
     PG_EDGE *start, *edge;
-    
+
     for(i = 0; i < pg->nv; i++){
-        degreeFrequency[i] = faceSizeFrequency[i] = 0;
+        invariant = 0;
+        start = edge = pg->firstedge[i];
+        do {
+            invariant += spreadInvariant(pg->faceSize[edge->rightface]);
+            edge = edge->next;
+        } while (start != edge);
+        workspace.vertexInvariant[i] = combineInvariant(pg->degree[i], invariant);
     }
-    
-    workspace->startingEdgesCount = 0;
-    
-    //build the degree frequency table
-    for(i = 0; i < pg->nv; i++){
-        degreeFrequency[pg->degree[i]]++;
+
+    for(i = 0; i < pg->ne; i++){
+        edge = pg->edges + i;
+        invariant = combineInvariant(combineInvariant(2166136261u,
+                workspace.vertexInvariant[edge->start]), workspace.vertexInvariant[edge->end]);
+        workspace.edgeInvariant[i] = combineInvariant(combineInvariant(invariant,
+                pg->faceSize[edge->rightface]), pg->faceSize[edge->prev->rightface]);
+        workspace.mirrorEdgeInvariant[i] = combineInvariant(combineInvariant(invariant,
+                pg->faceSize[edge->prev->rightface]), pg->faceSize[edge->rightface]);
     }
-    
-    //find the smallest degree with the lowest frequency
-    minimumFrequency = pg->nv + 1;
-    for(i = 0; i < pg->nv; i++){
-        if(degreeFrequency[i] && degreeFrequency[i] < minimumFrequency){
-            startingDegree = i;
-            minimumFrequency = degreeFrequency[i];
-        }
+
+    if(++workspace.invariantTableMarkValue == 0){
+        memset(workspace.invariantTableMarks, 0, sizeof(unsigned int)*workspace.invariantTableSize);
+        workspace.invariantTableMarkValue = 1;
     }
-    
-    //build the frequency table of face sizes incident to a vertex with startingDegree
-    for(i = 0; i < pg->nv; i++){
-        if(pg->degree[i] == startingDegree){
-            start = edge = pg->firstedge[i];
-            
-            do {
-                faceSizeFrequency[pg->faceSize[edge->rightface]]++;
-                edge = edge->next;
-            } while (start != edge);
-        }
+    for(i = 0; i < pg->ne; i++){
+        workspace.invariantFrequency[findInvariant(workspace.edgeInvariant[i])]++;
     }
-    
-    //find the smallest face size incident with a vertex of startingDegree and with smallest frequency
+
+    //find the smallest invariant with the lowest frequency
     minimumFrequency = pg->ne + 1;
-    for(i = 0; i < pg->nv; i++){
-        if(faceSizeFrequency[i] && faceSizeFrequency[i] < minimumFrequency){
-            startingFaceSize = i;
-            minimumFrequency = faceSizeFrequency[i];
+    startingInvariant = 0;
+    for(i = 0; i < pg->ne; i++){
+        invariant = workspace.edgeInvariant[i];
+        frequency = workspace.invariantFrequency[findInvariant(invariant)];
+        if(frequency < minimumFrequency ||
+                (frequency == minimumFrequency && invariant < startingInvariant)){
+            minimumFrequency = frequency;
+            startingInvariant = invariant;
         }
     }
-    
+
     //store all starting edges
-    for(i = 0; i < pg->nv; i++){
-        if(pg->degree[i] == startingDegree){
-            start = edge = pg->firstedge[i];
-            
-            do {
-                if(pg->faceSize[edge->rightface] == startingFaceSize){
-                    workspace->orientationPreservingStartingEdges[workspace->startingEdgesCount] = edge;
-                    workspace->orientationReversingStartingEdges[workspace->startingEdgesCount] = edge->next;
-                    workspace->startingEdgesCount++;
-                }
-                edge = edge->next;
-            } while (start != edge);
+    workspace.orientationPreservingStartingEdgesCount = 0;
+    workspace.orientationReversingStartingEdgesCount = 0;
+    for(i = 0; i < pg->ne; i++){
+        if(workspace.edgeInvariant[i] == startingInvariant){
+            workspace.orientationPreservingStartingEdges
+                    [workspace.orientationPreservingStartingEdgesCount++] = pg->edges + i;
+        }
+        if(workspace.mirrorEdgeInvariant[i] == startingInvariant){
+            workspace.orientationReversingStartingEdges
+                    [workspace.orientationReversingStartingEdgesCount++] = pg->edges + i;
         }
     }
 }
 
-void constructCertificate(PLANE_GRAPH *pg, PG_EDGE *eStart, PG_AUT_COMP_DATA *workspace){
-    int i;
-    for(i=0; i<pg->nv; i++){
-        workspace->canonicalLabelling[i] = INT_MAX;
-    }
-    PG_EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int position = 0;
-    workspace->queue[0] = eStart->start;
-    workspace->canonicalFirstEdge[eStart->start] = eStart;
-    workspace->canonicalLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = workspace->queue[tail++];
-        e = elast = workspace->canonicalFirstEdge[currentVertex];
-        do {
-            if(workspace->canonicalLabelling[e->end]==INT_MAX){
-                workspace->queue[head++] = e->end;
-                workspace->canonicalLabelling[e->end] = vertexCounter++;
-                workspace->canonicalFirstEdge[e->end] = e->inverse;
+//////////////////////////////////////////////////////////////////////////////
+
+static void resetOrbit(PLANE_GRAPH *pg){
+    int baseFlag = FLAG(pg, workspace.canonicalStart, workspace.canonicalMirrored);
+
+    nextFlagMark();
+    workspace.flagMarks[baseFlag] = workspace.flagMarkValue;
+    workspace.orbit[0] = baseFlag;
+    workspace.orbitSize = 1;
+}
+
+/* Adds the images of the flags in the orbit under all generators until the
+ * orbit is closed.
+ */
+static void closeOrbit(PG_AUTOMORPHISM_GROUP *aut){
+    int i, j, flag, image;
+
+    for(i = 0; i < workspace.orbitSize; i++){
+        flag = workspace.orbit[i];
+        for(j = 0; j < aut->generatorCount; j++){
+            image = 2*aut->generatorEdgeImages[j][flag/2] +
+                    ((flag & 1) ^ aut->generatorIsOrientationReversing[j]);
+            if(workspace.flagMarks[image] != workspace.flagMarkValue){
+                workspace.flagMarks[image] = workspace.flagMarkValue;
+                workspace.orbit[workspace.orbitSize++] = image;
             }
-            workspace->certificate[position++] = workspace->canonicalLabelling[e->end];
-            e = e->next;
-        } while (e!=elast);
-        workspace->certificate[position++] = INT_MAX;
-    }
-    for(i = 0; i < pg->nv; i++){
-        workspace->reverseCanonicalLabelling[workspace->canonicalLabelling[i]] = i;
+        }
     }
 }
 
-void constructCertificateOrientationReversed(PLANE_GRAPH *pg, PG_EDGE *eStart, PG_AUT_COMP_DATA *workspace){
+static void constructCertificate(PLANE_GRAPH *pg, PG_EDGE *eStart, boolean mirrored){
     int i;
-    for(i=0; i<pg->nv; i++){
-        workspace->canonicalLabelling[i] = INT_MAX;
-    }
     PG_EDGE *e, *elast;
     int head = 1;
     int tail = 0;
     int vertexCounter = 1;
     int position = 0;
-    workspace->queue[0] = eStart->start;
-    workspace->canonicalFirstEdge[eStart->start] = eStart;
-    workspace->canonicalLabelling[eStart->start] = 0;
+    nextVertexMark();
+    workspace.queue[0] = eStart->start;
+    workspace.canonicalFirstEdge[eStart->start] = eStart;
+    workspace.canonicalLabelling[eStart->start] = 0;
+    workspace.vertexMarks[eStart->start] = workspace.vertexMarkValue;
     while(head>tail){
-        int currentVertex = workspace->queue[tail++];
-        e = elast = workspace->canonicalFirstEdge[currentVertex];
+        int currentVertex = workspace.queue[tail++];
+        e = elast = workspace.canonicalFirstEdge[currentVertex];
         do {
-            if(workspace->canonicalLabelling[e->end]==INT_MAX){
-                workspace->queue[head++] = e->end;
-                workspace->canonicalLabelling[e->end] = vertexCounter++;
-                workspace->canonicalFirstEdge[e->end] = e->inverse;
+            if(workspace.vertexMarks[e->end] != workspace.vertexMarkValue){
+                workspace.vertexMarks[e->end] = workspace.vertexMarkValue;
+                workspace.queue[head++] = e->end;
+                workspace.canonicalLabelling[e->end] = vertexCounter++;
+                workspace.canonicalFirstEdge[e->end] = e->inverse;
             }
-            workspace->certificate[position++] = workspace->canonicalLabelling[e->end];
-            e = e->prev;
+            workspace.certificate[position++] = workspace.canonicalLabelling[e->end];
+            e = mirrored ? e->prev : e->next;
         } while (e!=elast);
-        workspace->certificate[position++] = INT_MAX;
+        workspace.certificate[position++] = pg->nv;
     }
     for(i = 0; i < pg->nv; i++){
-       workspace->reverseCanonicalLabelling[workspace->canonicalLabelling[i]] = i;
+        workspace.reverseCanonicalLabelling[workspace.canonicalLabelling[i]] = i;
     }
+    workspace.canonicalStart = eStart;
+    workspace.canonicalMirrored = mirrored;
 }
 
 /* returns 1 if this edge leads to a better certificate
  * returns 0 if this edge leads to the same certificate
  * returns -1 if this edge leads to a worse certificate
+ *
+ * If the certificate is better, then it is stored as the new canonical
+ * certificate while it is constructed.
  */
-int hasBetterCertificateOrientationPreserving(PLANE_GRAPH *pg, PG_EDGE *eStart, PG_AUTOMORPHISM_GROUP *autGroup, PG_AUT_COMP_DATA *workspace){
-    int i, j;
-    for(i=0; i<pg->nv; i++){
-        workspace->alternateLabelling[i] = INT_MAX;
-    }
+static int hasBetterCertificate(PLANE_GRAPH *pg, PG_EDGE *eStart, boolean mirrored){
+    int i;
     PG_EDGE *e, *elast;
     int head = 1;
     int tail = 0;
     int vertexCounter = 1;
     int currentPos = 0;
-    workspace->queue[0] = eStart->start;
-    workspace->alternateFirstEdge[eStart->start] = eStart;
-    workspace->alternateLabelling[eStart->start] = 0;
+    boolean better = FALSE;
+    nextVertexMark();
+    workspace.queue[0] = eStart->start;
+    workspace.alternateFirstEdge[eStart->start] = eStart;
+    workspace.alternateLabelling[eStart->start] = 0;
+    workspace.vertexMarks[eStart->start] = workspace.vertexMarkValue;
     while(head>tail){
-        int currentVertex = workspace->queue[tail++];
-        e = elast = workspace->alternateFirstEdge[currentVertex];
+        int currentVertex = workspace.queue[tail++];
+        e = elast = workspace.alternateFirstEdge[currentVertex];
         do {
-            if(workspace->alternateLabelling[e->end]==INT_MAX){
-                workspace->queue[head++] = e->end;
-                workspace->alternateLabelling[e->end] = vertexCounter++;
-                workspace->alternateFirstEdge[e->end] = e->inverse;
+            if(workspace.vertexMarks[e->end] != workspace.vertexMarkValue){
+                workspace.vertexMarks[e->end] = workspace.vertexMarkValue;
+                workspace.queue[head++] = e->end;
+                workspace.alternateLabelling[e->end] = vertexCounter++;
+                workspace.alternateFirstEdge[e->end] = e->inverse;
             }
-            if(workspace->alternateLabelling[e->end] < workspace->certificate[currentPos]){
-                constructCertificate(pg, eStart, workspace);
-                autGroup->size = 1;
-                autGroup->orientationPreservingCount = 1;
-                return 1;
-            } else if(workspace->alternateLabelling[e->end] > workspace->certificate[currentPos]){
+            if(better){
+                workspace.certificate[currentPos] = workspace.alternateLabelling[e->end];
+            } else if(workspace.alternateLabelling[e->end] < workspace.certificate[currentPos]){
+                better = TRUE;
+                workspace.certificate[currentPos] = workspace.alternateLabelling[e->end];
+            } else if(workspace.alternateLabelling[e->end] > workspace.certificate[currentPos]){
                 return -1;
             }
             currentPos++;
-            e = e->next;
+            e = mirrored ? e->prev : e->next;
         } while (e!=elast);
-        //INT_MAX will always be at least the value of certificate[currentPos]
-        if(INT_MAX > workspace->certificate[currentPos]){
+        //nv will always be at least the value of certificate[currentPos]
+        if(!better && pg->nv > workspace.certificate[currentPos]){
             return -1;
         }
-        currentPos++;
+        workspace.certificate[currentPos++] = pg->nv;
     }
-    for(j = 0; j < pg->nv; j++){
-        autGroup->automorphisms[autGroup->size][j] 
-                = workspace->reverseCanonicalLabelling[workspace->alternateLabelling[j]];
+
+    if(!better){
+        return 0;
     }
-    autGroup->size++;
-    autGroup->orientationPreservingCount++;
-    return 0;
-}
 
-int hasBetterCertificateOrientationReversing(PLANE_GRAPH *pg, PG_EDGE *eStart, PG_AUTOMORPHISM_GROUP *autGroup, PG_AUT_COMP_DATA *workspace){
-    int i, j;
-    for(i=0; i<pg->nv; i++){
-        workspace->alternateLabelling[i] = INT_MAX;
+    //the alternate labelling becomes the canonical labelling
+    int *labelling = workspace.canonicalLabelling;
+    workspace.canonicalLabelling = workspace.alternateLabelling;
+    workspace.alternateLabelling = labelling;
+    PG_EDGE **firstEdge = workspace.canonicalFirstEdge;
+    workspace.canonicalFirstEdge = workspace.alternateFirstEdge;
+    workspace.alternateFirstEdge = firstEdge;
+    for(i = 0; i < pg->nv; i++){
+        workspace.reverseCanonicalLabelling[workspace.canonicalLabelling[i]] = i;
     }
-    PG_EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int currentPos = 0;
-    workspace->queue[0] = eStart->start;
-    workspace->alternateFirstEdge[eStart->start] = eStart;
-    workspace->alternateLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = workspace->queue[tail++];
-        e = elast = workspace->alternateFirstEdge[currentVertex];
-        do {
-            if(workspace->alternateLabelling[e->end]==INT_MAX){
-                workspace->queue[head++] = e->end;
-                workspace->alternateLabelling[e->end] = vertexCounter++;
-                workspace->alternateFirstEdge[e->end] = e->inverse;
-            }
-            if(workspace->alternateLabelling[e->end] < workspace->certificate[currentPos]){
-                constructCertificateOrientationReversed(pg, eStart, workspace);
-                workspace->hasChiralGroup = TRUE;
-                autGroup->size = 1;
-                autGroup->orientationPreservingCount = 1;
-                autGroup->orientationReversingCount = 0;
-                return 1;
-            } else if(workspace->alternateLabelling[e->end] > workspace->certificate[currentPos]){
-                return -1;
-            }
-            currentPos++;
-            e = e->prev;
-        } while (e!=elast);
-        //INT_MAX will always be at least the value of certificate[currentPos]
-        if(INT_MAX > workspace->certificate[currentPos]){
-            return -1;
+    workspace.canonicalStart = eStart;
+    workspace.canonicalMirrored = mirrored;
+    return 1;
+}
+
+/* Stores the automorphism that maps the last alternate labelling to the
+ * canonical labelling as a new generator.
+ */
+static void storeGenerator(PLANE_GRAPH *pg, PG_AUTOMORPHISM_GROUP *aut, boolean mirrored){
+    int i, j, image;
+    PG_EDGE *e, *eImage;
+    int *vertexImages = aut->generators[aut->generatorCount];
+    int *edgeImages = aut->generatorEdgeImages[aut->generatorCount];
+
+    for(i = 0; i < pg->nv; i++){
+        image = workspace.reverseCanonicalLabelling[workspace.alternateLabelling[i]];
+        vertexImages[i] = image;
+        e = workspace.alternateFirstEdge[i];
+        eImage = workspace.canonicalFirstEdge[image];
+        for(j = 0; j < pg->degree[i]; j++){
+            edgeImages[e - pg->edges] = eImage - pg->edges;
+            e = mirrored ? e->prev : e->next;
+            eImage = workspace.canonicalMirrored ? eImage->prev : eImage->next;
         }
-        currentPos++;
     }
-    for(j = 0; j < pg->nv; j++){
-        autGroup->automorphisms[autGroup->size][j] 
-                = workspace->reverseCanonicalLabelling[workspace->alternateLabelling[j]];
+    aut->generatorIsOrientationReversing[aut->generatorCount] =
+            (mirrored != workspace.canonicalMirrored);
+    aut->generatorCount++;
+
+    closeOrbit(aut);
+}
+
+static void handleStartingEdge(PLANE_GRAPH *pg, PG_EDGE *eStart, boolean mirrored, PG_AUTOMORPHISM_GROUP *aut){
+    if(workspace.flagMarks[FLAG(pg, eStart, mirrored)] != workspace.flagMarkValue){
+        int result = hasBetterCertificate(pg, eStart, mirrored);
+        if(result == 1){
+            aut->size = 1;
+            aut->orientationPreservingCount = 1;
+            aut->orientationReversingCount = 0;
+            aut->generatorCount = 0;
+            resetOrbit(pg);
+            return;
+        } else if(result == -1){
+            return;
+        }
+        storeGenerator(pg, aut, mirrored);
     }
-    if(workspace->hasChiralGroup){
-        autGroup->orientationPreservingCount++;
+    //if the flag is in the orbit, then it is the image of the canonical
+    //starting flag under an automorphism that is already known, so
+    //there is no need to compare the certificates
+    if(mirrored != workspace.canonicalMirrored){
+        aut->orientationReversingCount++;
     } else {
-        autGroup->orientationReversingCount++;
+        aut->orientationPreservingCount++;
     }
-    autGroup->size++;
-    return 0;
+    aut->size++;
 }
 
-PG_AUTOMORPHISM_GROUP *determineAutomorphisms(PLANE_GRAPH *pg){
+PG_AUTOMORPHISM_GROUP *determineAutomorphismsReusing(PLANE_GRAPH *pg, PG_AUTOMORPHISM_GROUP *aut){
     int i;
-    
-    PG_AUTOMORPHISM_GROUP *aut = allocateAutomorphismGroup(pg);
-    
-    //identity
-    for(i = 0; i < pg->nv; i++){
-        aut->automorphisms[0][i] = i;
+
+    if(aut == NULL){
+        aut = allocateAutomorphismGroup();
     }
-    
-    aut->size = 1;
-    aut->orientationPreservingCount = 1;
-    aut->orientationReversingCount = 0;
-    
-    PG_AUT_COMP_DATA *workspace = getAutomorphismComputationWorkspace(pg);
-    workspace->hasChiralGroup = FALSE;
-    
+    prepareAutomorphismGroup(aut, pg);
+
+    if(pg->ne == 0){
+        //only the identity
+        return aut;
+    }
+
+    if(!pg->dualComputed){
+        makeDual(pg);
+    }
+    ensureWorkspaceSize(pg);
+
     //find starting edges
-    findStartingEdges(pg, workspace);
-    
+    findStartingEdges(pg);
+
     //construct initial certificate
-    constructCertificate(pg, workspace->orientationPreservingStartingEdges[0], workspace);
-    
+    constructCertificate(pg, workspace.orientationPreservingStartingEdges[0], FALSE);
+    resetOrbit(pg);
+
     //look for better automorphism
-    for(i = 1; i < workspace->startingEdgesCount; i++){
-        int result = hasBetterCertificateOrientationPreserving(pg,
-                                workspace->orientationPreservingStartingEdges[i],
-                                aut, workspace);
-        //if result == 1, then the counts are already reset and the new certificate is stored
-        //if result == 0, then the automorphism is already stored
-    }
-    for(i = 0; i < workspace->startingEdgesCount; i++){
-        int result = hasBetterCertificateOrientationReversing(pg,
-                                workspace->orientationReversingStartingEdges[i],
-                                aut, workspace);
-        //if result == 1, then the counts are already reset and the new certificate is stored
-        //if result == 0, then the automorphism is already stored
-    }
-    
+    for(i = 1; i < workspace.orientationPreservingStartingEdgesCount; i++){
+        handleStartingEdge(pg, workspace.orientationPreservingStartingEdges[i], FALSE, aut);
+    }
+    for(i = 0; i < workspace.orientationReversingStartingEdgesCount; i++){
+        handleStartingEdge(pg, workspace.orientationReversingStartingEdges[i], TRUE, aut);
+    }
+
     return aut;
-}
\ No newline at end of file
+}
+
+PG_AUTOMORPHISM_GROUP *determineAutomorphisms(PLANE_GRAPH *pg){
+    return determineAutomorphismsReusing(pg, NULL);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void expandAutomorphismGroup(PG_AUTOMORPHISM_GROUP *aut){
+    int i, j, k, flag, image, flagCount, preservingPosition, reversingPosition;
+    PLANE_GRAPH *pg = aut->graph;
+
+    if(aut->expanded){
+        return;
+    }
+
+    if(aut->size > aut->allocatedSize){
+        free(aut->automorphisms);
+        aut->automorphisms = malloc(sizeof(int *)*aut->size);
+        ABORT_IF_NULL(aut->automorphisms);
+        aut->allocatedSize = aut->size;
+    }
+    if(aut->size*pg->nv > aut->automorphismStorageSize){
+        free(aut->automorphismStorage);
+        aut->automorphismStorage = malloc(sizeof(int)*aut->size*pg->nv);
+        ABORT_IF_NULL(aut->automorphismStorage);
+        aut->automorphismStorageSize = aut->size*pg->nv;
+    }
+
+    //identity
+    aut->automorphisms[0] = aut->automorphismStorage;
+    for(i = 0; i < pg->nv; i++){
+        aut->automorphisms[0][i] = i;
+    }
+
+    if(aut->generatorCount == 0){
+        aut->expanded = TRUE;
+        return;
+    }
+
+    //the group acts regularly on the orbit of a flag, so each automorphism
+    //corresponds to one flag in the orbit of the flag 0 (which is mapped to
+    //itself by the identity)
+    int *flags = malloc(sizeof(int)*2*pg->ne);
+    ABORT_IF_NULL(flags);
+    int *flagAutomorphism = malloc(sizeof(int)*2*pg->ne);
+    ABORT_IF_NULL(flagAutomorphism);
+    for(i = 0; i < 2*pg->ne; i++){
+        flagAutomorphism[i] = -1;
+    }
+    flags[0] = 0;
+    flagAutomorphism[0] = 0;
+    flagCount = 1;
+    preservingPosition = 1;
+    reversingPosition = aut->orientationPreservingCount;
+    for(i = 0; i < flagCount; i++){
+        flag = flags[i];
+        for(j = 0; j < aut->generatorCount; j++){
+            image = 2*aut->generatorEdgeImages[j][flag/2] +
+                    ((flag & 1) ^ aut->generatorIsOrientationReversing[j]);
+            if(flagAutomorphism[image] == -1){
+                //the new automorphism is the generator applied after
+                //the automorphism of flag
+                int position = (image & 1) ? reversingPosition++ : preservingPosition++;
+                if(preservingPosition > aut->orientationPreservingCount || reversingPosition > aut->size){
+                    fprintf(stderr, "Generators do not match the order of the automorphism group -- exiting!\n");
+                    exit(EXIT_FAILURE);
+                }
+                int *source = aut->automorphisms[flagAutomorphism[flag]];
+                int *target = aut->automorphismStorage + position*pg->nv;
+                for(k = 0; k < pg->nv; k++){
+                    target[k] = aut->generators[j][source[k]];
+                }
+                aut->automorphisms[position] = target;
+                flagAutomorphism[image] = position;
+                flags[flagCount++] = image;
+            }
+        }
+    }
+    free(flags);
+    free(flagAutomorphism);
+
+    aut->expanded = TRUE;
+}
@@ -1,4 +1,4 @@
-/* 
+/*
  * File:   planar_automorphismgroup.h
  * Author: nvcleemp
  *
@@ -13,18 +13,51 @@
 typedef struct __pg_automorphism_group PG_AUTOMORPHISM_GROUP;
 
 struct __pg_automorphism_group {
+    //all automorphisms: the identity first, then the other orientation
+    //preserving automorphisms and finally the orientation reversing ones
+    //NOTE: only valid if expandAutomorphismGroup() called
     int **automorphisms;
     int size;
     int orientationPreservingCount;
     int orientationReversingCount;
-    
+
+    //a set of generators of the group: for each generator the image of
+    //each vertex and the index of the image of each edge
+    int **generators;
+    int **generatorEdgeImages;
+    boolean *generatorIsOrientationReversing;
+    int generatorCount;
+
     PLANE_GRAPH *graph;
-    
+
+    boolean expanded;
+
     int allocatedSize;
+    int allocatedGenerators;
+    int *automorphismStorage;
+    int automorphismStorageSize;
+    int *generatorStorage;
+    int generatorStorageSize;
 };
 
+/* Determines the automorphism group of pg. Only a set of generators is
+ * stored; call expandAutomorphismGroup() if the individual automorphisms
+ * are needed. The dual of pg is computed if this was not done yet.
+ */
 PG_AUTOMORPHISM_GROUP *determineAutomorphisms(PLANE_GRAPH *pg);
 
+/* Determines the automorphism group of pg and stores it in aut, which is
+ * grown when needed. If aut is NULL, a new group is created. Reusing the
+ * same group for all graphs in a file avoids allocating memory for each
+ * graph.
+ */
+PG_AUTOMORPHISM_GROUP *determineAutomorphismsReusing(PLANE_GRAPH *pg, PG_AUTOMORPHISM_GROUP *aut);
+
+/* Computes all elements of the group from the generators and stores them
+ * in aut->automorphisms. Does nothing if this was already done.
+ */
+void expandAutomorphismGroup(PG_AUTOMORPHISM_GROUP *aut);
+
 void freeAutomorphismGroup(PG_AUTOMORPHISM_GROUP *aut);
 
 
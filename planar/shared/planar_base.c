@@ -9,76 +9,112 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-PLANE_GRAPH *newPlaneGraph(int maxn, int maxe) {
-    if(maxn <= 0){
-        fprintf(stderr, "maxn should be a positive integer -- exiting!\n");
-        return NULL;
-    }
+/* The maximum number of oriented edges in a simple plane graph with the given
+ * number of vertices.
+ */
+static int maximumEdgeCount(int maxn){
+    return maxn < 3 ? 2*(maxn - 1) : 6*maxn - 12;
+}
+
+/* The maximum number of faces in a simple plane graph with the given number
+ * of vertices.
+ */
+static int maximumFaceCount(int maxn){
+    return maxn < 3 ? 1 : 2*maxn - 4;
+}
+
+/* The edges, the vertex arrays and the face arrays of a plane graph are
+ * stored in one block of memory, which starts with the edges. The arrays of
+ * pg are only replaced if the new block could be allocated.
+ */
+static boolean allocateArena(PLANE_GRAPH *pg, int maxn, int maxe, int maxf){
+    char *arena = (char *)malloc(sizeof(PG_EDGE)*maxe 
+            + (sizeof(PG_EDGE *) + sizeof(int))*(maxn + maxf));
     
-    if(maxe <= 0 || maxe > (6*maxn-12)){
-        maxe = 6*maxn-12;
+    if(arena == NULL){
+        return FALSE;
     }
     
-    PLANE_GRAPH *pg = (PLANE_GRAPH *)malloc(sizeof(PLANE_GRAPH));
+    free(pg->edges);
     
-    if(pg == NULL){
-        fprintf(stderr, "Insufficient memory for plane_graph -- exiting!\n");
-        return NULL;
-    }
+    pg->edges = (PG_EDGE *)arena;
+    arena += sizeof(PG_EDGE)*maxe;
+    pg->firstedge = (PG_EDGE **)arena;
+    arena += sizeof(PG_EDGE *)*maxn;
+    pg->facestart = (PG_EDGE **)arena;
+    arena += sizeof(PG_EDGE *)*maxf;
+    pg->degree = (int *)arena;
+    arena += sizeof(int)*maxn;
+    pg->faceSize = (int *)arena;
     
     pg->maxn = maxn;
     pg->maxe = maxe;
+    pg->maxf = maxf;
     
     pg->nv = pg->ne = pg->nf = 0;
+    pg->dualComputed = FALSE;
     
-    pg->edges = (PG_EDGE *)malloc(sizeof(PG_EDGE)*maxe);
+    //the marks of the new edges are cleared by the next RESETMARKS
+    pg->markvalue = 30000;
     
-    if(pg->edges == NULL){
-        fprintf(stderr, "Insufficient memory for edges -- exiting!\n");
-        free(pg);
+    return TRUE;
+}
+
+static PLANE_GRAPH *newPlaneGraphWithFaces(int maxn, int maxe, int maxf) {
+    PLANE_GRAPH *pg = (PLANE_GRAPH *)malloc(sizeof(PLANE_GRAPH));
+    
+    if(pg == NULL){
+        fprintf(stderr, "Insufficient memory for plane_graph -- exiting!\n");
         return NULL;
     }
     
-    pg->firstedge = (PG_EDGE **)malloc(sizeof(PG_EDGE *)*maxn);
-    
-    if(pg->firstedge == NULL){
-        fprintf(stderr, "Insufficient memory for firstedges -- exiting!\n");
-        free(pg->edges);
+    pg->edges = NULL;
+    if(!allocateArena(pg, maxn, maxe, maxf)){
+        fprintf(stderr, "Insufficient memory for edges, vertices and faces -- exiting!\n");
         free(pg);
         return NULL;
     }
     
-    pg->degree = (int *)malloc(sizeof(int)*maxn);
-    
-    if(pg->degree == NULL){
-        fprintf(stderr, "Insufficient memory for degrees -- exiting!\n");
-        free(pg->degree);
-        free(pg->edges);
-        free(pg);
+    return pg;
+}
+
+PLANE_GRAPH *newPlaneGraph(int maxn, int maxe) {
+    if(maxn <= 0){
+        fprintf(stderr, "maxn should be a positive integer -- exiting!\n");
         return NULL;
     }
     
-    //by default the dual is not yet initialised
-    pg->maxf = 0;
-    pg->facestart = NULL;
-    pg->faceSize = NULL;
-    pg->dualComputed = FALSE;
-    pg->markvalue = 30000;
+    if(maxe <= 0 || maxe > maximumEdgeCount(maxn)){
+        maxe = maximumEdgeCount(maxn);
+    }
     
-    return pg;
+    return newPlaneGraphWithFaces(maxn, maxe, maximumFaceCount(maxn));
 }
 
-void freePlaneGraph(PLANE_GRAPH *pg){
-    if(pg->facestart != NULL){
-        free(pg->facestart);
+boolean ensurePlaneGraphCapacity(PLANE_GRAPH *pg, int maxn, int maxe){
+    if(maxe <= 0 || maxe > maximumEdgeCount(maxn)){
+        maxe = maximumEdgeCount(maxn);
     }
     
-    if(pg->faceSize != NULL){
-        free(pg->faceSize);
+    if(maxn <= pg->maxn && maxe <= pg->maxe){
+        return TRUE;
     }
     
-    free(pg->degree);
-    free(pg->firstedge);
+    if(maxn < pg->maxn){
+        maxn = pg->maxn;
+    }
+    if(maxe < pg->maxe){
+        maxe = pg->maxe;
+    }
+    int maxf = maximumFaceCount(maxn);
+    if(maxf < pg->maxf){
+        maxf = pg->maxf;
+    }
+    
+    return allocateArena(pg, maxn, maxe, maxf);
+}
+
+void freePlaneGraph(PLANE_GRAPH *pg){
     free(pg->edges);
     free(pg);
 }
@@ -108,39 +144,20 @@ void makeDual(PLANE_GRAPH *pg) {
 
     RESETMARKS(pg);
     
-    //first allocate the memory to store faces if this has not yet been done
-    int maxf = 2*pg->maxn - 4;
-    if(pg->maxf < maxf){
-        if(pg->facestart!=NULL){
-            free(pg->facestart);
-        }
-        if(pg->faceSize!=NULL){
-            free(pg->faceSize);
-        }
-        pg->maxf = maxf;
-        
-        pg->facestart = (PG_EDGE **)malloc(sizeof(PG_EDGE *)*maxf);
-        
-        if(pg->facestart == NULL){
-            pg->maxf = 0;
-            return;
-        }
-        
-        pg->faceSize = (int *)malloc(sizeof(int)*maxf);
-        
-        if(pg->faceSize == NULL){
-            pg->maxf = 0;
-            free(pg->facestart);
-            return;
-        }
-    }
-
     int nf = 0;
     for (i = 0; i < pg->nv; ++i) {
 
         e = ex = pg->firstedge[i];
+        if (e == NULL) {
+            //isolated vertex
+            continue;
+        }
         do {
             if (!ISMARKEDLO(pg, e)) {
+                if (nf == pg->maxf) {
+                    fprintf(stderr, "Too many faces for plane graph (%d) -- exiting!\n", pg->maxf);
+                    exit(EXIT_FAILURE);
+                }
                 pg->facestart[nf] = ef = efx = e;
                 sz = 0;
                 do {
@@ -174,7 +191,9 @@ PLANE_GRAPH *getDualGraph(PLANE_GRAPH *pg){
         makeDual(pg);
     }
     
-    PLANE_GRAPH *dual = newPlaneGraph(pg->nf, pg->ne);
+    //the dual can have parallel edges, so the bounds for simple plane graphs
+    //do not apply
+    PLANE_GRAPH *dual = newPlaneGraphWithFaces(pg->nf, pg->ne, pg->nv);
     
     if(dual==NULL){
         fprintf(stderr, "Insufficient memory to create dual.\n");
@@ -204,23 +223,6 @@ PLANE_GRAPH *getDualGraph(PLANE_GRAPH *pg){
         dual->firstedge[i] = dual->edges + pg->facestart[i]->index;
     }
     
-    dual->maxf = pg->nv;
-    
-    dual->facestart = (PG_EDGE **)malloc(sizeof(PG_EDGE *)*(dual->maxf));
-        
-    if(dual->facestart == NULL){
-        dual->maxf = 0;
-        return dual;
-    }
-
-    dual->faceSize = (int *)malloc(sizeof(int)*(dual->maxf));
-
-    if(dual->faceSize == NULL){
-        dual->maxf = 0;
-        free(dual->facestart);
-        return dual;
-    }
-    
     for(i = 0; i < pg->nv; i++){
         dual->faceSize[i] = pg->degree[i];
         dual->facestart[i] = dual->edges + pg->firstedge[i]->inverse->index;
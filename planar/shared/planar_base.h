@@ -49,6 +49,8 @@ struct __plane_graph {
     int maxf;
     
     //an array containing all edges of this graph
+    //NOTE: all arrays of the graph are stored in one block of memory that
+    //starts with this array
     PG_EDGE *edges;
     
     //an array containing for each vertex a pointer to an edge leaving that vertex
@@ -91,6 +93,17 @@ struct __plane_graph {
  */
 PLANE_GRAPH *newPlaneGraph(int maxn, int maxe);
 
+/**
+ * Makes sure that pg can hold plane graphs with up to maxn vertices and maxe
+ * oriented edges. If maxe is zero, then the theoretical maximum for maxn is
+ * used. The memory of pg only grows, and when it grows the graph stored in pg
+ * is lost.
+ * 
+ * Returns FALSE if insufficient memory was available. In that case pg is
+ * not changed.
+ */
+boolean ensurePlaneGraphCapacity(PLANE_GRAPH *pg, int maxn, int maxe);
+
 void freePlaneGraph(PLANE_GRAPH *pg);
 
 void makeDual(PLANE_GRAPH *pg);
@@ -1,241 +1,287 @@
 /*
  * Main developer: Nico Van Cleemput
- * 
+ *
  * Copyright (C) 2013 Nico Van Cleemput.
  * Licensed under the GNU GPL, read the file LICENSE.txt for details.
  */
 
 #include "planar_input.h"
+#include "../../multicode/shared/multicode_scanner.h"
 #include <stdlib.h>
-#include <string.h>
 
-PLANE_GRAPH *decodePlanarCode(unsigned short* code, PG_INPUT_OPTIONS *options) {
-    int i, j, codePosition, nv, maxn;
+#define MAX_STREAM_COUNT 16
+
+/* Scratch arrays used to pair the inverse edges. They only grow, so decoding
+ * a graph does not allocate memory unless the graph is larger than all
+ * graphs that were decoded before.
+ *
+ * While a graph is decoded, pendingEdges[v] is the start of a list of the
+ * edges from smaller vertices to v. The edges in this list are chained by
+ * their inverse field, and the edges from the same vertex are consecutive in
+ * this list, the last one in the code first. edgeFrom[u] is the next unpaired
+ * edge from u to the current vertex.
+ *
+ * Parallel edges are paired in reverse order: the first edge from v to u in
+ * the code of v is the inverse of the last edge from u to v in the code of u.
+ * This is the pairing that makes a set of consecutive parallel edges, such as
+ * in the dual of a triangle, plane.
+ */
+static PG_EDGE **pendingEdges = NULL;
+static PG_EDGE **edgeFrom = NULL;
+static int scratchSize = 0;
+
+static void ensureScratchSize(int nv){
+    if(nv <= scratchSize){
+        return;
+    }
+    free(pendingEdges);
+    free(edgeFrom);
+    pendingEdges = (PG_EDGE **)malloc(sizeof(PG_EDGE *)*nv);
+    edgeFrom = (PG_EDGE **)malloc(sizeof(PG_EDGE *)*nv);
+    if(pendingEdges == NULL || edgeFrom == NULL){
+        fprintf(stderr, "Insufficient memory to decode graph -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    scratchSize = nv;
+}
+
+static void missingInverse(int vertex){
+    fprintf(stderr, "error while looking for the inverse edges at vertex %d.\n", vertex);
+    exit(EXIT_FAILURE);
+}
+
+void decodePlanarCodeInto(unsigned short* code, PLANE_GRAPH *pg) {
+    int i, j, codePosition, nv, neighbour, smallerNeighbours;
     int edgeCounter = 0;
-    PG_EDGE *inverse;
+    PG_EDGE *e, *inverse;
 
     nv = code[0];
-    codePosition = 1;
-    
-    if(options->maxn <= 0){
-        maxn = nv*options->maxnFactor;
-    } else {
-        maxn = options->maxn;
+    if (nv > pg->maxn) {
+        fprintf(stderr, "Constant N too small %d > %d \n", nv, pg->maxn);
+        exit(EXIT_FAILURE);
     }
-    
-    PLANE_GRAPH *pg = newPlaneGraph(maxn, options->maxe);
+    ensureScratchSize(nv);
+
     pg->nv = nv;
+    pg->nf = 0;
+    pg->dualComputed = FALSE;
 
     for (i = 0; i < nv; i++) {
-        pg->degree[i] = 0;
-        pg->firstedge[i] = pg->edges + edgeCounter;
-        pg->edges[edgeCounter].start = i;
-        pg->edges[edgeCounter].end = code[codePosition] - 1;
-        pg->edges[edgeCounter].next = pg->edges + edgeCounter + 1;
-        if (code[codePosition] - 1 < i) {
-            inverse = findEdge(pg, code[codePosition] - 1, i);
-            pg->edges[edgeCounter].inverse = inverse;
-            inverse->inverse = pg->edges + edgeCounter;
-        } else {
-            pg->edges[edgeCounter].inverse = NULL;
+        pendingEdges[i] = NULL;
+        edgeFrom[i] = NULL;
+    }
+
+    codePosition = 1;
+    for (i = 0; i < nv; i++) {
+        smallerNeighbours = 0;
+        for (e = pendingEdges[i]; e != NULL; e = e->inverse) {
+            if (edgeFrom[e->start] == NULL) {
+                edgeFrom[e->start] = e;
+            }
+            smallerNeighbours++;
         }
-        edgeCounter++;
-        codePosition++;
-        for (j = 1; code[codePosition]; j++, codePosition++) {
-            pg->edges[edgeCounter].start = i;
-            pg->edges[edgeCounter].end = code[codePosition] - 1;
-            pg->edges[edgeCounter].prev = pg->edges + edgeCounter - 1;
-            pg->edges[edgeCounter].next = pg->edges + edgeCounter + 1;
-            if (code[codePosition] - 1 < i) {
-                inverse = findEdge(pg, code[codePosition] - 1, i);
-                pg->edges[edgeCounter].inverse = inverse;
-                inverse->inverse = pg->edges + edgeCounter;
+
+        pg->firstedge[i] = pg->edges + edgeCounter;
+        for (j = 0; code[codePosition]; j++, codePosition++) {
+            if (edgeCounter == pg->maxe) {
+                fprintf(stderr, "Too many edges for plane graph (%d) -- exiting!\n", pg->maxe);
+                exit(EXIT_FAILURE);
+            }
+            neighbour = code[codePosition] - 1;
+            if (neighbour >= nv) {
+                fprintf(stderr, "Illegal vertex %d in code -- exiting!\n", neighbour + 1);
+                exit(EXIT_FAILURE);
+            }
+            e = pg->edges + edgeCounter;
+            e->start = i;
+            e->end = neighbour;
+            e->prev = e - 1;
+            e->next = e + 1;
+            if (neighbour < i) {
+                inverse = edgeFrom[neighbour];
+                if (inverse == NULL || inverse->end != i) {
+                    missingInverse(i);
+                }
+                //the next edge in the list is the next parallel edge, if any
+                if (inverse->inverse != NULL && inverse->inverse->start == neighbour) {
+                    edgeFrom[neighbour] = inverse->inverse;
+                } else {
+                    edgeFrom[neighbour] = NULL;
+                }
+                e->inverse = inverse;
+                inverse->inverse = e;
+                smallerNeighbours--;
+            } else if (neighbour > i) {
+                e->inverse = pendingEdges[neighbour];
+                pendingEdges[neighbour] = e;
             } else {
-                pg->edges[edgeCounter].inverse = NULL;
+                e->inverse = NULL;
             }
             edgeCounter++;
         }
-        pg->firstedge[i]->prev = pg->edges + edgeCounter - 1;
-        pg->edges[edgeCounter - 1].next = pg->firstedge[i];
+        if (smallerNeighbours) {
+            missingInverse(i);
+        }
+
+        if (j) {
+            pg->firstedge[i]->prev = pg->edges + edgeCounter - 1;
+            pg->edges[edgeCounter - 1].next = pg->firstedge[i];
+        } else {
+            pg->firstedge[i] = NULL;
+        }
         pg->degree[i] = j;
 
         codePosition++; /* read the closing 0 */
     }
 
     pg->ne = edgeCounter;
+}
+
+static int getRequiredMaxn(unsigned short* code, PG_INPUT_OPTIONS *options) {
+    int maxn;
+
+    if(options->maxn <= 0){
+        maxn = code[0]*options->maxnFactor;
+    } else {
+        maxn = options->maxn;
+    }
+
+    return maxn > 0 ? maxn : 1;
+}
+
+PLANE_GRAPH *decodePlanarCode(unsigned short* code, PG_INPUT_OPTIONS *options) {
+    PLANE_GRAPH *pg = newPlaneGraph(getRequiredMaxn(code, options), options->maxe);
+    if(pg == NULL){
+        return NULL;
+    }
+
+    decodePlanarCodeInto(code, pg);
 
     if(options->computeDual){
         makeDual(pg);
     }
-    
+
     return pg;
 }
 
-/**
- * 
- * @param code
- * @param length
- * @param file
- * @return returns 1 if a code was read and 0 otherwise. Exits in case of error.
- */
-unsigned short *readPlanarCode(FILE *file, PG_INPUT_OPTIONS *options) {
-    static boolean first = TRUE;
-    unsigned char c;
-    char testheader[20];
-    int bufferSize, zeroCounter;
-    
-    int readCount;
-    
-    int codeLength = options->initialCodeLength;
-    unsigned short* code = malloc(codeLength*sizeof(unsigned short));
-    if(code == NULL){
-        fprintf(stderr, "Insufficient memory to store code for this graph.\n");
+PLANE_GRAPH *decodePlanarCodeReusing(unsigned short* code, PLANE_GRAPH *pg, PG_INPUT_OPTIONS *options) {
+    if(pg == NULL){
+        return decodePlanarCode(code, options);
+    }
+
+    if(!ensurePlaneGraphCapacity(pg, getRequiredMaxn(code, options), options->maxe)){
+        fprintf(stderr, "Insufficient memory for plane graph with %d vertices.\n", code[0]);
         return NULL;
     }
 
-    if (first) {
-        first = FALSE;
-        
-        if(options->containsHeader){
-            //we check that there is a header
-            if (fread(&testheader, sizeof (unsigned char), 13, file) != 13) {
-                fprintf(stderr, "can't read header: file too small.\n");
-                free(code);
-                return NULL;
-            }
-            testheader[13] = 0;
-            if (strcmp(testheader, ">>planar_code") != 0) {
-                fprintf(stderr, "No planarcode header detected.\n");
-                free(code);
-                return NULL;
-            }
+    decodePlanarCodeInto(code, pg);
 
-            //read reminder of header (either empty or le/be specification)
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                fprintf(stderr, "Invalid formatted header.\n");
-                free(code);
-                return NULL;
-            }
-            while (c!='<'){
-                if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                    fprintf(stderr, "Invalid formatted header.\n");
-                    free(code);
-                    return NULL;
-                }
-            }
-            //read one more character (header is closed by <<)
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                fprintf(stderr, "Invalid formatted header.\n");
-                free(code);
-                return NULL;
-            }
-        }
+    if(options->computeDual){
+        makeDual(pg);
     }
 
-    /* possibly removing interior headers */
-    if(options->removeInternalHeaders){
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            //nothing left in file
-            return NULL;
-        }
+    return pg;
+}
 
-        if (c == '>') {
-            // could be a header, or maybe just a 62 (which is also possible for unsigned char
-            code[0] = c;
-            bufferSize = 1;
-            zeroCounter = 0;
-            code[1] = (unsigned short) getc(file);
-            if (code[1] == 0) zeroCounter++;
-            code[2] = (unsigned short) getc(file);
-            if (code[2] == 0) zeroCounter++;
-            bufferSize = 3;
-            // 3 characters were read and stored in buffer
-            if ((code[1] == '>') && (code[2] == 'p')) /*we are sure that we're dealing with a header*/ {
-                while ((c = getc(file)) != '<');
-                /* read 2 more characters: */
-                c = getc(file);
-                if (c != '<') {
-                    fprintf(stderr, "Problems with header -- single '<'\n");
-                    free(code);
-                    return NULL;
-                }
-                if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                    //nothing left in file
-                    code[0] = 0;
-                    return code;
-                }
-                bufferSize = 1;
-                zeroCounter = 0;
-            }
-        } else {
-            //no header present
-            bufferSize = 1;
-            zeroCounter = 0;
+/* Each stream that is read gets its own code scanner. Scanners are never
+ * freed, because the reader cannot know whether the caller is done with a
+ * stream.
+ */
+typedef struct {
+    FILE *file;
+    CODE_SCANNER *scanner;
+} STREAM_SCANNER;
+
+static STREAM_SCANNER streamScanners[MAX_STREAM_COUNT];
+static int streamScannerCount = 0;
+
+static CODE_SCANNER *getStreamScanner(FILE *file) {
+    int i;
+
+    for (i = 0; i < streamScannerCount; i++) {
+        if (streamScanners[i].file == file) {
+            return streamScanners[i].scanner;
         }
     }
 
-    //start reading the graph
-    if (c != 0) {
-        code[0] = c;
-        while (zeroCounter < code[0]) {
-            if(bufferSize==codeLength){
-                codeLength = (2*codeLength < (7*code[0] - 9)) ? 2*codeLength : (7*code[0] - 9);
-                // 7*code[0]-9 is the maximum code length for this number of vertices 
-                unsigned short* newCode = realloc(code, codeLength*sizeof(unsigned short));
-                if(newCode == NULL){
-                    free(code);
-                    fprintf(stderr, "Insufficient memory to store code for this graph.\n");
-                    return NULL;
-                } else {
-                    code = newCode;
-                }
-            }
-            code[bufferSize] = (unsigned short) getc(file);
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    } else {
-        readCount = fread(code, sizeof (unsigned short), 1, file);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            free(code);
-            return NULL;
-        }
-        bufferSize = 1;
-        zeroCounter = 0;
-        while (zeroCounter < code[0]) {
-            if(bufferSize==codeLength){
-                codeLength = (2*codeLength < (7*code[0] - 9)) ? 2*codeLength : (7*code[0] - 9);
-                // 7*code[0]-9 is the maximum code length for this number of vertices 
-                unsigned short* newCode = realloc(code, codeLength*sizeof(unsigned short));
-                if(newCode == NULL){
-                    free(code);
-                    fprintf(stderr, "Insufficient memory to store code for this graph.\n");
-                    return NULL;
-                } else {
-                    code = newCode;
-                }
-            }
-            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                free(code);
-                return NULL;
-            }
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
+    if (streamScannerCount == MAX_STREAM_COUNT) {
+        fprintf(stderr, "Too many planarcode streams (%d) -- exiting!\n", MAX_STREAM_COUNT);
+        exit(EXIT_FAILURE);
+    }
+    streamScanners[streamScannerCount].file = file;
+    streamScanners[streamScannerCount].scanner = newCodeScanner(file, PLANARCODE_FORMAT);
+
+    return streamScanners[streamScannerCount++].scanner;
+}
+
+int readPlanarCodeInto(FILE *file, unsigned short code[], int maxLength) {
+    CODE_RECORD record;
+
+    if (!nextCodeRecord(getStreamScanner(file), &record)) {
+        //nothing left in file
+        return 0;
+    }
+
+    return copyCodeEntries(record.data, record.length, code, maxLength);
+}
+
+int readPlanarCodeReusing(FILE *file, unsigned short **code, int *codeSize) {
+    CODE_RECORD record;
+    int codeLength;
+
+    if (!nextCodeRecord(getStreamScanner(file), &record)) {
+        //nothing left in file
+        return 0;
+    }
+
+    codeLength = record.twoByteEntries ? (record.length - 1)/2 : record.length;
+    if (codeLength > *codeSize) {
+        unsigned short *newCode = realloc(*code, codeLength*sizeof(unsigned short));
+        if (newCode == NULL) {
+            fprintf(stderr, "Insufficient memory to store code for this graph -- exiting!\n");
+            exit(EXIT_FAILURE);
         }
+        *code = newCode;
+        *codeSize = codeLength;
     }
 
+    return copyCodeEntries(record.data, record.length, *code, *codeSize);
+}
+
+/**
+ * Reads the next code from file and returns it in a newly allocated array.
+ *
+ * @param file
+ * @param options
+ * @return returns the code or NULL if no code was read. Exits in case of error.
+ */
+unsigned short *readPlanarCode(FILE *file, PG_INPUT_OPTIONS *options) {
+    CODE_RECORD record;
+    int codeLength;
+
+    if (!nextCodeRecord(getStreamScanner(file), &record)) {
+        //nothing left in file
+        return NULL;
+    }
+
+    codeLength = record.twoByteEntries ? (record.length - 1)/2 : record.length;
+    unsigned short* code = malloc(codeLength*sizeof(unsigned short));
+    if(code == NULL){
+        fprintf(stderr, "Insufficient memory to store code for this graph.\n");
+        return NULL;
+    }
+    copyCodeEntries(record.data, record.length, code, codeLength);
+
     return code;
 }
 
 PLANE_GRAPH *readAndDecodePlanarCode(FILE *f, PG_INPUT_OPTIONS *options){
-    unsigned short *code = readPlanarCode(f, options);
-    if(code==NULL){
+    //the code is only needed until it is decoded, so one buffer is reused
+    static unsigned short *code = NULL;
+    static int codeSize = 0;
+
+    if(!readPlanarCodeReusing(f, &code, &codeSize)){
         return NULL;
     }
-    PLANE_GRAPH *pg = decodePlanarCode(code, options);
-    free(code);
-    return pg;
+    return decodePlanarCode(code, options);
 }
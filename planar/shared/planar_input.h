@@ -1,6 +1,6 @@
 /*
  * Main developer: Nico Van Cleemput
- * 
+ *
  * Copyright (C) 2013 Nico Van Cleemput.
  * Licensed under the GNU GPL, read the file LICENSE.txt for details.
  */
@@ -14,29 +14,57 @@
 #ifdef	__cplusplus
 extern "C" {
 #endif
-    
+
     typedef struct __plane_graph_input_options PG_INPUT_OPTIONS;
-    
+
     struct __plane_graph_input_options {
-        boolean containsHeader;
-        boolean removeInternalHeaders;
-        
-        int initialCodeLength;
-        
         int maxn;
         int maxnFactor;
         int maxe;
-        
+
         boolean computeDual;
     };
-    
-//the default code length is sufficient to store any graph with less than 100 vertices
-#define DEFAULT_PG_INPUT_OPTIONS(options) PG_INPUT_OPTIONS options = {TRUE, TRUE, 700, 0, 1, 0, FALSE}
+
+#define DEFAULT_PG_INPUT_OPTIONS(options) PG_INPUT_OPTIONS options = {0, 1, 0, FALSE}
+
+    /* Decodes the code into the given plane graph. The inverse of each edge
+     * is found with a single pass over the edges. Exits if the graph does
+     * not fit in pg.
+     */
+    void decodePlanarCodeInto(unsigned short* code, PLANE_GRAPH *pg);
 
     PLANE_GRAPH *decodePlanarCode(unsigned short* code, PG_INPUT_OPTIONS *options);
 
+    /* Decodes the code into pg, which is grown when the graph does not fit.
+     * The size that is needed is determined by the options in the same way
+     * as for decodePlanarCode. If pg is NULL, a new plane graph is created.
+     * Returns the plane graph, or NULL if there was insufficient memory.
+     *
+     * Reusing the same plane graph for all graphs in a file avoids allocating
+     * memory for each graph.
+     */
+    PLANE_GRAPH *decodePlanarCodeReusing(unsigned short* code, PLANE_GRAPH *pg, PG_INPUT_OPTIONS *options);
+
+    /* Reads the next code from file and stores it in code, which has room
+     * for maxLength entries. Returns the number of entries, or 0 if there
+     * are no codes left. Exits in case of error.
+     *
+     * The input is read in large blocks (or mapped into memory for regular
+     * files) by a reader that belongs to the file, so the file should not
+     * be read in any other way.
+     */
+    int readPlanarCodeInto(FILE *file, unsigned short code[], int maxLength);
+
+    /* Reads the next code from file and stores it in *code, which has room
+     * for *codeSize entries. The array is reallocated when the code does not
+     * fit, and *code and *codeSize are updated. *code may be NULL if *codeSize
+     * is 0. Returns the number of entries, or 0 if there are no codes left.
+     * Exits in case of error.
+     */
+    int readPlanarCodeReusing(FILE *file, unsigned short **code, int *codeSize);
+
     unsigned short *readPlanarCode(FILE *file, PG_INPUT_OPTIONS *options);
-    
+
     PLANE_GRAPH *readAndDecodePlanarCode(FILE *f, PG_INPUT_OPTIONS *options);
 
 #ifdef	__cplusplus
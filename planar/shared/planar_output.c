@@ -7,73 +7,141 @@
 
 #include "planar_output.h"
 #include <stdlib.h>
+#include <string.h>
 
-void writePlanarCodeChar(PLANE_GRAPH *pg, FILE *f){
-    int i;
-    PG_EDGE *e, *elast;
-    
-    //write the number of vertices
-    fputc(pg->nv, f);
-    
-    for(i=0; i<pg->nv; i++){
-        e = elast = pg->firstedge[i];
-        do {
-            fputc(e->end + 1, f);
-            e = e->next;
-        } while (e != elast);
-        fputc(0, f);
+/* The code of a graph is assembled in this buffer and written with a single
+ * fwrite. The buffer only grows.
+ */
+static unsigned char *codeBuffer = NULL;
+static size_t codeBufferSize = 0;
+
+static boolean headerWritten = FALSE;
+
+#define PLANARCODE_HEADER ">>planar_code<<"
+
+/* Makes sure that the buffer can hold a code of the given number of bytes
+ * and the header, and returns the position at which the code should be
+ * stored.
+ */
+static size_t prepareCodeBuffer(size_t codeSize){
+    size_t headerSize = headerWritten ? 0 : strlen(PLANARCODE_HEADER);
+
+    if(headerSize + codeSize > codeBufferSize){
+        size_t newSize = codeBufferSize ? codeBufferSize : 4096;
+        while(newSize < headerSize + codeSize){
+            newSize *= 2;
+        }
+        unsigned char *newBuffer = (unsigned char *)realloc(codeBuffer, newSize);
+        if(newBuffer == NULL){
+            fprintf(stderr, "Insufficient memory to write code -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+        codeBuffer = newBuffer;
+        codeBufferSize = newSize;
     }
+
+    if(headerSize){
+        memcpy(codeBuffer, PLANARCODE_HEADER, headerSize);
+        headerWritten = TRUE;
+    }
+
+    return headerSize;
 }
 
-void writePlanarCodeShort(PLANE_GRAPH *pg, FILE *f){
-    int i;
-    PG_EDGE *e, *elast;
-    unsigned short temp;
-    
-    //write the number of vertices
-    fputc(0, f);
-    temp = pg->nv;
-    if (fwrite(&temp, sizeof (unsigned short), 1, stdout) != 1) {
+static void writeCodeBuffer(size_t size, FILE *f){
+    if (fwrite(codeBuffer, sizeof(unsigned char), size, f) != size) {
         fprintf(stderr, "fwrite() failed -- exiting!\n");
         exit(EXIT_FAILURE);
     }
-    
-    for(i=0; i<pg->nv; i++){
-        e = elast = pg->firstedge[i];
-        do {
-            temp = e->end + 1;
-            if (fwrite(&temp, sizeof (unsigned short), 1, f) != 1) {
-                fprintf(stderr, "fwrite() failed -- exiting!\n");
-                exit(EXIT_FAILURE);
+}
+
+static inline void storeShort(size_t position, unsigned short value){
+    memcpy(codeBuffer + position, &value, sizeof(unsigned short));
+}
+
+static void checkPlanarCodeOrder(int nv){
+    if (nv + 1 > 65535) {
+        fprintf(stderr, "Graphs of that size are currently not supported -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void writePlanarCode(PLANE_GRAPH *pg, FILE *f){
+    int i;
+    size_t position;
+    PG_EDGE *e, *elast;
+    int entries = 1 + pg->ne + pg->nv;
+
+    checkPlanarCodeOrder(pg->nv);
+
+    if (pg->nv + 1 <= 255) {
+        position = prepareCodeBuffer(entries);
+
+        //write the number of vertices
+        codeBuffer[position++] = pg->nv;
+
+        for(i=0; i<pg->nv; i++){
+            e = elast = pg->firstedge[i];
+            if(e != NULL){
+                do {
+                    codeBuffer[position++] = e->end + 1;
+                    e = e->next;
+                } while (e != elast);
             }
-            e = e->next;
-        } while (e != elast);
-        temp = 0;
-        if (fwrite(&temp, sizeof (unsigned short), 1, f) != 1) {
-            fprintf(stderr, "fwrite() failed -- exiting!\n");
-            exit(EXIT_FAILURE);
+            codeBuffer[position++] = 0;
+        }
+    } else {
+        position = prepareCodeBuffer(1 + entries*sizeof(unsigned short));
+
+        //write the number of vertices
+        codeBuffer[position++] = 0;
+        storeShort(position, pg->nv);
+        position += sizeof(unsigned short);
+
+        for(i=0; i<pg->nv; i++){
+            e = elast = pg->firstedge[i];
+            if(e != NULL){
+                do {
+                    storeShort(position, e->end + 1);
+                    position += sizeof(unsigned short);
+                    e = e->next;
+                } while (e != elast);
+            }
+            storeShort(position, 0);
+            position += sizeof(unsigned short);
         }
     }
+
+    writeCodeBuffer(position, f);
 }
 
-void writePlanarCode(PLANE_GRAPH *pg, FILE *f){
-    static int first = TRUE;
-    
-    if(first){
-        first = FALSE;
-        
-        fprintf(f, ">>planar_code<<");
+void writePlanarCodeEntries(unsigned short code[], FILE *f){
+    int i, zeroCount;
+    size_t position;
+    int nv = code[0];
+    int entries = 1;
+
+    checkPlanarCodeOrder(nv);
+
+    for(zeroCount = 0; zeroCount < nv; entries++){
+        if(code[entries] == 0){
+            zeroCount++;
+        }
     }
-    
-    if (pg->nv + 1 <= 255) {
-        writePlanarCodeChar(pg, f);
-    } else if (pg->nv + 1 <= 65535) {
-        writePlanarCodeShort(pg, f);
+
+    if (nv + 1 <= 255) {
+        position = prepareCodeBuffer(entries);
+        for(i = 0; i < entries; i++){
+            codeBuffer[position++] = code[i];
+        }
     } else {
-        fprintf(stderr, "Graphs of that size are currently not supported -- exiting!\n");
-        exit(EXIT_FAILURE);
+        position = prepareCodeBuffer(1 + entries*sizeof(unsigned short));
+        codeBuffer[position++] = 0;
+        memcpy(codeBuffer + position, code, entries*sizeof(unsigned short));
+        position += entries*sizeof(unsigned short);
     }
-    
+
+    writeCodeBuffer(position, f);
 }
 
 
@@ -15,8 +15,18 @@
 extern "C" {
 #endif
 
+/* The header is written before the first code. Each code is assembled in
+ * memory and written with a single fwrite.
+ */
 void writePlanarCode(PLANE_GRAPH *pg, FILE *f);
 
+/* Writes a code that is given as an array of entries: the order followed
+ * by the zero-terminated lists of neighbours (numbered starting from 1).
+ * This is used by programs that write a modified version of a graph without
+ * building it.
+ */
+void writePlanarCodeEntries(unsigned short code[], FILE *f);
+
 void writeEdgeCode(PLANE_GRAPH *pg, FILE *f);
 
 #ifdef	__cplusplus
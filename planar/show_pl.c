@@ -11,7 +11,8 @@
  * 
  * Compile with:
  *     
- *     cc -o show_pl -O4 show_pl.c shared/planar_base.c shared/planar_input.c
+ *     cc -o show_pl -O4 show_pl.c shared/planar_base.c shared/planar_input.c \
+ *     ../multicode/shared/multicode_scanner.c
  * 
  */
 
@@ -110,17 +111,20 @@ int main(int argc, char** argv) {
         }
     }
     
-    unsigned short *code;
+    unsigned short *code = NULL;
+    int codeSize = 0;
+    PLANE_GRAPH *pg = NULL;
     DEFAULT_PG_INPUT_OPTIONS(options);
-    while ((code = readPlanarCode(stdin, &options))) {
+    while (readPlanarCodeReusing(stdin, &code, &codeSize)) {
         if(showCode){
             printCode(code);
         } else {
-            PLANE_GRAPH *pg = decodePlanarCode(code, &options);
+            pg = decodePlanarCodeReusing(code, pg, &options);
+            if(pg == NULL){
+                return EXIT_FAILURE;
+            }
             printAdjacencyList(pg);
-            freePlaneGraph(pg);
         }
-        free(code);
         graphsRead++;
     }
     
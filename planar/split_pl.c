@@ -11,7 +11,8 @@
  * 
  * Compile with:
  *     
- *     cc -o split_pl -O4 split_pl.c
+ *     cc -o split_pl -O4 split_pl.c ../multicode/shared/multicode_scanner.c \
+ *     ../multicode/shared/multicode_index.c
  * 
  */
 
@@ -20,16 +21,8 @@
 #include <getopt.h>
 #include <string.h>
 
-
-#ifndef MAXN
-#define MAXN 200            /* the maximum number of vertices */
-#endif
-#define MAXE (6*MAXN-12)    /* the maximum number of oriented edges */
-#define MAXF (2*MAXN-4)      /* the maximum number of faces */
-#define MAXVAL (MAXN-1)  /* the maximum degree of a vertex */
-#define MAXCODELENGTH (MAXN+MAXE+3)
-
-#define INFI (MAXN + 1)
+#include "../multicode/shared/multicode_scanner.h"
+#include "../multicode/shared/multicode_index.h"
 
 #undef FALSE
 #undef TRUE
@@ -44,154 +37,50 @@ boolean onePerFile = FALSE;
 
 char *extension = "code";
 
-//=============== Reading and decoding planarcode ===========================
+CODE_INDEX *codeIndex = NULL;
+unsigned long long indexedGraphCount;
 
-/**
- * 
- * @param code
- * @param length
- * @param file
- * @return returns 1 if a code was read and 0 otherwise. Exits in case of error.
+//=============== Reading and writing planarcode ===========================
+
+/* Stores the next code in code, either from the scanner or, if an index is
+ * used, from the index. Returns FALSE if there are no codes left.
  */
-int readPlanarCode(unsigned short code[], int *length, FILE *file) {
-    static int first = 1;
-    unsigned char c;
-    char testheader[20];
-    int bufferSize, zeroCounter;
+boolean nextCode(CODE_SCANNER *scanner, CODE_RECORD *code){
+    static unsigned char *buffer = NULL;
+    static unsigned int bufferSize = 0;
+    static unsigned long long nextIndexedGraph = 0;
+    CODE_INDEX_ENTRY entry;
     
-    int readCount;
-
-
-    if (first) {
-        first = 0;
-
-        if (fread(&testheader, sizeof (unsigned char), 13, file) != 13) {
-            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
-            exit(1);
-        }
-        testheader[13] = 0;
-        if (strcmp(testheader, ">>planar_code") == 0) {
-
-        } else {
-            fprintf(stderr, "No planarcode header detected -- exiting!\n");
-            exit(1);
-        }
-        //read reminder of header (either empty or le/be specification)
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-        while (c!='<'){
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                return FALSE;
-            }
-        }
-        //read one more character
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-    }
-
-    /* possibly removing interior headers -- only done for planarcode */
-    if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-        //nothing left in file
-        return (0);
+    if(codeIndex == NULL){
+        return nextCodeRecord(scanner, code);
+    } else if(nextIndexedGraph == indexedGraphCount){
+        return FALSE;
     }
-
-    if (c == '>') {
-        // could be a header, or maybe just a 62 (which is also possible for unsigned char
-        code[0] = c;
-        bufferSize = 1;
-        zeroCounter = 0;
-        code[1] = (unsigned short) getc(file);
-        if (code[1] == 0) zeroCounter++;
-        code[2] = (unsigned short) getc(file);
-        if (code[2] == 0) zeroCounter++;
-        bufferSize = 3;
-        // 3 characters were read and stored in buffer
-        if ((code[1] == '>') && (code[2] == 'p')) /*we are sure that we're dealing with a header*/ {
-            while ((c = getc(file)) != '<');
-            /* read 2 more characters: */
-            c = getc(file);
-            if (c != '<') {
-                fprintf(stderr, "Problems with header -- single '<'\n");
-                exit(1);
-            }
-            if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                //nothing left in file
-                return (0);
-            }
-            bufferSize = 1;
-            zeroCounter = 0;
-        }
-    } else {
-        //no header present
-        bufferSize = 1;
-        zeroCounter = 0;
-    }
-
-    if (c != 0) /* unsigned chars would be sufficient */ {
-        code[0] = c;
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        while (zeroCounter < code[0]) {
-            code[bufferSize] = (unsigned short) getc(file);
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    } else {
-        readCount = fread(code, sizeof (unsigned short), 1, file);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            exit(1);
-        }
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        bufferSize = 1;
-        zeroCounter = 0;
-        while (zeroCounter < code[0]) {
-            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                exit(1);
-            }
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
+    
+    getCodeIndexEntry(codeIndex, nextIndexedGraph++, &entry);
+    if(entry.length > bufferSize){
+        free(buffer);
+        bufferSize = 2*entry.length;
+        buffer = (unsigned char *)malloc(bufferSize);
+        if(buffer == NULL){
+            fprintf(stderr, "Insufficient memory -- exiting!\n");
+            exit(-1);
         }
     }
-
-    *length = bufferSize;
-    
-    
-    
-    return (1);
-
-
+    readIndexedBytes(codeIndex, &entry, buffer);
+    code->data = buffer;
+    code->length = entry.length;
+    return TRUE;
 }
 
-void writePlanarCode(unsigned short code[], int length, FILE *outFile, boolean withHeader){
-    int i;
+/* The code is copied as it is, so it is never decoded.
+ */
+void writePlanarCode(CODE_RECORD *code, FILE *outFile, boolean withHeader){
     if(withHeader){
         fprintf(outFile, ">>planar_code<<");
     }
-    
-    if(code[0]+1 <= 255) {
-        for(i=0; i<length; i++){
-             fputc(code[i], outFile);
-        }
-    } else if(code[0]+1 <= 65535) {
-        fputc(0, outFile);
-        for(i=0; i<length; i++){
-             if (fwrite(code+i, sizeof (unsigned short), 1, outFile) != 1) {
-                fprintf(stderr, "fwrite() failed -- exiting!\n");
-                exit(-1);
-            }
-        }
-    } else {
-        fprintf(stderr, "Graphs of that size are currently not supported -- exiting!\n");
+    if (fwrite(code->data, sizeof (unsigned char), code->length, outFile) != code->length) {
+        fprintf(stderr, "fwrite() failed -- exiting!\n");
         exit(-1);
     }
 }
@@ -202,8 +91,6 @@ void help(char *name) {
     fprintf(stderr, "The program %s splits the given graphs over a given number of files.\n\n", name);
     fprintf(stderr, "Usage\n=====\n");
     fprintf(stderr, " %s\n\n", name);
-    fprintf(stderr, "\nThis program can handle graphs up to %d vertices.\n", MAXN);
-    fprintf(stderr, "Recompile with a larger value for MAXN if you need larger graphs.\n\n");
     fprintf(stderr, "Valid options\n=============\n");
     fprintf(stderr, " -h, --help\n");
     fprintf(stderr, "    Print this help and return.\n");
@@ -211,6 +98,9 @@ void help(char *name) {
     fprintf(stderr, "    Split this file such that each file contains only one graph.\n");
     fprintf(stderr, " -e, --extension\n");
     fprintf(stderr, "    Specify the extension of the new files. Defaults to code.\n");
+    fprintf(stderr, " -I, --index file\n");
+    fprintf(stderr, "    Use the given index (see index_pl) to copy the codes without parsing\n");
+    fprintf(stderr, "    them. Standard in should be the file for which the index was built.\n");
 }
 
 void usage(char *name) {
@@ -228,11 +118,12 @@ int main(int argc, char *argv[]) {
     static struct option long_options[] = {
         {"one-per-file", no_argument, NULL, '1'},
         {"extension", required_argument, NULL, 'e'},
+        {"index", required_argument, NULL, 'I'},
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "h1e:", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "h1e:I:", long_options, &option_index)) != -1) {
         switch (c) {
             case 0:
                 break;
@@ -245,6 +136,14 @@ int main(int argc, char *argv[]) {
             case 'e':
                 extension = optarg;
                 break;
+            case 'I':
+                codeIndex = openCodeIndex(optarg, PLANARCODE_FORMAT, fileno(stdin));
+                if(codeIndex == NULL){
+                    fprintf(stderr, "Could not open %s to read index -- exiting!\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                indexedGraphCount = getCodeIndexSize(codeIndex);
+                break;
             case '?':
                 usage(name);
                 return EXIT_FAILURE;
@@ -274,9 +173,9 @@ int main(int argc, char *argv[]) {
 
         /*=========== read planar graphs ===========*/
 
-        unsigned short code[MAXCODELENGTH];
-        int length;
-        while (readPlanarCode(code, &length, stdin)) {
+        CODE_SCANNER *scanner = codeIndex == NULL ? newCodeScanner(stdin, PLANARCODE_FORMAT) : NULL;
+        CODE_RECORD code;
+        while (nextCode(scanner, &code)) {
             numberOfGraphs++;
             int n = snprintf(fileName, 100, "%s-%d.%s", fileNameBase, numberOfGraphs, extension);
             if (n<0 || n>=100){
@@ -284,10 +183,13 @@ int main(int argc, char *argv[]) {
                 return EXIT_FAILURE;
             }
             FILE *f = fopen(fileName, "w");
-            writePlanarCode(code, length, f, TRUE);
+            writePlanarCode(&code, f, TRUE);
             
             fclose(f);
         }
+        if(scanner != NULL){
+            freeCodeScanner(scanner);
+        }
     } else {
         int i;
         
@@ -308,12 +210,15 @@ int main(int argc, char *argv[]) {
 
         /*=========== read planar graphs ===========*/
 
-        unsigned short code[MAXCODELENGTH];
-        int length;
-        while (readPlanarCode(code, &length, stdin)) {
-            writePlanarCode(code, length, files[numberOfGraphs%fileCount], FALSE);
+        CODE_SCANNER *scanner = codeIndex == NULL ? newCodeScanner(stdin, PLANARCODE_FORMAT) : NULL;
+        CODE_RECORD code;
+        while (nextCode(scanner, &code)) {
+            writePlanarCode(&code, files[numberOfGraphs%fileCount], FALSE);
             numberOfGraphs++;
         }
+        if(scanner != NULL){
+            freeCodeScanner(scanner);
+        }
 
         for (i = 0; i < fileCount; i++){
             fclose(files[i]);
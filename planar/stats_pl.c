@@ -11,7 +11,9 @@
  * 
  * Compile with:
  *     
- *     cc -o stats_pl -O4 stats_pl.c
+ *     cc -o stats_pl -O4 stats_pl.c shared/planar_base.c shared/planar_input.c \
+ *     shared/planar_output.c shared/planar_automorphismgroup.c \
+ *     ../multicode/shared/multicode_scanner.c
  * 
  */
 
@@ -20,6 +22,10 @@
 #include <getopt.h>
 #include <string.h>
 
+#include "shared/planar_base.h"
+#include "shared/planar_input.h"
+#include "shared/planar_output.h"
+#include "shared/planar_automorphismgroup.h"
 
 #ifndef MAXN
 #define MAXN 64            /* the maximum number of vertices */
@@ -31,46 +37,7 @@
 
 #define INFI (MAXN + 1)
 
-typedef int boolean;
-
-#undef FALSE
-#undef TRUE
-#define FALSE 0
-#define TRUE  1
-
-typedef struct e /* The data type used for edges */ {
-    int start; /* vertex where the edge starts */
-    int end; /* vertex where the edge ends */
-    int rightface; /* face on the right side of the edge
-                          note: only valid if make_dual() called */
-    struct e *prev; /* previous edge in clockwise direction */
-    struct e *next; /* next edge in clockwise direction */
-    struct e *inverse; /* the edge that is inverse to this one */
-    int mark, index; /* two ints for temporary use;
-                          Only access mark via the MARK macros. */
-
-    int left_facesize; /* size of the face in prev-direction of the edge.
-        		  Only used for -p option. */
-} EDGE;
-
-EDGE *firstedge[MAXN]; /* pointer to arbitrary edge out of vertex i. */
-int degree[MAXN];
-
-EDGE *facestart[MAXF]; /* pointer to arbitrary edge of face i. */
-int faceSize[MAXF]; /* pointer to arbitrary edge of face i. */
-
-EDGE edges[MAXE];
-
-static int markvalue = 30000;
-#define RESETMARKS {int mki; if ((markvalue += 2) > 30000) \
-       { markvalue = 2; for (mki=0;mki<MAXE;++mki) edges[mki].mark=0;}}
-#define MARK(e) (e)->mark = markvalue
-#define MARKLO(e) (e)->mark = markvalue
-#define MARKHI(e) (e)->mark = markvalue+1
-#define UNMARK(e) (e)->mark = markvalue-1
-#define ISMARKED(e) ((e)->mark >= markvalue)
-#define ISMARKEDLO(e) ((e)->mark == markvalue)
-#define ISMARKEDHI(e) ((e)->mark > markvalue)
+PLANE_GRAPH *pg;
 
 int filterEnabled = FALSE;
 int filterOnly = 0;
@@ -96,302 +63,16 @@ int vertexOrbitCount;
 
 typedef int VERTEXPAIR[2];
 VERTEXPAIR undirectedEdges[MAXE/2];
+int undirectedEdgeIndex[MAXE]; //the position of each oriented edge in undirectedEdges
 int edgeOrbits[MAXE/2];
 int edgeOrbitsSize[MAXE/2];
 int edgeOrbitCount;
 
-int faceOrbits[MAXN];
-int faceOrbitsSize[MAXN];
+int faceOrbits[MAXF];
+int faceOrbitsSize[MAXF];
 int faceOrbitCount;
 
-int nv;
-int ne;
-int nf;
-
-int automorphisms[2*MAXE][MAXN]; //there are at most 2e automorphisms (e = #arcs)
-int automorphismsCount;
-int orientationPreservingAutomorphismsCount;
-int orientationReversingAutomorphismsCount;
-
-//////////////////////////////////////////////////////////////////////////////
-
-int certificate[MAXE+MAXN];
-int canonicalLabelling[MAXN];
-int reverseCanonicalLabelling[MAXN];
-EDGE *canonicalFirstedge[MAXN];
-int alternateLabelling[MAXN];
-EDGE *alternateFirstedge[MAXN];
-int queue[MAXN];
-boolean hasChiralGroup;
-
-EDGE *orientationPreservingStartingEdges[MAXE];
-EDGE *orientationReversingStartingEdges[MAXE];
-int startingEdgesCount; //the number of starting edges is always the same for both orientations
-
-void findStartingEdges(){
-    int i, startingDegree, startingFaceSize, minimumFrequency;
-    int degreeFrequency[MAXN] = {0};
-    int faceSizeFrequency[MAXN] = {0};
-    EDGE *start, *edge;
-    
-    startingEdgesCount = 0;
-    
-    //build the degree frequency table
-    for(i = 0; i < nv; i++){
-        degreeFrequency[degree[i]]++;
-    }
-    
-    //find the smallest degree with the lowest frequency
-    minimumFrequency = MAXN;
-    for(i = 0; i < MAXN; i++){
-        if(degreeFrequency[i] && degreeFrequency[i] < minimumFrequency){
-            startingDegree = i;
-            minimumFrequency = degreeFrequency[i];
-        }
-    }
-    
-    //build the frequency table of face sizes incident to a vertex with startingDegree
-    for(i = 0; i < nv; i++){
-        if(degree[i] == startingDegree){
-            start = edge = firstedge[i];
-            
-            do {
-                faceSizeFrequency[faceSize[edge->rightface]]++;
-                edge = edge->next;
-            } while (start != edge);
-        }
-    }
-    
-    //find the smallest face size incident with a vertex of startingDegree and with smallest frequency
-    minimumFrequency = MAXE;
-    for(i = 0; i < MAXN; i++){
-        if(faceSizeFrequency[i] && faceSizeFrequency[i] < minimumFrequency){
-            startingFaceSize = i;
-            minimumFrequency = faceSizeFrequency[i];
-        }
-    }
-    
-    //store all starting edges
-    for(i = 0; i < nv; i++){
-        if(degree[i] == startingDegree){
-            start = edge = firstedge[i];
-            
-            do {
-                if(faceSize[edge->rightface] == startingFaceSize){
-                    orientationPreservingStartingEdges[startingEdgesCount] = edge;
-                    orientationReversingStartingEdges[startingEdgesCount] = edge->next;
-                    startingEdgesCount++;
-                }
-                edge = edge->next;
-            } while (start != edge);
-        }
-    }
-}
-
-void constructCertificate(EDGE *eStart){
-    int i;
-    for(i=0; i<MAXN; i++){
-        canonicalLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int position = 0;
-    queue[0] = eStart->start;
-    canonicalFirstedge[eStart->start] = eStart;
-    canonicalLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = canonicalFirstedge[currentVertex];
-        do {
-            if(canonicalLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                canonicalLabelling[e->end] = vertexCounter++;
-                canonicalFirstedge[e->end] = e->inverse;
-            }
-            certificate[position++] = canonicalLabelling[e->end];
-            e = e->next;
-        } while (e!=elast);
-        certificate[position++] = MAXN;
-    }
-    for(i = 0; i < nv; i++){
-        reverseCanonicalLabelling[canonicalLabelling[i]] = i;
-    }
-}
-
-void constructCertificateOrientationReversed(EDGE *eStart){
-    int i;
-    for(i=0; i<MAXN; i++){
-        canonicalLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int position = 0;
-    queue[0] = eStart->start;
-    canonicalFirstedge[eStart->start] = eStart;
-    canonicalLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = canonicalFirstedge[currentVertex];
-        do {
-            if(canonicalLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                canonicalLabelling[e->end] = vertexCounter++;
-                canonicalFirstedge[e->end] = e->inverse;
-            }
-            certificate[position++] = canonicalLabelling[e->end];
-            e = e->prev;
-        } while (e!=elast);
-        certificate[position++] = MAXN;
-    }
-    for(i = 0; i < nv; i++){
-       reverseCanonicalLabelling[canonicalLabelling[i]] = i;
-    }
-}
-
-/* returns 1 if this edge leads to a better certificate
- * returns 0 if this edge leads to the same certificate
- * returns -1 if this edge leads to a worse certificate
- */
-int hasBetterCertificateOrientationPreserving(EDGE *eStart){
-    int i, j;
-    for(i=0; i<MAXN; i++){
-        alternateLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int currentPos = 0;
-    queue[0] = eStart->start;
-    alternateFirstedge[eStart->start] = eStart;
-    alternateLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = alternateFirstedge[currentVertex];
-        do {
-            if(alternateLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                alternateLabelling[e->end] = vertexCounter++;
-                alternateFirstedge[e->end] = e->inverse;
-            }
-            if(alternateLabelling[e->end] < certificate[currentPos]){
-                constructCertificate(eStart);
-                automorphismsCount = 1;
-                orientationPreservingAutomorphismsCount = 1;
-                return 1;
-            } else if(alternateLabelling[e->end] > certificate[currentPos]){
-                return -1;
-            }
-            currentPos++;
-            e = e->next;
-        } while (e!=elast);
-        //MAXN will always be at least the value of certificate[currentPos]
-        if(MAXN > certificate[currentPos]){
-            return -1;
-        }
-        currentPos++;
-    }
-    if(needAutomorphisms){
-        for(j = 0; j < nv; j++){
-            automorphisms[automorphismsCount][j] 
-                    = reverseCanonicalLabelling[alternateLabelling[j]];
-        }
-    }
-    automorphismsCount++;
-    orientationPreservingAutomorphismsCount++;
-    return 0;
-}
-
-int hasBetterCertificateOrientationReversing(EDGE *eStart){
-    int i, j;
-    for(i=0; i<MAXN; i++){
-        alternateLabelling[i] = MAXN;
-    }
-    EDGE *e, *elast;
-    int head = 1;
-    int tail = 0;
-    int vertexCounter = 1;
-    int currentPos = 0;
-    queue[0] = eStart->start;
-    alternateFirstedge[eStart->start] = eStart;
-    alternateLabelling[eStart->start] = 0;
-    while(head>tail){
-        int currentVertex = queue[tail++];
-        e = elast = alternateFirstedge[currentVertex];
-        do {
-            if(alternateLabelling[e->end]==MAXN){
-                queue[head++] = e->end;
-                alternateLabelling[e->end] = vertexCounter++;
-                alternateFirstedge[e->end] = e->inverse;
-            }
-            if(alternateLabelling[e->end] < certificate[currentPos]){
-                constructCertificateOrientationReversed(eStart);
-                hasChiralGroup = TRUE;
-                automorphismsCount = 1;
-                orientationPreservingAutomorphismsCount = 1;
-                orientationReversingAutomorphismsCount = 0;
-                return 1;
-            } else if(alternateLabelling[e->end] > certificate[currentPos]){
-                return -1;
-            }
-            currentPos++;
-            e = e->prev;
-        } while (e!=elast);
-        //MAXN will always be at least the value of certificate[currentPos]
-        if(MAXN > certificate[currentPos]){
-            return -1;
-        }
-        currentPos++;
-    }
-    if(needAutomorphisms){
-        for(j = 0; j < nv; j++){
-            automorphisms[automorphismsCount][j] 
-                    = reverseCanonicalLabelling[alternateLabelling[j]];
-        }
-    }
-    if(hasChiralGroup){
-        orientationPreservingAutomorphismsCount++;
-    } else {
-        orientationReversingAutomorphismsCount++;
-    }
-    automorphismsCount++;
-    return 0;
-}
-
-void calculateAutomorphismGroup(){
-    int i;
-    
-    hasChiralGroup = FALSE;
-    
-    //identity    
-    automorphismsCount = 1;
-    orientationPreservingAutomorphismsCount = 1;
-    orientationReversingAutomorphismsCount = 0;
-    
-    //find starting edges
-    findStartingEdges();
-    
-    //construct initial certificate
-    constructCertificate(orientationPreservingStartingEdges[0]);
-    
-    //look for better automorphism
-    for(i = 1; i < startingEdgesCount; i++){
-        int result = hasBetterCertificateOrientationPreserving(
-                                orientationPreservingStartingEdges[i]);
-        //if result == 1, then the counts are already reset and the new certificate is stored
-        //if result == 0, then the automorphism is already stored
-    }
-    for(i = 0; i < startingEdgesCount; i++){
-        int result = hasBetterCertificateOrientationReversing(
-                                orientationReversingStartingEdges[i]);
-        //if result == 1, then the counts are already reset and the new certificate is stored
-        //if result == 0, then the automorphism is already stored
-    }
-}
+PG_AUTOMORPHISM_GROUP *automorphismGroup = NULL;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -409,7 +90,9 @@ void unionElements(int forest[], int treeSizes[], int *numberOfComponents, int e
 
     if(root1==root2) return;
 
-    if(treeSizes[root1]<treeSizes[root2]){
+    //the smallest element of an orbit is its root, because the orbits
+    //are written starting from their root
+    if(root2<root1){
         forest[root1]=root2;
         treeSizes[root2]+=treeSizes[root1];
     } else {
@@ -426,130 +109,100 @@ void determineVertexOrbits(){
         vertexOrbits[i] = i;
         vertexOrbitsSize[i] = 1;
     }
-    vertexOrbitCount = nv;
+    vertexOrbitCount = pg->nv;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         return; //trivial symmetry
     }
     
-    //we skip the first automorphism since this always corresponds to the identity
-    for(j = 1; j < automorphismsCount; j++){
-        for(i = 0; i < nv; i++){
+    //the orbits of the group are the orbits of its generators
+    for(j = 0; j < automorphismGroup->generatorCount; j++){
+        for(i = 0; i < pg->nv; i++){
             unionElements(vertexOrbits, vertexOrbitsSize, &vertexOrbitCount,
-                    i, automorphisms[j][i]);
+                    i, automorphismGroup->generators[j][i]);
         }
     }
     
     //make sure that each element is connected to its root
-    for(i = 0; i < nv; i++){
+    for(i = 0; i < pg->nv; i++){
         findRootOfElement(vertexOrbits, i);
     }
 }
 
 void determineEdgeOrbits(){
-    int i, j, k, start, end, temp;
+    int i, j, image;
     
     for(i = 0; i < MAXE/2; i++){
         edgeOrbits[i] = i;
         edgeOrbitsSize[i] = 1;
     }
-    edgeOrbitCount = ne/2;
+    edgeOrbitCount = pg->ne/2;
     
-    for(i = 0, j = 0; i < ne; i++){
-        if(edges[i].start < edges[i].end){
-            undirectedEdges[j][0] = edges[i].start;
-            undirectedEdges[j][1] = edges[i].end;
+    for(i = 0, j = 0; i < pg->ne; i++){
+        if(pg->edges[i].start < pg->edges[i].end){
+            undirectedEdges[j][0] = pg->edges[i].start;
+            undirectedEdges[j][1] = pg->edges[i].end;
+            undirectedEdgeIndex[i] = j;
+            undirectedEdgeIndex[pg->edges[i].inverse - pg->edges] = j;
             j++;
         }
     }
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         return; //trivial symmetry
     }
     
-    //we skip the first automorphism since this always corresponds to the identity
-    for(j = 1; j < automorphismsCount; j++){
-        for(i = 0; i < ne/2; i++){
-            //determine image of edge
-            start = automorphisms[j][undirectedEdges[i][0]];
-            end = automorphisms[j][undirectedEdges[i][1]];
-            
-            //canonical version of image
-            if(start > end){
-                temp = start;
-                start = end;
-                end = temp;
-            }
-            
-            //search the pair in the list
-            for(k = 0; k<ne/2; k++){
-                if(start == undirectedEdges[k][0] && end == undirectedEdges[k][1]){
-                    unionElements(edgeOrbits, edgeOrbitsSize, &edgeOrbitCount, i, k);
-                    break;
-                    //the list of edges doesn't contain any duplicates so we can stop
-                }
+    //the orbits of the group are the orbits of its generators
+    for(j = 0; j < automorphismGroup->generatorCount; j++){
+        for(i = 0; i < pg->ne; i++){
+            if(pg->edges[i].start < pg->edges[i].end){
+                image = automorphismGroup->generatorEdgeImages[j][i];
+                unionElements(edgeOrbits, edgeOrbitsSize, &edgeOrbitCount,
+                        undirectedEdgeIndex[i], undirectedEdgeIndex[image]);
             }
         }
     }
     
     //make sure that each element is connected to its root
-    for(i = 0; i < ne/2; i++){
+    for(i = 0; i < pg->ne/2; i++){
         findRootOfElement(edgeOrbits, i);
     }
 }
 
 void determineFaceOrbits(){
-    int i, j, start, end, image;
-    EDGE *e;
+    int i, j, image;
+    PG_EDGE *e;
     
-    for(i = 0; i < nf; i++){
+    for(i = 0; i < pg->nf; i++){
         faceOrbits[i] = i;
         faceOrbitsSize[i] = 1;
     }
-    faceOrbitCount = nf;
+    faceOrbitCount = pg->nf;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         return; //trivial symmetry
     }
     
-    //we skip the first automorphism since this always corresponds to the identity
-    for(j = 1; j < orientationPreservingAutomorphismsCount; j++){
-        for(i = 0; i < nf; i++){
-            //determine image
-            start = automorphisms[j][facestart[i]->start];
-            end = automorphisms[j][facestart[i]->end];
-            
-            e = firstedge[start];
-            while(e->end != end){
-                e = e->next;
-            }
-            
-            image = e->rightface;
-            
-            unionElements(faceOrbits, faceOrbitsSize, &faceOrbitCount,
-                    i, image);
-        }
-    }
-    for(j = orientationPreservingAutomorphismsCount; j < automorphismsCount; j++){
-        for(i = 0; i < nf; i++){
+    //the orbits of the group are the orbits of its generators
+    for(j = 0; j < automorphismGroup->generatorCount; j++){
+        for(i = 0; i < pg->nf; i++){
             //determine image
-            start = automorphisms[j][facestart[i]->start];
-            end = automorphisms[j][facestart[i]->end];
+            e = pg->edges + 
+                    automorphismGroup->generatorEdgeImages[j][pg->facestart[i] - pg->edges];
             
-            e = firstedge[start];
-            while(e->end != end){
-                e = e->next;
+            if(automorphismGroup->generatorIsOrientationReversing[j]){
+                image = e->inverse->rightface;
+            } else {
+                image = e->rightface;
             }
             
-            image = e->inverse->rightface;
-            
             unionElements(faceOrbits, faceOrbitsSize, &faceOrbitCount,
                     i, image);
         }
     }
     
     //make sure that each element is connected to its root
-    for(i = 0; i < nf; i++){
+    for(i = 0; i < pg->nf; i++){
         findRootOfElement(faceOrbits, i);
     }
 }
@@ -561,13 +214,13 @@ void writeNumbering() {
 }
 
 void writeData() {
-    fprintf(stdout, "Number of vertices: %d\n", nv);
-    fprintf(stdout, "Number of edges: %d\n", ne/2);
-    fprintf(stdout, "Number of faces: %d\n", nf);
+    fprintf(stdout, "Number of vertices: %d\n", pg->nv);
+    fprintf(stdout, "Number of edges: %d\n", pg->ne/2);
+    fprintf(stdout, "Number of faces: %d\n", pg->nf);
     if(automorphismInfo){
-        fprintf(stdout, "Number of automorphisms: %d\n", automorphismsCount);
-        fprintf(stdout, "Number of orientation preserving automorphisms: %d\n", automorphismsCount - orientationReversingAutomorphismsCount);
-        fprintf(stdout, "Number of orientation reversing automorphisms: %d\n", orientationReversingAutomorphismsCount);
+        fprintf(stdout, "Number of automorphisms: %d\n", automorphismGroup->size);
+        fprintf(stdout, "Number of orientation preserving automorphisms: %d\n", automorphismGroup->size - automorphismGroup->orientationReversingCount);
+        fprintf(stdout, "Number of orientation reversing automorphisms: %d\n", automorphismGroup->orientationReversingCount);
     }
 }
 
@@ -579,8 +232,8 @@ void writeDegreeSequence() {
         degreeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nv; i++) {
-        degreeFrequency[degree[i] - 1]++;
+    for (i = 0; i < pg->nv; i++) {
+        degreeFrequency[pg->degree[i] - 1]++;
     }
 
     fprintf(stdout, "Degree sequence:    ");
@@ -600,8 +253,8 @@ void writeFaceSizeSequence() {
         faceSizeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nf; i++) {
-        faceSizeFrequency[faceSize[i] - 1]++;
+    for (i = 0; i < pg->nf; i++) {
+        faceSizeFrequency[pg->faceSize[i] - 1]++;
     }
 
     fprintf(stdout, "Face size sequence: ");
@@ -622,9 +275,9 @@ void writeDegreeVector() {
         degreeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nv; i++) {
-        degreeFrequency[degree[i] - 1]++;
-        if(degree[i]>maxDegree) maxDegree = degree[i];
+    for (i = 0; i < pg->nv; i++) {
+        degreeFrequency[pg->degree[i] - 1]++;
+        if(pg->degree[i]>maxDegree) maxDegree = pg->degree[i];
     }
 
     fprintf(stdout, "Degree vector:    ");
@@ -643,9 +296,9 @@ void writeFaceSizeVector() {
         faceSizeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nf; i++) {
-        faceSizeFrequency[faceSize[i] - 1]++;
-        if(faceSize[i]>maxSize) maxSize=faceSize[i];
+    for (i = 0; i < pg->nf; i++) {
+        faceSizeFrequency[pg->faceSize[i] - 1]++;
+        if(pg->faceSize[i]>maxSize) maxSize=pg->faceSize[i];
     }
 
     fprintf(stdout, "Face size vector: ");
@@ -656,8 +309,8 @@ void writeFaceSizeVector() {
 }
 
 void writeFace(FILE *f, int i) {
-    EDGE *e, *eStart;
-    e = eStart = facestart[i];
+    PG_EDGE *e, *eStart;
+    e = eStart = pg->facestart[i];
     fprintf(f, "%d", e->start + 1);
     e = e->inverse->prev;
     while (e!=eStart){
@@ -669,11 +322,11 @@ void writeFace(FILE *f, int i) {
 
 void writeFaces() {
     int i;
-    EDGE *e, *eStart;
+    PG_EDGE *e, *eStart;
 
     fprintf(stdout, "Faces:\n");
-    for (i = 0; i < nf; i++) {
-        e = eStart = facestart[i];
+    for (i = 0; i < pg->nf; i++) {
+        e = eStart = pg->facestart[i];
         fprintf(stdout, "   F%d) %d", i+1, e->start + 1);
         e = e->inverse->prev;
         while (e!=eStart){
@@ -687,7 +340,7 @@ void writeFaces() {
 void writeVertexOrbits() {
     int i, j, count;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         fprintf(stdout, "Graph has trivial symmetry, so each vertex corresponds to an orbit.\n");
         return;
     }
@@ -695,11 +348,11 @@ void writeVertexOrbits() {
     fprintf(stdout, "Vertex orbits:\n");
     
     count = 0;
-    for (i = 0; i < nv; i++) {
+    for (i = 0; i < pg->nv; i++) {
         if(vertexOrbits[i] == i){
             count++;
             fprintf(stdout, "   Orbit %d: %d", count, i+1);
-            for(j = i + 1; j < nv; j++){
+            for(j = i + 1; j < pg->nv; j++){
                 if(vertexOrbits[j] == i){
                     fprintf(stdout, ", %d", j + 1);
                 }
@@ -712,7 +365,7 @@ void writeVertexOrbits() {
 void writeEdgeOrbits() {
     int i, j, count;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         fprintf(stdout, "Graph has trivial symmetry, so each edge corresponds to an orbit.\n");
         return;
     }
@@ -720,11 +373,11 @@ void writeEdgeOrbits() {
     fprintf(stdout, "Edge orbits:\n");
     
     count = 0;
-    for (i = 0; i < ne/2; i++) {
+    for (i = 0; i < pg->ne/2; i++) {
         if(edgeOrbits[i] == i){
             count++;
             fprintf(stdout, "   Orbit %d: %d-%d", count, undirectedEdges[i][0]+1, undirectedEdges[i][1]+1);
-            for(j = i + 1; j < ne/2; j++){
+            for(j = i + 1; j < pg->ne/2; j++){
                 if(edgeOrbits[j] == i){
                     fprintf(stdout, ", %d-%d", undirectedEdges[j][0]+1, undirectedEdges[j][1]+1);
                 }
@@ -737,7 +390,7 @@ void writeEdgeOrbits() {
 void writeFaceOrbits() {
     int i, j, count;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         fprintf(stdout, "Graph has trivial symmetry, so each face corresponds to an orbit.\n");
         return;
     }
@@ -745,11 +398,11 @@ void writeFaceOrbits() {
     fprintf(stdout, "Face orbits:\n");
     
     count = 0;
-    for (i = 0; i < nf; i++) {
+    for (i = 0; i < pg->nf; i++) {
         if(faceOrbits[i] == i){
             count++;
             fprintf(stdout, "   Orbit %d: F%d", count, i+1);
-            for(j = i + 1; j < nf; j++){
+            for(j = i + 1; j < pg->nf; j++){
                 if(faceOrbits[j] == i){
                     fprintf(stdout, ", F%d", j + 1);
                 }
@@ -765,12 +418,12 @@ void writeFaceOrbits_grouped() {
     fprintf(stdout, "Face orbits:\n");
     
     count = 0;
-    for (i = 0; i < nf; i++) {
+    for (i = 0; i < pg->nf; i++) {
         if(faceOrbits[i] == i){
             count++;
             fprintf(stdout, "   Orbit %d:\n      F%d) ", count, i + 1);
             writeFace(stdout, i);
-            for(j = i + 1; j < nf; j++){
+            for(j = i + 1; j < pg->nf; j++){
                 if(faceOrbits[j] == i){
                     fprintf(stdout, "      F%d) ", j + 1);
                     writeFace(stdout, j);
@@ -786,13 +439,13 @@ void writeNumberingLatex() {
 }
 
 void writeDataLatex() {
-    fprintf(stdout, "Number of vertices: %d\\\\\n", nv);
-    fprintf(stdout, "Number of edges: %d\\\\\n", ne/2);
-    fprintf(stdout, "Number of faces: %d\\\\\n", nf);
+    fprintf(stdout, "Number of vertices: %d\\\\\n", pg->nv);
+    fprintf(stdout, "Number of edges: %d\\\\\n", pg->ne/2);
+    fprintf(stdout, "Number of faces: %d\\\\\n", pg->nf);
     if(automorphismInfo){
-        fprintf(stdout, "Number of automorphisms: %d\\\\\n", automorphismsCount);
-        fprintf(stdout, "Number of orientation preserving automorphisms: %d\\\\\n", automorphismsCount - orientationReversingAutomorphismsCount);
-        fprintf(stdout, "Number of orientation reversing automorphisms: %d\\\\\n", orientationReversingAutomorphismsCount);
+        fprintf(stdout, "Number of automorphisms: %d\\\\\n", automorphismGroup->size);
+        fprintf(stdout, "Number of orientation preserving automorphisms: %d\\\\\n", automorphismGroup->size - automorphismGroup->orientationReversingCount);
+        fprintf(stdout, "Number of orientation reversing automorphisms: %d\\\\\n", automorphismGroup->orientationReversingCount);
     }
 }
 
@@ -804,8 +457,8 @@ void writeDegreeSequenceLatex() {
         degreeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nv; i++) {
-        degreeFrequency[degree[i] - 1]++;
+    for (i = 0; i < pg->nv; i++) {
+        degreeFrequency[pg->degree[i] - 1]++;
     }
 
     fprintf(stdout, "Degree sequence: ");
@@ -825,8 +478,8 @@ void writeFaceSizeSequenceLatex() {
         faceSizeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nf; i++) {
-        faceSizeFrequency[faceSize[i] - 1]++;
+    for (i = 0; i < pg->nf; i++) {
+        faceSizeFrequency[pg->faceSize[i] - 1]++;
     }
 
     fprintf(stdout, "Face size sequence: ");
@@ -847,9 +500,9 @@ void writeDegreeVectorLatex() {
         degreeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nv; i++) {
-        degreeFrequency[degree[i] - 1]++;
-        if(degree[i]>maxDegree) maxDegree = degree[i];
+    for (i = 0; i < pg->nv; i++) {
+        degreeFrequency[pg->degree[i] - 1]++;
+        if(pg->degree[i]>maxDegree) maxDegree = pg->degree[i];
     }
 
     fprintf(stdout, "Degree vector:    ");
@@ -868,9 +521,9 @@ void writeFaceSizeVectorLatex() {
         faceSizeFrequency[i] = 0;
     }
 
-    for (i = 0; i < nf; i++) {
-        faceSizeFrequency[faceSize[i] - 1]++;
-        if(faceSize[i]>maxSize) maxSize=faceSize[i];
+    for (i = 0; i < pg->nf; i++) {
+        faceSizeFrequency[pg->faceSize[i] - 1]++;
+        if(pg->faceSize[i]>maxSize) maxSize=pg->faceSize[i];
     }
 
     fprintf(stdout, "Face size vector: ");
@@ -881,8 +534,8 @@ void writeFaceSizeVectorLatex() {
 }
 
 void writeFaceLatex(FILE* f, int i) {
-    EDGE *e, *eStart;
-    e = eStart = facestart[i];
+    PG_EDGE *e, *eStart;
+    e = eStart = pg->facestart[i];
     fprintf(f, "%d", e->start + 1);
     e = e->inverse->prev;
     while (e!=eStart){
@@ -894,11 +547,11 @@ void writeFaceLatex(FILE* f, int i) {
 
 void writeFacesLatex() {
     int i;
-    EDGE *e, *eStart;
+    PG_EDGE *e, *eStart;
 
     fprintf(stdout, "Faces:\\\\\n");
-    for (i = 0; i < nf; i++) {
-        e = eStart = facestart[i];
+    for (i = 0; i < pg->nf; i++) {
+        e = eStart = pg->facestart[i];
         fprintf(stdout, "\\ \\  F%d) %d", i+1, e->start + 1);
         e = e->inverse->prev;
         while (e!=eStart){
@@ -912,7 +565,7 @@ void writeFacesLatex() {
 void writeVertexOrbitsLatex() {
     int i, j, count;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         fprintf(stdout, "Graph has trivial symmetry, so each vertex corresponds to an orbit.\\\\\n");
         return;
     }
@@ -920,11 +573,11 @@ void writeVertexOrbitsLatex() {
     fprintf(stdout, "Vertex orbits:\\\\\n");
     
     count = 0;
-    for (i = 0; i < nv; i++) {
+    for (i = 0; i < pg->nv; i++) {
         if(vertexOrbits[i] == i){
             count++;
             fprintf(stdout, "\\ \\  Orbit %d: %d", count, i+1);
-            for(j = i + 1; j < nv; j++){
+            for(j = i + 1; j < pg->nv; j++){
                 if(vertexOrbits[j] == i){
                     fprintf(stdout, ", %d", j + 1);
                 }
@@ -937,7 +590,7 @@ void writeVertexOrbitsLatex() {
 void writeEdgeOrbitsLatex() {
     int i, j, count;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         fprintf(stdout, "Graph has trivial symmetry, so each edge corresponds to an orbit.\\\\\n");
         return;
     }
@@ -945,11 +598,11 @@ void writeEdgeOrbitsLatex() {
     fprintf(stdout, "Edge orbits:\\\\\n");
     
     count = 0;
-    for (i = 0; i < ne/2; i++) {
+    for (i = 0; i < pg->ne/2; i++) {
         if(edgeOrbits[i] == i){
             count++;
             fprintf(stdout, "\\ \\  Orbit %d: %d-%d", count, undirectedEdges[i][0]+1, undirectedEdges[i][1]+1);
-            for(j = i + 1; j < ne/2; j++){
+            for(j = i + 1; j < pg->ne/2; j++){
                 if(edgeOrbits[j] == i){
                     fprintf(stdout, ", %d-%d", undirectedEdges[j][0]+1, undirectedEdges[j][1]+1);
                 }
@@ -962,7 +615,7 @@ void writeEdgeOrbitsLatex() {
 void writeFaceOrbitsLatex() {
     int i, j, count;
     
-    if(automorphismsCount == 1){
+    if(automorphismGroup->size == 1){
         fprintf(stdout, "Graph has trivial symmetry, so each face corresponds to an orbit.\\\\\n");
         return;
     }
@@ -970,11 +623,11 @@ void writeFaceOrbitsLatex() {
     fprintf(stdout, "Face orbits:\\\\\n");
     
     count = 0;
-    for (i = 0; i < nf; i++) {
+    for (i = 0; i < pg->nf; i++) {
         if(faceOrbits[i] == i){
             count++;
             fprintf(stdout, "\\ \\  Orbit %d: F%d", count, i+1);
-            for(j = i + 1; j < nf; j++){
+            for(j = i + 1; j < pg->nf; j++){
                 if(faceOrbits[j] == i){
                     fprintf(stdout, ", F%d", j + 1);
                 }
@@ -990,12 +643,12 @@ void writeFaceOrbits_groupedLatex() {
     fprintf(stdout, "Face orbits:\\\\\n");
     
     count = 0;
-    for (i = 0; i < nf; i++) {
+    for (i = 0; i < pg->nf; i++) {
         if(faceOrbits[i] == i){
             count++;
             fprintf(stdout, "\\ \\  Orbit %d:\\\\\\ \\ \\ \\ F%d) ", count, i+1);
             writeFaceLatex(stdout, i);
-            for(j = i + 1; j < nf; j++){
+            for(j = i + 1; j < pg->nf; j++){
                 if(faceOrbits[j] == i){
                     fprintf(stdout, "\\ \\ \\ \\ F%d) ", j + 1);
                     writeFaceLatex(stdout, j);
@@ -1008,7 +661,7 @@ void writeFaceOrbits_groupedLatex() {
 
 void writeStatistics() {
     if(automorphismInfo || needAutomorphisms){
-        calculateAutomorphismGroup();
+        automorphismGroup = determineAutomorphismsReusing(pg, automorphismGroup);
         if(vertexOrbitInfo){
             determineVertexOrbits();
         }
@@ -1087,235 +740,6 @@ void writeSummary() {
     fprintf(stdout, "\n");
 }
 
-//=============== Reading and decoding planarcode ===========================
-
-EDGE *findEdge(int from, int to) {
-    EDGE *e, *elast;
-
-    e = elast = firstedge[from];
-    do {
-        if (e->end == to) {
-            return e;
-        }
-        e = e->next;
-    } while (e != elast);
-    fprintf(stderr, "error while looking for edge from %d to %d.\n", from, to);
-    exit(0);
-}
-
-/* Store in the rightface field of each edge the number of the face on
-   the right hand side of that edge.  Faces are numbered 0,1,....  Also
-   store in facestart[i] an example of an edge in the clockwise orientation
-   of the face boundary, and the size of the face in facesize[i], for each i.
-   Returns the number of faces. */
-void makeDual() {
-    register int i, sz;
-    register EDGE *e, *ex, *ef, *efx;
-
-    RESETMARKS;
-
-    nf = 0;
-    for (i = 0; i < nv; ++i) {
-
-        e = ex = firstedge[i];
-        do {
-            if (!ISMARKEDLO(e)) {
-                facestart[nf] = ef = efx = e;
-                sz = 0;
-                do {
-                    ef->rightface = nf;
-                    MARKLO(ef);
-                    ef = ef->inverse->prev;
-                    ++sz;
-                } while (ef != efx);
-                faceSize[nf] = sz;
-                ++nf;
-            }
-            e = e->next;
-        } while (e != ex);
-    }
-}
-
-void decodePlanarCode(unsigned short* code) {
-    /* complexity of method to determine inverse isn't that good, but will have to satisfy for now
-     */
-    int i, j, codePosition;
-    int edgeCounter = 0;
-    EDGE *inverse;
-
-    nv = code[0];
-    codePosition = 1;
-
-    for (i = 0; i < nv; i++) {
-        degree[i] = 0;
-        firstedge[i] = edges + edgeCounter;
-        edges[edgeCounter].start = i;
-        edges[edgeCounter].end = code[codePosition] - 1;
-        edges[edgeCounter].next = edges + edgeCounter + 1;
-        if (code[codePosition] - 1 < i) {
-            inverse = findEdge(code[codePosition] - 1, i);
-            edges[edgeCounter].inverse = inverse;
-            inverse->inverse = edges + edgeCounter;
-        } else {
-            edges[edgeCounter].inverse = NULL;
-        }
-        edgeCounter++;
-        codePosition++;
-        for (j = 1; code[codePosition]; j++, codePosition++) {
-            if (j == MAXVAL) {
-                fprintf(stderr, "MAXVAL too small: %d\n", MAXVAL);
-                exit(0);
-            }
-            edges[edgeCounter].start = i;
-            edges[edgeCounter].end = code[codePosition] - 1;
-            edges[edgeCounter].prev = edges + edgeCounter - 1;
-            edges[edgeCounter].next = edges + edgeCounter + 1;
-            if (code[codePosition] - 1 < i) {
-                inverse = findEdge(code[codePosition] - 1, i);
-                edges[edgeCounter].inverse = inverse;
-                inverse->inverse = edges + edgeCounter;
-            } else {
-                edges[edgeCounter].inverse = NULL;
-            }
-            edgeCounter++;
-        }
-        firstedge[i]->prev = edges + edgeCounter - 1;
-        edges[edgeCounter - 1].next = firstedge[i];
-        degree[i] = j;
-
-        codePosition++; /* read the closing 0 */
-    }
-
-    ne = edgeCounter;
-
-    makeDual();
-
-    // nv - ne/2 + nf = 2
-}
-
-/**
- * 
- * @param code
- * @param laenge
- * @param file
- * @return returns 1 if a code was read and 0 otherwise. Exits in case of error.
- */
-int readPlanarCode(unsigned short code[], int *length, FILE *file) {
-    static int first = 1;
-    unsigned char c;
-    char testheader[20];
-    int bufferSize, zeroCounter;
-    
-    int readCount;
-
-
-    if (first) {
-        first = 0;
-
-        if (fread(&testheader, sizeof (unsigned char), 13, file) != 13) {
-            fprintf(stderr, "can't read header ((1)file too small)-- exiting\n");
-            exit(1);
-        }
-        testheader[13] = 0;
-        if (strcmp(testheader, ">>planar_code") == 0) {
-
-        } else {
-            fprintf(stderr, "No planarcode header detected -- exiting!\n");
-            exit(1);
-        }
-        //read reminder of header (either empty or le/be specification)
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-        while (c!='<'){
-            if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-                return FALSE;
-            }
-        }
-        //read one more character
-        if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-            return FALSE;
-        }
-    }
-
-    /* possibly removing interior headers -- only done for planarcode */
-    if (fread(&c, sizeof (unsigned char), 1, file) == 0) {
-        //nothing left in file
-        return (0);
-    }
-
-    if (c == '>') {
-        // could be a header, or maybe just a 62 (which is also possible for unsigned char
-        code[0] = c;
-        bufferSize = 1;
-        zeroCounter = 0;
-        code[1] = (unsigned short) getc(file);
-        if (code[1] == 0) zeroCounter++;
-        code[2] = (unsigned short) getc(file);
-        if (code[2] == 0) zeroCounter++;
-        bufferSize = 3;
-        // 3 characters were read and stored in buffer
-        if ((code[1] == '>') && (code[2] == 'p')) /*we are sure that we're dealing with a header*/ {
-            while ((c = getc(file)) != '<');
-            /* read 2 more characters: */
-            c = getc(file);
-            if (c != '<') {
-                fprintf(stderr, "Problems with header -- single '<'\n");
-                exit(1);
-            }
-            if (!fread(&c, sizeof (unsigned char), 1, file)) {
-                //nothing left in file
-                return (0);
-            }
-            bufferSize = 1;
-            zeroCounter = 0;
-        }
-    } else {
-        //no header present
-        bufferSize = 1;
-        zeroCounter = 0;
-    }
-
-    if (c != 0) /* unsigned chars would be sufficient */ {
-        code[0] = c;
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        while (zeroCounter < code[0]) {
-            code[bufferSize] = (unsigned short) getc(file);
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    } else {
-        readCount = fread(code, sizeof (unsigned short), 1, file);
-        if(!readCount){
-            fprintf(stderr, "Unexpected EOF.\n");
-            exit(1);
-        }
-        if (code[0] > MAXN) {
-            fprintf(stderr, "Constant N too small %d > %d \n", code[0], MAXN);
-            exit(1);
-        }
-        bufferSize = 1;
-        zeroCounter = 0;
-        while (zeroCounter < code[0]) {
-            readCount = fread(code + bufferSize, sizeof (unsigned short), 1, file);
-            if(!readCount){
-                fprintf(stderr, "Unexpected EOF.\n");
-                exit(1);
-            }
-            if (code[bufferSize] == 0) zeroCounter++;
-            bufferSize++;
-        }
-    }
-
-    *length = bufferSize;
-    return (1);
-
-
-}
-
 //====================== USAGE =======================
 
 void help(char *name) {
@@ -1414,10 +838,15 @@ int main(int argc, char *argv[]) {
 
     /*=========== read planar graphs ===========*/
 
+    pg = newPlaneGraph(MAXN, MAXE);
+    if (pg == NULL) {
+        exit(EXIT_FAILURE);
+    }
+
     unsigned short code[MAXCODELENGTH];
-    int length;
-    while (readPlanarCode(code, &length, stdin)) {
-        decodePlanarCode(code);
+    while (readPlanarCodeInto(stdin, code, MAXCODELENGTH)) {
+        decodePlanarCodeInto(code, pg);
+        makeDual(pg);
         numberOfGraphs++;
         if (!filterEnabled || numberOfGraphs == filterOnly) {
             writeStatistics();
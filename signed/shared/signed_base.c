@@ -9,6 +9,8 @@
 #include "signed_base.h"
 #include<stdio.h>
 
+EDGE edges[MAXE];
+
 /* This method adds the edge (v,w) to graph. This assumes that adj contains
  * the current degree of the vertices v and w. This degrees are then updated.
  */
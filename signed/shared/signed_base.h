@@ -49,7 +49,7 @@ typedef struct e /* The data type used for edges */ {
 typedef EDGE *GRAPH[MAXN + 1][MAXVAL + 1];
 typedef unsigned short ADJACENCY[MAXN + 1];
     
-EDGE edges[MAXE];
+extern EDGE edges[MAXE];
 extern int edgeCounter;
 
 #ifdef	__cplusplus
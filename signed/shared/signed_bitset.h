@@ -0,0 +1,130 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef SIGNED_BITSET_H
+#define	SIGNED_BITSET_H
+
+#include "signed_base.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Sets of edges or vertices of a fixed size that is chosen at compile time
+ * with SIGNED_BITSET_SIZE. This should be a multiple of 64, e.g.,
+ *
+ *     cc -DSIGNED_BITSET_SIZE=256 ...
+ *
+ * A set of size 64 is a single unsigned long long, so the default is as fast
+ * as using the word directly. Larger sets are structs of words that are
+ * passed by value. All operations work on every word without branching, so
+ * the compiler can unroll them.
+ *
+ * The program should check with SET_CAN_STORE that a set can contain all
+ * the elements of a graph.
+ */
+#ifndef SIGNED_BITSET_SIZE
+#define SIGNED_BITSET_SIZE 64
+#endif
+
+#if SIGNED_BITSET_SIZE <= 0 || SIGNED_BITSET_SIZE % 64 != 0
+#error "SIGNED_BITSET_SIZE should be a positive multiple of 64"
+#endif
+
+#define SET_CAN_STORE(el) ((el) < SIGNED_BITSET_SIZE)
+
+#if SIGNED_BITSET_SIZE == 64
+
+typedef unsigned long long int BITSET;
+
+#define EMPTY_SET 0ULL
+#define SET_ADD(s, el) ((s) |= 1ULL << (el))
+#define SET_TOGGLE(s, el) ((s) ^= 1ULL << (el))
+#define SET_CONTAINS(s, el) (((s) >> (el)) & 1ULL)
+#define SET_WITH(s, el) ((s) | (1ULL << (el)))
+#define SET_REMOVE_ALL(s, t) ((s) &= ~(t))
+#define SET_IS_EMPTY(s) (!(s))
+
+//the set containing the elements 0 up to n-1
+static inline BITSET firstElementsSet(int n){
+    return n ? ~0ULL >> (64 - n) : 0ULL;
+}
+
+static inline boolean intersectionHasAtMostOneElement(BITSET s1, BITSET s2){
+    BITSET intersection = s1 & s2;
+    return !(intersection & (intersection - 1));
+}
+
+#else
+
+#define SIGNED_BITSET_WORDS (SIGNED_BITSET_SIZE / 64)
+
+typedef struct {
+    unsigned long long int words[SIGNED_BITSET_WORDS];
+} BITSET;
+
+#define EMPTY_SET ((BITSET){{0ULL}})
+#define SET_ADD(s, el) ((s).words[(el) / 64] |= 1ULL << ((el) % 64))
+#define SET_TOGGLE(s, el) ((s).words[(el) / 64] ^= 1ULL << ((el) % 64))
+#define SET_CONTAINS(s, el) (((s).words[(el) / 64] >> ((el) % 64)) & 1ULL)
+#define SET_WITH(s, el) setWith((s), (el))
+#define SET_REMOVE_ALL(s, t) removeAll(&(s), &(t))
+#define SET_IS_EMPTY(s) setIsEmpty(&(s))
+
+static inline BITSET setWith(BITSET s, int el){
+    SET_ADD(s, el);
+    return s;
+}
+
+static inline void removeAll(BITSET *s, const BITSET *t){
+    int i;
+    for(i = 0; i < SIGNED_BITSET_WORDS; i++){
+        s->words[i] &= ~(t->words[i]);
+    }
+}
+
+static inline boolean setIsEmpty(const BITSET *s){
+    unsigned long long int all = 0ULL;
+    int i;
+    for(i = 0; i < SIGNED_BITSET_WORDS; i++){
+        all |= s->words[i];
+    }
+    return !all;
+}
+
+//the set containing the elements 0 up to n-1
+static inline BITSET firstElementsSet(int n){
+    BITSET s;
+    int i;
+    for(i = 0; i < SIGNED_BITSET_WORDS; i++){
+        int bits = n - 64*i;
+        s.words[i] = bits >= 64 ? ~0ULL : (bits <= 0 ? 0ULL : ~0ULL >> (64 - bits));
+    }
+    return s;
+}
+
+static inline boolean intersectionHasAtMostOneElement(BITSET s1, BITSET s2){
+    unsigned long long int seen = 0ULL;
+    unsigned long long int more = 0ULL;
+    int i;
+    for(i = 0; i < SIGNED_BITSET_WORDS; i++){
+        unsigned long long int intersection = s1.words[i] & s2.words[i];
+        //a second element is either in the same word or in an earlier word
+        more |= (intersection & (intersection - 1)) | (seen & (0ULL - (intersection != 0)));
+        seen |= intersection;
+    }
+    return !more;
+}
+
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SIGNED_BITSET_H */
+
@@ -0,0 +1,212 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The canonical form is computed with nauty on the double cover of the
+ * signed graph. Each vertex v has two copies v+ and v- in the cover. A
+ * positive edge vw gives the edges v+w+ and v-w-, and a negative edge vw
+ * gives the edges v+w- and v-w+. Switching at v corresponds to exchanging
+ * v+ and v-, so the cover does not change under switching.
+ *
+ * For each vertex v an extra fibre vertex is added that is adjacent to v+
+ * and v-. The fibre vertices get a different colour than the cover
+ * vertices, so an isomorphism of the coloured cover maps the pair {v+, v-}
+ * to a pair {w+, w-}: it is a relabelling of the signed graph combined with
+ * switchings.
+ *
+ * If the signed graph has loops or parallel edges with the same sign, then
+ * the cover is a multigraph. In that case each edge of the cover is
+ * subdivided by a vertex with a third colour. Whether this is needed does
+ * not change under switching or relabelling.
+ */
+
+#include "signed_canonical.h"
+#include<stdio.h>
+#include "../nauty/nausparse.h"
+
+static sparsegraph sg = {0}, cg = {0}; /* cover and canonically labelled cover */
+static int *lab = NULL, *ptn = NULL, *orbits = NULL;
+static setword *workspace = NULL;
+static size_t allocatedVertexCount = 0;
+
+static int *form = NULL;
+static size_t allocatedFormLength = 0;
+
+static int (*coverEdges)[2] = NULL;
+static size_t allocatedCoverEdgeCount = 0;
+
+static void *resize(void *array, size_t size){
+    array = realloc(array, size);
+    if(array == NULL){
+        fprintf(stderr, "Insufficient memory for canonical form -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+static boolean coverIsMultigraph(GRAPH graph, ADJACENCY adj, int order){
+    int v, i, j;
+
+    for(v = 1; v <= order; v++){
+        for(i = 0; i < adj[v]; i++){
+            EDGE *e = graph[v][i];
+            if(e->smallest == e->largest){
+                return TRUE;
+            }
+            for(j = i + 1; j < adj[v]; j++){
+                EDGE *f = graph[v][j];
+                if(f->smallest == e->smallest && f->largest == e->largest &&
+                        f->isNegative == e->isNegative){
+                    return TRUE;
+                }
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+static void addCoverEdge(int *coverEdgeCount, int v, int w){
+    coverEdges[*coverEdgeCount][0] = v;
+    coverEdges[*coverEdgeCount][1] = w;
+    (*coverEdgeCount)++;
+}
+
+/* Computes the canonical labelling of the cover in sg. This is a separate
+ * function because the parameter graph of getSwitchingCanonicalForm hides
+ * the type graph of nauty.
+ */
+static void canonicallyLabelCover(int vertexCount){
+    static DEFAULTOPTIONS_SPARSEGRAPH(options);
+    statsblk stats;
+    int m = SETWORDSNEEDED(vertexCount);
+
+    options.getcanon = TRUE;
+    options.defaultptn = FALSE;
+    nauty((graph*) &sg, lab, ptn, NULL, orbits, &options, &stats,
+            workspace, 50 * m, m, vertexCount, (graph*) &cg);
+    sortlists_sg(&cg);
+}
+
+int *getSwitchingCanonicalForm(GRAPH graph, ADJACENCY adj, int order, int *length){
+    int i, j, v;
+
+    if(order == 0){
+        static int emptyForm[2] = {0, 0};
+        *length = 2;
+        return emptyForm;
+    }
+
+    boolean subdivided = coverIsMultigraph(graph, adj, order);
+    //v+ is v-1, v- is order+v-1 and the fibre vertex of v is 2*order+v-1
+    int vertexCount = 3*order + (subdivided ? 2*edgeCounter : 0);
+    int coverEdgeCount = 0;
+
+    //collect the edges of the cover
+    if(allocatedCoverEdgeCount < (size_t)(2*edgeCounter + 2*order)){
+        allocatedCoverEdgeCount = 2*edgeCounter + 2*order;
+        coverEdges = resize(coverEdges, allocatedCoverEdgeCount * sizeof(int[2]));
+    }
+    for(i = 0; i < edgeCounter; i++){
+        int a = edges[i].smallest - 1;
+        int b = edges[i].largest - 1;
+        if(edges[i].isNegative){
+            addCoverEdge(&coverEdgeCount, a, order + b);
+            addCoverEdge(&coverEdgeCount, order + a, b);
+        } else {
+            addCoverEdge(&coverEdgeCount, a, b);
+            addCoverEdge(&coverEdgeCount, order + a, order + b);
+        }
+    }
+    for(v = 0; v < order; v++){
+        addCoverEdge(&coverEdgeCount, v, 2*order + v);
+        addCoverEdge(&coverEdgeCount, order + v, 2*order + v);
+    }
+
+    //translate to nauty's sparse graph
+    if(allocatedVertexCount < (size_t)vertexCount){
+        allocatedVertexCount = vertexCount;
+        lab = resize(lab, allocatedVertexCount * sizeof(int));
+        ptn = resize(ptn, allocatedVertexCount * sizeof(int));
+        orbits = resize(orbits, allocatedVertexCount * sizeof(int));
+        workspace = resize(workspace,
+                50 * SETWORDSNEEDED(allocatedVertexCount) * sizeof(setword));
+    }
+    SG_ALLOC(sg, vertexCount, 4*coverEdgeCount, "Failed to allocate memory to store cover");
+    sg.nv = vertexCount;
+    for(v = 0; v < vertexCount; v++){
+        sg.d[v] = 0;
+    }
+    for(i = 0; i < coverEdgeCount; i++){
+        int a = coverEdges[i][0];
+        int b = coverEdges[i][1];
+        if(subdivided && b < 2*order){
+            int s = 3*order + i;
+            sg.d[a]++;
+            sg.d[s]++;
+            if(a != b){
+                sg.d[b]++;
+                sg.d[s]++;
+            }
+        } else {
+            sg.d[a]++;
+            sg.d[b]++;
+        }
+    }
+    sg.nde = 0;
+    for(v = 0; v < vertexCount; v++){
+        sg.v[v] = sg.nde;
+        sg.nde += sg.d[v];
+        sg.d[v] = 0;
+    }
+    for(i = 0; i < coverEdgeCount; i++){
+        int a = coverEdges[i][0];
+        int b = coverEdges[i][1];
+        if(subdivided && b < 2*order){
+            int s = 3*order + i;
+            sg.e[sg.v[a] + sg.d[a]++] = s;
+            sg.e[sg.v[s] + sg.d[s]++] = a;
+            if(a != b){
+                sg.e[sg.v[b] + sg.d[b]++] = s;
+                sg.e[sg.v[s] + sg.d[s]++] = b;
+            }
+        } else {
+            sg.e[sg.v[a] + sg.d[a]++] = b;
+            sg.e[sg.v[b] + sg.d[b]++] = a;
+        }
+    }
+
+    //colour the cover vertices, the fibre vertices and the subdivision vertices
+    for(v = 0; v < vertexCount; v++){
+        lab[v] = v;
+        ptn[v] = 1;
+    }
+    ptn[2*order - 1] = 0;
+    ptn[3*order - 1] = 0;
+    ptn[vertexCount - 1] = 0;
+
+    canonicallyLabelCover(vertexCount);
+
+    //the form is the order, the type of cover and the canonical cover
+    *length = 2 + vertexCount + cg.nde;
+    if(allocatedFormLength < (size_t)*length){
+        allocatedFormLength = *length;
+        form = resize(form, allocatedFormLength * sizeof(int));
+    }
+    form[0] = order;
+    form[1] = subdivided;
+    j = 2;
+    for(v = 0; v < vertexCount; v++){
+        form[j++] = cg.d[v];
+    }
+    for(v = 0; v < vertexCount; v++){
+        for(i = 0; i < cg.d[v]; i++){
+            form[j++] = cg.e[cg.v[v] + i];
+        }
+    }
+
+    return form;
+}
@@ -0,0 +1,32 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef SIGNED_CANONICAL_H
+#define	SIGNED_CANONICAL_H
+
+#include "signed_base.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Computes a canonical form of a signed graph up to switching and
+ * isomorphism: two signed graphs have the same canonical form if and only if
+ * one can be obtained from the other by switching at some vertices and
+ * relabelling the vertices.
+ *
+ * The form is stored in a buffer that is overwritten by the next call. Its
+ * length is stored in length.
+ */
+int *getSwitchingCanonicalForm(GRAPH graph, ADJACENCY adj, int order, int *length);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SIGNED_CANONICAL_H */
+
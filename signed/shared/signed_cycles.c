@@ -0,0 +1,176 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#include "signed_cycles.h"
+#include<stdio.h>
+
+/* The arguments that do not change while a cycle is extended are stored in
+ * search. The path itself is passed by value, so backtracking needs no work
+ * and the sets can stay in registers. A SIGNED_CYCLE is only built for the
+ * visitor.
+ */
+//whether a cycle with this number of negative edges is passed to the visitor
+#define IS_VISITED(visitor, negativeEdgeCount) \
+    ((visitor)->cycles == ALL_CYCLES || \
+     ((visitor)->cycles == UNBALANCED_CYCLES) == ((negativeEdgeCount) & 1))
+
+static struct {
+    EDGE *(*graph)[MAXVAL + 1];
+    unsigned short *adj;
+    int firstVertex;
+    int secondVertex;
+    int firstEdge;
+    CYCLE_VISITOR *visitor;
+} search;
+
+static boolean extendPath(int currentVertex, BITSET verticesInPath,
+        BITSET edgesInPath, int negativeEdgesInPath, int length){
+    SIGNED_CYCLE cycle;
+    int i;
+    for(i=0; i<search.adj[currentVertex]; i++){
+        EDGE *e = search.graph[currentVertex][i];
+        int neighbour = (e->smallest == currentVertex) ? e->largest : e->smallest;
+        if(SET_CONTAINS(edgesInPath, e->index)){
+            //edge already in cycle
+            continue;
+        } else if(neighbour < search.firstVertex){
+            //cycle not in canonical form
+            continue;
+        } else if(neighbour == search.firstVertex){
+            //we have returned to the first vertex
+            if(currentVertex < search.secondVertex ||
+                    (currentVertex == search.secondVertex && e->index < search.firstEdge)){
+                //cycle not in canonical form
+                continue;
+            }
+            cycle.negativeEdgeCount = negativeEdgesInPath + e->isNegative;
+            if(!IS_VISITED(search.visitor, cycle.negativeEdgeCount)){
+                continue;
+            }
+            cycle.vertices = verticesInPath;
+            cycle.edges = SET_WITH(edgesInPath, e->index);
+            cycle.length = length + 1;
+            if(search.visitor->visitCycle(&cycle, search.visitor->data) == CYCLES_STOP){
+                return TRUE;
+            }
+        } else if(SET_CONTAINS(verticesInPath, neighbour)){
+            //vertex already in cycle
+            continue;
+        } else {
+            //we continue the cycle
+            if(search.visitor->visitPath != NULL){
+                int result;
+                cycle.vertices = SET_WITH(verticesInPath, neighbour);
+                cycle.edges = SET_WITH(edgesInPath, e->index);
+                cycle.negativeEdgeCount = negativeEdgesInPath + e->isNegative;
+                cycle.length = length + 1;
+                result = search.visitor->visitPath(&cycle, neighbour, search.visitor->data);
+                if(result == CYCLES_STOP){
+                    return TRUE;
+                } else if(result == CYCLES_PRUNE){
+                    continue;
+                }
+            }
+            if(extendPath(neighbour, SET_WITH(verticesInPath, neighbour),
+                    SET_WITH(edgesInPath, e->index),
+                    negativeEdgesInPath + e->isNegative, length + 1)){
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+boolean enumerateSimpleCycles(GRAPH graph, ADJACENCY adj, int order,
+        CYCLE_VISITOR *visitor){
+    int v, i;
+    for(i=0; i<edgeCounter; i++){
+        edges[i].index = i;
+    }
+
+    search.graph = graph;
+    search.adj = adj;
+    search.visitor = visitor;
+    for(v = 1; v < order; v++){ //intentionally skip v==order!
+        for(i=0; i<adj[v]; i++){
+            EDGE *e = graph[v][i];
+            int neighbour = e->largest;
+            if(neighbour == v){
+                //cycle not in canonical form: we have seen this cycle already
+                continue;
+            }
+            //start a cycle
+            SIGNED_CYCLE path;
+            path.vertices = EMPTY_SET;
+            path.edges = EMPTY_SET;
+            SET_ADD(path.vertices, v);
+            SET_ADD(path.vertices, neighbour);
+            SET_ADD(path.edges, e->index);
+            path.negativeEdgeCount = e->isNegative;
+            path.length = 1;
+            if(visitor->visitPath != NULL){
+                int result = visitor->visitPath(&path, neighbour, visitor->data);
+                if(result == CYCLES_STOP){
+                    return TRUE;
+                } else if(result == CYCLES_PRUNE){
+                    continue;
+                }
+            }
+            search.firstVertex = v;
+            search.secondVertex = neighbour;
+            search.firstEdge = e->index;
+            if(extendPath(neighbour, path.vertices, path.edges,
+                    path.negativeEdgeCount, path.length)){
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+//====================== CACHE =======================
+
+static int storeCycle(SIGNED_CYCLE *cycle, void *data){
+    CYCLE_CACHE *cache = (CYCLE_CACHE *)data;
+    if(cache->count == cache->capacity){
+        int capacity = cache->capacity ? 2*cache->capacity : 1024;
+        SIGNED_CYCLE *cycles = (SIGNED_CYCLE *)realloc(cache->cycles,
+                capacity * sizeof(SIGNED_CYCLE));
+        if(cycles == NULL){
+            fprintf(stderr, "Insufficient memory to store cycles -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+        cache->cycles = cycles;
+        cache->capacity = capacity;
+    }
+    cache->cycles[cache->count++] = *cycle;
+    return CYCLES_CONTINUE;
+}
+
+void fillCycleCache(GRAPH graph, ADJACENCY adj, int order, CYCLE_CACHE *cache){
+    CYCLE_VISITOR visitor = {ALL_CYCLES, storeCycle, NULL, cache};
+    cache->count = 0;
+    enumerateSimpleCycles(graph, adj, order, &visitor);
+}
+
+boolean visitCachedCycles(CYCLE_CACHE *cache, CYCLE_VISITOR *visitor){
+    int i;
+    for(i = 0; i < cache->count; i++){
+        if(IS_VISITED(visitor, cache->cycles[i].negativeEdgeCount) &&
+                visitor->visitCycle(cache->cycles + i, visitor->data) == CYCLES_STOP){
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void freeCycleCache(CYCLE_CACHE *cache){
+    free(cache->cycles);
+    cache->cycles = NULL;
+    cache->count = 0;
+    cache->capacity = 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef SIGNED_CYCLES_H
+#define	SIGNED_CYCLES_H
+
+#include "signed_base.h"
+#include "signed_bitset.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* A simple cycle, or the path from which a cycle is being built. The length
+ * is the number of edges.
+ */
+typedef struct {
+    BITSET vertices;
+    BITSET edges;
+    int negativeEdgeCount;
+    int length;
+} SIGNED_CYCLE;
+
+#define CYCLE_IS_BALANCED(cycle) (((cycle)->negativeEdgeCount & 1) == 0)
+
+/* Return values of the callbacks of a visitor. CYCLES_PRUNE is only
+ * meaningful for visitPath: the current path is not extended any further.
+ */
+#define CYCLES_CONTINUE 0
+#define CYCLES_PRUNE 1
+#define CYCLES_STOP 2
+
+/* The cycles that are passed to visitCycle.
+ */
+#define ALL_CYCLES 0
+#define BALANCED_CYCLES 1
+#define UNBALANCED_CYCLES 2
+
+/* visitCycle is called once for each simple cycle of the given kind. Since
+ * the other cycles are skipped without calling the visitor, a visitor should
+ * ask for the cycles it needs. visitPath is called each time the path is
+ * extended to lastVertex and before the path is extended further. It may be
+ * NULL. Both receive data as their last argument.
+ */
+typedef struct {
+    int cycles;
+    int (*visitCycle)(SIGNED_CYCLE *cycle, void *data);
+    int (*visitPath)(SIGNED_CYCLE *path, int lastVertex, void *data);
+    void *data;
+} CYCLE_VISITOR;
+
+/* Enumerates each simple cycle of length at least 2 once. The graph should
+ * not contain loops. A cycle is built starting from its smallest vertex v and its first edge
+ * goes to the smallest of the two neighbours of v on the cycle. A cycle of
+ * length 2 starts with the edge that is first in edges. This sets the index
+ * of each edge to its position in edges.
+ *
+ * Returns TRUE if the enumeration was stopped by the visitor.
+ */
+boolean enumerateSimpleCycles(GRAPH graph, ADJACENCY adj, int order,
+        CYCLE_VISITOR *visitor);
+
+/* The simple cycles of a graph can be stored, so several properties can be
+ * checked without enumerating the cycles again.
+ */
+typedef struct {
+    SIGNED_CYCLE *cycles;
+    int count;
+    int capacity;
+} CYCLE_CACHE;
+
+#define EMPTY_CYCLE_CACHE {NULL, 0, 0}
+
+/* Replaces the content of the cache by all simple cycles of the graph.
+ */
+void fillCycleCache(GRAPH graph, ADJACENCY adj, int order, CYCLE_CACHE *cache);
+
+/* Calls visitCycle for the cycles of the given kind in the cache in the
+ * order in which they were enumerated. visitPath is not used. Returns TRUE if this was stopped
+ * by the visitor.
+ */
+boolean visitCachedCycles(CYCLE_CACHE *cache, CYCLE_VISITOR *visitor);
+
+void freeCycleCache(CYCLE_CACHE *cache);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SIGNED_CYCLES_H */
+
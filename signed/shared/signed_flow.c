@@ -0,0 +1,528 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* The flow is found by a backtracking search that assigns values to edges.
+ * Each vertex v has a residue: the sum of the values of the assigned edges
+ * at v, multiplied by the coefficient of v in the edge. A positive edge has
+ * coefficient -1 at its smallest vertex and 1 at its largest vertex, a
+ * negative edge has coefficient 1 at both vertices, and a negative loop has
+ * coefficient 2 at its vertex. A positive loop does not change any residue,
+ * so it just gets the value 1.
+ *
+ * After each assignment the residues are checked against bounds that are
+ * cheap to compute, and a vertex with one unassigned edge left forces the
+ * value of that edge. Before branching, each component of the unassigned
+ * edges is checked as a whole. The search branches on an edge at a vertex
+ * with the fewest unassigned edges. These vertices are kept in a bucket
+ * queue.
+ */
+
+#include "signed_flow.h"
+
+#define FORCED 0
+#define INFEASIBLE 1
+#define NOT_FORCED 2
+
+static int flowK;
+static int flowType;
+
+static int *value;
+static int internalValues[MAXE];
+
+static int endCount[MAXE];
+static int edgeEnd[MAXE][2];
+static int edgeCoefficient[MAXE][2];
+
+static int incidenceCount[MAXN + 1];
+static int incidenceEdge[MAXN + 1][MAXVAL + 1];
+static int incidenceCoefficient[MAXN + 1][MAXVAL + 1];
+
+static int residue[MAXN + 1];
+static int unassignedCount[MAXN + 1];
+//the sum of the absolute values of the coefficients of the unassigned edges
+static int unassignedWeight[MAXN + 1];
+
+//the sum of all residues: only negative edges change it
+static int totalResidue;
+static int unassignedNegativeCount;
+static int unassignedEdgeCount;
+
+static int trail[MAXE];
+static int trailSize;
+
+static int forcedVertices[2*MAXE];
+static int forcedCount;
+
+static int sideParent[MAXN + 1];
+static int sideParity[MAXN + 1];
+
+static boolean componentVisited[MAXN + 1];
+static int componentQueue[MAXN];
+static int graphOrder;
+
+#define INITIAL_NODE_LIMIT 1000
+
+static long long int nodeCount;
+static long long int nodeLimit;
+static boolean searchAborted;
+static unsigned int restartSeed;
+
+//vertex 0 does not exist, so it marks the end of a bucket
+static int bucketHead[MAXVAL + 2];
+static int bucketNext[MAXN + 1];
+static int bucketPrev[MAXN + 1];
+
+static int reduce(int x){
+    if(flowType == MODULAR_FLOW){
+        x %= flowK;
+        if(x < 0) x += flowK;
+    }
+    return x;
+}
+
+static void insertInBucket(int v){
+    int u = unassignedCount[v];
+    bucketPrev[v] = 0;
+    bucketNext[v] = bucketHead[u];
+    if(bucketHead[u]) bucketPrev[bucketHead[u]] = v;
+    bucketHead[u] = v;
+}
+
+static void removeFromBucket(int v){
+    if(bucketPrev[v]){
+        bucketNext[bucketPrev[v]] = bucketNext[v];
+    } else {
+        bucketHead[unassignedCount[v]] = bucketNext[v];
+    }
+    if(bucketNext[v]) bucketPrev[bucketNext[v]] = bucketPrev[v];
+}
+
+/* Returns FALSE if the residue of v can no longer be cancelled by the
+ * unassigned edges at v.
+ */
+static boolean isFeasibleVertex(int v){
+    int r = residue[v];
+    if(unassignedCount[v] == 0){
+        return r == 0;
+    }
+    if(flowK == 2 && ((r + unassignedWeight[v]) & 1)){
+        //all values are odd, so the parity of the remaining sum is fixed
+        return FALSE;
+    }
+    if(flowType == INTEGER_FLOW){
+        return abs(r) <= unassignedWeight[v] * (flowK - 1);
+    }
+    return TRUE;
+}
+
+/* Returns FALSE if a sum of residues can no longer be cancelled by the given
+ * number of unassigned negative edges: positive edges do not change the sum
+ * of the residues of their ends, and a negative edge adds twice its value.
+ */
+static boolean isFeasibleSum(int sum, int negativeCount){
+    if(negativeCount == 0){
+        return sum == 0;
+    }
+    if(flowType == INTEGER_FLOW){
+        if(negativeCount == 1 && sum == 0){
+            //the last negative edge would get the value 0
+            return FALSE;
+        }
+        return abs(sum) <= 2 * (flowK - 1) * negativeCount;
+    } else if(flowK % 2 == 0){
+        //the negative edges can only add an even number
+        return sum % 2 == 0;
+    } else if(negativeCount == 1){
+        //the last negative edge would get the value 0
+        return sum != 0;
+    }
+    return TRUE;
+}
+
+static boolean isFeasibleTotal(){
+    return isFeasibleSum(totalResidue, unassignedNegativeCount);
+}
+
+/* Applies isFeasibleSum to each component of the graph formed by the
+ * unassigned edges. This is more expensive than the other checks, so it is
+ * only used before branching.
+ */
+static boolean areComponentsFeasible(int order){
+    int v, i;
+
+    for(v = 1; v <= order; v++){
+        componentVisited[v] = FALSE;
+    }
+    for(v = 1; v <= order; v++){
+        int head = 0, tail = 0, sum = 0, negativeCount = 0;
+        if(componentVisited[v] || unassignedCount[v] == 0) continue;
+        componentVisited[v] = TRUE;
+        componentQueue[tail++] = v;
+        while(head < tail){
+            int current = componentQueue[head++];
+            sum = reduce(sum + residue[current]);
+            for(i = 0; i < incidenceCount[current]; i++){
+                int e = incidenceEdge[current][i];
+                int neighbour = edgeEnd[e][0] == current ? edgeEnd[e][endCount[e] - 1] : edgeEnd[e][0];
+                if(value[e]) continue;
+                //each negative edge is seen from both ends, and a negative loop once
+                if(edges[e].isNegative) negativeCount += (endCount[e] == 1) ? 2 : 1;
+                if(!componentVisited[neighbour]){
+                    componentVisited[neighbour] = TRUE;
+                    componentQueue[tail++] = neighbour;
+                }
+            }
+        }
+        if(!isFeasibleSum(sum, negativeCount / 2)){
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void changeIncidence(int v, int coefficient, int x, int direction){
+    removeFromBucket(v);
+    residue[v] = reduce(residue[v] + direction * coefficient * x);
+    unassignedCount[v] -= direction;
+    unassignedWeight[v] -= direction * abs(coefficient);
+    insertInBucket(v);
+}
+
+/* Assigns x to edge e and returns FALSE if this makes the flow infeasible.
+ * The assignment is always stored on the trail, so it can be undone.
+ */
+static boolean assignValue(int e, int x){
+    int i;
+    boolean feasible = TRUE;
+
+    value[e] = x;
+    trail[trailSize++] = e;
+    unassignedEdgeCount--;
+    if(edges[e].isNegative) unassignedNegativeCount--;
+    for(i = 0; i < endCount[e]; i++){
+        int v = edgeEnd[e][i];
+        changeIncidence(v, edgeCoefficient[e][i], x, 1);
+        totalResidue = reduce(totalResidue + edgeCoefficient[e][i] * x);
+        if(unassignedCount[v] == 1){
+            forcedVertices[forcedCount++] = v;
+        }
+        if(!isFeasibleVertex(v)){
+            feasible = FALSE;
+        }
+    }
+
+    return feasible && isFeasibleTotal();
+}
+
+static void undoUntil(int position){
+    int i;
+    while(trailSize > position){
+        int e = trail[--trailSize];
+        for(i = 0; i < endCount[e]; i++){
+            changeIncidence(edgeEnd[e][i], edgeCoefficient[e][i], value[e], -1);
+            totalResidue = reduce(totalResidue - edgeCoefficient[e][i] * value[e]);
+        }
+        if(edges[e].isNegative) unassignedNegativeCount++;
+        unassignedEdgeCount++;
+        value[e] = 0;
+    }
+    forcedCount = 0;
+}
+
+/* Determines the value of the last unassigned edge at v. A negative loop
+ * does not force a unique value modulo an even k.
+ */
+static int getForcedValue(int v, int *e, int *x){
+    int i = 0;
+    while(value[incidenceEdge[v][i]]){
+        i++;
+    }
+    int c = incidenceCoefficient[v][i];
+    int r = residue[v];
+    *e = incidenceEdge[v][i];
+
+    if(flowType == INTEGER_FLOW){
+        if(r % c){
+            return INFEASIBLE;
+        }
+        *x = -r / c;
+        if(*x == 0 || abs(*x) >= flowK){
+            return INFEASIBLE;
+        }
+    } else if(c == 2 && flowK % 2 == 0){
+        return NOT_FORCED;
+    } else {
+        //c is its own inverse if it is 1 or -1, and (k+1)/2 is the inverse of 2
+        *x = reduce(c == 2 ? -r * ((flowK + 1) / 2) : -r * c);
+        if(*x == 0){
+            return INFEASIBLE;
+        }
+    }
+    return FORCED;
+}
+
+static boolean propagate(){
+    while(forcedCount > 0){
+        int v = forcedVertices[--forcedCount];
+        int e, x, status;
+        if(unassignedCount[v] != 1){
+            continue;
+        }
+        status = getForcedValue(v, &e, &x);
+        if(status == INFEASIBLE){
+            return FALSE;
+        } else if(status == NOT_FORCED){
+            continue;
+        }
+        if(!assignValue(e, x)){
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Returns a vertex with the fewest unassigned edges. Among those, a vertex
+ * whose residue is furthest from 0 is chosen, since it has the fewest
+ * possibilities left. Remaining ties are broken differently in each restart.
+ */
+static int chooseVertex(){
+    int u, w, v = 0;
+    int bestResidue = -1;
+    unsigned int bestKey = 0;
+
+    for(u = 1; !bucketHead[u]; u++);
+    for(w = bucketHead[u]; w; w = bucketNext[w]){
+        int r = residue[w];
+        if(flowType == INTEGER_FLOW){
+            r = abs(r);
+        } else if(r > flowK - r){
+            r = flowK - r;
+        }
+        unsigned int key = ((unsigned int)w ^ restartSeed) * 2654435761u;
+        if(r > bestResidue || (r == bestResidue && key > bestKey)){
+            bestResidue = r;
+            bestKey = key;
+            v = w;
+        }
+    }
+    return v;
+}
+
+static boolean search(){
+    int i, v, e, x, position;
+    int otherCount = MAXVAL + 1;
+
+    if(++nodeCount > nodeLimit){
+        searchAborted = TRUE;
+        return FALSE;
+    }
+    if(!propagate()){
+        return FALSE;
+    }
+    if(unassignedEdgeCount == 0){
+        return TRUE;
+    }
+    if(!areComponentsFeasible(graphOrder)){
+        return FALSE;
+    }
+
+    v = chooseVertex();
+
+    //choose the edge at v whose other vertex is the most constrained
+    e = -1;
+    for(i = 0; i < incidenceCount[v]; i++){
+        int f = incidenceEdge[v][i];
+        if(!value[f]){
+            int w = edgeEnd[f][0] == v ? edgeEnd[f][endCount[f] - 1] : edgeEnd[f][0];
+            if(unassignedCount[w] < otherCount){
+                otherCount = unassignedCount[w];
+                e = f;
+            }
+        }
+    }
+
+    /* Small values are tried first, since they keep the residues small. The
+     * negation of an integer flow is again a flow, so the first edge can be
+     * given a positive value.
+     */
+    position = trailSize;
+    for(i = 1; i < flowK; i++){
+        if(flowType == INTEGER_FLOW){
+            x = i;
+        } else {
+            //1, k-1, 2, k-2, ... are the values with the smallest absolute value
+            x = (i % 2) ? (i + 1) / 2 : flowK - i / 2;
+        }
+        if(assignValue(e, x) && search()){
+            return TRUE;
+        }
+        undoUntil(position);
+        if(flowType == INTEGER_FLOW && position > 0){
+            if(assignValue(e, -x) && search()){
+                return TRUE;
+            }
+            undoUntil(position);
+        }
+        if(searchAborted){
+            return FALSE;
+        }
+    }
+    return FALSE;
+}
+
+static void addIncidence(int e, int v, int coefficient){
+    edgeEnd[e][endCount[e]] = v;
+    edgeCoefficient[e][endCount[e]] = coefficient;
+    endCount[e]++;
+    incidenceEdge[v][incidenceCount[v]] = e;
+    incidenceCoefficient[v][incidenceCount[v]] = coefficient;
+    incidenceCount[v]++;
+    unassignedCount[v]++;
+    unassignedWeight[v] += abs(coefficient);
+}
+
+boolean findNowhereZeroFlow(GRAPH graph, ADJACENCY adj, int order, int k,
+        int type, int *flowValues){
+    int i, v;
+
+    if(type == INTEGER_FLOW && flowValues == NULL && isBalanced(graph, adj, order)){
+        type = MODULAR_FLOW;
+    }
+    flowK = k;
+    flowType = type;
+    graphOrder = order;
+    value = flowValues == NULL ? internalValues : flowValues;
+
+    for(i = 0; i < edgeCounter; i++){
+        edges[i].index = i;
+        value[i] = 0;
+    }
+    if(k < 2){
+        //there are no non-zero values
+        return edgeCounter == 0;
+    }
+
+    for(v = 1; v <= order; v++){
+        incidenceCount[v] = 0;
+        residue[v] = 0;
+        unassignedCount[v] = 0;
+        unassignedWeight[v] = 0;
+    }
+    totalResidue = 0;
+    unassignedNegativeCount = 0;
+    unassignedEdgeCount = 0;
+    trailSize = 0;
+    forcedCount = 0;
+
+    for(i = 0; i < edgeCounter; i++){
+        endCount[i] = 0;
+        if(edges[i].smallest == edges[i].largest){
+            if(!edges[i].isNegative){
+                value[i] = 1;
+                continue;
+            }
+            addIncidence(i, edges[i].smallest, 2);
+        } else if(edges[i].isNegative){
+            addIncidence(i, edges[i].smallest, 1);
+            addIncidence(i, edges[i].largest, 1);
+        } else {
+            addIncidence(i, edges[i].smallest, -1);
+            addIncidence(i, edges[i].largest, 1);
+        }
+        unassignedEdgeCount++;
+        if(edges[i].isNegative) unassignedNegativeCount++;
+    }
+
+    for(i = 0; i <= MAXVAL + 1; i++){
+        bucketHead[i] = 0;
+    }
+    for(v = 1; v <= order; v++){
+        insertInBucket(v);
+        if(!isFeasibleVertex(v)){
+            return FALSE;
+        }
+    }
+    if(!isFeasibleTotal()){
+        return FALSE;
+    }
+
+    /* A search can get stuck after a bad choice early on, so it is restarted
+     * with other choices after a number of nodes. This number doubles with
+     * each restart, so eventually a search is completed.
+     */
+    nodeLimit = INITIAL_NODE_LIMIT;
+    for(restartSeed = 0; ; restartSeed++){
+        nodeCount = 0;
+        searchAborted = FALSE;
+        for(v = 1; v <= order; v++){
+            if(unassignedCount[v] == 1){
+                forcedVertices[forcedCount++] = v;
+            }
+        }
+        if(search()){
+            return TRUE;
+        }
+        undoUntil(0);
+        if(!searchAborted){
+            return FALSE;
+        }
+        if(nodeLimit < LLONG_MAX / 2){
+            nodeLimit *= 2;
+        }
+    }
+}
+
+/* Returns the representative of the set of v and stores in parity whether
+ * v is on the other side than its representative.
+ */
+static int findSide(int v, int *parity){
+    int root = v, p = 0;
+    while(sideParent[root] != root){
+        p ^= sideParity[root];
+        root = sideParent[root];
+    }
+    *parity = p;
+    //compress the path
+    while(sideParent[v] != root){
+        int next = sideParent[v];
+        int nextParity = p ^ sideParity[v];
+        sideParent[v] = root;
+        sideParity[v] = p;
+        v = next;
+        p = nextParity;
+    }
+    return root;
+}
+
+/* The edges are used instead of the adjacency lists, because a loop only
+ * occupies one position in the adjacency list of its vertex.
+ */
+boolean isBalanced(GRAPH graph, ADJACENCY adj, int order){
+    int v, i;
+
+    for(v = 1; v <= order; v++){
+        sideParent[v] = v;
+        sideParity[v] = 0;
+    }
+    for(i = 0; i < edgeCounter; i++){
+        int parity1, parity2;
+        int root1 = findSide(edges[i].smallest, &parity1);
+        int root2 = findSide(edges[i].largest, &parity2);
+        //the ends of a negative edge are on different sides
+        int difference = edges[i].isNegative ? 1 : 0;
+        if(root1 == root2){
+            if((parity1 ^ parity2) != difference){
+                return FALSE;
+            }
+        } else {
+            sideParent[root2] = root1;
+            sideParity[root2] = parity1 ^ parity2 ^ difference;
+        }
+    }
+    return TRUE;
+}
+
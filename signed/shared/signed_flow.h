@@ -0,0 +1,46 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+#ifndef SIGNED_FLOW_H
+#define	SIGNED_FLOW_H
+
+#include "signed_base.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+/* Positive edges are oriented from the smallest to the largest vertex, and
+ * negative edges are oriented like a source. An integer flow has values in
+ * {-k+1, ..., -1, 1, ..., k-1} and a modular flow has values in
+ * {1, ..., k-1} and is only conserved modulo k.
+ */
+#define INTEGER_FLOW 0
+#define MODULAR_FLOW 1
+
+/* Returns TRUE if the signed graph has a nowhere-zero k-flow of the given
+ * type. This sets the index of each edge to its position in edges.
+ *
+ * If flowValues is not NULL, then the flow is stored in it: the value of
+ * an edge is stored at the index of that edge. If flowValues is NULL, then
+ * an integer flow of a balanced graph is found as a modular flow, which is
+ * equivalent by Tutte's theorem and has half as many values per edge.
+ */
+boolean findNowhereZeroFlow(GRAPH graph, ADJACENCY adj, int order, int k,
+        int type, int *flowValues);
+
+/* Returns TRUE if the signed graph is balanced, i.e., if it can be switched
+ * to a graph in which all edges are positive.
+ */
+boolean isBalanced(GRAPH graph, ADJACENCY adj, int order);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SIGNED_FLOW_H */
+
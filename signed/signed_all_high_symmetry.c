@@ -9,7 +9,8 @@
  * and writes 'all' signatures to standard out in signed_code format.
  * At least all signatures up to equivalence will be written, but several
  * signatures up to equivalence will be written several times. This version
- * computes the orbits of edge sets. 
+ * only writes one signature of each orbit of edge sets under the
+ * automorphism group of the graph.
  * 
  * This version does NOT support multigraphs!!!
  * 
@@ -27,7 +28,7 @@
 
 #define MAXN 100
 
-#define MAX_EDGE_COUNT 28
+#define MAX_EDGE_COUNT 64
 
 #include "shared/signed_base.h"
 #include "shared/signed_input.h"
@@ -44,12 +45,37 @@ int negativeEdgesAtVertex[MAXN+1];
 
 boolean noOne = FALSE;
 
-//28 @ 32 bits roughly uses 1 gigabyte of memory
-#define MAX_EDGE_SETS_COUNT 1 << 28
+/* A set of negative edges. Edge i corresponds to bit edgeCounter-1-i, so
+ * that the signatures are generated in increasing order.
+ */
+typedef unsigned long long EDGESET;
+
+#define EDGE_BIT(i) (1ULL << (edgeCounter - 1 - (i)))
+
+/* Graphs with at most this number of edges keep track of the edge sets that
+ * were already seen in a bitmap with one bit for each edge set (32MB for 28
+ * edges). Larger graphs use a hash set of the edge sets instead.
+ */
+#define MAX_BITMAP_EDGE_COUNT 28
 
-unsigned int edgeSets[MAX_EDGE_SETS_COUNT];
+unsigned long long *seenBitmap = NULL;
 
-int edgeSetCounter;
+/* Open addressing hash set. No valid signature has all edges negative, so
+ * an empty slot can be marked with the full edge set. Edge sets that are
+ * smaller than the signature that is currently handled will not be looked up
+ * again, so they are dropped when the table is rebuilt.
+ */
+#define EMPTY_SLOT (~0ULL)
+#define INITIAL_SEEN_TABLE_SIZE (1 << 16)
+
+EDGESET *seenTable = NULL;
+size_t seenTableSize;
+size_t seenTableCount;
+EDGESET currentSignature;
+
+//queue for the breadth-first search through an orbit
+EDGESET *orbitQueue = NULL;
+size_t orbitQueueSize = 0;
 
 /* Nauty worksize */
 #define WORKSIZE 50 * MAXM
@@ -65,10 +91,13 @@ DEFAULTOPTIONS_SPARSEGRAPH(nautyOptions);
 permutation automorphismGroupGenerators[MAXN][MAXN];
 int numberOfGenerators;
 
-void printEdgeSet(unsigned int edgeSet){
+/* The images of the edges under the generators of the automorphism group. */
+int edgeImages[MAXN][MAX_EDGE_COUNT];
+
+void printEdgeSet(EDGESET edgeSet){
     int i;
     for(i = 0; i < edgeCounter; i++){
-        if((1<<i)&edgeSet){
+        if(EDGE_BIT(i)&edgeSet){
             fprintf(stderr, "%d-%d ", edges[i].smallest, edges[i].largest);
         }
     }
@@ -117,88 +146,209 @@ void initNautyOptions(int order) {
     }
 }
 
-int getImageOfEdgeSet(unsigned int edgeSet, permutation *automorphism){
+void computeEdgeImages(permutation *automorphism, int *images){
     int i, j;
-    unsigned int image = 0;
 
     for(i = 0; i<edgeCounter; i++){
-        if(edgeSet & (1<<i)){
-            int v = edges[i].smallest;
-            int w = edges[i].largest;
-            int vImage = automorphism[v-1]+1;
-            int wImage = automorphism[w-1]+1;
-            if(vImage > wImage){
-                int temp = vImage;
-                vImage = wImage;
-                wImage = temp;
-            }
-            j = 0;
-            while(j < edgeCounter && (edges[j].smallest!=vImage || edges[j].largest!=wImage)) j++;
-            if(j==edgeCounter){
-                fprintf(stderr, "Error while finding image of edge -- exiting!\n");
-                exit(EXIT_FAILURE);
-            }
-            image |= 1 << j;
+        int vImage = automorphism[edges[i].smallest-1]+1;
+        int wImage = automorphism[edges[i].largest-1]+1;
+        if(vImage > wImage){
+            int temp = vImage;
+            vImage = wImage;
+            wImage = temp;
         }
+        j = 0;
+        while(j < edgeCounter && (edges[j].smallest!=vImage || edges[j].largest!=wImage)) j++;
+        if(j==edgeCounter){
+            fprintf(stderr, "Error while finding image of edge -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+        images[i] = j;
+    }
+}
+
+EDGESET getImageOfEdgeSet(EDGESET edgeSet, int *images){
+    EDGESET image = 0;
+
+    while(edgeSet){
+        image |= EDGE_BIT(images[edgeCounter - 1 - __builtin_ctzll(edgeSet)]);
+        edgeSet &= edgeSet - 1;
     }
 
     return image;
 }
 
-//=================== union-find ==============================
+//=================== seen edge sets ==============================
 
-int findRootOfElement(int *forest, int element) {
-    //find with path-compression
-    if(element!=forest[element]){
-        forest[element]=findRootOfElement(forest, forest[element]);
+unsigned long long hashEdgeSet(EDGESET edgeSet){
+    //finaliser of splitmix64
+    edgeSet ^= edgeSet >> 30;
+    edgeSet *= 0xbf58476d1ce4e5b9ULL;
+    edgeSet ^= edgeSet >> 27;
+    edgeSet *= 0x94d049bb133111ebULL;
+    edgeSet ^= edgeSet >> 31;
+    return edgeSet;
+}
+
+void allocateSeenTable(size_t size){
+    size_t i;
+    seenTable = (EDGESET *)malloc(size * sizeof(EDGESET));
+    if(seenTable == NULL){
+        fprintf(stderr, "Insufficient memory for seen edge sets -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    for(i = 0; i < size; i++){
+        seenTable[i] = EMPTY_SLOT;
+    }
+    seenTableSize = size;
+}
+
+void insertInSeenTable(EDGESET edgeSet){
+    size_t slot = hashEdgeSet(edgeSet) & (seenTableSize - 1);
+    while(seenTable[slot] != EMPTY_SLOT){
+        slot = (slot + 1) & (seenTableSize - 1);
     }
-    return forest[element];
+    seenTable[slot] = edgeSet;
 }
 
-//implementation of union-find algorithm for sets of vertices
-void unionElements(int *forest, int *treeSizes, int *numberOfComponents, int element1, int element2){
-    int root1 = findRootOfElement(forest, element1);
-    int root2 = findRootOfElement(forest, element2);
+void rebuildSeenTable(){
+    EDGESET *oldTable = seenTable;
+    size_t oldSize = seenTableSize;
+    size_t newSize = oldSize;
+    size_t i;
 
-    if(root1==root2) return;
+    seenTableCount = 0;
+    for(i = 0; i < oldSize; i++){
+        if(oldTable[i] != EMPTY_SLOT && oldTable[i] >= currentSignature){
+            seenTableCount++;
+        }
+    }
+    //the load factor is at most 1/2 after rebuilding
+    while(2 * seenTableCount > newSize){
+        newSize *= 2;
+    }
 
-    if(treeSizes[root1]<treeSizes[root2]){
-        forest[root1]=root2;
-        treeSizes[root2]+=treeSizes[root1];
+    allocateSeenTable(newSize);
+    for(i = 0; i < oldSize; i++){
+        if(oldTable[i] != EMPTY_SLOT && oldTable[i] >= currentSignature){
+            insertInSeenTable(oldTable[i]);
+        }
+    }
+    free(oldTable);
+}
+
+void initSeenEdgeSets(){
+    if(edgeCounter <= MAX_BITMAP_EDGE_COUNT){
+        size_t words = ((1ULL << edgeCounter) + 63) / 64;
+        seenBitmap = (unsigned long long *)calloc(words, sizeof(unsigned long long));
+        if(seenBitmap == NULL){
+            fprintf(stderr, "Insufficient memory for seen edge sets -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
     } else {
-        forest[root2]=root1;
-        treeSizes[root1]+=treeSizes[root2];
+        allocateSeenTable(INITIAL_SEEN_TABLE_SIZE);
+        seenTableCount = 0;
     }
-    (*numberOfComponents)--;
 }
 
-void storeSignature(){
-    int i;
-    edgeSets[edgeSetCounter] = 0;
-    for(i = 0; i < edgeCounter; i++){
-        if(edges[i].isNegative){
-            edgeSets[edgeSetCounter] |= (1 << i);
+void freeSeenEdgeSets(){
+    free(seenBitmap);
+    seenBitmap = NULL;
+    free(seenTable);
+    seenTable = NULL;
+}
+
+/* Marks the edge set as seen. Returns TRUE if it was not seen before.
+ */
+boolean markSeen(EDGESET edgeSet){
+    if(seenBitmap != NULL){
+        unsigned long long bit = 1ULL << (edgeSet & 63);
+        if(seenBitmap[edgeSet >> 6] & bit){
+            return FALSE;
+        }
+        seenBitmap[edgeSet >> 6] |= bit;
+        return TRUE;
+    }
+
+    size_t slot = hashEdgeSet(edgeSet) & (seenTableSize - 1);
+    while(seenTable[slot] != EMPTY_SLOT){
+        if(seenTable[slot] == edgeSet){
+            return FALSE;
         }
+        slot = (slot + 1) & (seenTableSize - 1);
     }
-    edgeSetCounter++;
+    seenTable[slot] = edgeSet;
+    seenTableCount++;
+    //keep the load factor at most 3/4
+    if(4 * seenTableCount > 3 * seenTableSize){
+        rebuildSeenTable();
+    }
+    return TRUE;
 }
 
-void loadSignature(int signatureNumber){
+/* Marks all edge sets in the orbit of the given edge set as seen. The
+ * edge set itself should already be marked.
+ */
+void markOrbit(EDGESET edgeSet){
+    size_t head = 0, tail = 0;
     int i;
-    for(i = 0; i < edgeCounter; i++){
-        edges[i].isNegative = (edgeSets[signatureNumber] & (1 << i));
+
+    if(orbitQueueSize == 0){
+        orbitQueueSize = 1024;
+        orbitQueue = (EDGESET *)malloc(orbitQueueSize * sizeof(EDGESET));
+        if(orbitQueue == NULL){
+            fprintf(stderr, "Insufficient memory for orbit -- exiting!\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    orbitQueue[tail++] = edgeSet;
+    while(head < tail){
+        EDGESET current = orbitQueue[head++];
+        for(i = 0; i < numberOfGenerators; i++){
+            EDGESET image = getImageOfEdgeSet(current, edgeImages[i]);
+            if(markSeen(image)){
+                if(tail == orbitQueueSize){
+                    orbitQueueSize *= 2;
+                    orbitQueue = (EDGESET *)realloc(orbitQueue, orbitQueueSize * sizeof(EDGESET));
+                    if(orbitQueue == NULL){
+                        fprintf(stderr, "Insufficient memory for orbit -- exiting!\n");
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                orbitQueue[tail++] = image;
+            }
+        }
     }
 }
 
-void assignSigns_impl(int currentEdge, int negativeEdgeCount, ADJACENCY adj){
+//=================== signatures ==============================
+
+/* The signatures are generated one by one in increasing order. The first
+ * signature of each orbit that is generated is written, and then the complete
+ * orbit is marked as seen, so that the other signatures in that orbit are
+ * skipped. An automorphism preserves the number of negative edges at each
+ * vertex, so the orbit only contains signatures that are generated, and they
+ * are all larger than the signature that was written.
+ */
+void assignSigns_impl(int currentEdge, int negativeEdgeCount, EDGESET negativeEdges,
+        GRAPH graph, ADJACENCY adj, int order){
     if(currentEdge == edgeCounter){
         if(noOne && negativeEdgeCount==1){
             return;
         }
-        storeSignature();
+        if(numberOfGenerators){
+            currentSignature = negativeEdges;
+            if(!markSeen(negativeEdges)){
+                return;
+            }
+            markOrbit(negativeEdges);
+        }
+        writeSignedCode(graph, adj, order, outFile);
+        graphsWritten++;
     } else {
         edges[currentEdge].isNegative = FALSE;
-        assignSigns_impl(currentEdge+1, negativeEdgeCount, adj);
+        assignSigns_impl(currentEdge+1, negativeEdgeCount, negativeEdges, graph, adj, order);
         edges[currentEdge].isNegative = TRUE;
         int v = edges[currentEdge].largest;
         int w = edges[currentEdge].smallest;
@@ -206,21 +356,26 @@ void assignSigns_impl(int currentEdge, int negativeEdgeCount, ADJACENCY adj){
         negativeEdgesAtVertex[w]++;
         if((negativeEdgesAtVertex[v]*2<=adj[v]) &&
                 (negativeEdgesAtVertex[w]*2<=adj[w])){
-            assignSigns_impl(currentEdge+1, negativeEdgeCount + 1, adj);
+            assignSigns_impl(currentEdge+1, negativeEdgeCount + 1,
+                    negativeEdges | EDGE_BIT(currentEdge), graph, adj, order);
         }
         negativeEdgesAtVertex[v]--;
         negativeEdgesAtVertex[w]--;
+        edges[currentEdge].isNegative = FALSE;
     }
 }
 
 void assignSigns(GRAPH graph1, ADJACENCY adj, int order){
-    //compute sets
-    int i,j,k;
-    edgeSetCounter = 0;
-    for(i=1; i < order; i++){
+    int i;
+
+    if(edgeCounter > MAX_EDGE_COUNT){
+        fprintf(stderr, "This program can only handle graphs with at most %d edges -- exiting!\n", MAX_EDGE_COUNT);
+        exit(EXIT_FAILURE);
+    }
+
+    for(i=1; i <= order; i++){
         negativeEdgesAtVertex[i] = 0;
     }
-    assignSigns_impl(0, 0, adj);
     
     //translate to nauty graph
     initNautyOptions(order);
@@ -230,36 +385,16 @@ void assignSigns(GRAPH graph1, ADJACENCY adj, int order){
     numberOfGenerators = 0;
     nauty((graph*) &sg, lab, ptn, NULL, orbits, &nautyOptions, &stats, workspace, WORKSIZE, MAXM, order, NULL);    
     
-    //perform union-find
-    int forest[edgeSetCounter];
-    int treeSizes[edgeSetCounter];
-    for(i = 0; i < edgeSetCounter; i++){
-        forest[i] = i;
-        treeSizes[i] = 1;
-    }
-    
-    int numberOfOrbits = edgeSetCounter;
     for(i=0; i<numberOfGenerators; i++){
-        for(j=0; j<edgeSetCounter; j++){
-            unsigned int edgeSetImage = getImageOfEdgeSet(edgeSets[j], automorphismGroupGenerators[i]);
-            k = 0;
-            while((k<edgeSetCounter) && (edgeSetImage != edgeSets[k])) k++;
-            if(k==edgeSetCounter){
-                fprintf(stderr, "Error while finding image of edge set -- exiting!\n");
-                exit(EXIT_FAILURE);
-            }
-            unionElements(forest, treeSizes, &numberOfOrbits, j, k);
-        }
+        computeEdgeImages(automorphismGroupGenerators[i], edgeImages[i]);
     }
     
-    //write signed graphs
-    for(i=0; i<edgeSetCounter; i++){
-        if(forest[i]==i){
-            loadSignature(i);
-            writeSignedCode(graph1, adj, order, outFile);
-            graphsWritten++;
-        }
+    //write one signed graph for each orbit
+    if(numberOfGenerators){
+        initSeenEdgeSets();
     }
+    assignSigns_impl(0, 0, 0, graph1, adj, order);
+    freeSeenEdgeSets();
 }
     
 //====================== USAGE =======================
@@ -11,8 +11,9 @@
  * 
  * Compile with:
  *     
- *     cc -o signed_has_balanced_hamiltonian_cycle -O4  signed_has_balanced_hamiltonian_cycle.c \
- *           shared/signed_base.c shared/signed_input.c shared/signed_output.c
+ *     cc -o signed_has_balanced_hamiltonian_cycle -O4 -flto signed_has_balanced_hamiltonian_cycle.c \
+ *           shared/signed_cycles.c shared/signed_base.c shared/signed_input.c \
+ *           shared/signed_output.c
  * 
  */
 
@@ -23,102 +24,21 @@
 #include "shared/signed_base.h"
 #include "shared/signed_input.h"
 #include "shared/signed_output.h"
-
-#define MAX_EDGE_COUNT 64
+#include "shared/signed_cycles.h"
 
 int edgeCounter = 0;
 
-boolean handleSimpleCycle(int negativeEdgesInCycle){
-    if(negativeEdgesInCycle%2==0){
-        //cycle is balanced
-        return TRUE;
-    }
-    return FALSE;
-}
-
-boolean checkSimpleCycles_impl(GRAPH graph, ADJACENCY adj, int order, int firstVertex, int secondVertex,
-        int currentVertex,
-        unsigned long long int verticesInCycle, unsigned long long int edgesInCycle, int negativeEdgesInCycle, int length){
-    int i;
-    for(i=0; i<adj[currentVertex]; i++){
-        EDGE *e = graph[currentVertex][i];
-        int neighbour = (e->smallest == currentVertex) ? e->largest : e->smallest;
-        if((1ULL << e->index) & (edgesInCycle)){
-            //edge already in cycle
-            continue;
-        } else if((neighbour != firstVertex) && ((1ULL << neighbour) & (verticesInCycle))){
-            //vertex already in cycle (and not first vertex)
-            continue;
-        } else if(neighbour < firstVertex){
-            //cycle not in canonical form
-            continue;
-        } else if(neighbour == firstVertex){
-            //we have returned to the first vertex
-            if(currentVertex < secondVertex){
-                //cycle not in canonical form
-                continue;
-            }
-            if(length < order){
-                //if it is not a hamiltonian cycle
-                continue;
-            }
-            if(e->isNegative){
-                if(handleSimpleCycle(negativeEdgesInCycle + 1)){
-                    return TRUE;
-                }
-            } else {
-                if(handleSimpleCycle(negativeEdgesInCycle)){
-                    return TRUE;
-                }
-            }
-        } else {
-            //we continue the cycle
-            if(e->isNegative){
-                if(checkSimpleCycles_impl(graph, adj, order, firstVertex, secondVertex, neighbour,
-                    verticesInCycle | (1ULL<<neighbour), edgesInCycle | (1ULL<<(e->index)),
-                        negativeEdgesInCycle+1, length + 1)){
-                    return TRUE;
-                }
-            } else {
-                if(checkSimpleCycles_impl(graph, adj, order, firstVertex, secondVertex, neighbour,
-                    verticesInCycle | (1ULL<<neighbour), edgesInCycle | (1ULL<<(e->index)),
-                        negativeEdgesInCycle, length + 1)){
-                    return TRUE;
-                }
-            }
-        }
-    }
-    return FALSE;
+int handleSimpleCycle(SIGNED_CYCLE *cycle, void *data){
+    int order = *(int *)data;
+    //cycle is balanced
+    return cycle->length == order ? CYCLES_STOP : CYCLES_CONTINUE;
 }
 
 /* Checks the simple cycles and returns TRUE if the graph has a balanced hamiltonian cycle.
  */
 boolean hasBalancedHamiltonianCycle(GRAPH graph, ADJACENCY adj, int order){
-    int v, i;
-    for(i=0; i<edgeCounter; i++){
-        edges[i].index = i;
-    }
-    
-    for(v = 1; v < order; v++){ //intentionally skip v==order!
-        for(i=0; i<adj[v]; i++){
-            EDGE *e = graph[v][i];
-            int neighbour = e->largest;
-            if(neighbour == v){
-                //cycle not in canonical form: we have seen this cycle already
-                continue;
-            } else {
-                //start a cycle
-                unsigned long long int verticesInCycle = (1ULL<<v) | (1ULL<<neighbour); //add vertex
-                unsigned long long int edgesInCycle = (1ULL<<(e->index)); //add edge
-                int negativeEdgesInCycle = (e->isNegative) ? 1 : 0;
-                if(checkSimpleCycles_impl(graph, adj, order, v, neighbour, neighbour,
-                        verticesInCycle, edgesInCycle, negativeEdgesInCycle, 2)){
-                    return TRUE;
-                }
-            }
-        }
-    }
-    return FALSE;
+    CYCLE_VISITOR visitor = {BALANCED_CYCLES, handleSimpleCycle, NULL, &order};
+    return enumerateSimpleCycles(graph, adj, order, &visitor);
 }
 
 //====================== USAGE =======================
@@ -196,9 +116,11 @@ int main(int argc, char** argv) {
         int order;
         decodeSignedCode(code, length, graph, adj, &order);
         graphCount++;
-        if(edgeCounter > MAX_EDGE_COUNT){
-            fprintf(stderr, "Current version only supports graphs with up to %d edges.\n", MAX_EDGE_COUNT);
-            fprintf(stderr, "Graph %d has %d edges. Exiting!\n", graphCount, edgeCounter);
+        if(!SET_CAN_STORE(edgeCounter - 1) || !SET_CAN_STORE(order)){
+            fprintf(stderr, "Current version only supports graphs with up to %d edges and %d vertices.\n",
+                    SIGNED_BITSET_SIZE, SIGNED_BITSET_SIZE - 1);
+            fprintf(stderr, "Graph %d has %d edges and %d vertices.\n", graphCount, edgeCounter, order);
+            fprintf(stderr, "Recompile with a larger value for SIGNED_BITSET_SIZE -- exiting!\n");
             exit(EXIT_FAILURE);
         }
         
@@ -11,8 +11,9 @@
  * 
  * Compile with:
  *     
- *     cc -o signed_has_barbell -O4  signed_has_barbell.c \
- *           shared/signed_base.c shared/signed_input.c shared/signed_output.c
+ *     cc -o signed_has_barbell -O4 -flto signed_has_barbell.c \
+ *           shared/signed_cycles.c shared/signed_base.c shared/signed_input.c \
+ *           shared/signed_output.c
  * 
  */
 
@@ -23,121 +24,42 @@
 #include "shared/signed_base.h"
 #include "shared/signed_input.h"
 #include "shared/signed_output.h"
-
-#define MAX_EDGE_COUNT 64
+#include "shared/signed_cycles.h"
 
 #define MAX_UNBALANCED_CYCLES 5000
-unsigned long long int unbalancedCycles[MAX_UNBALANCED_CYCLES];
+BITSET unbalancedCycles[MAX_UNBALANCED_CYCLES];
 int unbalancedCycleCount = 0;
 
 
 int edgeCounter = 0;
 
-boolean handleSimpleCycle(unsigned long long int verticesInCycle, int negativeEdgesInCycle){
-    if(negativeEdgesInCycle%2==1){
-        //cycle is unbalanced
-        
-        int i;
-        for(i = 0; i < unbalancedCycleCount; i++){
-            unsigned long long int intersection = verticesInCycle & unbalancedCycles[i];
-            if(!((intersection) & ((intersection)-1))){
-                //intersection has only one or zero vertices
-                return TRUE;
-            }
-        }
-        
-        if(unbalancedCycleCount==MAX_UNBALANCED_CYCLES){
-            fprintf(stderr, "This program can handle only graphs with up to %d unbalanced cycles.\n", MAX_UNBALANCED_CYCLES);
-            fprintf(stderr, "Recompile with a larger value for MAX_UNBALANCED_CYCLES if needed -- exiting!\n");
-            exit(EXIT_FAILURE);
-        }
-        
-        //store cycle vertices and continue
-        unbalancedCycles[unbalancedCycleCount] = verticesInCycle;
-        unbalancedCycleCount++;
-    }
-    return FALSE;
-}
-
-boolean checkSimpleCycles_impl(GRAPH graph, ADJACENCY adj, int firstVertex, int secondVertex,
-        int currentVertex,
-        unsigned long long int verticesInCycle, unsigned long long int edgesInCycle, int negativeEdgesInCycle){
+int handleSimpleCycle(SIGNED_CYCLE *cycle, void *data){
+    //cycle is unbalanced
     int i;
-    for(i=0; i<adj[currentVertex]; i++){
-        EDGE *e = graph[currentVertex][i];
-        int neighbour = (e->smallest == currentVertex) ? e->largest : e->smallest;
-        if((1ULL << e->index) & (edgesInCycle)){
-            //edge already in cycle
-            continue;
-        } else if((neighbour != firstVertex) && ((1ULL << neighbour) & (verticesInCycle))){
-            //vertex already in cycle (and not first vertex)
-            continue;
-        } else if(neighbour < firstVertex){
-            //cycle not in canonical form
-            continue;
-        } else if(neighbour == firstVertex){
-            //we have returned to the first vertex
-            if(currentVertex < secondVertex){
-                //cycle not in canonical form
-                continue;
-            }
-            if(e->isNegative){
-                if(handleSimpleCycle(verticesInCycle, negativeEdgesInCycle + 1)){
-                    return TRUE;
-                }
-            } else {
-                if(handleSimpleCycle(verticesInCycle, negativeEdgesInCycle)){
-                    return TRUE;
-                }
-            }
-        } else {
-            //we continue the cycle
-            if(e->isNegative){
-                if(checkSimpleCycles_impl(graph, adj, firstVertex, secondVertex, neighbour,
-                    verticesInCycle | (1ULL<<neighbour), edgesInCycle | (1ULL<<(e->index)),
-                        negativeEdgesInCycle+1)){
-                    return TRUE;
-                }
-            } else {
-                if(checkSimpleCycles_impl(graph, adj, firstVertex, secondVertex, neighbour,
-                    verticesInCycle | (1ULL<<neighbour), edgesInCycle | (1ULL<<(e->index)),
-                        negativeEdgesInCycle)){
-                    return TRUE;
-                }
-            }
+    for(i = 0; i < unbalancedCycleCount; i++){
+        if(intersectionHasAtMostOneElement(cycle->vertices, unbalancedCycles[i])){
+            //intersection has only one or zero vertices
+            return CYCLES_STOP;
         }
     }
-    return FALSE;
+    
+    if(unbalancedCycleCount==MAX_UNBALANCED_CYCLES){
+        fprintf(stderr, "This program can handle only graphs with up to %d unbalanced cycles.\n", MAX_UNBALANCED_CYCLES);
+        fprintf(stderr, "Recompile with a larger value for MAX_UNBALANCED_CYCLES if needed -- exiting!\n");
+        exit(EXIT_FAILURE);
+    }
+    
+    //store cycle vertices and continue
+    unbalancedCycles[unbalancedCycleCount] = cycle->vertices;
+    unbalancedCycleCount++;
+    return CYCLES_CONTINUE;
 }
 
 /* Checks the simple cycles and returns TRUE if the graph has a barbell.
  */
 boolean hasBarbell(GRAPH graph, ADJACENCY adj, int order){
-    int v, i;
-    for(i=0; i<edgeCounter; i++){
-        edges[i].index = i;
-    }
-    
-    for(v = 1; v < order; v++){ //intentionally skip v==order!
-        for(i=0; i<adj[v]; i++){
-            EDGE *e = graph[v][i];
-            int neighbour = e->largest;
-            if(neighbour == v){
-                //cycle not in canonical form: we have seen this cycle already
-                continue;
-            } else {
-                //start a cycle
-                unsigned long long int verticesInCycle = (1ULL<<v) | (1ULL<<neighbour); //add vertex
-                unsigned long long int edgesInCycle = (1ULL<<(e->index)); //add edge
-                int negativeEdgesInCycle = (e->isNegative) ? 1 : 0;
-                if(checkSimpleCycles_impl(graph, adj, v, neighbour, neighbour,
-                        verticesInCycle, edgesInCycle, negativeEdgesInCycle)){
-                    return TRUE;
-                }
-            }
-        }
-    }
-    return FALSE;
+    CYCLE_VISITOR visitor = {UNBALANCED_CYCLES, handleSimpleCycle, NULL, NULL};
+    return enumerateSimpleCycles(graph, adj, order, &visitor);
 }
 
 //====================== USAGE =======================
@@ -215,9 +137,11 @@ int main(int argc, char** argv) {
         int order;
         decodeSignedCode(code, length, graph, adj, &order);
         graphCount++;
-        if(edgeCounter > MAX_EDGE_COUNT){
-            fprintf(stderr, "Current version only supports graphs with up to %d edges.\n", MAX_EDGE_COUNT);
-            fprintf(stderr, "Graph %d has %d edges. Exiting!\n", graphCount, edgeCounter);
+        if(!SET_CAN_STORE(edgeCounter - 1) || !SET_CAN_STORE(order)){
+            fprintf(stderr, "Current version only supports graphs with up to %d edges and %d vertices.\n",
+                    SIGNED_BITSET_SIZE, SIGNED_BITSET_SIZE - 1);
+            fprintf(stderr, "Graph %d has %d edges and %d vertices.\n", graphCount, edgeCounter, order);
+            fprintf(stderr, "Recompile with a larger value for SIGNED_BITSET_SIZE -- exiting!\n");
             exit(EXIT_FAILURE);
         }
         
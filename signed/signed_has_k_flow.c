@@ -11,6 +11,8 @@
  * 
  * Compile with:
  *     
+ *     cc -o signed_has_k_flow -O4  signed_has_k_flow.c shared/signed_flow.c \
+ *           shared/signed_base.c shared/signed_input.c shared/signed_output.c
  * 
  */
 
@@ -21,6 +23,7 @@
 #include "shared/signed_base.h"
 #include "shared/signed_input.h"
 #include "shared/signed_output.h"
+#include "shared/signed_flow.h"
 
 int k;
 
@@ -29,9 +32,8 @@ int edgeCounter = 0;
 int graphCount = 0;
 int graphsFiltered = 0;
 
-int unassignedEdgesAtVertex[MAXN+1];
-int flowAtVertex[MAXN+1];
 int flowValue[MAXE];
+int flowType = INTEGER_FLOW;
 
 FILE *flowFile = NULL;
 boolean showFlow = FALSE;
@@ -141,187 +143,9 @@ void writeFlow(GRAPH g, ADJACENCY adj, int order) {
 
 }
 
-boolean findKflow(GRAPH graph, ADJACENCY adj, int order, int unassignedEdges){
-    int i, j;
-    
-    if(unassignedEdges==0){
-        return TRUE;
-    }
-    //first see if there is a vertex incident to only one unassigned edge
-    i = 1;
-    int minUnassignedEdges = MAXN;
-    int minUnassignedEdgesVertex;
-    while(i <= order && unassignedEdgesAtVertex[i]!=1){
-        if(unassignedEdgesAtVertex[i]>0 && unassignedEdgesAtVertex[i] < minUnassignedEdges){
-            minUnassignedEdges = unassignedEdgesAtVertex[i];
-            minUnassignedEdgesVertex = i;
-        }
-        i++;
-    }
-    if(i<=order){
-        //assign that remaining edge
-        if(flowAtVertex[i]==0 || flowAtVertex[i] <= -k || flowAtVertex[i] >= k){
-            //does not lead to a valid k-flow
-            return FALSE;
-        }
-        //find the edge
-        j = 0;
-        while(j < adj[i] && flowValue[graph[i][j]->index]!=0){
-            j++;
-        }
-        if(j == adj[i]){
-            fprintf(stderr, "Program reached inconsistent state -- exiting!\n");
-            exit(EXIT_FAILURE);
-        }
-        EDGE *edge = graph[i][j];
-        
-        //determine the value
-        int value;
-        if(edge->isNegative){
-            //negative edges are always seen as 'sources'
-            value = -flowAtVertex[i];
-        } else if(i==edge->smallest){
-            //orientation is from small to large
-            value = flowAtVertex[i];
-        } else {
-            value = -flowAtVertex[i];
-        }
-        
-        //set the value
-        flowValue[edge->index] = value;
-        unassignedEdgesAtVertex[edge->smallest]--;
-        unassignedEdgesAtVertex[edge->largest]--;
-        if(edge->isNegative){
-            flowAtVertex[edge->smallest]+=value;
-            flowAtVertex[edge->largest]+=value;
-        } else {
-            flowAtVertex[edge->smallest]-=value;
-            flowAtVertex[edge->largest]+=value;
-        }
-        
-        //check legality at other vertex
-        int neighbour;
-        if(i==edge->smallest){
-            neighbour = edge->largest;
-        } else {
-            neighbour = edge->smallest;
-        }
-        if(unassignedEdgesAtVertex[neighbour]>0 || flowAtVertex[neighbour]==0){
-            //recurse
-            if(findKflow(graph, adj, order, unassignedEdges-1)){
-                return TRUE;
-            }
-        }
-        //reset values
-        flowValue[edge->index] = 0;
-        unassignedEdgesAtVertex[edge->smallest]++;
-        unassignedEdgesAtVertex[edge->largest]++;
-        if(edge->isNegative){
-            flowAtVertex[edge->smallest]-=value;
-            flowAtVertex[edge->largest]-=value;
-        } else {
-            flowAtVertex[edge->smallest]+=value;
-            flowAtVertex[edge->largest]-=value;
-        }
-        
-        return FALSE;
-    } else {
-        //choose an edge incident to a vertex which is incident to the least number of unassigned edges
-        
-        i = 0;
-        while(i < adj[minUnassignedEdgesVertex] &&
-                flowValue[graph[minUnassignedEdgesVertex][i]->index]!=0){
-           i++; 
-        }
-        if(i==adj[minUnassignedEdgesVertex]){
-            fprintf(stderr, "Program reached inconsistent state -- exiting!\n");
-            exit(EXIT_FAILURE);
-        }
-        EDGE *edge = graph[minUnassignedEdgesVertex][i];
-        
-        for(i = -k + 1; i < 0; i++){
-            int value = i;
-            //set the value
-            flowValue[edge->index] = value;
-            unassignedEdgesAtVertex[edge->smallest]--;
-            unassignedEdgesAtVertex[edge->largest]--;
-            if(edge->isNegative){
-                flowAtVertex[edge->smallest]+=value;
-                flowAtVertex[edge->largest]+=value;
-            } else {
-                flowAtVertex[edge->smallest]-=value;
-                flowAtVertex[edge->largest]+=value;
-            }
-
-            //check legality
-            if((unassignedEdgesAtVertex[edge->largest]>0 || flowAtVertex[edge->largest]==0)
-                    && (unassignedEdgesAtVertex[edge->smallest]>0 || flowAtVertex[edge->smallest]==0)){
-                //recurse
-                if(findKflow(graph, adj, order, unassignedEdges-1)){
-                    return TRUE;
-                }
-            }
-            //reset values
-            flowValue[edge->index] = 0;
-            unassignedEdgesAtVertex[edge->smallest]++;
-            unassignedEdgesAtVertex[edge->largest]++;
-            if(edge->isNegative){
-                flowAtVertex[edge->smallest]-=value;
-                flowAtVertex[edge->largest]-=value;
-            } else {
-                flowAtVertex[edge->smallest]+=value;
-                flowAtVertex[edge->largest]-=value;
-            }
-        }
-        for(i = 1; i < k; i++){
-            int value = i;
-            //set the value
-            flowValue[edge->index] = value;
-            unassignedEdgesAtVertex[edge->smallest]--;
-            unassignedEdgesAtVertex[edge->largest]--;
-            if(edge->isNegative){
-                flowAtVertex[edge->smallest]+=value;
-                flowAtVertex[edge->largest]+=value;
-            } else {
-                flowAtVertex[edge->smallest]-=value;
-                flowAtVertex[edge->largest]+=value;
-            }
-
-            //check legality
-            if((unassignedEdgesAtVertex[edge->largest]>0 || flowAtVertex[edge->largest]==0)
-                    && (unassignedEdgesAtVertex[edge->smallest]>0 || flowAtVertex[edge->smallest]==0)){
-                //recurse
-                if(findKflow(graph, adj, order, unassignedEdges-1)){
-                    return TRUE;
-                }
-            }
-            //reset values
-            flowValue[edge->index] = 0;
-            unassignedEdgesAtVertex[edge->smallest]++;
-            unassignedEdgesAtVertex[edge->largest]++;
-            if(edge->isNegative){
-                flowAtVertex[edge->smallest]-=value;
-                flowAtVertex[edge->largest]-=value;
-            } else {
-                flowAtVertex[edge->smallest]+=value;
-                flowAtVertex[edge->largest]-=value;
-            }
-        }
-    }
-    return FALSE;
-}
-
 boolean hasKflow(GRAPH graph, ADJACENCY adj, int order){
-    int i;
-    for(i=1; i<=order; i++){
-        unassignedEdgesAtVertex[i] = adj[i];
-        flowAtVertex[i] = 0;
-    }
-    for(i=0; i<edgeCounter; i++){
-        flowValue[i] = 0;
-        edges[i].index = i;
-    }
-    return findKflow(graph, adj, order, edgeCounter);
+    return findNowhereZeroFlow(graph, adj, order, k, flowType,
+            showFlow ? flowValue : NULL);
 }
 
 //====================== USAGE =======================
@@ -340,6 +164,8 @@ void help(char *name) {
     fprintf(stderr, "       Invert the filter.\n");
     fprintf(stderr, "    -m, --multicode\n");
     fprintf(stderr, "       Export the graphs in multi_code format (signs are not exported).\n");
+    fprintf(stderr, "    -z, --modular\n");
+    fprintf(stderr, "       Look for a nowhere-zero Z_k-flow instead of a nowhere-zero integer k-flow.\n");
     fprintf(stderr, "    -s, --show\n");
     fprintf(stderr, "       Shows the k-flow if there is one. This feature is disabled if -f is used.\n");
     fprintf(stderr, "       Note that positive edges are always oriented from small to large, and\n");
@@ -376,11 +202,12 @@ int main(int argc, char** argv) {
         {"filter", no_argument, NULL, 'f'},
         {"multicode", no_argument, NULL, 'm'},
         {"show", no_argument, NULL, 's'},
+        {"modular", no_argument, NULL, 'z'},
         {"help", no_argument, NULL, 'h'}
     };
     int option_index = 0;
 
-    while ((c = getopt_long(argc, argv, "hfims", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "hfimsz", long_options, &option_index)) != -1) {
         switch (c) {
             case 'i':
                 invert = TRUE;
@@ -394,6 +221,9 @@ int main(int argc, char** argv) {
             case 's':
                 showFlow = TRUE;
                 break;
+            case 'z':
+                flowType = MODULAR_FLOW;
+                break;
             case 'h':
                 help(name);
                 return EXIT_SUCCESS;
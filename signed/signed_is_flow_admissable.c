@@ -11,8 +11,9 @@
  * 
  * Compile with:
  *     
- *     cc -o signed_is_flow_admissable -O4  signed_is_flow_admissable.c \
- *           shared/signed_base.c shared/signed_input.c shared/signed_output.c
+ *     cc -o signed_is_flow_admissable -O4 -flto signed_is_flow_admissable.c \
+ *           shared/signed_cycles.c shared/signed_base.c shared/signed_input.c \
+ *           shared/signed_output.c
  * 
  */
 
@@ -23,91 +24,93 @@
 #include "shared/signed_base.h"
 #include "shared/signed_input.h"
 #include "shared/signed_output.h"
-
-#define MAX_EDGE_COUNT 64
-//higher numbers would be possible by using arrays as sets
-
-unsigned long long int fullSets[MAX_EDGE_COUNT+1] = 
-{
-    0ULL,
-    (1ULL <<  1) - 1, (1ULL <<  2) - 1, (1ULL <<  3) - 1, (1ULL <<  4) - 1,
-    (1ULL <<  5) - 1, (1ULL <<  6) - 1, (1ULL <<  7) - 1, (1ULL <<  8) - 1,
-    (1ULL <<  9) - 1, (1ULL << 10) - 1, (1ULL << 11) - 1, (1ULL << 12) - 1,
-    (1ULL << 13) - 1, (1ULL << 14) - 1, (1ULL << 15) - 1, (1ULL << 16) - 1,
-    (1ULL << 17) - 1, (1ULL << 18) - 1, (1ULL << 19) - 1, (1ULL << 20) - 1,
-    (1ULL << 21) - 1, (1ULL << 22) - 1, (1ULL << 23) - 1, (1ULL << 24) - 1,
-    (1ULL << 25) - 1, (1ULL << 26) - 1, (1ULL << 27) - 1, (1ULL << 28) - 1,
-    (1ULL << 29) - 1, (1ULL << 30) - 1, (1ULL << 31) - 1, (1ULL << 32) - 1,
-    (1ULL << 33) - 1, (1ULL << 34) - 1, (1ULL << 35) - 1, (1ULL << 36) - 1,
-    (1ULL << 37) - 1, (1ULL << 38) - 1, (1ULL << 39) - 1, (1ULL << 40) - 1,
-    (1ULL << 41) - 1, (1ULL << 42) - 1, (1ULL << 43) - 1, (1ULL << 44) - 1,
-    (1ULL << 45) - 1, (1ULL << 46) - 1, (1ULL << 47) - 1, (1ULL << 48) - 1,
-    (1ULL << 49) - 1, (1ULL << 50) - 1, (1ULL << 51) - 1, (1ULL << 52) - 1,
-    (1ULL << 53) - 1, (1ULL << 54) - 1, (1ULL << 55) - 1, (1ULL << 56) - 1,
-    (1ULL << 57) - 1, (1ULL << 58) - 1, (1ULL << 59) - 1, (1ULL << 60) - 1,
-    (1ULL << 61) - 1, (1ULL << 62) - 1, (1ULL << 63) - 1, 18446744073709551615ULL
-};
+#include "shared/signed_cycles.h"
 
 int edgeCounter = 0;
 
-void handleSimpleCycle(unsigned long long int *possibleEquivalentOneSets,
-        unsigned long long int *edgesInCycle, int *negativeEdgesInCycle){
-    if((*negativeEdgesInCycle)%2==0){
-        //cycle is balanced
-        //remove all edges in cycle from set of possible equivalent signatures
-        *possibleEquivalentOneSets &= ~(*edgesInCycle);
+/* A signed graph is flow-admissable if and only if each edge is contained
+ * in a signed circuit. A signed circuit is either a balanced cycle or a
+ * barbell: two unbalanced cycles that share exactly one vertex, or two
+ * vertex-disjoint unbalanced cycles that are joined by a path which only
+ * meets them in its end points.
+ *
+ * uncoveredEdges contains the edges that are not in a balanced cycle.
+ */
+BITSET uncoveredEdges;
+
+int handleSimpleCycle(SIGNED_CYCLE *cycle, void *data){
+    //cycle is balanced
+    //remove all edges in cycle from set of uncovered edges
+    SET_REMOVE_ALL(uncoveredEdges, cycle->edges);
+    if(SET_IS_EMPTY(uncoveredEdges)){
+        //each edge is contained in a balanced cycle
+        return CYCLES_STOP;
     }
+    return CYCLES_CONTINUE;
 }
 
-void checkSimpleCycles_impl(GRAPH graph, ADJACENCY adj, int firstVertex, int secondVertex,
-        int currentVertex, unsigned long long int *possibleEquivalentOneSets,
-        unsigned long long int *verticesInCycle, unsigned long long int *edgesInCycle, int *negativeEdgesInCycle){
-    int i;
-    for(i=0; i<adj[currentVertex]; i++){
-        EDGE *e = graph[currentVertex][i];
-        int neighbour = (e->smallest == currentVertex) ? e->largest : e->smallest;
-        if((1ULL << e->index) & (*edgesInCycle)){
-            //edge already in cycle
-            continue;
-        } else if((neighbour != firstVertex) && ((1ULL << neighbour) & (*verticesInCycle))){
-            //vertex already in cycle (and not first vertex)
-            continue;
-        } else if(neighbour < firstVertex){
-            //cycle not in canonical form
-            continue;
-        } else if(neighbour == firstVertex){
-            //we have returned to the first vertex
-            if(currentVertex < secondVertex){
-                //cycle not in canonical form
-                continue;
+/* Returns TRUE if the part of the graph that can be reached from start
+ * without using skippedEdge is balanced. The vertices that are reached are
+ * stored in reached.
+ */
+boolean isBalancedWithoutEdge(GRAPH graph, ADJACENCY adj, int start,
+        EDGE *skippedEdge, BITSET *reached){
+    int queue[MAXN];
+    int side[MAXN + 1];
+    int head = 0, tail = 1, i;
+    boolean balanced = TRUE;
+
+    *reached = EMPTY_SET;
+    SET_ADD(*reached, start);
+    side[start] = 0;
+    queue[0] = start;
+    while(head < tail){
+        int v = queue[head++];
+        for(i=0; i<adj[v]; i++){
+            EDGE *e = graph[v][i];
+            if(e == skippedEdge) continue;
+            int neighbour = (e->smallest == v) ? e->largest : e->smallest;
+            //switching at the vertices with side 1 makes all edges positive
+            int neighbourSide = side[v] ^ e->isNegative;
+            if(!SET_CONTAINS(*reached, neighbour)){
+                SET_ADD(*reached, neighbour);
+                side[neighbour] = neighbourSide;
+                queue[tail++] = neighbour;
+            } else if(side[neighbour] != neighbourSide){
+                balanced = FALSE;
             }
-            *edgesInCycle |= (1ULL<<e->index); //add edge
-            if(e->isNegative) (*negativeEdgesInCycle)++;
-            handleSimpleCycle(possibleEquivalentOneSets, edgesInCycle, negativeEdgesInCycle);
-            if(e->isNegative) (*negativeEdgesInCycle)--;
-            *edgesInCycle ^= (1ULL<<e->index); //remove edge (we know that it is in the set, so we can just toggle it)
-        } else {
-            //we continue the cycle
-            *verticesInCycle |= (1ULL<<neighbour); //add vertex
-            *edgesInCycle |= (1ULL<<e->index); //add edge
-            if(e->isNegative) (*negativeEdgesInCycle)++;
-            checkSimpleCycles_impl(graph, adj, firstVertex, secondVertex, neighbour,
-                    possibleEquivalentOneSets, verticesInCycle, edgesInCycle, negativeEdgesInCycle);
-            if(e->isNegative) (*negativeEdgesInCycle)--;
-            *edgesInCycle ^= (1ULL<<e->index); //remove edge (we know that it is in the set, so we can just toggle it)
-            *verticesInCycle ^= (1ULL<<neighbour); //remove vertex (we know that it is in the set, so we can just toggle it)
-        }
-        if(!(*possibleEquivalentOneSets)){
-            //there are no possible equivalent one sets left
-            return;
         }
     }
+    return balanced;
 }
 
-/* Checks the simple cycles and returns TRUE if the graph is flow-admissable.
+/* Returns TRUE if the edge, which is not contained in a balanced cycle, is
+ * contained in a barbell. Such an edge is not contained in a barbell if and
+ * only if removing it makes its component balanced (then all unbalanced
+ * cycles of that component contain this edge), or if it is a bridge and one
+ * of the two sides is balanced (then there is no unbalanced cycle on that
+ * side). Otherwise unbalanced cycles can be combined into a barbell through
+ * this edge.
+ */
+boolean isInBarbell(GRAPH graph, ADJACENCY adj, EDGE *e){
+    BITSET reached;
+    if(isBalancedWithoutEdge(graph, adj, e->smallest, e, &reached)){
+        //either the component becomes balanced or one side of the bridge is balanced
+        return FALSE;
+    }
+    if(SET_CONTAINS(reached, e->largest)){
+        //the edge is not a bridge and its component stays unbalanced
+        return TRUE;
+    }
+    return !isBalancedWithoutEdge(graph, adj, e->largest, e, &reached);
+}
+
+/* Returns TRUE if the graph is flow-admissable. The balanced cycles are
+ * checked first, since they usually cover all edges. Only the edges that are
+ * not in a balanced cycle are checked for barbells.
  */
 boolean isFlowAdmissable(GRAPH graph, ADJACENCY adj, int order){
-    int v,i,negativeEdgeCount;
+    int i, negativeEdgeCount = 0;
     for(i=1; i<=order; i++){
         if(adj[i]==1){
             //if there are vertices of degree 1 it is not flow-admissable
@@ -115,35 +118,22 @@ boolean isFlowAdmissable(GRAPH graph, ADJACENCY adj, int order){
         }
     }
     for(i=0; i<edgeCounter; i++){
-        edges[i].index = i;
         if(edges[i].isNegative) negativeEdgeCount++;
     }
     if(negativeEdgeCount==1){
         return FALSE;
     }
-    unsigned long long int possibleEquivalentOneSets = fullSets[edgeCounter];
-    for(v = 1; v < order; v++){ //intentionally skip v==order!
-        for(i=0; i<adj[v]; i++){
-            EDGE *e = graph[v][i];
-            int neighbour = e->largest;
-            if(neighbour == v){
-                //cycle not in canonical form: we have seen this cycle already
-                continue;
-            } else {
-                //start a cycle
-                unsigned long long int verticesInCycle = (1ULL<<v) & (1ULL<<neighbour); //add vertex
-                unsigned long long int edgesInCycle = (1ULL<<(e->index)); //add edge
-                int negativeEdgesInCycle = (e->isNegative) ? 1 : 0;
-                checkSimpleCycles_impl(graph, adj, v, neighbour, neighbour,
-                        &possibleEquivalentOneSets, &verticesInCycle, &edgesInCycle, &negativeEdgesInCycle);
-                if(!possibleEquivalentOneSets){
-                    //each edge is contained in a balanced cycle
-                    return TRUE;
-                }
-            }
+    uncoveredEdges = firstElementsSet(edgeCounter);
+    CYCLE_VISITOR visitor = {BALANCED_CYCLES, handleSimpleCycle, NULL, NULL};
+    if(enumerateSimpleCycles(graph, adj, order, &visitor)){
+        return TRUE;
+    }
+    for(i=0; i<edgeCounter; i++){
+        if(SET_CONTAINS(uncoveredEdges, i) && !isInBarbell(graph, adj, edges + i)){
+            return FALSE;
         }
     }
-    return FALSE;
+    return TRUE;
 }
 
 //====================== USAGE =======================
@@ -221,9 +211,11 @@ int main(int argc, char** argv) {
         int order;
         decodeSignedCode(code, length, graph, adj, &order);
         graphCount++;
-        if(edgeCounter > MAX_EDGE_COUNT){
-            fprintf(stderr, "Current version only supports graphs with up to %d edges.\n", MAX_EDGE_COUNT);
-            fprintf(stderr, "Graph %d has %d edges. Exiting!\n", graphCount, edgeCounter);
+        if(!SET_CAN_STORE(edgeCounter - 1) || !SET_CAN_STORE(order)){
+            fprintf(stderr, "Current version only supports graphs with up to %d edges and %d vertices.\n",
+                    SIGNED_BITSET_SIZE, SIGNED_BITSET_SIZE - 1);
+            fprintf(stderr, "Graph %d has %d edges and %d vertices.\n", graphCount, edgeCounter, order);
+            fprintf(stderr, "Recompile with a larger value for SIGNED_BITSET_SIZE -- exiting!\n");
             exit(EXIT_FAILURE);
         }
         
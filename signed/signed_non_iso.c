@@ -0,0 +1,144 @@
+/*
+ * Main developer: Nico Van Cleemput
+ *
+ * Copyright (C) 2026 Ghent University.
+ * Licensed under the GNU GPL, read the file LICENSE.txt for details.
+ */
+
+/* This program reads graphs in signed_code format from standard in and
+ * writes the first graph of each class up to switching and isomorphism to
+ * standard out in signed_code format.
+ *
+ * Compile with:
+ *
+ *     cc -o signed_non_iso -O4  signed_non_iso.c shared/signed_canonical.c \
+ *     shared/signed_base.c shared/signed_input.c shared/signed_output.c \
+ *     ../multicode/shared/multicode_dedup.c \
+ *     nauty/nauty.c nauty/nautil.c nauty/nausparse.c nauty/schreier.c \
+ *     nauty/naurng.c
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include "shared/signed_base.h"
+#include "shared/signed_input.h"
+#include "shared/signed_output.h"
+#include "shared/signed_canonical.h"
+#include "../multicode/shared/multicode_dedup.h"
+
+int edgeCounter = 0;
+
+/* The canonical forms that have been seen are stored in a hash table keyed
+ * by a fingerprint of the form (see ../multicode/shared/multicode_dedup.h).
+ */
+FORM_TABLE *formTable = NULL;
+
+//====================== USAGE =======================
+
+void help(char *name) {
+    fprintf(stderr, "The program %s keeps one signed graph of each class up to switching\n", name);
+    fprintf(stderr, "and isomorphism, in the order they were read.\n\n");
+    fprintf(stderr, "Usage\n=====\n");
+    fprintf(stderr, " %s [options]\n\n", name);
+    fprintf(stderr, "\nThis program can handle graphs up to %d vertices. Recompile if you need larger\n", MAXN);
+    fprintf(stderr, "graphs.\n\n");
+    fprintf(stderr, "Valid options\n=============\n");
+    fprintf(stderr, "    -c, --count\n");
+    fprintf(stderr, "       Only count the number of non-equivalent signed graphs.\n");
+    fprintf(stderr, "    -i, --info\n");
+    fprintf(stderr, "       Report for each graph whether it is new or of which graph it is a copy.\n");
+    fprintf(stderr, "    -h, --help\n");
+    fprintf(stderr, "       Print this help and return.\n");
+}
+
+void usage(char *name) {
+    fprintf(stderr, "Usage: %s [options]\n", name);
+    fprintf(stderr, "For more information type: %s -h \n\n", name);
+}
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+
+    GRAPH graph;
+    ADJACENCY adj;
+
+    int graphsRead = 0;
+    int graphsWritten = 0;
+
+    boolean onlyCount = FALSE;
+    boolean info = FALSE;
+
+    /*=========== commandline parsing ===========*/
+
+    int c;
+    char *name = argv[0];
+    static struct option long_options[] = {
+        {"count", no_argument, NULL, 'c'},
+        {"info", no_argument, NULL, 'i'},
+        {"help", no_argument, NULL, 'h'}
+    };
+    int option_index = 0;
+
+    while ((c = getopt_long(argc, argv, "hci", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'c':
+                onlyCount = TRUE;
+                break;
+            case 'i':
+                info = TRUE;
+                break;
+            case 'h':
+                help(name);
+                return EXIT_SUCCESS;
+            case '?':
+                usage(name);
+                return EXIT_FAILURE;
+            default:
+                fprintf(stderr, "Illegal option %c.\n", c);
+                usage(name);
+                return EXIT_FAILURE;
+        }
+    }
+
+    formTable = newFormTable(FALSE);
+
+    unsigned short code[MAXCODELENGTH];
+    int length;
+    while (readSignedCode(code, &length, stdin)) {
+        int order, formLength, copy;
+        int *form;
+        decodeSignedCode(code, length, graph, adj, &order);
+        graphsRead++;
+
+        form = getSwitchingCanonicalForm(graph, adj, order, &formLength);
+        copy = addToFormTable(formTable,
+                computeFingerprint(form, formLength * sizeof(int), formLength),
+                form, formLength * sizeof(int), graphsRead);
+        if(!copy){
+            graphsWritten++;
+            if(!onlyCount && !info){
+                writeSignedCode(graph, adj, order, stdout);
+            }
+        }
+        if(info){
+            if(!copy){
+                fprintf(stdout, "Graph %d is new.\n", graphsRead);
+            } else {
+                fprintf(stdout, "Graph %d is not new, copy is %d.\n", graphsRead, copy);
+            }
+        }
+    }
+
+    fprintf(stderr, "Read %d signed graph%s.\n", graphsRead, graphsRead==1 ? "" : "s");
+    fprintf(stderr, "Found %d signed graph%s up to switching and isomorphism.\n",
+            graphsWritten, graphsWritten==1 ? "" : "s");
+
+    freeFormTable(formTable);
+
+    return (EXIT_SUCCESS);
+}